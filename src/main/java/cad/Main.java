@@ -1,13 +1,37 @@
 package cad;
 
-import java.util.Scanner;
+import cad.cli.BatchProcessor;
+import cad.cli.BatchRunner;
+import cad.cli.BooleanBenchmark;
 import cad.cli.Cli;
-import cad.gui.GuiFX;
+import cad.cli.KernelServer;
+import cad.cli.MacroSweep;
+import cad.cli.StartupBenchmark;
 
 public class Main {
 
     public static void main(String[] args) {
 
+        // Headless modes return before anything prints or loads the GUI toolkit
+        if (args.length > 0 && BatchRunner.isBatchMode(args[0])) {
+            System.exit(BatchRunner.run(args));
+        }
+        if (args.length > 0 && BatchProcessor.isBatchCommand(args[0])) {
+            System.exit(BatchProcessor.run(args));
+        }
+        if (args.length > 0 && MacroSweep.isSweepCommand(args[0])) {
+            System.exit(MacroSweep.run(args));
+        }
+        if (args.length > 0 && BooleanBenchmark.isBenchmarkCommand(args[0])) {
+            System.exit(BooleanBenchmark.run(args));
+        }
+        if (args.length > 0 && StartupBenchmark.isBenchmarkCommand(args[0])) {
+            System.exit(StartupBenchmark.run(args));
+        }
+        if (args.length > 0 && KernelServer.isServeMode(args[0])) {
+            System.exit(KernelServer.run(args));
+        }
+
         Runtime.getRuntime().addShutdownHook(new Thread(() -> {
             System.out.println("\nCAD Application shutting down gracefully...");
         }));
@@ -19,13 +43,13 @@ public class Main {
                 if (mode.equals("--cli") || mode.equals("-cli")) {
                     Cli.launch();
                 } else if (mode.equals("--gui") || mode.equals("-gui")) {
-                    javafx.application.Application.launch(GuiFX.class, args);
+                    launchGui(args);
                 } else {
                     printUsage();
                 }
             } else {
                 System.out.println("No arguments provided. Starting GUI mode...");
-                javafx.application.Application.launch(GuiFX.class, args);
+                launchGui(args);
             }
         } catch (Exception e) {
             System.err.println("Error starting CAD application: " + e.getMessage());
@@ -33,9 +57,21 @@ public class Main {
         }
     }
 
+    // The only place Main names a GUI class, so CLI and headless runs never load JavaFX or JOGL
+    private static void launchGui(String[] args) {
+        javafx.application.Application.launch(cad.gui.GuiFX.class, args);
+    }
+
     private static void printUsage() {
-        System.out.println("Usage: java -jar SketchApp.jar [--cli|--gui]");
+        System.out.println("Usage: java -jar SketchApp.jar [--cli|--gui|--batch <script>|--eval <commands>|--serve]");
         System.out.println("  --cli     Launch in command-line interface mode");
         System.out.println("  --gui     Launch in graphical user interface mode");
+        System.out.println("  --batch   Run a command script headlessly; add --json for a JSON report");
+        System.out.println("  --eval    Run ';'-separated commands headlessly; add --json for a JSON report");
+        System.out.println("  batch     Run a command pipeline over many files in parallel, with a CSV/JSON summary");
+        System.out.println("  sweep     Run a macro over a grid of ${param} values in parallel, with a CSV of mass properties");
+        System.out.println("  bench-booleans  Time JCSG against the mesh boolean engine on a set of test parts");
+        System.out.println("  bench-startup   Time cold starts of the jar with and without the CDS archive");
+        System.out.println("  --serve   Keep models resident and accept JSON-RPC on stdio, or on --socket <path>");
     }
 }
\ No newline at end of file
@@ -0,0 +1,367 @@
+package cad.cli;
+
+import com.google.gson.GsonBuilder;
+import com.google.gson.JsonArray;
+import com.google.gson.JsonObject;
+import java.io.IOException;
+import java.io.PrintStream;
+import java.io.PrintWriter;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.FileSystems;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.PathMatcher;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.Set;
+import java.util.concurrent.CompletionService;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorCompletionService;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.stream.Stream;
+
+// The "batch" subcommand: runs one pipeline of CLI commands over many input files on a fixed pool of
+// worker threads. Every file gets its own ModelContext and Cli session, so files share no geometry
+// and one failure does not affect the rest. Pipeline lines may use {file}, {name}, {ext}, {dir} and
+// {out}, which expand to the input path, its base name without extension, its extension, its
+// directory and the --out directory.
+//
+//   batch parts/**/*.stl --pipeline "load {file}; mass_props; save {out}/{name}.stl" --out converted
+//         --jobs 8 --summary summary.csv
+public class BatchProcessor {
+
+    private final List<String> pipeline;
+    private final String outDir;
+    private final int jobs;
+
+    public BatchProcessor(List<String> pipeline, String outDir, int jobs) {
+        if (jobs < 1) {
+            throw new IllegalArgumentException("Need at least one worker");
+        }
+        this.pipeline = pipeline;
+        this.outDir = outDir;
+        this.jobs = jobs;
+    }
+
+    // One input file's outcome
+    public static class FileResult {
+        private final Path file;
+        private final BatchRunner.Report report;
+        private final Throwable crash;
+
+        FileResult(Path file, BatchRunner.Report report, Throwable crash) {
+            this.file = file;
+            this.report = report;
+            this.crash = crash;
+        }
+
+        public Path getFile() {
+            return file;
+        }
+
+        public BatchRunner.Report getReport() {
+            return report;
+        }
+
+        public boolean isOk() {
+            return crash == null && report.isOk();
+        }
+
+        public int getExitCode() {
+            return crash != null ? BatchRunner.EXIT_COMMAND_FAILED : report.getExitCode();
+        }
+
+        public CommandResult getFailure() {
+            for (CommandResult result : report.getResults()) {
+                if (!result.isOk()) {
+                    return result;
+                }
+            }
+            return null;
+        }
+
+        public String getMessage() {
+            if (crash != null) {
+                return crash.toString();
+            }
+            CommandResult failure = getFailure();
+            return failure != null ? failure.getMessage() : null;
+        }
+
+        // Volume and surface area from the last mass_props in the pipeline, or null
+        public double[] getMassProperties() {
+            double[] props = null;
+            for (CommandResult result : report.getResults()) {
+                Double volume = result.getValue("volume");
+                Double area = result.getValue("surface_area");
+                if (volume != null && area != null) {
+                    props = new double[] { volume, area };
+                }
+            }
+            return props;
+        }
+    }
+
+    public interface ProgressListener {
+        void onFileDone(int done, int total, FileResult result);
+    }
+
+    public static boolean isBatchCommand(String arg) {
+        return arg.equalsIgnoreCase("batch");
+    }
+
+    // Entry point from Main; args[0] is "batch". Returns the process exit code.
+    public static int run(String[] args) {
+        List<String> inputs = new ArrayList<>();
+        String pipelineText = null;
+        String outDir = ".";
+        String summary = null;
+        int jobs = Runtime.getRuntime().availableProcessors();
+        try {
+            for (int i = 1; i < args.length; i++) {
+                String arg = args[i];
+                switch (arg.toLowerCase()) {
+                    case "--pipeline":
+                        pipelineText = requireValue(args, ++i, arg);
+                        break;
+                    case "--out":
+                        outDir = requireValue(args, ++i, arg);
+                        break;
+                    case "--summary":
+                        summary = requireValue(args, ++i, arg);
+                        break;
+                    case "--jobs":
+                        jobs = Integer.parseInt(requireValue(args, ++i, arg));
+                        break;
+                    default:
+                        if (arg.startsWith("--")) {
+                            throw new IllegalArgumentException("Unknown option: " + arg);
+                        }
+                        inputs.add(arg);
+                }
+            }
+            if (pipelineText == null || inputs.isEmpty()) {
+                throw new IllegalArgumentException("Need input files and a --pipeline");
+            }
+            if (jobs < 1) {
+                throw new IllegalArgumentException("--jobs must be at least 1");
+            }
+        } catch (IllegalArgumentException e) {
+            return usage(e.getMessage());
+        }
+
+        List<String> pipeline;
+        List<Path> files;
+        try {
+            pipeline = pipelineText.startsWith("@")
+                    ? Files.readAllLines(Paths.get(pipelineText.substring(1)), StandardCharsets.UTF_8)
+                    : BatchRunner.splitCommands(pipelineText);
+            files = resolveInputs(inputs);
+            Files.createDirectories(Paths.get(outDir));
+        } catch (IOException e) {
+            System.err.println("Cannot prepare batch: " + e.getMessage());
+            return BatchRunner.EXIT_IO_ERROR;
+        }
+        if (files.isEmpty()) {
+            System.err.println("No input files matched");
+            return BatchRunner.EXIT_IO_ERROR;
+        }
+
+        PrintStream err = System.err;
+        long start = System.nanoTime();
+        List<FileResult> results;
+        try {
+            results = new BatchProcessor(pipeline, outDir, jobs).process(files,
+                    (done, total, result) -> err.printf("[%d/%d] %s %s (%.0f ms)%s%n", done, total,
+                            result.isOk() ? "ok    " : "FAILED", result.getFile(),
+                            result.getReport().getElapsedNanos() / 1e6,
+                            result.isOk() ? "" : ": " + result.getMessage()));
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return BatchRunner.EXIT_COMMAND_FAILED;
+        }
+        long failed = results.stream().filter(r -> !r.isOk()).count();
+        err.printf("Processed %d files in %.1f s: %d ok, %d failed%n", results.size(),
+                (System.nanoTime() - start) / 1e9, results.size() - failed, failed);
+
+        if (summary != null) {
+            try {
+                writeSummary(Paths.get(summary), results);
+            } catch (IOException e) {
+                System.err.println("Cannot write summary: " + e.getMessage());
+                return BatchRunner.EXIT_IO_ERROR;
+            }
+        }
+        return failed == 0 ? BatchRunner.EXIT_OK : BatchRunner.EXIT_COMMAND_FAILED;
+    }
+
+    // Runs the pipeline on every file and returns the results in input order
+    public List<FileResult> process(List<Path> files, ProgressListener progress) throws InterruptedException {
+        ExecutorService pool = Executors.newFixedThreadPool(jobs, r -> {
+            Thread t = new Thread(r, "batch-worker");
+            t.setDaemon(true);
+            return t;
+        });
+        try {
+            CompletionService<Integer> completion = new ExecutorCompletionService<>(pool);
+            FileResult[] results = new FileResult[files.size()];
+            for (int i = 0; i < files.size(); i++) {
+                int index = i;
+                completion.submit(() -> {
+                    results[index] = processFile(files.get(index));
+                    return index;
+                });
+            }
+            AtomicInteger done = new AtomicInteger();
+            for (int i = 0; i < files.size(); i++) {
+                int index;
+                try {
+                    index = completion.take().get();
+                } catch (ExecutionException e) {
+                    throw new IllegalStateException(e.getCause());
+                }
+                if (progress != null) {
+                    progress.onFileDone(done.incrementAndGet(), files.size(), results[index]);
+                }
+            }
+            return List.of(results);
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+
+    public FileResult processFile(Path file) {
+        BatchRunner runner = new BatchRunner().captureOutput(true);
+        // Nothing is undone in a batch; keep history from holding every intermediate model
+        runner.getCli().getCommandManager().setMaxHistorySize(1);
+        List<String> lines = new ArrayList<>(pipeline.size());
+        for (String line : pipeline) {
+            lines.add(expand(line, file));
+        }
+        try {
+            return new FileResult(file, runner.execute(file.toString(), lines), null);
+        } catch (RuntimeException | StackOverflowError e) {
+            return new FileResult(file, new BatchRunner.Report(file.toString()), e);
+        }
+    }
+
+    // Every value is quoted, so paths with spaces stay one word when Cli.run splits the line;
+    // "{out}/{name}.stl" still reads as a single path because quoted parts join adjacent text
+    private String expand(String line, Path file) {
+        String fileName = file.getFileName().toString();
+        int dot = fileName.lastIndexOf('.');
+        Path dir = file.toAbsolutePath().getParent();
+        return line.replace("{file}", Cli.quote(file.toString()))
+                .replace("{name}", Cli.quote(dot > 0 ? fileName.substring(0, dot) : fileName))
+                .replace("{ext}", Cli.quote(dot > 0 ? fileName.substring(dot + 1) : ""))
+                .replace("{dir}", Cli.quote(dir != null ? dir.toString() : "."))
+                .replace("{out}", Cli.quote(outDir));
+    }
+
+    // Plain paths, glob patterns (relative to the part before the first wildcard), and @manifest
+    // files listing one input per line. Duplicates are dropped; order follows the arguments.
+    static List<Path> resolveInputs(List<String> inputs) throws IOException {
+        Set<Path> files = new LinkedHashSet<>();
+        for (String input : inputs) {
+            if (input.startsWith("@")) {
+                for (String line : Files.readAllLines(Paths.get(input.substring(1)), StandardCharsets.UTF_8)) {
+                    line = line.trim();
+                    if (!line.isEmpty() && !line.startsWith("#")) {
+                        files.add(Paths.get(line));
+                    }
+                }
+            } else if (input.matches(".*[*?\\[{].*")) {
+                files.addAll(glob(input));
+            } else {
+                files.add(Paths.get(input));
+            }
+        }
+        return new ArrayList<>(files);
+    }
+
+    private static List<Path> glob(String pattern) throws IOException {
+        String normalized = pattern.replace('\\', '/');
+        int wildcard = normalized.replaceAll("[*?\\[{].*", "").lastIndexOf('/');
+        Path base = wildcard >= 0 ? Paths.get(normalized.substring(0, wildcard + 1)) : Paths.get(".");
+        String relative = wildcard >= 0 ? normalized.substring(wildcard + 1) : normalized;
+        PathMatcher matcher = FileSystems.getDefault().getPathMatcher("glob:" + relative);
+        // "**/" should also match files directly in the base directory, which PathMatcher does not
+        PathMatcher topLevel = relative.startsWith("**/")
+                ? FileSystems.getDefault().getPathMatcher("glob:" + relative.substring(3))
+                : matcher;
+        if (!Files.isDirectory(base)) {
+            return List.of();
+        }
+        try (Stream<Path> walk = Files.walk(base)) {
+            return walk.filter(Files::isRegularFile)
+                    .filter(p -> matcher.matches(base.relativize(p)) || topLevel.matches(base.relativize(p)))
+                    .sorted()
+                    .toList();
+        }
+    }
+
+    // CSV unless the name ends in .json, which also carries every command's status and output
+    static void writeSummary(Path path, List<FileResult> results) throws IOException {
+        if (path.toString().toLowerCase(Locale.ROOT).endsWith(".json")) {
+            JsonArray files = new JsonArray();
+            for (FileResult result : results) {
+                JsonObject json = result.getReport().toJson();
+                json.addProperty("exitCode", result.getExitCode());
+                if (!result.isOk()) {
+                    json.addProperty("error", result.getMessage());
+                }
+                double[] props = result.getMassProperties();
+                if (props != null) {
+                    json.addProperty("volume", props[0]);
+                    json.addProperty("surfaceArea", props[1]);
+                }
+                files.add(json);
+            }
+            Files.writeString(path, new GsonBuilder().setPrettyPrinting().disableHtmlEscaping().create().toJson(files),
+                    StandardCharsets.UTF_8);
+            return;
+        }
+        try (PrintWriter out = new PrintWriter(Files.newBufferedWriter(path, StandardCharsets.UTF_8))) {
+            out.println("file,status,exit_code,elapsed_ms,volume,surface_area,failed_command,message");
+            for (FileResult result : results) {
+                CommandResult failure = result.getFailure();
+                double[] props = result.getMassProperties();
+                out.println(String.join(",",
+                        csv(result.getFile().toString()),
+                        result.isOk() ? "ok" : "failed",
+                        Integer.toString(result.getExitCode()),
+                        String.format(Locale.ROOT, "%.1f", result.getReport().getElapsedNanos() / 1e6),
+                        props != null ? Double.toString(props[0]) : "",
+                        props != null ? Double.toString(props[1]) : "",
+                        csv(failure != null ? failure.getLine() : ""),
+                        csv(result.getMessage() != null ? result.getMessage() : "")));
+            }
+        }
+    }
+
+    private static String csv(String value) {
+        if (value.contains(",") || value.contains("\"") || value.contains("\n")) {
+            return "\"" + value.replace("\"", "\"\"") + "\"";
+        }
+        return value;
+    }
+
+    private static String requireValue(String[] args, int i, String option) {
+        if (i >= args.length) {
+            throw new IllegalArgumentException("Missing argument for " + option);
+        }
+        return args[i];
+    }
+
+    private static int usage(String message) {
+        System.err.println(message);
+        System.err.println("Usage: java -jar SketchApp.jar batch <file|glob|@manifest>... --pipeline \"cmd; cmd\"|@file");
+        System.err.println("           [--out dir] [--jobs n] [--summary results.csv|results.json]");
+        return BatchRunner.EXIT_USAGE;
+    }
+}
@@ -0,0 +1,300 @@
+package cad.cli;
+
+import cad.core.ModelContext;
+import com.google.gson.Gson;
+import com.google.gson.GsonBuilder;
+import com.google.gson.JsonArray;
+import com.google.gson.JsonObject;
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.PrintStream;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+// Headless script execution for --batch and --eval: runs CLI command lines with no banner or prompt
+// on a fresh model context and reports the outcome through the exit code and, with --json, a JSON
+// document on stdout. Nothing here touches JavaFX or JOGL.
+public class BatchRunner {
+    public static final int EXIT_OK = 0;
+    public static final int EXIT_COMMAND_FAILED = 1;
+    public static final int EXIT_SCRIPT_ERROR = 2;
+    public static final int EXIT_IO_ERROR = 3;
+    public static final int EXIT_USAGE = 64;
+
+    private final Cli cli;
+    private boolean keepGoing;
+    private boolean captureOutput;
+
+    public BatchRunner() {
+        this(new Cli(new ModelContext()));
+    }
+
+    public BatchRunner(Cli cli) {
+        this.cli = cli;
+    }
+
+    public Cli getCli() {
+        return cli;
+    }
+
+    // Run every line even after a failure; the exit code still reports the first one
+    public BatchRunner keepGoing(boolean keepGoing) {
+        this.keepGoing = keepGoing;
+        return this;
+    }
+
+    // Attach each command's printed output to its result instead of letting it reach stdout
+    public BatchRunner captureOutput(boolean captureOutput) {
+        this.captureOutput = captureOutput;
+        return this;
+    }
+
+    public static boolean isBatchMode(String arg) {
+        String mode = arg.toLowerCase();
+        return mode.equals("--batch") || mode.equals("--eval");
+    }
+
+    // Entry point from Main; returns the process exit code
+    public static int run(String[] args) {
+        List<String> scripts = new ArrayList<>();
+        List<String> evals = new ArrayList<>();
+        boolean json = false;
+        boolean keepGoing = false;
+        for (int i = 0; i < args.length; i++) {
+            String arg = args[i];
+            switch (arg.toLowerCase()) {
+                case "--batch":
+                case "--eval":
+                    if (i + 1 >= args.length) {
+                        return usage("Missing argument for " + arg);
+                    }
+                    (arg.equalsIgnoreCase("--batch") ? scripts : evals).add(args[++i]);
+                    break;
+                case "--json":
+                    json = true;
+                    break;
+                case "--keep-going":
+                    keepGoing = true;
+                    break;
+                default:
+                    return usage("Unknown option: " + arg);
+            }
+        }
+        if (!scripts.isEmpty() && !evals.isEmpty()) {
+            return usage("Use either --batch or --eval, not both");
+        }
+
+        if (json) {
+            OutputCapture.install();
+        }
+        PrintStream out = OutputCapture.originalOut();
+        List<Report> reports = new ArrayList<>();
+        int exitCode = EXIT_OK;
+        if (!evals.isEmpty()) {
+            List<String> lines = new ArrayList<>();
+            for (String eval : evals) {
+                lines.addAll(splitCommands(eval));
+            }
+            reports.add(new BatchRunner().keepGoing(keepGoing).captureOutput(json).execute("<eval>", lines));
+        } else {
+            // Each script gets its own model, as if run by a separate process
+            for (String script : scripts) {
+                Report report;
+                try {
+                    BatchRunner runner = new BatchRunner().keepGoing(keepGoing).captureOutput(json);
+                    report = runner.execute(script, readScript(script));
+                } catch (IOException e) {
+                    report = Report.ioError(script, e);
+                }
+                reports.add(report);
+                if (!report.isOk() && !keepGoing) {
+                    break;
+                }
+            }
+        }
+        for (Report report : reports) {
+            if (exitCode == EXIT_OK) {
+                exitCode = report.getExitCode();
+            }
+            if (!json && report.getIoError() != null) {
+                System.err.println("Cannot read " + report.getSource() + ": " + report.getIoError().getMessage());
+            }
+        }
+
+        if (json) {
+            JsonObject document = new JsonObject();
+            document.addProperty("exitCode", exitCode);
+            JsonArray scriptArray = new JsonArray();
+            for (Report report : reports) {
+                scriptArray.add(report.toJson());
+            }
+            document.add("scripts", scriptArray);
+            Gson gson = new GsonBuilder().setPrettyPrinting().disableHtmlEscaping().create();
+            out.println(gson.toJson(document));
+            out.flush();
+        }
+        return exitCode;
+    }
+
+    // Runs the lines in order; blank lines and lines starting with '#' are skipped. "exit" ends the
+    // script successfully.
+    public Report execute(String source, List<String> lines) {
+        Report report = new Report(source);
+        long start = System.nanoTime();
+        for (int i = 0; i < lines.size(); i++) {
+            String line = lines.get(i).trim();
+            if (line.isEmpty() || line.startsWith("#")) {
+                continue;
+            }
+            if (captureOutput) {
+                OutputCapture.begin();
+            }
+            CommandResult result;
+            String output = null;
+            try {
+                result = cli.run(line);
+            } finally {
+                if (captureOutput) {
+                    output = OutputCapture.end();
+                }
+            }
+            result.setOutput(output);
+            report.add(i + 1, result);
+            if (result.getStatus() == CommandResult.Status.EXIT) {
+                break;
+            }
+            if (!result.isOk()) {
+                if (!captureOutput) {
+                    System.err.printf("%s:%d: %s: %s%n", source, i + 1, result.getStatus(), result.getMessage());
+                }
+                if (!keepGoing) {
+                    break;
+                }
+            }
+        }
+        report.elapsedNanos = System.nanoTime() - start;
+        return report;
+    }
+
+    // --eval accepts commands separated by ';' or newlines
+    static List<String> splitCommands(String text) {
+        return new ArrayList<>(Arrays.asList(text.split("[;\\r\\n]+")));
+    }
+
+    private static List<String> readScript(String script) throws IOException {
+        if (script.equals("-")) {
+            BufferedReader reader = new BufferedReader(new InputStreamReader(System.in, StandardCharsets.UTF_8));
+            List<String> lines = new ArrayList<>();
+            String line;
+            while ((line = reader.readLine()) != null) {
+                lines.add(line);
+            }
+            return lines;
+        }
+        Path path = Paths.get(script);
+        return Files.readAllLines(path, StandardCharsets.UTF_8);
+    }
+
+    private static int usage(String message) {
+        System.err.println(message);
+        System.err.println("Usage: java -jar SketchApp.jar --batch <script.cad|-> [--batch ...] [--json] [--keep-going]");
+        System.err.println("       java -jar SketchApp.jar --eval \"cmd; cmd; ...\" [--json] [--keep-going]");
+        return EXIT_USAGE;
+    }
+
+    public static class Report {
+        private final String source;
+        private final List<Integer> lineNumbers = new ArrayList<>();
+        private final List<CommandResult> results = new ArrayList<>();
+        private IOException ioError;
+        private long elapsedNanos;
+
+        Report(String source) {
+            this.source = source;
+        }
+
+        static Report ioError(String source, IOException e) {
+            Report report = new Report(source);
+            report.ioError = e;
+            return report;
+        }
+
+        void add(int lineNumber, CommandResult result) {
+            lineNumbers.add(lineNumber);
+            results.add(result);
+        }
+
+        public String getSource() {
+            return source;
+        }
+
+        public List<CommandResult> getResults() {
+            return results;
+        }
+
+        public IOException getIoError() {
+            return ioError;
+        }
+
+        public long getElapsedNanos() {
+            return elapsedNanos;
+        }
+
+        public boolean isOk() {
+            return getExitCode() == EXIT_OK;
+        }
+
+        // The first failure decides: unknown commands and bad arguments are script errors
+        public int getExitCode() {
+            if (ioError != null) {
+                return EXIT_IO_ERROR;
+            }
+            for (CommandResult result : results) {
+                switch (result.getStatus()) {
+                    case UNKNOWN_COMMAND:
+                    case INVALID_ARGUMENTS:
+                        return EXIT_SCRIPT_ERROR;
+                    case FAILED:
+                        return EXIT_COMMAND_FAILED;
+                    default:
+                        break;
+                }
+            }
+            return EXIT_OK;
+        }
+
+        public JsonObject toJson() {
+            JsonObject json = new JsonObject();
+            json.addProperty("source", source);
+            json.addProperty("exitCode", getExitCode());
+            json.addProperty("elapsedMillis", elapsedNanos / 1_000_000.0);
+            if (ioError != null) {
+                json.addProperty("error", ioError.getMessage());
+            }
+            JsonArray commands = new JsonArray();
+            for (int i = 0; i < results.size(); i++) {
+                CommandResult result = results.get(i);
+                JsonObject command = new JsonObject();
+                command.addProperty("line", lineNumbers.get(i));
+                command.addProperty("command", result.getLine());
+                command.addProperty("status", result.getStatus().name().toLowerCase());
+                if (result.getMessage() != null) {
+                    command.addProperty("message", result.getMessage());
+                }
+                if (result.getOutput() != null && !result.getOutput().isEmpty()) {
+                    command.addProperty("output", result.getOutput());
+                }
+                command.addProperty("elapsedMillis", result.getElapsedNanos() / 1_000_000.0);
+                commands.add(command);
+            }
+            json.add("commands", commands);
+            return json;
+        }
+    }
+}
@@ -0,0 +1,171 @@
+package cad.cli;
+
+import cad.geometry.booleans.IndexedMesh;
+import cad.geometry.booleans.MeshBoolean;
+import eu.mihosoft.jcsg.CSG;
+import eu.mihosoft.jcsg.Cube;
+import eu.mihosoft.jcsg.Cylinder;
+import eu.mihosoft.jcsg.Polygon;
+import eu.mihosoft.jcsg.Sphere;
+import eu.mihosoft.vvecmath.Transform;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Locale;
+import java.util.function.Supplier;
+
+// The "bench-booleans" subcommand: times JCSG's BSP booleans against the mesh engine in
+// cad.geometry.booleans on a fixed set of test parts, and prints one CSV row per part, operation
+// and engine:
+//
+//   bench-booleans --repeat 5
+//
+// Besides small parts that exercise coplanar and curved cases, two parts run well past 50k
+// polygons each: a 384 x 192 sphere (about 74k) against a cube, and a plate drilled with 100 holes
+// of 256 facets (about 77k polygons in the tool). --small leaves those out; JCSG can take minutes on
+// them.
+//
+// Times are the best of the repeats after one warm-up run, and include converting to and from CSG
+// as Geometry.combine does. Volumes and open edge counts sit next to them so that a fast wrong
+// answer stands out.
+public class BooleanBenchmark {
+    static final class Part {
+        final String name;
+        final CSG first;
+        final CSG second;
+
+        Part(String name, CSG first, CSG second) {
+            this.name = name;
+            this.first = first;
+            this.second = second;
+        }
+    }
+
+    private static final class Timing {
+        double bestMillis = Double.POSITIVE_INFINITY;
+        IndexedMesh result;
+        String error;
+    }
+
+    public static boolean isBenchmarkCommand(String arg) {
+        return arg.equalsIgnoreCase("bench-booleans");
+    }
+
+    static List<Part> parts(boolean large) {
+        CSG cube = new Cube(2, 2, 2).toCSG();
+        CSG sphere = new Sphere(1, 48, 24).toCSG();
+        List<Part> parts = new ArrayList<>(List.of(
+                new Part("offset cubes", cube, cube.transformed(Transform.unity().translate(1, 1, 1))),
+                new Part("drilled plate", new Cube(4, 4, 1).toCSG(),
+                        new Cylinder(0.5, 3, 64).toCSG().transformed(Transform.unity().translateZ(-1.5))),
+                new Part("flush pocket", new Cube(4, 4, 2).toCSG(),
+                        new Cube(2, 2, 1).toCSG().transformed(Transform.unity().translateZ(0.5))),
+                new Part("cube and sphere", cube, new Sphere(1.3, 48, 24).toCSG()),
+                new Part("two spheres", sphere, sphere.transformed(Transform.unity().translateX(0.7))),
+                new Part("crossed cylinders", new Cylinder(0.6, 4, 48).toCSG()
+                        .transformed(Transform.unity().translateZ(-2)),
+                        new Cylinder(0.6, 4, 48).toCSG().transformed(Transform.unity().translateZ(-2))
+                                .transformed(Transform.unity().rotX(90)))));
+        if (large) {
+            // Past the ~50k polygon mark where the BSP trees stop scaling
+            parts.add(new Part("fine sphere and cube", new Sphere(1, 384, 192).toCSG(),
+                    cube.transformed(Transform.unity().translate(0.6, 0.6, 0.6))));
+            parts.add(new Part("plate with 100 holes", new Cube(22, 22, 2).toCSG(), holeGrid(10, 2.0, 0.6, 256)));
+        }
+        return parts;
+    }
+
+    // A count x count grid of disjoint cylinders through a plate centred on the origin. They are
+    // gathered into one polygon soup rather than unioned, so building the tool costs nothing.
+    static CSG holeGrid(int count, double pitch, double radius, int slices) {
+        List<Polygon> polygons = new ArrayList<>();
+        double start = -pitch * (count - 1) / 2.0;
+        for (int i = 0; i < count; i++) {
+            for (int j = 0; j < count; j++) {
+                CSG hole = new Cylinder(radius, 4, slices).toCSG()
+                        .transformed(Transform.unity().translate(start + i * pitch, start + j * pitch, -2));
+                polygons.addAll(hole.getPolygons());
+            }
+        }
+        return CSG.fromPolygons(polygons);
+    }
+
+    // Entry point from Main; args[0] is "bench-booleans". Returns the process exit code.
+    public static int run(String[] args) {
+        int repeat = 3;
+        boolean large = true;
+        try {
+            for (int i = 1; i < args.length; i++) {
+                if (args[i].equalsIgnoreCase("--repeat") && i + 1 < args.length) {
+                    repeat = Integer.parseInt(args[++i]);
+                } else if (args[i].equalsIgnoreCase("--small")) {
+                    large = false;
+                } else {
+                    throw new IllegalArgumentException("Unexpected argument: " + args[i]);
+                }
+            }
+            if (repeat < 1) {
+                throw new IllegalArgumentException("--repeat needs at least 1");
+            }
+        } catch (IllegalArgumentException e) {
+            System.err.println(e.getMessage());
+            System.err.println("Usage: bench-booleans [--repeat <n>] [--small]");
+            return BatchRunner.EXIT_USAGE;
+        }
+
+        System.out.println("part,operation,engine,best_ms,triangles,volume,open_edges,status");
+        int failed = 0;
+        for (Part part : parts(large)) {
+            for (MeshBoolean.Operation op : MeshBoolean.Operation.values()) {
+                Timing jcsg = time(repeat, () -> IndexedMesh.fromCSG(jcsg(part.first, part.second, op)));
+                Timing mesh = time(repeat, () -> IndexedMesh.fromCSG(MeshBoolean.apply(part.first, part.second, op)));
+                print(part, op, "jcsg", jcsg);
+                print(part, op, "mesh", mesh);
+                if (mesh.error != null) {
+                    failed++;
+                } else if (jcsg.error == null) {
+                    System.err.printf(Locale.ROOT, "%s %s: jcsg %.1f ms, mesh %.1f ms (%.1fx)%n", part.name,
+                            op.name().toLowerCase(), jcsg.bestMillis, mesh.bestMillis,
+                            jcsg.bestMillis / mesh.bestMillis);
+                }
+            }
+        }
+        return failed == 0 ? BatchRunner.EXIT_OK : BatchRunner.EXIT_COMMAND_FAILED;
+    }
+
+    static CSG jcsg(CSG first, CSG second, MeshBoolean.Operation op) {
+        switch (op) {
+            case UNION:
+                return first.union(second);
+            case DIFFERENCE:
+                return first.difference(second);
+            default:
+                return first.intersect(second);
+        }
+    }
+
+    private static Timing time(int repeat, Supplier<IndexedMesh> operation) {
+        Timing timing = new Timing();
+        try {
+            operation.get();
+            for (int i = 0; i < repeat; i++) {
+                long start = System.nanoTime();
+                timing.result = operation.get();
+                timing.bestMillis = Math.min(timing.bestMillis, (System.nanoTime() - start) / 1e6);
+            }
+        } catch (RuntimeException e) {
+            timing.error = e.getMessage();
+        }
+        return timing;
+    }
+
+    private static void print(Part part, MeshBoolean.Operation op, String engine, Timing timing) {
+        if (timing.error != null) {
+            System.out.printf(Locale.ROOT, "%s,%s,%s,,,,,\"failed: %s\"%n", part.name, op.name().toLowerCase(),
+                    engine, timing.error);
+            return;
+        }
+        System.out.printf(Locale.ROOT, "%s,%s,%s,%.2f,%d,%.6f,%d,ok%n", part.name, op.name().toLowerCase(),
+                engine, timing.bestMillis, timing.result.getTriangleCount(), timing.result.volume(),
+                timing.result.countOpenEdges());
+    }
+}
@@ -2,24 +2,168 @@ package cad.cli;
 
 import cad.core.Sketch;
 import cad.core.CommandManager;
+import cad.core.ModelContext;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.Scanner;
 
+// One CLI session: a sketch, undo history and command set bound to a model context. The interactive
+// shell uses the default context; other sessions can run on their own contexts from separate threads.
 public class Cli {
 
-    private static final Sketch sketch = new Sketch();
-    private static final CommandManager commandManager = new CommandManager();
+    private final ModelContext context;
+    private final Sketch sketch = new Sketch();
+    private final CommandManager commandManager = new CommandManager();
+    private final CommandRegistry registry;
+
+    public Cli() {
+        this(ModelContext.getDefault());
+    }
+
+    public Cli(ModelContext context) {
+        this.context = context;
+        context.setSketch(sketch);
+        this.registry = new CommandRegistry(r -> StandardHandlers.registerAll(r, commandManager, sketch));
+    }
 
     public static void launch() {
         System.out.println("Welcome to CAD CLI v3.0.0 (AI Ready)");
         System.out.println("Running Cli mode...");
 
-        // Register all standard commands
-        StandardHandlers.registerAll(commandManager, sketch);
+        new Cli().runCli();
+    }
+
+    public ModelContext getContext() {
+        return context;
+    }
+
+    public Sketch getSketch() {
+        return sketch;
+    }
+
+    public CommandManager getCommandManager() {
+        return commandManager;
+    }
+
+    public CommandRegistry getRegistry() {
+        return registry;
+    }
+
+    // Runs one command line against this session's context and reports the outcome without
+    // printing anything itself; the command's own output still goes to System.out. "exit" is
+    // reported as EXIT rather than run, so callers decide what ending the session means.
+    public CommandResult run(String input) {
+        String line = input.trim();
+        if (line.isEmpty()) {
+            return new CommandResult(line, CommandResult.Status.OK, null, null, 0);
+        }
+
+        String[] argsArray = tokenize(line);
+        String commandName = argsArray[0].toLowerCase();
+
+        CliHandler handler = registry.getHandler(commandName);
+        if (handler == null) {
+            return new CommandResult(line, CommandResult.Status.UNKNOWN_COMMAND,
+                    "Unknown command: " + commandName, null, 0);
+        }
+        if (handler == registry.getHandler("exit")) {
+            return new CommandResult(line, CommandResult.Status.EXIT, null, null, 0);
+        }
+
+        long start = System.nanoTime();
+        return context.call(() -> {
+            try {
+                cad.core.Command cmd = handler.createCommand(argsArray);
+                if (cmd != null) {
+                    commandManager.executeCommand(cmd);
+                }
+                CommandResult result = new CommandResult(line, CommandResult.Status.OK, null, null,
+                        System.nanoTime() - start);
+                if (cmd instanceof ReportingCommand reporting) {
+                    result.setValues(reporting.getValues());
+                }
+                return result;
+            } catch (IllegalArgumentException e) {
+                return new CommandResult(line, CommandResult.Status.INVALID_ARGUMENTS, e.getMessage(), e,
+                        System.nanoTime() - start);
+            } catch (Exception e) {
+                return new CommandResult(line, CommandResult.Status.FAILED, e.getMessage(), e,
+                        System.nanoTime() - start);
+            }
+        });
+    }
+
+    // Splits a command line into words on whitespace. Double quotes keep spaces inside a word and may
+    // adjoin unquoted text, so "my parts"/a.stl is one word; within quotes \" and \\ are escapes and
+    // any other backslash is literal, which keeps Windows paths intact. An unclosed quote runs to the end.
+    static String[] tokenize(String line) {
+        List<String> words = new ArrayList<>();
+        StringBuilder word = new StringBuilder();
+        boolean inWord = false;
+        boolean quoted = false;
+        for (int i = 0; i < line.length(); i++) {
+            char c = line.charAt(i);
+            if (quoted) {
+                if (c == '"') {
+                    quoted = false;
+                } else if (c == '\\' && i + 1 < line.length()
+                        && (line.charAt(i + 1) == '"' || line.charAt(i + 1) == '\\')) {
+                    word.append(line.charAt(++i));
+                } else {
+                    word.append(c);
+                }
+            } else if (c == '"') {
+                quoted = true;
+                inWord = true;
+            } else if (Character.isWhitespace(c)) {
+                if (inWord) {
+                    words.add(word.toString());
+                    word.setLength(0);
+                    inWord = false;
+                }
+            } else {
+                word.append(c);
+                inWord = true;
+            }
+        }
+        if (inWord) {
+            words.add(word.toString());
+        }
+        return words.toArray(new String[0]);
+    }
+
+    // Quotes a value so that tokenize() returns it as a single word whatever characters it holds
+    static String quote(String value) {
+        return "\"" + value.replace("\\", "\\\\").replace("\"", "\\\"") + "\"";
+    }
 
-        runCli();
+    // Interactive form of run: reports errors on the console. Returns false for an unknown command.
+    public boolean execute(String input) {
+        CommandResult result = run(input);
+        switch (result.getStatus()) {
+            case UNKNOWN_COMMAND:
+                System.out.println(result.getMessage());
+                System.out.println("Type 'help' for available commands.");
+                return false;
+            case INVALID_ARGUMENTS:
+                System.out.println("Error: " + result.getMessage());
+                break;
+            case FAILED:
+                System.out.println("Execution Error: " + result.getMessage());
+                if (!(result.getError() instanceof java.io.UncheckedIOException)) {
+                    result.getError().printStackTrace();
+                }
+                break;
+            case EXIT:
+                System.exit(0);
+                break;
+            default:
+                break;
+        }
+        return true;
     }
 
-    public static void runCli() {
+    public void runCli() {
         try (Scanner scanner = new Scanner(System.in)) {
             while (true) {
                 try {
@@ -29,31 +173,7 @@ public class Cli {
                         System.exit(0);
                     }
 
-                    String input = scanner.nextLine().trim();
-                    if (input.isEmpty())
-                        continue;
-
-                    String[] argsArray = input.split("\\s+");
-                    String commandName = argsArray[0].toLowerCase();
-
-                    CliHandler handler = CommandRegistry.getHandler(commandName);
-
-                    if (handler != null) {
-                        try {
-                            cad.core.Command cmd = handler.createCommand(argsArray);
-                            if (cmd != null) {
-                                commandManager.executeCommand(cmd);
-                            }
-                        } catch (IllegalArgumentException e) {
-                            System.out.println("Error: " + e.getMessage());
-                        } catch (Exception e) {
-                            System.out.println("Execution Error: " + e.getMessage());
-                            e.printStackTrace();
-                        }
-                    } else {
-                        System.out.println("Unknown command: " + commandName);
-                        System.out.println("Type 'help' for available commands.");
-                    }
+                    execute(scanner.nextLine());
                 } catch (Exception e) {
                     System.err.println("Error processing input: " + e.getMessage());
                 }
@@ -4,20 +4,46 @@ import cad.core.Command;
 import java.util.HashMap;
 import java.util.Map;
 import java.util.TreeMap;
+import java.util.function.Consumer;
 
+// Handlers for one CLI session; each session binds them to its own sketch and command manager.
+// A registry built with an initializer registers nothing until the first lookup, so sessions that
+// are created but never used do not load the handler classes.
 public class CommandRegistry {
-    private static final Map<String, CliHandler> handlers = new HashMap<>();
-    private static final Map<String, String> aliases = new HashMap<>();
+    private final Map<String, CliHandler> handlers = new HashMap<>();
+    private final Map<String, String> aliases = new HashMap<>();
+    private volatile Consumer<CommandRegistry> initializer;
 
-    public static void register(String name, CliHandler handler) {
+    public CommandRegistry() {
+    }
+
+    public CommandRegistry(Consumer<CommandRegistry> initializer) {
+        this.initializer = initializer;
+    }
+
+    private void ensureInitialized() {
+        if (initializer == null) {
+            return;
+        }
+        synchronized (this) {
+            Consumer<CommandRegistry> pending = initializer;
+            if (pending != null) {
+                initializer = null;
+                pending.accept(this);
+            }
+        }
+    }
+
+    public void register(String name, CliHandler handler) {
         handlers.put(name.toLowerCase(), handler);
     }
 
-    public static void registerAlias(String alias, String target) {
+    public void registerAlias(String alias, String target) {
         aliases.put(alias.toLowerCase(), target.toLowerCase());
     }
 
-    public static CliHandler getHandler(String name) {
+    public CliHandler getHandler(String name) {
+        ensureInitialized();
         String lowerName = name.toLowerCase();
         if (handlers.containsKey(lowerName)) {
             return handlers.get(lowerName);
@@ -28,7 +54,8 @@ public class CommandRegistry {
         return null;
     }
 
-    public static Map<String, String> getHelpMap() {
+    public Map<String, String> getHelpMap() {
+        ensureInitialized();
         Map<String, String> help = new TreeMap<>();
         for (Map.Entry<String, CliHandler> entry : handlers.entrySet()) {
             help.put(entry.getKey(), entry.getValue().getUsage());
@@ -0,0 +1,77 @@
+package cad.cli;
+
+import java.util.Map;
+
+// Outcome of one CLI command line, as reported by Cli.run for scripted and remote callers
+public class CommandResult {
+
+    public enum Status {
+        OK, UNKNOWN_COMMAND, INVALID_ARGUMENTS, FAILED, EXIT;
+
+        public boolean isError() {
+            return this == UNKNOWN_COMMAND || this == INVALID_ARGUMENTS || this == FAILED;
+        }
+    }
+
+    private final String line;
+    private final Status status;
+    private final String message;
+    private final Throwable error;
+    private final long elapsedNanos;
+    private String output;
+    private Map<String, Double> values = Map.of();
+
+    public CommandResult(String line, Status status, String message, Throwable error, long elapsedNanos) {
+        this.line = line;
+        this.status = status;
+        this.message = message;
+        this.error = error;
+        this.elapsedNanos = elapsedNanos;
+    }
+
+    public String getLine() {
+        return line;
+    }
+
+    public Status getStatus() {
+        return status;
+    }
+
+    public boolean isOk() {
+        return !status.isError();
+    }
+
+    public String getMessage() {
+        return message;
+    }
+
+    public Throwable getError() {
+        return error;
+    }
+
+    public long getElapsedNanos() {
+        return elapsedNanos;
+    }
+
+    // What the command printed, when the caller captured it
+    public String getOutput() {
+        return output;
+    }
+
+    void setOutput(String output) {
+        this.output = output;
+    }
+
+    // Named measurements from a ReportingCommand, such as "volume"; null when not reported
+    public Double getValue(String name) {
+        return values.get(name);
+    }
+
+    public Map<String, Double> getValues() {
+        return values;
+    }
+
+    void setValues(Map<String, Double> values) {
+        this.values = Map.copyOf(values);
+    }
+}
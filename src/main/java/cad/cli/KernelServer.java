@@ -0,0 +1,406 @@
+package cad.cli;
+
+import cad.core.Geometry;
+import cad.core.ModelContext;
+import com.google.gson.Gson;
+import com.google.gson.JsonArray;
+import com.google.gson.JsonElement;
+import com.google.gson.JsonNull;
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParseException;
+import com.google.gson.JsonParser;
+import com.google.gson.JsonPrimitive;
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.io.OutputStream;
+import java.io.PrintStream;
+import java.io.Writer;
+import java.io.OutputStreamWriter;
+import java.net.StandardProtocolFamily;
+import java.net.UnixDomainSocketAddress;
+import java.nio.channels.Channels;
+import java.nio.channels.ServerSocketChannel;
+import java.nio.channels.SocketChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+
+// Long-lived kernel process speaking JSON-RPC 2.0, one message per line, over stdio or a Unix domain
+// socket. Documents stay resident between calls. Requests on one document run in the order they
+// arrived; requests on different documents run concurrently on the worker pool, so responses can
+// come back out of order and are matched by id. Requests without an id are notifications: they run
+// but get no response.
+//
+// Methods: open {document?}, close {document}, documents, commands, execute {document, command |
+// commands}, massProperties {document}, shutdown, and every CLI command by name with
+// {document, args: [...]}, e.g. {"method": "extrude", "params": {"document": "a", "args": [5]}}.
+public class KernelServer {
+    public static final int PARSE_ERROR = -32700;
+    public static final int INVALID_REQUEST = -32600;
+    public static final int METHOD_NOT_FOUND = -32601;
+    public static final int INVALID_PARAMS = -32602;
+    public static final int INTERNAL_ERROR = -32603;
+    public static final int COMMAND_FAILED = -32000;
+
+    private final Gson gson = new Gson();
+    private final ExecutorService workers;
+    private final Map<String, Document> documents = new ConcurrentHashMap<>();
+    private final AtomicInteger nextDocument = new AtomicInteger();
+    private final CountDownLatch stopped = new CountDownLatch(1);
+    private final CommandRegistry commandNames;
+
+    // A resident model: its CLI session and the tail of its request queue
+    private static final class Document {
+        final String id;
+        final BatchRunner runner;
+        CompletableFuture<Void> tail = CompletableFuture.completedFuture(null);
+
+        Document(String id) {
+            this.id = id;
+            this.runner = new BatchRunner(new Cli(new ModelContext(id))).captureOutput(true);
+        }
+    }
+
+    private static final class RpcException extends Exception {
+        final int code;
+        final JsonElement data;
+
+        RpcException(int code, String message) {
+            this(code, message, null);
+        }
+
+        RpcException(int code, String message, JsonElement data) {
+            super(message);
+            this.code = code;
+            this.data = data;
+        }
+    }
+
+    // Writes whole response lines; a connection's reader and the workers share it
+    private interface Responder {
+        void send(String line);
+    }
+
+    public KernelServer(int workerThreads) {
+        AtomicInteger n = new AtomicInteger();
+        this.workers = Executors.newFixedThreadPool(workerThreads, r -> {
+            Thread t = new Thread(r, "kernel-worker-" + n.incrementAndGet());
+            t.setDaemon(true);
+            return t;
+        });
+        // Only used to resolve method names; never executes anything
+        this.commandNames = new Cli(new ModelContext("commands")).getRegistry();
+        OutputCapture.install();
+    }
+
+    public static boolean isServeMode(String arg) {
+        return arg.equalsIgnoreCase("--serve");
+    }
+
+    // Entry point from Main: --serve [--socket path] [--workers n]
+    public static int run(String[] args) {
+        String socket = null;
+        int workers = Runtime.getRuntime().availableProcessors();
+        for (int i = 1; i < args.length; i++) {
+            if (args[i].equalsIgnoreCase("--socket") && i + 1 < args.length) {
+                socket = args[++i];
+            } else if (args[i].equalsIgnoreCase("--workers") && i + 1 < args.length) {
+                workers = Integer.parseInt(args[++i]);
+            } else {
+                System.err.println("Usage: java -jar SketchApp.jar --serve [--socket path] [--workers n]");
+                return BatchRunner.EXIT_USAGE;
+            }
+        }
+
+        // Responses own stdout in stdio mode; stray prints from the kernel go to stderr
+        PrintStream rpcOut = System.out;
+        System.setOut(System.err);
+        KernelServer server = new KernelServer(Math.max(1, workers));
+        try {
+            if (socket != null) {
+                server.serveSocket(Paths.get(socket));
+            } else {
+                server.serve(System.in, rpcOut);
+            }
+            return BatchRunner.EXIT_OK;
+        } catch (IOException e) {
+            System.err.println("Kernel server failed: " + e.getMessage());
+            return BatchRunner.EXIT_IO_ERROR;
+        }
+    }
+
+    // Serves one stream until it ends or shutdown is called
+    public void serve(InputStream in, OutputStream out) throws IOException {
+        Writer writer = new OutputStreamWriter(out, StandardCharsets.UTF_8);
+        Responder responder = line -> {
+            synchronized (writer) {
+                try {
+                    writer.write(line);
+                    writer.write('\n');
+                    writer.flush();
+                } catch (IOException e) {
+                    System.err.println("Cannot send response: " + e.getMessage());
+                }
+            }
+        };
+        BufferedReader reader = new BufferedReader(new InputStreamReader(in, StandardCharsets.UTF_8));
+        String line;
+        while (stopped.getCount() > 0 && (line = reader.readLine()) != null) {
+            if (!line.isBlank()) {
+                handle(line, responder);
+            }
+        }
+        awaitQueued();
+    }
+
+    // Accepts connections on a Unix domain socket; all connections see the same documents
+    public void serveSocket(Path path) throws IOException {
+        Files.deleteIfExists(path);
+        try (ServerSocketChannel server = ServerSocketChannel.open(StandardProtocolFamily.UNIX)) {
+            server.bind(UnixDomainSocketAddress.of(path));
+            System.err.println("Kernel server listening on " + path);
+            Thread acceptor = new Thread(() -> {
+                while (stopped.getCount() > 0) {
+                    try {
+                        SocketChannel client = server.accept();
+                        Thread connection = new Thread(() -> {
+                            try (client) {
+                                serve(Channels.newInputStream(client), Channels.newOutputStream(client));
+                            } catch (IOException e) {
+                                System.err.println("Connection closed: " + e.getMessage());
+                            }
+                        }, "kernel-connection");
+                        connection.setDaemon(true);
+                        connection.start();
+                    } catch (IOException e) {
+                        if (stopped.getCount() > 0) {
+                            System.err.println("Accept failed: " + e.getMessage());
+                        }
+                        return;
+                    }
+                }
+            }, "kernel-acceptor");
+            acceptor.setDaemon(true);
+            acceptor.start();
+            stopped.await();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        } finally {
+            Files.deleteIfExists(path);
+            workers.shutdown();
+        }
+    }
+
+    public void stop() {
+        stopped.countDown();
+    }
+
+    // Lets requests already queued on any document finish and send their responses
+    private void awaitQueued() {
+        for (Document doc : documents.values()) {
+            CompletableFuture<Void> tail;
+            synchronized (doc) {
+                tail = doc.tail;
+            }
+            tail.join();
+        }
+    }
+
+    private void handle(String line, Responder responder) {
+        JsonElement id = JsonNull.INSTANCE;
+        try {
+            JsonElement parsed;
+            try {
+                parsed = JsonParser.parseString(line);
+            } catch (JsonParseException e) {
+                throw new RpcException(PARSE_ERROR, "Parse error: " + e.getMessage());
+            }
+            if (!parsed.isJsonObject()) {
+                throw new RpcException(INVALID_REQUEST, "Request must be an object");
+            }
+            JsonObject request = parsed.getAsJsonObject();
+            if (request.has("id")) {
+                id = request.get("id");
+            } else {
+                // A notification: run it, but JSON-RPC 2.0 forbids answering it
+                responder = ignored -> {
+                };
+            }
+            if (!request.has("method") || !request.get("method").isJsonPrimitive()) {
+                throw new RpcException(INVALID_REQUEST, "Missing method");
+            }
+            String method = request.get("method").getAsString();
+            JsonObject params = request.has("params") && request.get("params").isJsonObject()
+                    ? request.getAsJsonObject("params")
+                    : new JsonObject();
+            dispatch(method, params, id, responder);
+        } catch (RpcException e) {
+            responder.send(error(id, e));
+        } catch (RuntimeException e) {
+            // Parameters are decoded through the typed helpers, so anything else failed while running
+            responder.send(error(id, new RpcException(INTERNAL_ERROR, String.valueOf(e))));
+        }
+    }
+
+    private void dispatch(String method, JsonObject params, JsonElement id, Responder responder) throws RpcException {
+        switch (method) {
+            case "open": {
+                String name = params.has("document") ? string(params.get("document"), "document")
+                        : "doc" + nextDocument.incrementAndGet();
+                if (documents.putIfAbsent(name, new Document(name)) != null) {
+                    throw new RpcException(INVALID_PARAMS, "Document already open: " + name);
+                }
+                responder.send(result(id, new JsonPrimitive(name)));
+                return;
+            }
+            case "close": {
+                Document doc = documents.remove(document(params).id);
+                // Let queued requests on the document finish before answering
+                synchronized (doc) {
+                    doc.tail = doc.tail.whenComplete((r, t) -> responder.send(result(id, new JsonPrimitive(true))));
+                }
+                return;
+            }
+            case "documents": {
+                JsonArray names = new JsonArray();
+                documents.keySet().stream().sorted().forEach(names::add);
+                responder.send(result(id, names));
+                return;
+            }
+            case "commands": {
+                responder.send(result(id, gson.toJsonTree(commandNames.getHelpMap())));
+                return;
+            }
+            case "shutdown": {
+                responder.send(result(id, new JsonPrimitive(true)));
+                stop();
+                return;
+            }
+            default:
+                break;
+        }
+
+        Document doc = document(params);
+        RpcTask task;
+        if (method.equals("execute")) {
+            List<String> lines = commandLines(params);
+            task = () -> doc.runner.execute(doc.id, lines).toJson();
+        } else if (method.equals("massProperties")) {
+            task = () -> doc.runner.getCli().getContext().call(() -> {
+                JsonObject props = new JsonObject();
+                props.addProperty("volume", Geometry.calculateVolume());
+                props.addProperty("surfaceArea", Geometry.calculateSurfaceArea());
+                props.add("centroid", gson.toJsonTree(Geometry.calculateCentroid()));
+                return props;
+            });
+        } else if (commandNames.getHandler(method) != null) {
+            StringBuilder line = new StringBuilder(method);
+            if (params.has("args") && params.get("args").isJsonArray()) {
+                for (JsonElement arg : params.getAsJsonArray("args")) {
+                    line.append(' ').append(string(arg, "args"));
+                }
+            }
+            task = () -> {
+                BatchRunner.Report report = doc.runner.execute(doc.id, List.of(line.toString()));
+                JsonObject command = report.toJson().getAsJsonArray("commands").get(0).getAsJsonObject();
+                if (!report.isOk()) {
+                    throw new RpcException(COMMAND_FAILED, report.getResults().get(0).getMessage(), command);
+                }
+                return command;
+            };
+        } else {
+            throw new RpcException(METHOD_NOT_FOUND, "Unknown method: " + method);
+        }
+        enqueue(doc, id, task, responder);
+    }
+
+    @FunctionalInterface
+    private interface RpcTask {
+        JsonElement run() throws Exception;
+    }
+
+    // Chains the task behind earlier requests on the same document
+    private void enqueue(Document doc, JsonElement id, RpcTask task, Responder responder) {
+        synchronized (doc) {
+            doc.tail = doc.tail.thenRunAsync(() -> {
+                try {
+                    responder.send(result(id, task.run()));
+                } catch (RpcException e) {
+                    responder.send(error(id, e));
+                } catch (Exception e) {
+                    responder.send(error(id, new RpcException(INTERNAL_ERROR, String.valueOf(e))));
+                }
+            }, workers);
+        }
+    }
+
+    private Document document(JsonObject params) throws RpcException {
+        if (!params.has("document")) {
+            throw new RpcException(INVALID_PARAMS, "Missing document");
+        }
+        String name = string(params.get("document"), "document");
+        Document doc = documents.get(name);
+        if (doc == null) {
+            throw new RpcException(INVALID_PARAMS, "No such document: " + name);
+        }
+        return doc;
+    }
+
+    private static List<String> commandLines(JsonObject params) throws RpcException {
+        List<String> lines = new ArrayList<>();
+        if (params.has("command")) {
+            lines.addAll(BatchRunner.splitCommands(string(params.get("command"), "command")));
+        }
+        if (params.has("commands") && params.get("commands").isJsonArray()) {
+            for (JsonElement e : params.getAsJsonArray("commands")) {
+                lines.add(string(e, "commands"));
+            }
+        }
+        if (lines.isEmpty()) {
+            throw new RpcException(INVALID_PARAMS, "Missing command or commands");
+        }
+        return lines;
+    }
+
+    // Strings and numbers pass as text; objects, arrays and null are rejected as INVALID_PARAMS
+    private static String string(JsonElement value, String name) throws RpcException {
+        if (value == null || !value.isJsonPrimitive()) {
+            throw new RpcException(INVALID_PARAMS, name + " must be a string or a number");
+        }
+        return value.getAsString();
+    }
+
+    private String result(JsonElement id, JsonElement value) {
+        JsonObject response = new JsonObject();
+        response.addProperty("jsonrpc", "2.0");
+        response.add("id", id);
+        response.add("result", value);
+        return gson.toJson(response);
+    }
+
+    private String error(JsonElement id, RpcException e) {
+        JsonObject error = new JsonObject();
+        error.addProperty("code", e.code);
+        error.addProperty("message", e.getMessage());
+        if (e.data != null) {
+            error.add("data", e.data);
+        }
+        JsonObject response = new JsonObject();
+        response.addProperty("jsonrpc", "2.0");
+        response.add("id", id);
+        response.add("error", error);
+        return gson.toJson(response);
+    }
+}
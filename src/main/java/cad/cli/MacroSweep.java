@@ -0,0 +1,625 @@
+package cad.cli;
+
+import cad.core.Geometry;
+import cad.core.MacroProgram;
+import cad.core.MacroRecorder;
+import cad.core.ModelContext;
+import cad.core.Sketch;
+import java.io.IOException;
+import java.io.PrintStream;
+import java.io.PrintWriter;
+import java.io.Writer;
+import java.math.BigDecimal;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.StandardCopyOption;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.EnumSet;
+import java.util.HashMap;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Set;
+import java.util.TreeMap;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionService;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorCompletionService;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+// The "sweep" subcommand: runs one macro as a parametric template over a grid (or, with --zip, a
+// list) of parameter values. Macro values may contain ${name} placeholders:
+//
+//   SKETCH_NACA profile=${naca} chord=${chord}
+//   EXTRUDE depth=${height}
+//
+//   sweep wing.macro --param naca=0012,2412,4412 --param chord=50:100:25 --param height=10,20
+//         --jobs 8 --out variants --csv sweep.csv
+//
+// Every variant runs on its own ModelContext and Sketch on a fixed worker pool. The template is
+// parsed once; variants only substitute values. Variants that expand to the same script are
+// modelled once, and NACA profiles are generated once per profile and chord for the whole sweep.
+// Variants that open with the same sketch steps draw that sketch once and each start from a copy.
+public class MacroSweep {
+    private static final Pattern PLACEHOLDER = Pattern.compile("\\$\\{([A-Za-z_][A-Za-z0-9_]*)\\}");
+    // Steps that only edit the sketch; a copy of the sketch carries everything they did
+    private static final Set<MacroRecorder.ActionType> SKETCH_STEPS = EnumSet.of(
+            MacroRecorder.ActionType.SKETCH_POINT, MacroRecorder.ActionType.SKETCH_LINE,
+            MacroRecorder.ActionType.SKETCH_CIRCLE, MacroRecorder.ActionType.SKETCH_POLYGON,
+            MacroRecorder.ActionType.SKETCH_NACA, MacroRecorder.ActionType.CLEAR_SKETCH,
+            MacroRecorder.ActionType.SET_UNITS);
+
+    private final List<MacroRecorder.MacroCommand> template;
+    private final Map<String, List<String>> parameters;
+    private final boolean zip;
+    private final Path outDir;
+    private final int jobs;
+    private final Map<String, float[]> profileCache = new ConcurrentHashMap<>();
+    private final Map<String, CompletableFuture<VariantResult>> modelled = new ConcurrentHashMap<>();
+    private final Map<String, CompletableFuture<SketchPrefix>> prefixes = new ConcurrentHashMap<>();
+
+    public MacroSweep(List<MacroRecorder.MacroCommand> template, Map<String, List<String>> parameters, boolean zip,
+            Path outDir, int jobs) {
+        if (jobs < 1) {
+            throw new IllegalArgumentException("Need at least one worker");
+        }
+        for (String name : placeholders(template)) {
+            if (!parameters.containsKey(name)) {
+                throw new IllegalArgumentException("No values for placeholder ${" + name + "}");
+            }
+        }
+        if (zip) {
+            int size = -1;
+            for (Map.Entry<String, List<String>> entry : parameters.entrySet()) {
+                if (size >= 0 && entry.getValue().size() != size) {
+                    throw new IllegalArgumentException("--zip needs the same number of values for every parameter");
+                }
+                size = entry.getValue().size();
+            }
+        }
+        this.template = template;
+        this.parameters = new LinkedHashMap<>(parameters);
+        this.zip = zip;
+        this.outDir = outDir;
+        this.jobs = jobs;
+    }
+
+    // One variant's parameter values and what its model measured
+    public static class VariantResult {
+        private final int index;
+        private final Map<String, String> values;
+        private final double volume;
+        private final double surfaceArea;
+        private final int triangles;
+        private final Path export;
+        private final List<String> errors;
+        private final long elapsedNanos;
+        private final boolean reused;
+
+        VariantResult(int index, Map<String, String> values, double volume, double surfaceArea, int triangles,
+                Path export, List<String> errors, long elapsedNanos, boolean reused) {
+            this.index = index;
+            this.values = values;
+            this.volume = volume;
+            this.surfaceArea = surfaceArea;
+            this.triangles = triangles;
+            this.export = export;
+            this.errors = errors;
+            this.elapsedNanos = elapsedNanos;
+            this.reused = reused;
+        }
+
+        VariantResult copyFor(int index, Map<String, String> values, Path export, List<String> errors) {
+            return new VariantResult(index, values, volume, surfaceArea, triangles, export, errors, 0, true);
+        }
+
+        public int getIndex() {
+            return index;
+        }
+
+        public Map<String, String> getValues() {
+            return values;
+        }
+
+        public double getVolume() {
+            return volume;
+        }
+
+        public double getSurfaceArea() {
+            return surfaceArea;
+        }
+
+        public int getTriangleCount() {
+            return triangles;
+        }
+
+        public Path getExport() {
+            return export;
+        }
+
+        public List<String> getErrors() {
+            return errors;
+        }
+
+        public boolean isOk() {
+            return errors.isEmpty();
+        }
+
+        public long getElapsedNanos() {
+            return elapsedNanos;
+        }
+
+        // True when an identical variant was modelled and this one copied its results
+        public boolean isReused() {
+            return reused;
+        }
+    }
+
+    // A sketch drawn by the opening steps several variants share, and what went wrong drawing it
+    private static final class SketchPrefix {
+        final Sketch sketch;
+        final List<String> errors;
+
+        SketchPrefix(Sketch sketch, List<String> errors) {
+            this.sketch = sketch;
+            this.errors = errors;
+        }
+    }
+
+    public interface ProgressListener {
+        void onVariantDone(int done, int total, VariantResult result);
+    }
+
+    public static boolean isSweepCommand(String arg) {
+        return arg.equalsIgnoreCase("sweep");
+    }
+
+    // Entry point from Main; args[0] is "sweep". Returns the process exit code.
+    public static int run(String[] args) {
+        String macro = null;
+        Map<String, List<String>> parameters = new LinkedHashMap<>();
+        boolean zip = false;
+        String outDir = null;
+        String csv = null;
+        int jobs = Runtime.getRuntime().availableProcessors();
+        try {
+            for (int i = 1; i < args.length; i++) {
+                String arg = args[i];
+                switch (arg.toLowerCase()) {
+                    case "--param": {
+                        String spec = requireValue(args, ++i, arg);
+                        int eq = spec.indexOf('=');
+                        if (eq <= 0) {
+                            throw new IllegalArgumentException("Expected --param name=values, got " + spec);
+                        }
+                        parameters.put(spec.substring(0, eq), parseValues(spec.substring(eq + 1)));
+                        break;
+                    }
+                    case "--zip":
+                        zip = true;
+                        break;
+                    case "--out":
+                        outDir = requireValue(args, ++i, arg);
+                        break;
+                    case "--csv":
+                        csv = requireValue(args, ++i, arg);
+                        break;
+                    case "--jobs":
+                        jobs = Integer.parseInt(requireValue(args, ++i, arg));
+                        break;
+                    default:
+                        if (arg.startsWith("--") || macro != null) {
+                            throw new IllegalArgumentException("Unexpected argument: " + arg);
+                        }
+                        macro = arg;
+                }
+            }
+            if (macro == null || parameters.isEmpty()) {
+                throw new IllegalArgumentException("Need a macro file and at least one --param");
+            }
+        } catch (IllegalArgumentException e) {
+            return usage(e.getMessage());
+        }
+
+        MacroSweep sweep;
+        try {
+            List<MacroRecorder.MacroCommand> template = parseTemplate(
+                    Files.readAllLines(Paths.get(macro), StandardCharsets.UTF_8));
+            if (outDir != null) {
+                Files.createDirectories(Paths.get(outDir));
+            }
+            sweep = new MacroSweep(template, parameters, zip, outDir != null ? Paths.get(outDir) : null, jobs);
+        } catch (IOException e) {
+            System.err.println("Cannot prepare sweep: " + e.getMessage());
+            return BatchRunner.EXIT_IO_ERROR;
+        } catch (IllegalArgumentException e) {
+            System.err.println(e.getMessage());
+            return BatchRunner.EXIT_SCRIPT_ERROR;
+        }
+
+        // Kernel chatter is captured per variant, so stdout carries only the CSV
+        OutputCapture.install();
+        PrintStream err = System.err;
+        long start = System.nanoTime();
+        List<VariantResult> results;
+        try {
+            results = sweep.run((done, total, result) -> err.printf("[%d/%d] %s %s (%.0f ms)%s%n", done, total,
+                    result.isOk() ? "ok    " : "FAILED", result.getValues(), result.getElapsedNanos() / 1e6,
+                    result.isOk() ? "" : ": " + String.join("; ", result.getErrors())));
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return BatchRunner.EXIT_COMMAND_FAILED;
+        }
+        long failed = results.stream().filter(r -> !r.isOk()).count();
+        err.printf("Ran %d variants in %.1f s: %d ok, %d failed%n", results.size(),
+                (System.nanoTime() - start) / 1e9, results.size() - failed, failed);
+
+        try {
+            if (csv != null) {
+                try (Writer writer = Files.newBufferedWriter(Paths.get(csv), StandardCharsets.UTF_8)) {
+                    sweep.writeCsv(writer, results);
+                }
+            } else {
+                PrintWriter out = new PrintWriter(OutputCapture.originalOut());
+                sweep.writeCsv(out, results);
+                out.flush();
+            }
+        } catch (IOException e) {
+            System.err.println("Cannot write results: " + e.getMessage());
+            return BatchRunner.EXIT_IO_ERROR;
+        }
+        return failed == 0 ? BatchRunner.EXIT_OK : BatchRunner.EXIT_COMMAND_FAILED;
+    }
+
+    // Cartesian product in parameter order (last parameter varies fastest), or position-wise with --zip
+    public List<Map<String, String>> variants() {
+        List<Map<String, String>> variants = new ArrayList<>();
+        List<String> names = new ArrayList<>(parameters.keySet());
+        if (zip) {
+            int size = names.isEmpty() ? 0 : parameters.get(names.get(0)).size();
+            for (int i = 0; i < size; i++) {
+                Map<String, String> values = new LinkedHashMap<>();
+                for (String name : names) {
+                    values.put(name, parameters.get(name).get(i));
+                }
+                variants.add(values);
+            }
+            return variants;
+        }
+        variants.add(new LinkedHashMap<>());
+        for (String name : names) {
+            List<Map<String, String>> next = new ArrayList<>();
+            for (Map<String, String> partial : variants) {
+                for (String value : parameters.get(name)) {
+                    Map<String, String> values = new LinkedHashMap<>(partial);
+                    values.put(name, value);
+                    next.add(values);
+                }
+            }
+            variants = next;
+        }
+        return variants;
+    }
+
+    // Runs every variant and returns the results in variant order
+    public List<VariantResult> run(ProgressListener progress) throws InterruptedException {
+        List<Map<String, String>> variants = variants();
+        List<List<MacroRecorder.MacroCommand>> scripts = new ArrayList<>(variants.size());
+        for (Map<String, String> values : variants) {
+            scripts.add(instantiate(template, values));
+        }
+        int[] shared = sharedPrefixLengths(scripts);
+        ExecutorService pool = Executors.newFixedThreadPool(jobs, r -> {
+            Thread t = new Thread(r, "sweep-worker");
+            t.setDaemon(true);
+            return t;
+        });
+        try {
+            CompletionService<Integer> completion = new ExecutorCompletionService<>(pool);
+            VariantResult[] results = new VariantResult[variants.size()];
+            for (int i = 0; i < variants.size(); i++) {
+                int index = i;
+                completion.submit(() -> {
+                    results[index] = runVariant(index, variants.get(index), scripts.get(index), shared[index]);
+                    return index;
+                });
+            }
+            for (int done = 1; done <= variants.size(); done++) {
+                int index;
+                try {
+                    index = completion.take().get();
+                } catch (ExecutionException e) {
+                    throw new IllegalStateException(e.getCause());
+                }
+                if (progress != null) {
+                    progress.onVariantDone(done, variants.size(), results[index]);
+                }
+            }
+            return List.of(results);
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+
+    private VariantResult runVariant(int index, Map<String, String> values, List<MacroRecorder.MacroCommand> commands,
+            int shared) {
+        Path export = outDir != null ? outDir.resolve(String.format(Locale.ROOT, "variant-%04d.stl", index + 1)) : null;
+
+        // The first variant with a given script models it; identical ones wait and copy
+        CompletableFuture<VariantResult> mine = new CompletableFuture<>();
+        CompletableFuture<VariantResult> first = modelled.putIfAbsent(scriptKey(commands), mine);
+        if (first != null) {
+            VariantResult original = first.join();
+            List<String> errors = new ArrayList<>(original.getErrors());
+            if (export != null && original.getExport() != null) {
+                try {
+                    Files.copy(original.getExport(), export, StandardCopyOption.REPLACE_EXISTING);
+                } catch (IOException e) {
+                    errors.add("Export failed: " + e.getMessage());
+                }
+            }
+            return original.copyFor(index, values, export, errors);
+        }
+
+        VariantResult result;
+        try {
+            result = model(index, values, commands, shared, export);
+        } catch (RuntimeException | StackOverflowError e) {
+            result = new VariantResult(index, values, 0, 0, 0, null, List.of(e.toString()), 0, false);
+        }
+        mine.complete(result);
+        return result;
+    }
+
+    // The first shared steps come from a copy of the group's sketch; only the rest run here
+    private VariantResult model(int index, Map<String, String> values, List<MacroRecorder.MacroCommand> commands,
+            int shared, Path export) {
+        long start = System.nanoTime();
+        ModelContext context = new ModelContext("variant-" + (index + 1));
+
+        OutputCapture.begin();
+        try {
+            List<String> errors = new ArrayList<>();
+            Sketch sketch;
+            if (shared > 0) {
+                SketchPrefix prefix = sketchPrefix(commands.subList(0, shared));
+                sketch = new Sketch(prefix.sketch);
+                errors.addAll(prefix.errors);
+            } else {
+                sketch = new Sketch();
+            }
+            context.setSketch(sketch);
+            MacroProgram program = MacroProgram.compile(commands.subList(shared, commands.size()), profileCache,
+                    shared + 1);
+            errors.addAll(program.getCompileErrors());
+            errors.addAll(program.run(context, sketch, null, null).getErrors());
+            return context.call(() -> {
+                // The same mesh saveStl would write: extruded sketch faces first, then the solid
+                List<float[]> mesh = sketch.getExtrudedTriangles();
+                double volume;
+                double area;
+                int triangles;
+                if (!mesh.isEmpty()) {
+                    volume = Geometry.calculateVolume(mesh);
+                    area = Geometry.calculateSurfaceArea(mesh);
+                    triangles = mesh.size();
+                } else {
+                    volume = Geometry.calculateVolume();
+                    area = Geometry.calculateSurfaceArea();
+                    triangles = Geometry.getCurrentShape() == Geometry.Shape.NONE ? 0
+                            : Math.max(Geometry.getExtrudedTriangles().size(), Geometry.getLoadedStlTriangles().size());
+                }
+                Path written = null;
+                if (export != null) {
+                    if (triangles == 0) {
+                        errors.add("Nothing to export");
+                    } else {
+                        Geometry.saveStl(export.toString());
+                        written = export;
+                    }
+                }
+                return new VariantResult(index, values, volume, area, triangles, written, errors,
+                        System.nanoTime() - start, false);
+            });
+        } finally {
+            OutputCapture.end();
+        }
+    }
+
+    // The first variant to reach a shared prefix draws its sketch; the others wait for it
+    private SketchPrefix sketchPrefix(List<MacroRecorder.MacroCommand> commands) {
+        CompletableFuture<SketchPrefix> mine = new CompletableFuture<>();
+        CompletableFuture<SketchPrefix> first = prefixes.putIfAbsent(scriptKey(commands), mine);
+        if (first != null) {
+            return first.join();
+        }
+        try {
+            MacroProgram program = MacroProgram.compile(commands, profileCache);
+            List<String> errors = new ArrayList<>(program.getCompileErrors());
+            ModelContext context = new ModelContext("sweep-prefix");
+            Sketch sketch = new Sketch();
+            context.setSketch(sketch);
+            errors.addAll(program.run(context, sketch, null, null).getErrors());
+            mine.complete(new SketchPrefix(sketch, errors));
+        } catch (RuntimeException | StackOverflowError e) {
+            mine.completeExceptionally(e);
+            throw e;
+        }
+        return mine.join();
+    }
+
+    public void writeCsv(Writer writer, List<VariantResult> results) {
+        PrintWriter out = new PrintWriter(writer);
+        List<String> header = new ArrayList<>();
+        header.add("variant");
+        header.addAll(parameters.keySet());
+        Collections.addAll(header, "status", "volume", "surface_area", "triangles", "export", "elapsed_ms", "message");
+        out.println(String.join(",", header));
+        for (VariantResult result : results) {
+            List<String> row = new ArrayList<>();
+            row.add(Integer.toString(result.getIndex() + 1));
+            for (String name : parameters.keySet()) {
+                row.add(csv(result.getValues().get(name)));
+            }
+            row.add(result.isOk() ? "ok" : "failed");
+            row.add(Double.toString(result.getVolume()));
+            row.add(Double.toString(result.getSurfaceArea()));
+            row.add(Integer.toString(result.getTriangleCount()));
+            row.add(csv(result.getExport() != null ? result.getExport().toString() : ""));
+            row.add(String.format(Locale.ROOT, "%.1f", result.getElapsedNanos() / 1e6));
+            row.add(csv(String.join("; ", result.getErrors())));
+            out.println(String.join(",", row));
+        }
+        out.flush();
+    }
+
+    // Macro file lines as commands; comments and blank lines are skipped, placeholders kept as text
+    public static List<MacroRecorder.MacroCommand> parseTemplate(List<String> lines) {
+        List<MacroRecorder.MacroCommand> commands = new ArrayList<>();
+        for (int i = 0; i < lines.size(); i++) {
+            String line = lines.get(i).trim();
+            if (line.isEmpty() || line.startsWith("#")) {
+                continue;
+            }
+            try {
+                commands.add(MacroRecorder.MacroCommand.fromScriptLine(line));
+            } catch (IllegalArgumentException e) {
+                throw new IllegalArgumentException("Line " + (i + 1) + ": unknown macro action in \"" + line + "\"");
+            }
+        }
+        return commands;
+    }
+
+    static Set<String> placeholders(List<MacroRecorder.MacroCommand> template) {
+        Set<String> names = new LinkedHashSet<>();
+        for (MacroRecorder.MacroCommand cmd : template) {
+            for (Object value : cmd.parameters.values()) {
+                Matcher m = PLACEHOLDER.matcher(String.valueOf(value));
+                while (m.find()) {
+                    names.add(m.group(1));
+                }
+            }
+        }
+        return names;
+    }
+
+    static List<MacroRecorder.MacroCommand> instantiate(List<MacroRecorder.MacroCommand> template,
+            Map<String, String> values) {
+        List<MacroRecorder.MacroCommand> commands = new ArrayList<>(template.size());
+        for (MacroRecorder.MacroCommand cmd : template) {
+            Map<String, Object> params = cmd.parameters;
+            for (Map.Entry<String, Object> entry : cmd.parameters.entrySet()) {
+                String text = String.valueOf(entry.getValue());
+                if (text.contains("${")) {
+                    if (params == cmd.parameters) {
+                        params = new HashMap<>(cmd.parameters);
+                    }
+                    Matcher m = PLACEHOLDER.matcher(text);
+                    params.put(entry.getKey(), m.replaceAll(r -> Matcher.quoteReplacement(values.get(r.group(1)))));
+                }
+            }
+            commands.add(params == cmd.parameters ? cmd : new MacroRecorder.MacroCommand(cmd.action, params));
+        }
+        return commands;
+    }
+
+    // For each script, the number of leading sketch steps it has in common with at least one other
+    // script. Variants with the same prefix of that length draw it once between them.
+    static int[] sharedPrefixLengths(List<List<MacroRecorder.MacroCommand>> scripts) {
+        Map<String, Integer> uses = new HashMap<>();
+        List<List<String>> prefixKeys = new ArrayList<>(scripts.size());
+        for (List<MacroRecorder.MacroCommand> script : scripts) {
+            List<String> keys = new ArrayList<>();
+            StringBuilder key = new StringBuilder();
+            for (MacroRecorder.MacroCommand cmd : script) {
+                if (!SKETCH_STEPS.contains(cmd.action)) {
+                    break;
+                }
+                appendKey(key, cmd);
+                keys.add(key.toString());
+                uses.merge(key.toString(), 1, Integer::sum);
+            }
+            prefixKeys.add(keys);
+        }
+        int[] shared = new int[scripts.size()];
+        for (int i = 0; i < shared.length; i++) {
+            List<String> keys = prefixKeys.get(i);
+            int length = keys.size();
+            while (length > 0 && uses.get(keys.get(length - 1)) < 2) {
+                length--;
+            }
+            shared[i] = length;
+        }
+        return shared;
+    }
+
+    private static String scriptKey(List<MacroRecorder.MacroCommand> commands) {
+        StringBuilder key = new StringBuilder();
+        for (MacroRecorder.MacroCommand cmd : commands) {
+            appendKey(key, cmd);
+        }
+        return key.toString();
+    }
+
+    private static void appendKey(StringBuilder key, MacroRecorder.MacroCommand cmd) {
+        key.append(cmd.action).append(new TreeMap<>(cmd.parameters)).append('\n');
+    }
+
+    // "a,b,c" lists values; "start:end:step" is an inclusive numeric range
+    static List<String> parseValues(String spec) {
+        String[] range = spec.split(":");
+        if (range.length == 3) {
+            BigDecimal from = new BigDecimal(range[0].trim());
+            BigDecimal to = new BigDecimal(range[1].trim());
+            BigDecimal step = new BigDecimal(range[2].trim());
+            if (step.signum() <= 0) {
+                throw new IllegalArgumentException("Range step must be positive: " + spec);
+            }
+            List<String> values = new ArrayList<>();
+            for (BigDecimal v = from; v.compareTo(to) <= 0; v = v.add(step)) {
+                values.add(v.stripTrailingZeros().toPlainString());
+            }
+            return values;
+        }
+        List<String> values = new ArrayList<>();
+        for (String value : spec.split(",")) {
+            if (!value.isBlank()) {
+                values.add(value.trim());
+            }
+        }
+        if (values.isEmpty()) {
+            throw new IllegalArgumentException("No values in " + spec);
+        }
+        return values;
+    }
+
+    private static String csv(String value) {
+        if (value.contains(",") || value.contains("\"") || value.contains("\n")) {
+            return "\"" + value.replace("\"", "\"\"") + "\"";
+        }
+        return value;
+    }
+
+    private static String requireValue(String[] args, int i, String option) {
+        if (i >= args.length) {
+            throw new IllegalArgumentException("Missing argument for " + option);
+        }
+        return args[i];
+    }
+
+    private static int usage(String message) {
+        System.err.println(message);
+        System.err.println("Usage: java -jar SketchApp.jar sweep <macro> --param name=a,b,c|start:end:step ...");
+        System.err.println("           [--zip] [--out dir] [--jobs n] [--csv results.csv]");
+        return BatchRunner.EXIT_USAGE;
+    }
+}
@@ -0,0 +1,68 @@
+package cad.cli;
+
+import java.io.ByteArrayOutputStream;
+import java.io.OutputStream;
+import java.io.PrintStream;
+import java.nio.charset.StandardCharsets;
+
+// Routes System.out per thread while a capture is open, so headless runs can attach each command's
+// printed output to its result, including when several documents run on worker threads at once.
+// Threads without an open capture write through to the original stream.
+public final class OutputCapture {
+    private static final ThreadLocal<ByteArrayOutputStream> BUFFER = new ThreadLocal<>();
+    private static PrintStream original;
+
+    private OutputCapture() {
+    }
+
+    public static synchronized void install() {
+        if (original != null) {
+            return;
+        }
+        original = System.out;
+        PrintStream target = original;
+        System.setOut(new PrintStream(new OutputStream() {
+            @Override
+            public void write(int b) {
+                ByteArrayOutputStream buffer = BUFFER.get();
+                if (buffer != null) {
+                    buffer.write(b);
+                } else {
+                    target.write(b);
+                }
+            }
+
+            @Override
+            public void write(byte[] b, int off, int len) {
+                ByteArrayOutputStream buffer = BUFFER.get();
+                if (buffer != null) {
+                    buffer.write(b, off, len);
+                } else {
+                    target.write(b, off, len);
+                }
+            }
+
+            @Override
+            public void flush() {
+                target.flush();
+            }
+        }, true, StandardCharsets.UTF_8));
+    }
+
+    // The stream that was System.out before install, for writing past an open capture
+    public static synchronized PrintStream originalOut() {
+        return original != null ? original : System.out;
+    }
+
+    public static void begin() {
+        install();
+        BUFFER.set(new ByteArrayOutputStream());
+    }
+
+    public static String end() {
+        System.out.flush();
+        ByteArrayOutputStream buffer = BUFFER.get();
+        BUFFER.remove();
+        return buffer != null ? buffer.toString(StandardCharsets.UTF_8) : "";
+    }
+}
@@ -0,0 +1,10 @@
+package cad.cli;
+
+import cad.core.Command;
+import java.util.Map;
+
+// A command that measures something. Cli.run copies its values onto the CommandResult, so scripted
+// callers read numbers directly instead of parsing the printed text.
+public interface ReportingCommand extends Command {
+    Map<String, Double> getValues();
+}
@@ -1,20 +1,24 @@
 package cad.cli;
 
 import cad.core.*;
+import java.io.IOException;
+import java.io.UncheckedIOException;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.Locale;
+import java.util.Map;
 
 public class StandardHandlers {
 
-    public static void registerAll(CommandManager commandManager, Sketch sketch) {
+    public static void registerAll(CommandRegistry registry, CommandManager commandManager, Sketch sketch) {
 
         // --- System ---
-        CommandRegistry.register("help", new CliHandler() {
+        registry.register("help", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new Command() {
                     public void execute() {
                         System.out.println("Available commands:");
-                        CommandRegistry.getHelpMap().forEach((k, v) -> System.out.printf("  %-15s %s%n", k, v));
+                        registry.getHelpMap().forEach((k, v) -> System.out.printf("  %-15s %s%n", k, v));
                     }
 
                     public void undo() {
@@ -30,9 +34,9 @@ public class StandardHandlers {
                 return "help - List commands";
             }
         });
-        CommandRegistry.registerAlias("h", "help");
+        registry.registerAlias("h", "help");
 
-        CommandRegistry.register("exit", new CliHandler() {
+        registry.register("exit", new CliHandler() {
             public Command createCommand(String[] args) {
                 System.exit(0);
                 return null;
@@ -42,10 +46,10 @@ public class StandardHandlers {
                 return "exit - Quit application";
             }
         });
-        CommandRegistry.registerAlias("e", "exit");
-        CommandRegistry.registerAlias("quit", "exit");
+        registry.registerAlias("e", "exit");
+        registry.registerAlias("quit", "exit");
 
-        CommandRegistry.register("version", new CliHandler() {
+        registry.register("version", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new Command() {
                     public void execute() {
@@ -65,10 +69,10 @@ public class StandardHandlers {
                 return "version - Show version";
             }
         });
-        CommandRegistry.registerAlias("v", "version");
+        registry.registerAlias("v", "version");
 
         // --- Sketching ---
-        CommandRegistry.register("sketch_point", new CliHandler() {
+        registry.register("sketch_point", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 3)
                     throw new IllegalArgumentException("Usage: sketch_point <x> <y>");
@@ -82,7 +86,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("sketch_line", new CliHandler() {
+        registry.register("sketch_line", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 5)
                     throw new IllegalArgumentException("Usage: sketch_line <x1> <y1> <x2> <y2>");
@@ -97,10 +101,10 @@ public class StandardHandlers {
                 return "sketch_line <x1> <y1> <x2> <y2>";
             }
         });
-        CommandRegistry.registerAlias("line", "sketch_line");
-        CommandRegistry.registerAlias("l", "sketch_line");
+        registry.registerAlias("line", "sketch_line");
+        registry.registerAlias("l", "sketch_line");
 
-        CommandRegistry.register("sketch_circle", new CliHandler() {
+        registry.register("sketch_circle", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 4)
                     throw new IllegalArgumentException("Usage: sketch_circle <x> <y> <r>");
@@ -114,9 +118,9 @@ public class StandardHandlers {
                 return "sketch_circle <x> <y> <r>";
             }
         });
-        CommandRegistry.registerAlias("circle", "sketch_circle");
+        registry.registerAlias("circle", "sketch_circle");
 
-        CommandRegistry.register("sketch_polygon", new CliHandler() {
+        registry.register("sketch_polygon", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 5)
                     throw new IllegalArgumentException(
@@ -147,9 +151,9 @@ public class StandardHandlers {
                 return "sketch_polygon <x> <y> <r> <sides> [circum]";
             }
         });
-        CommandRegistry.registerAlias("poly", "sketch_polygon");
+        registry.registerAlias("poly", "sketch_polygon");
 
-        CommandRegistry.register("sketch_clear", new CliHandler() {
+        registry.register("sketch_clear", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new Command() {
                     public void execute() {
@@ -172,7 +176,7 @@ public class StandardHandlers {
         });
 
         // --- 3D Primitive Commands ---
-        CommandRegistry.register("cube", new CliHandler() {
+        registry.register("cube", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 if (args.length < 2)
@@ -187,15 +191,15 @@ public class StandardHandlers {
                 return "cube <size> - Create a cube";
             }
         });
-        CommandRegistry.registerAlias("c", "cube");
+        registry.registerAlias("c", "cube");
 
-        CommandRegistry.register("sphere", new CliHandler() {
+        registry.register("sphere", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: sphere <radius>");
                 float radius = Float.parseFloat(args[1]);
-                return new CreateSphereCommand(radius, Geometry.sphereLatDiv, Geometry.sphereLonDiv);
+                return new CreateSphereCommand(radius, Geometry.getSphereLatDiv(), Geometry.getSphereLonDiv());
             }
 
             @Override
@@ -203,10 +207,10 @@ public class StandardHandlers {
                 return "sphere <radius> - Create a sphere";
             }
         });
-        CommandRegistry.registerAlias("sp", "sphere");
+        registry.registerAlias("sp", "sphere");
 
         // --- 3D Operations ---
-        CommandRegistry.register("extrude", new CliHandler() {
+        registry.register("extrude", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 if (args.length < 2)
@@ -220,9 +224,9 @@ public class StandardHandlers {
                 return "extrude <height> - Extrude 2D sketch";
             }
         });
-        CommandRegistry.registerAlias("ext", "extrude");
+        registry.registerAlias("ext", "extrude");
 
-        CommandRegistry.register("revolve", new CliHandler() {
+        registry.register("revolve", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 float angle = 360.0f;
@@ -242,7 +246,7 @@ public class StandardHandlers {
         });
 
         // --- Inspection ---
-        CommandRegistry.register("inspect", new CliHandler() {
+        registry.register("inspect", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 return new InspectStateCommand(sketch);
@@ -255,7 +259,7 @@ public class StandardHandlers {
         });
 
         // --- System / History ---
-        CommandRegistry.register("undo", new CliHandler() {
+        registry.register("undo", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 if (commandManager.undo())
@@ -270,9 +274,9 @@ public class StandardHandlers {
                 return "undo - Undo last action";
             }
         });
-        CommandRegistry.registerAlias("u", "undo");
+        registry.registerAlias("u", "undo");
 
-        CommandRegistry.register("redo", new CliHandler() {
+        registry.register("redo", new CliHandler() {
             @Override
             public Command createCommand(String[] args) {
                 if (commandManager.redo())
@@ -287,9 +291,9 @@ public class StandardHandlers {
                 return "redo - Redo last action";
             }
         });
-        CommandRegistry.registerAlias("r", "redo");
+        registry.registerAlias("r", "redo");
 
-        CommandRegistry.register("cut", new CliHandler() {
+        registry.register("cut", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: cut <depth>");
@@ -302,7 +306,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("intersect", new CliHandler() {
+        registry.register("intersect", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: intersect <depth>");
@@ -315,7 +319,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("sweep", new CliHandler() {
+        registry.register("sweep", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new CreateSweepCommand(sketch, Geometry.BooleanOp.UNION);
             }
@@ -325,7 +329,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("loft", new CliHandler() {
+        registry.register("loft", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new CreateLoftCommand(sketch, Geometry.BooleanOp.UNION);
             }
@@ -335,7 +339,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("kite", new CliHandler() {
+        registry.register("kite", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 6)
                     throw new IllegalArgumentException("Usage: kite <cx> <cy> <v> <h> <a>");
@@ -365,7 +369,7 @@ public class StandardHandlers {
         });
 
         // --- Constraints ---
-        CommandRegistry.register("list_entities", new CliHandler() {
+        registry.register("list_entities", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new Command() {
                     public void execute() {
@@ -390,7 +394,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("constraint_tangent", new CliHandler() {
+        registry.register("constraint_tangent", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 3)
                     throw new IllegalArgumentException("Usage: constraint_tangent <id1> <id2>");
@@ -405,7 +409,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("constraint_concentric", new CliHandler() {
+        registry.register("constraint_concentric", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 3)
                     throw new IllegalArgumentException("Usage: constraint_concentric <id1> <id2>");
@@ -420,7 +424,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("solve", new CliHandler() {
+        registry.register("solve", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new Command() {
                     public void execute() {
@@ -442,13 +446,20 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("mass_props", new CliHandler() {
+        registry.register("mass_props", new CliHandler() {
             public Command createCommand(String[] args) {
-                return new Command() {
+                return new ReportingCommand() {
+                    private double volume;
+                    private double area;
+
                     public void execute() {
-                        float vol = Geometry.calculateVolume();
-                        float area = Geometry.calculateSurfaceArea();
-                        System.out.printf("Volume: %.4f, Surface Area: %.4f%n", vol, area);
+                        volume = Geometry.calculateVolume();
+                        area = Geometry.calculateSurfaceArea();
+                        System.out.printf(Locale.ROOT, "Volume: %.4f, Surface Area: %.4f%n", volume, area);
+                    }
+
+                    public Map<String, Double> getValues() {
+                        return Map.of("volume", volume, "surface_area", area);
                     }
 
                     public void undo() {
@@ -465,7 +476,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("constraint_horizontal", new CliHandler() {
+        registry.register("constraint_horizontal", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: constraint_horizontal <line_id>");
@@ -484,7 +495,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("constraint_vertical", new CliHandler() {
+        registry.register("constraint_vertical", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: constraint_vertical <line_id>");
@@ -503,7 +514,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("constraint_coincident", new CliHandler() {
+        registry.register("constraint_coincident", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 3)
                     throw new IllegalArgumentException("Usage: constraint_coincident <id1> <id2>");
@@ -519,7 +530,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("constraint_fixed", new CliHandler() {
+        registry.register("constraint_fixed", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: constraint_fixed <id>");
@@ -537,14 +548,14 @@ public class StandardHandlers {
         });
 
         // --- Settings & File I/O ---
-        CommandRegistry.register("cube_div", new CliHandler() {
+        registry.register("cube_div", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: cube_div <count>");
                 int count = Integer.parseInt(args[1]);
                 if (count < 1 || count > 200)
                     throw new IllegalArgumentException("Divisions must be 1-200");
-                Geometry.cubeDivisions = count;
+                Geometry.setCubeDivisions(count);
                 return new Command() {
                     public void execute() {
                         System.out.println("Cube divisions set to " + count);
@@ -564,16 +575,16 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("sphere_div", new CliHandler() {
+        registry.register("sphere_div", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 3)
                     throw new IllegalArgumentException("Usage: sphere_div <lat> <lon>");
                 int lat = Integer.parseInt(args[1]);
                 int lon = Integer.parseInt(args[2]);
-                if (lat < 1 || lat > 200 || lon < 1 || lon > 200)
-                    throw new IllegalArgumentException("Divisions must be 1-200");
-                Geometry.sphereLatDiv = lat;
-                Geometry.sphereLonDiv = lon;
+                boolean auto = lat == Geometry.AUTO_DIVISIONS && lon == Geometry.AUTO_DIVISIONS;
+                if (!auto && (lat < 1 || lat > 200 || lon < 1 || lon > 200))
+                    throw new IllegalArgumentException("Divisions must be 1-200, or 0 0 for tolerance-driven");
+                Geometry.setSphereDivisions(lat, lon);
                 return new Command() {
                     public void execute() {
                         System.out.printf("Sphere divisions set to %d, %d%n", lat, lon);
@@ -593,7 +604,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("units", new CliHandler() {
+        registry.register("units", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: units <mm|cm|m|in|ft>");
@@ -633,7 +644,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("save", new CliHandler() {
+        registry.register("save", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: save <filename>");
@@ -643,8 +654,8 @@ public class StandardHandlers {
                         try {
                             Geometry.saveStl(filename);
                             System.out.println("Saved " + filename);
-                        } catch (Exception e) {
-                            System.out.println("Error saving: " + e.getMessage());
+                        } catch (IOException e) {
+                            throw new UncheckedIOException("Error saving: " + e.getMessage(), e);
                         }
                     }
 
@@ -662,25 +673,26 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("load", new CliHandler() {
+        registry.register("load", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: load <filename>");
                 String filename = args[1];
+                String lower = filename.toLowerCase();
+                if (!lower.endsWith(".stl") && !lower.endsWith(".dxf"))
+                    throw new IllegalArgumentException("Unknown format: " + filename);
                 return new Command() {
                     public void execute() {
                         try {
-                            if (filename.toLowerCase().endsWith(".stl")) {
+                            if (lower.endsWith(".stl")) {
                                 Geometry.loadStl(filename);
                                 System.out.println("Loaded STL: " + filename);
-                            } else if (filename.toLowerCase().endsWith(".dxf")) {
+                            } else {
                                 sketch.loadDXF(filename);
                                 System.out.println("Loaded DXF: " + filename);
-                            } else {
-                                System.out.println("Unknown format.");
                             }
-                        } catch (Exception e) {
-                            System.out.println("Error loading: " + e.getMessage());
+                        } catch (IOException e) {
+                            throw new UncheckedIOException("Error loading: " + e.getMessage(), e);
                         }
                     }
 
@@ -698,7 +710,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("export_dxf", new CliHandler() {
+        registry.register("export_dxf", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: export_dxf <filename>");
@@ -706,10 +718,10 @@ public class StandardHandlers {
                 return new Command() {
                     public void execute() {
                         try {
-                            sketch.exportSketchToDXF(filename);
+                            DxfWriter.export(sketch, filename);
                             System.out.println("Exported " + filename);
-                        } catch (Exception e) {
-                            System.out.println("Error exporting: " + e.getMessage());
+                        } catch (IOException e) {
+                            throw new UncheckedIOException("Error exporting: " + e.getMessage(), e);
                         }
                     }
 
@@ -727,7 +739,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("cg", new CliHandler() {
+        registry.register("cg", new CliHandler() {
             public Command createCommand(String[] args) {
                 return new Command() {
                     public void execute() {
@@ -749,7 +761,7 @@ public class StandardHandlers {
             }
         });
 
-        CommandRegistry.register("naca", new CliHandler() {
+        registry.register("naca", new CliHandler() {
             public Command createCommand(String[] args) {
                 if (args.length < 2)
                     throw new IllegalArgumentException("Usage: naca <digits> [chord]");
@@ -0,0 +1,169 @@
+package cad.cli;
+
+import java.io.IOException;
+import java.net.URISyntaxException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Locale;
+
+// The "bench-startup" subcommand: measures cold start of the headless jar by launching a fresh JVM
+// for every run, once per class-sharing setup, and prints one CSV row per setup:
+//
+//   bench-startup --archive target/SketchApp.jsa --repeat 10 --out target/startup-benchmark.csv
+//
+// The setups are no class sharing at all (-Xshare:off), the JDK's own base archive (the default),
+// and the application archive written by the "cds" Maven profile. The application archive runs
+// with -Xshare:on, so a stale or unusable archive fails instead of quietly timing the default.
+//
+// Each run is wall time from process start to exit for one --eval script. Setups take turns run
+// by run so that background load affects all of them alike, and one untimed round first brings
+// the jar and the archive into the file cache.
+public class StartupBenchmark {
+    static final String DEFAULT_SCRIPT = "cube 1; mass_props";
+
+    static final class Setup {
+        final String name;
+        final List<String> options;
+        final long[] nanos;
+        String error;
+
+        Setup(String name, List<String> options, int repeat) {
+            this.name = name;
+            this.options = options;
+            this.nanos = new long[repeat];
+        }
+    }
+
+    public static boolean isBenchmarkCommand(String arg) {
+        return arg.equalsIgnoreCase("bench-startup");
+    }
+
+    // Entry point from Main; args[0] is "bench-startup". Returns the process exit code.
+    public static int run(String[] args) {
+        int repeat = 10;
+        String archive = null;
+        String script = DEFAULT_SCRIPT;
+        String out = null;
+        try {
+            for (int i = 1; i < args.length; i++) {
+                if (args[i].equalsIgnoreCase("--repeat") && i + 1 < args.length) {
+                    repeat = Integer.parseInt(args[++i]);
+                } else if (args[i].equalsIgnoreCase("--archive") && i + 1 < args.length) {
+                    archive = args[++i];
+                } else if (args[i].equalsIgnoreCase("--eval") && i + 1 < args.length) {
+                    script = args[++i];
+                } else if (args[i].equalsIgnoreCase("--out") && i + 1 < args.length) {
+                    out = args[++i];
+                } else {
+                    throw new IllegalArgumentException("Unexpected argument: " + args[i]);
+                }
+            }
+            if (repeat < 1) {
+                throw new IllegalArgumentException("--repeat needs at least 1");
+            }
+        } catch (IllegalArgumentException e) {
+            System.err.println(e.getMessage());
+            System.err.println("Usage: bench-startup [--archive <file.jsa>] [--repeat <n>] [--eval <commands>] [--out <file.csv>]");
+            return BatchRunner.EXIT_USAGE;
+        }
+
+        Path jar;
+        try {
+            jar = Paths.get(StartupBenchmark.class.getProtectionDomain().getCodeSource().getLocation().toURI());
+        } catch (URISyntaxException | SecurityException e) {
+            System.err.println("Cannot locate the application jar: " + e.getMessage());
+            return BatchRunner.EXIT_IO_ERROR;
+        }
+        if (!Files.isRegularFile(jar)) {
+            System.err.println("bench-startup must be run from the packaged jar, not from " + jar);
+            return BatchRunner.EXIT_USAGE;
+        }
+        Path archivePath = archive != null ? Paths.get(archive) : jar.resolveSibling("SketchApp.jsa");
+
+        List<Setup> setups = new ArrayList<>();
+        setups.add(new Setup("no sharing", List.of("-Xshare:off"), repeat));
+        setups.add(new Setup("jdk archive", List.of(), repeat));
+        if (Files.isRegularFile(archivePath)) {
+            setups.add(new Setup("app archive",
+                    List.of("-Xshare:on", "-XX:SharedArchiveFile=" + archivePath.toAbsolutePath()), repeat));
+        } else {
+            System.err.println("No archive at " + archivePath + "; build one with mvn -Pcds package");
+        }
+
+        String java = Paths.get(System.getProperty("java.home"), "bin", "java").toString();
+        for (int round = -1; round < repeat; round++) {
+            for (Setup setup : setups) {
+                if (setup.error != null) {
+                    continue;
+                }
+                List<String> command = new ArrayList<>();
+                command.add(java);
+                command.addAll(setup.options);
+                Collections.addAll(command, "-jar", jar.toString(), "--eval", script);
+                try {
+                    long elapsed = launch(command);
+                    if (round >= 0) {
+                        setup.nanos[round] = elapsed;
+                    }
+                } catch (IOException | IllegalStateException e) {
+                    setup.error = e.getMessage();
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    return BatchRunner.EXIT_COMMAND_FAILED;
+                }
+            }
+        }
+
+        List<String> rows = new ArrayList<>();
+        rows.add("setup,runs,best_ms,median_ms,mean_ms,status");
+        int failed = 0;
+        for (Setup setup : setups) {
+            if (setup.error != null) {
+                rows.add(String.format(Locale.ROOT, "%s,%d,,,,\"failed: %s\"", setup.name, repeat,
+                        setup.error.replace("\"", "\"\"")));
+                failed++;
+                continue;
+            }
+            long[] sorted = setup.nanos.clone();
+            Arrays.sort(sorted);
+            rows.add(String.format(Locale.ROOT, "%s,%d,%.1f,%.1f,%.1f,ok", setup.name, repeat, sorted[0] / 1e6,
+                    median(sorted) / 1e6, Arrays.stream(sorted).average().orElse(0) / 1e6));
+        }
+        rows.forEach(System.out::println);
+        if (out != null) {
+            // Also written to a file so a CI run can publish the comparison as an artifact
+            try {
+                Files.write(Paths.get(out), rows);
+            } catch (IOException e) {
+                System.err.println("Cannot write " + out + ": " + e.getMessage());
+                return BatchRunner.EXIT_IO_ERROR;
+            }
+        }
+        return failed == 0 ? BatchRunner.EXIT_OK : BatchRunner.EXIT_COMMAND_FAILED;
+    }
+
+    // Wall time of one child JVM; its output is discarded so that only the launch is timed
+    private static long launch(List<String> command) throws IOException, InterruptedException {
+        ProcessBuilder builder = new ProcessBuilder(command)
+                .redirectOutput(ProcessBuilder.Redirect.DISCARD)
+                .redirectError(ProcessBuilder.Redirect.DISCARD);
+        long start = System.nanoTime();
+        Process process = builder.start();
+        int exit = process.waitFor();
+        long elapsed = System.nanoTime() - start;
+        if (exit != 0) {
+            throw new IllegalStateException("exit code " + exit + " from " + String.join(" ", command));
+        }
+        return elapsed;
+    }
+
+    static double median(long[] sorted) {
+        int mid = sorted.length / 2;
+        return sorted.length % 2 == 1 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2.0;
+    }
+}
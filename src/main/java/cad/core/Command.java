@@ -4,4 +4,24 @@ public interface Command {
     void execute();
     void undo();
     String getDescription();
+
+    // Folds a command executed right after this one into it, as while scrubbing a value; the manager
+    // then drops the other command's undo data. Returns false when the two must stay separate steps.
+    default boolean mergeWith(Command next) {
+        return false;
+    }
+
+    // Heap bytes held by this command's undo data; CommandManager's memory budget sums these
+    default long getRetainedBytes() {
+        return 0;
+    }
+
+    // Moves undo data into the spill file when the history is over budget; returns bytes released
+    default long spill(UndoSpill store) {
+        return 0;
+    }
+
+    // Called once the command has left the history and can no longer be undone or redone
+    default void discard() {
+    }
 }
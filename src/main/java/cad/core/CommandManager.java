@@ -1,150 +1,440 @@
 package cad.core;
 
-import java.util.Stack;
+import java.io.IOException;
+import java.util.ArrayDeque;
 import java.util.ArrayList;
+import java.util.Deque;
+import java.util.IdentityHashMap;
+import java.util.Iterator;
 import java.util.List;
+import java.util.Map;
+import java.util.concurrent.Executor;
+import java.util.function.Consumer;
 
 public class CommandManager {
-    
-    private static final int MAX_HISTORY_SIZE = 100;
-    
-    private Stack<Command> undoStack;
-    private Stack<Command> redoStack;
+
+    private static final int DEFAULT_MAX_HISTORY_SIZE = 100;
+    private static final long DEFAULT_MEMORY_BUDGET = 256L * 1024 * 1024;
+
+    // Oldest command first; the top of each stack is its last element
+    private final Deque<Command> undoStack;
+    private final Deque<Command> redoStack;
     private List<CommandListener> listeners;
-    
-    
+
+    private int maxHistorySize = DEFAULT_MAX_HISTORY_SIZE;
+    private long memoryBudget = DEFAULT_MEMORY_BUDGET;
+    // Bytes each command reported when it last ran, and their sum over both stacks
+    private final Map<Command, Long> retained = new IdentityHashMap<>();
+    private long retainedBytes;
+    private UndoSpill spill;
+
+    // A command executed within the merge window of the previous one may fold into it. Off unless a
+    // caller opts in: scripts and batch runs execute commands back to back and expect one step each.
+    private long mergeWindowMillis;
+    private long lastExecutedAt;
+    private boolean mergeable;
+
+    private int groupDepth;
+    private String groupDescription;
+    private List<Command> groupCommands;
+
+    // With a dispatcher, events are queued and delivered in one flush it runs, and onHistoryChanged
+    // fires once per flush however many commands went through
+    private Executor dispatcher;
+    private final List<Consumer<CommandListener>> pendingEvents = new ArrayList<>();
+    private boolean historyDirty;
+    private boolean flushScheduled;
+
+
     public interface CommandListener {
         void onCommandExecuted(Command cmd);
         void onUndo(Command cmd);
         void onRedo(Command cmd);
         void onHistoryChanged();
     }
-    
+
     public CommandManager() {
-        undoStack = new Stack<>();
-        redoStack = new Stack<>();
+        undoStack = new ArrayDeque<>();
+        redoStack = new ArrayDeque<>();
         listeners = new ArrayList<>();
     }
-    
-    
+
+
     public void executeCommand(Command cmd) {
         cmd.execute();
-        undoStack.push(cmd);
-        
-        
-        redoStack.clear();
-        
-        
-        while (undoStack.size() > MAX_HISTORY_SIZE) {
-            undoStack.remove(0);
+
+        if (groupDepth > 0) {
+            appendMerging(groupCommands, cmd);
+            return;
         }
-        
+
+        long now = System.nanoTime();
+        Command top = undoStack.peekLast();
+        boolean withinWindow = now - lastExecutedAt <= mergeWindowMillis * 1_000_000L;
+        lastExecutedAt = now;
+        if (top != null && mergeable && withinWindow && top.mergeWith(cmd)) {
+            cmd.discard();
+            account(top);
+            enforceBudget();
+            publish();
+            notifyCommandExecuted(top);
+            notifyHistoryChanged();
+            return;
+        }
+
+        push(cmd);
+        mergeable = true;
+        publish();
         notifyCommandExecuted(cmd);
         notifyHistoryChanged();
     }
-    
-    
+
+    // Everything executed until the matching endGroup becomes a single history entry, with one
+    // notification when the outermost group ends. Groups nest; the outermost description is used.
+    public void beginGroup(String description) {
+        if (groupDepth++ == 0) {
+            groupDescription = description;
+            groupCommands = new ArrayList<>();
+        }
+    }
+
+    public void endGroup() {
+        if (groupDepth == 0) {
+            throw new IllegalStateException("endGroup without beginGroup");
+        }
+        if (--groupDepth > 0) {
+            return;
+        }
+        List<Command> commands = groupCommands;
+        groupCommands = null;
+        if (commands.isEmpty()) {
+            return;
+        }
+        Command entry = commands.size() == 1 ? commands.get(0) : new CompositeCommand(groupDescription, commands);
+        push(entry);
+        mergeable = false;
+        publish();
+        notifyCommandExecuted(entry);
+        notifyHistoryChanged();
+    }
+
+    public boolean isInGroup() {
+        return groupDepth > 0;
+    }
+
+    private void appendMerging(List<Command> commands, Command cmd) {
+        if (!commands.isEmpty() && commands.get(commands.size() - 1).mergeWith(cmd)) {
+            cmd.discard();
+        } else {
+            commands.add(cmd);
+        }
+    }
+
+    private void push(Command cmd) {
+        undoStack.addLast(cmd);
+        account(cmd);
+
+        while (!redoStack.isEmpty()) {
+            release(redoStack.removeLast());
+        }
+
+        while (undoStack.size() > maxHistorySize) {
+            release(undoStack.removeFirst());
+        }
+        enforceBudget();
+    }
+
+
     public boolean undo() {
+        checkNotInGroup();
         if (undoStack.isEmpty()) {
             return false;
         }
-        
-        Command cmd = undoStack.pop();
+        mergeable = false;
+
+        Command cmd = undoStack.removeLast();
         cmd.undo();
-        redoStack.push(cmd);
-        
+        redoStack.addLast(cmd);
+        reaccount();
+        enforceBudget();
+        publish();
+
         notifyUndo(cmd);
         notifyHistoryChanged();
         return true;
     }
-    
-    
+
+
     public boolean redo() {
+        checkNotInGroup();
         if (redoStack.isEmpty()) {
             return false;
         }
-        
-        Command cmd = redoStack.pop();
+        mergeable = false;
+
+        Command cmd = redoStack.removeLast();
         cmd.execute();
-        undoStack.push(cmd);
-        
+        undoStack.addLast(cmd);
+        reaccount();
+        enforceBudget();
+        publish();
+
         notifyRedo(cmd);
         notifyHistoryChanged();
         return true;
     }
-    
-    
+
+
     public boolean canUndo() {
         return !undoStack.isEmpty();
     }
-    
-    
+
+
     public boolean canRedo() {
         return !redoStack.isEmpty();
     }
-    
-    
+
+
     public String getUndoDescription() {
         if (undoStack.isEmpty()) return "Undo";
-        return "Undo " + undoStack.peek().getDescription();
+        return "Undo " + undoStack.peekLast().getDescription();
     }
-    
-    
+
+
     public String getRedoDescription() {
         if (redoStack.isEmpty()) return "Redo";
-        return "Redo " + redoStack.peek().getDescription();
+        return "Redo " + redoStack.peekLast().getDescription();
     }
-    
-    
+
+
     public void clearHistory() {
+        checkNotInGroup();
+        mergeable = false;
+        for (Command cmd : undoStack) {
+            cmd.discard();
+        }
+        for (Command cmd : redoStack) {
+            cmd.discard();
+        }
         undoStack.clear();
         redoStack.clear();
+        retained.clear();
+        retainedBytes = 0;
+        if (spill != null) {
+            try {
+                spill.close();
+            } catch (IOException e) {
+                System.err.println("Could not delete undo spill file: " + e.getMessage());
+            }
+            spill = null;
+        }
         notifyHistoryChanged();
     }
-    
-    
+
+
     public int getUndoCount() {
         return undoStack.size();
     }
-    
-    
+
+
     public int getRedoCount() {
         return redoStack.size();
     }
-    
-    
+
+    public int getMaxHistorySize() {
+        return maxHistorySize;
+    }
+
+    public void setMaxHistorySize(int maxHistorySize) {
+        if (maxHistorySize < 1) {
+            throw new IllegalArgumentException("History size must be at least 1");
+        }
+        this.maxHistorySize = maxHistorySize;
+        while (undoStack.size() > maxHistorySize) {
+            release(undoStack.removeFirst());
+        }
+    }
+
+    public long getMemoryBudget() {
+        return memoryBudget;
+    }
+
+    // Heap bytes the undo history may hold before older entries are compressed to the spill file
+    public void setMemoryBudget(long bytes) {
+        if (bytes < 0) {
+            throw new IllegalArgumentException("Memory budget must not be negative");
+        }
+        this.memoryBudget = bytes;
+        enforceBudget();
+    }
+
+    // Heap bytes currently held by undo and redo data, as reported by the commands
+    public long getRetainedBytes() {
+        return retainedBytes;
+    }
+
+    public long getSpilledBytes() {
+        return spill != null ? spill.getFileSize() : 0;
+    }
+
+
+    public long getMergeWindowMillis() {
+        return mergeWindowMillis;
+    }
+
+    // Zero turns merging off outside groups
+    public void setMergeWindowMillis(long millis) {
+        if (millis < 0) {
+            throw new IllegalArgumentException("Merge window must not be negative");
+        }
+        this.mergeWindowMillis = millis;
+    }
+
+    // The GUI passes Platform::runLater so listeners run at most once per frame; null delivers
+    // every event synchronously
+    public void setNotificationDispatcher(Executor dispatcher) {
+        flushNotifications();
+        this.dispatcher = dispatcher;
+    }
+
+    // Delivers queued events now, in the order they happened
+    public void flushNotifications() {
+        List<Consumer<CommandListener>> events;
+        boolean history;
+        synchronized (pendingEvents) {
+            events = new ArrayList<>(pendingEvents);
+            pendingEvents.clear();
+            history = historyDirty;
+            historyDirty = false;
+            flushScheduled = false;
+        }
+        for (Consumer<CommandListener> event : events) {
+            deliver(event);
+        }
+        if (history) {
+            deliver(CommandListener::onHistoryChanged);
+        }
+    }
+
     public void addListener(CommandListener listener) {
         listeners.add(listener);
     }
-    
+
     public void removeListener(CommandListener listener) {
         listeners.remove(listener);
     }
-    
-    private void notifyCommandExecuted(Command cmd) {
-        for (CommandListener l : listeners) {
-            l.onCommandExecuted(cmd);
+
+    private void account(Command cmd) {
+        Long previous = retained.put(cmd, cmd.getRetainedBytes());
+        retainedBytes += retained.get(cmd) - (previous != null ? previous : 0);
+    }
+
+    // What a state retains depends on which model it is compared with, so undo and redo, which
+    // swap the live model, re-measure every entry rather than just the one that moved
+    private void reaccount() {
+        for (Command cmd : undoStack) {
+            account(cmd);
+        }
+        for (Command cmd : redoStack) {
+            account(cmd);
         }
     }
-    
-    private void notifyUndo(Command cmd) {
-        for (CommandListener l : listeners) {
-            l.onUndo(cmd);
+
+    private void release(Command cmd) {
+        Long bytes = retained.remove(cmd);
+        if (bytes != null) {
+            retainedBytes -= bytes;
         }
+        cmd.discard();
     }
-    
-    private void notifyRedo(Command cmd) {
-        for (CommandListener l : listeners) {
-            l.onRedo(cmd);
+
+    // Spills the oldest undo entries first, so recent undo steps stay in memory; the redo stack
+    // holds the most recently undone work and is spilled last
+    private void enforceBudget() {
+        if (retainedBytes <= memoryBudget) {
+            return;
+        }
+        if (spill == null) {
+            spill = new UndoSpill();
+        }
+        spillFrom(undoStack.iterator());
+        spillFrom(redoStack.iterator());
+    }
+
+    private void spillFrom(Iterator<Command> commands) {
+        while (retainedBytes > memoryBudget && commands.hasNext()) {
+            Command cmd = commands.next();
+            Long bytes = retained.get(cmd);
+            if (bytes == null || bytes == 0) {
+                continue;
+            }
+            long released = cmd.spill(spill);
+            if (released > 0) {
+                retained.put(cmd, Math.max(0, bytes - released));
+                retainedBytes -= Math.min(bytes, released);
+            }
+        }
+    }
+
+    // Each finished history entry becomes the snapshot other threads read; a group publishes once
+    // when it closes
+    private void publish() {
+        ModelContext.current().publish();
+    }
+
+    private void checkNotInGroup() {
+        if (groupDepth > 0) {
+            throw new IllegalStateException("Command group \"" + groupDescription + "\" is still open");
         }
     }
-    
+
+    private void notifyCommandExecuted(Command cmd) {
+        post(l -> l.onCommandExecuted(cmd));
+    }
+
+    private void notifyUndo(Command cmd) {
+        post(l -> l.onUndo(cmd));
+    }
+
+    private void notifyRedo(Command cmd) {
+        post(l -> l.onRedo(cmd));
+    }
+
     private void notifyHistoryChanged() {
-        for (CommandListener l : listeners) {
-            l.onHistoryChanged();
+        if (dispatcher == null) {
+            deliver(CommandListener::onHistoryChanged);
+            return;
+        }
+        synchronized (pendingEvents) {
+            historyDirty = true;
+            scheduleFlush();
+        }
+    }
+
+    private void post(Consumer<CommandListener> event) {
+        if (dispatcher == null) {
+            deliver(event);
+            return;
+        }
+        synchronized (pendingEvents) {
+            pendingEvents.add(event);
+            scheduleFlush();
+        }
+    }
+
+    private void scheduleFlush() {
+        if (!flushScheduled) {
+            flushScheduled = true;
+            dispatcher.execute(this::flushNotifications);
         }
     }
-    
+
+    private void deliver(Consumer<CommandListener> event) {
+        for (CommandListener l : new ArrayList<>(listeners)) {
+            event.accept(l);
+        }
+    }
+
     public List<Command> getCommandHistory() {
         return new ArrayList<>(undoStack);
     }
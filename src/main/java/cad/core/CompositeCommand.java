@@ -0,0 +1,63 @@
+package cad.core;
+
+import java.util.ArrayList;
+import java.util.List;
+
+// Commands recorded between CommandManager.beginGroup and endGroup, undone and redone as one step
+public class CompositeCommand implements Command {
+    private final String description;
+    private final List<Command> commands;
+
+    public CompositeCommand(String description, List<Command> commands) {
+        this.description = description;
+        this.commands = new ArrayList<>(commands);
+    }
+
+    public List<Command> getCommands() {
+        return new ArrayList<>(commands);
+    }
+
+    @Override
+    public void execute() {
+        for (Command cmd : commands) {
+            cmd.execute();
+        }
+    }
+
+    @Override
+    public void undo() {
+        for (int i = commands.size() - 1; i >= 0; i--) {
+            commands.get(i).undo();
+        }
+    }
+
+    @Override
+    public String getDescription() {
+        return description;
+    }
+
+    @Override
+    public long getRetainedBytes() {
+        long bytes = 0;
+        for (Command cmd : commands) {
+            bytes += cmd.getRetainedBytes();
+        }
+        return bytes;
+    }
+
+    @Override
+    public long spill(UndoSpill store) {
+        long released = 0;
+        for (Command cmd : commands) {
+            released += cmd.spill(store);
+        }
+        return released;
+    }
+
+    @Override
+    public void discard() {
+        for (Command cmd : commands) {
+            cmd.discard();
+        }
+    }
+}
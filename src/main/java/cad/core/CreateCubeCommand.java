@@ -1,9 +1,8 @@
 package cad.core;
 
-public class CreateCubeCommand implements Command {
+public class CreateCubeCommand extends GeometryCommand {
     private final float size;
     private final int divisions;
-    private Geometry.State previousState;
 
     public CreateCubeCommand(float size, int divisions) {
         this.size = size;
@@ -12,17 +11,10 @@ public class CreateCubeCommand implements Command {
 
     @Override
     public void execute() {
-        this.previousState = Geometry.captureState();
+        captureState();
         Geometry.createCube(size, divisions);
     }
 
-    @Override
-    public void undo() {
-        if (previousState != null) {
-            Geometry.restoreState(previousState);
-        }
-    }
-
     @Override
     public String getDescription() {
         return "Create Cube (size=" + size + ")";
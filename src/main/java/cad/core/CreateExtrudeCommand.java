@@ -1,10 +1,9 @@
 package cad.core;
 
-public class CreateExtrudeCommand implements Command {
+public class CreateExtrudeCommand extends GeometryCommand {
     private final Sketch sketch;
     private float height;
     private final Geometry.BooleanOp op;
-    private Geometry.State previousState;
 
     public CreateExtrudeCommand(Sketch sketch, float height) {
         this(sketch, height, Geometry.BooleanOp.NONE);
@@ -26,15 +25,20 @@ public class CreateExtrudeCommand implements Command {
 
     @Override
     public void execute() {
-        this.previousState = Geometry.captureState();
+        captureState();
         Geometry.extrude(sketch, height, op);
     }
 
+    // Successive plain extrudes of the same sketch replace each other's solid, so they collapse into
+    // one step ending at the latest height; boolean extrudes accumulate and stay separate
     @Override
-    public void undo() {
-        if (previousState != null) {
-            Geometry.restoreState(previousState);
+    public boolean mergeWith(Command next) {
+        if (next instanceof CreateExtrudeCommand other && other.sketch == sketch
+                && op == Geometry.BooleanOp.NONE && other.op == op) {
+            height = other.height;
+            return true;
         }
+        return false;
     }
 
     @Override
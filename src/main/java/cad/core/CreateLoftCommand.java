@@ -1,9 +1,8 @@
 package cad.core;
 
-public class CreateLoftCommand implements Command {
+public class CreateLoftCommand extends GeometryCommand {
     private final Sketch sketch;
     private final Geometry.BooleanOp op;
-    private Geometry.State previousState;
 
     public CreateLoftCommand(Sketch sketch, Geometry.BooleanOp op) {
         this.sketch = sketch;
@@ -12,7 +11,7 @@ public class CreateLoftCommand implements Command {
 
     @Override
     public void execute() {
-        this.previousState = Geometry.captureState();
+        captureState();
         try {
             Geometry.loft(sketch, op);
         } catch (Exception e) {
@@ -20,13 +19,6 @@ public class CreateLoftCommand implements Command {
         }
     }
 
-    @Override
-    public void undo() {
-        if (previousState != null) {
-            Geometry.restoreState(previousState);
-        }
-    }
-
     @Override
     public String getDescription() {
         return "Loft (op=" + op + ")";
@@ -1,11 +1,10 @@
 package cad.core;
 
-public class CreateRevolveCommand implements Command {
+public class CreateRevolveCommand extends GeometryCommand {
     private final Sketch sketch;
     private final String axisName;
     private float angle;
     private final int steps;
-    private Geometry.State previousState;
 
     public CreateRevolveCommand(Sketch sketch, String axisName, float angle, int steps) {
         this.sketch = sketch;
@@ -24,7 +23,7 @@ public class CreateRevolveCommand implements Command {
 
     @Override
     public void execute() {
-        this.previousState = Geometry.captureState();
+        captureState();
         
         cad.math.Vector3d axisOrigin = cad.math.Vector3d.zero();
         cad.math.Vector3d axisDir = axisName.equals("X") ? cad.math.Vector3d.X_AXIS : cad.math.Vector3d.Y_AXIS;
@@ -47,10 +46,13 @@ public class CreateRevolveCommand implements Command {
     }
 
     @Override
-    public void undo() {
-        if (previousState != null) {
-            Geometry.restoreState(previousState);
+    public boolean mergeWith(Command next) {
+        if (next instanceof CreateRevolveCommand other && other.sketch == sketch
+                && other.axisName.equals(axisName) && other.steps == steps) {
+            angle = other.angle;
+            return true;
         }
+        return false;
     }
 
     @Override
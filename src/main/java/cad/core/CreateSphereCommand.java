@@ -1,10 +1,9 @@
 package cad.core;
 
-public class CreateSphereCommand implements Command {
+public class CreateSphereCommand extends GeometryCommand {
     private final float radius;
     private final int latDiv;
     private final int lonDiv;
-    private Geometry.State previousState;
 
     public CreateSphereCommand(float radius, int latDiv, int lonDiv) {
         this.radius = radius;
@@ -14,17 +13,10 @@ public class CreateSphereCommand implements Command {
 
     @Override
     public void execute() {
-        this.previousState = Geometry.captureState();
+        captureState();
         Geometry.createSphere(radius, latDiv, lonDiv);
     }
 
-    @Override
-    public void undo() {
-        if (previousState != null) {
-            Geometry.restoreState(previousState);
-        }
-    }
-
     @Override
     public String getDescription() {
         return "Create Sphere (r=" + radius + ")";
@@ -1,9 +1,8 @@
 package cad.core;
 
-public class CreateSweepCommand implements Command {
+public class CreateSweepCommand extends GeometryCommand {
     private final Sketch sketch;
     private final Geometry.BooleanOp op;
-    private Geometry.State previousState;
 
     public CreateSweepCommand(Sketch sketch, Geometry.BooleanOp op) {
         this.sketch = sketch;
@@ -12,7 +11,7 @@ public class CreateSweepCommand implements Command {
 
     @Override
     public void execute() {
-        this.previousState = Geometry.captureState();
+        captureState();
         try {
             Geometry.sweep(sketch, op);
         } catch (Exception e) {
@@ -22,13 +21,6 @@ public class CreateSweepCommand implements Command {
         }
     }
 
-    @Override
-    public void undo() {
-        if (previousState != null) {
-            Geometry.restoreState(previousState);
-        }
-    }
-
     @Override
     public String getDescription() {
         return "Sweep (op=" + op + ")";
@@ -0,0 +1,307 @@
+package cad.core;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+public class DxfWriter {
+
+    public static final int DEFAULT_BUFFER_SIZE = 1 << 20;
+    public static final int DEFAULT_PRECISION = 6;
+
+    private static final long[] POW10 = {
+            1L, 10L, 100L, 1000L, 10000L, 100000L, 1000000L, 10000000L, 100000000L, 1000000000L
+    };
+
+    private static final ThreadLocal<DxfWriter> WORKER_WRITERS = ThreadLocal.withInitial(DxfWriter::new);
+
+    private final byte[] buffer;
+    private final byte[] digits = new byte[20];
+    private final int precision;
+    // Values beyond this cannot be scaled into a long without overflow and are written in E notation
+    private final double maxFixed;
+    private OutputStream out;
+    private int pos;
+
+    public DxfWriter() {
+        this(DEFAULT_BUFFER_SIZE, DEFAULT_PRECISION);
+    }
+
+    public DxfWriter(int bufferSize, int precision) {
+        if (bufferSize < 64) {
+            throw new IllegalArgumentException("Buffer size must be at least 64 bytes");
+        }
+        if (precision < 0 || precision >= POW10.length) {
+            throw new IllegalArgumentException("Precision must be between 0 and " + (POW10.length - 1));
+        }
+        this.buffer = new byte[bufferSize];
+        this.precision = precision;
+        this.maxFixed = (double) (Long.MAX_VALUE / POW10[precision]);
+    }
+
+    public void write(Sketch sketch, String filename) throws IOException {
+        try (OutputStream fileOut = new FileOutputStream(filename)) {
+            write(sketch, fileOut);
+        }
+    }
+
+    public void write(Sketch sketch, OutputStream target) throws IOException {
+        this.out = target;
+        this.pos = 0;
+        try {
+            section("HEADER");
+            group(9, "$INSUNITS");
+            group(70, sketch.getUnitSystem().getDXFCode());
+            group(0, "ENDSEC");
+
+            section("ENTITIES");
+            for (Sketch.Entity e : sketch.getEntities()) {
+                writeEntity(e);
+            }
+            group(0, "ENDSEC");
+            group(0, "EOF");
+            flush();
+        } finally {
+            this.out = null;
+        }
+    }
+
+    private void writeEntity(Sketch.Entity e) throws IOException {
+        if (e instanceof Sketch.PointEntity p) {
+            entity("POINT");
+            group(10, p.getX());
+            group(20, p.getY());
+        } else if (e instanceof Sketch.Line l) {
+            entity("LINE");
+            group(10, l.getX1());
+            group(20, l.getY1());
+            group(11, l.getX2());
+            group(21, l.getY2());
+        } else if (e instanceof Sketch.Circle c) {
+            entity("CIRCLE");
+            group(10, c.getX());
+            group(20, c.getY());
+            group(40, c.getRadius());
+        } else if (e instanceof Sketch.Arc a) {
+            entity("ARC");
+            group(10, a.getX());
+            group(20, a.getY());
+            group(40, a.getRadius());
+            group(50, normalizeDegrees(a.getStartAngle()));
+            group(51, normalizeDegrees(a.getEndAngle()));
+        } else if (e instanceof Sketch.Polygon poly) {
+            List<Sketch.PointEntity> pts = poly.getSketchPoints();
+            entity("LWPOLYLINE");
+            group(90, pts.size());
+            group(70, 1);
+            for (Sketch.PointEntity p : pts) {
+                group(10, p.getX());
+                group(20, p.getY());
+            }
+        } else if (e instanceof Sketch.Spline s) {
+            writeSpline(s);
+        }
+    }
+
+    // Control points are written as a uniform B-spline of degree up to 3: clamped when open, and
+    // periodic when closed, with the first degree points repeated at the end so the curve wraps
+    // round smoothly. Sketch.loadDXF drops the repeated points again.
+    private void writeSpline(Sketch.Spline s) throws IOException {
+        List<Sketch.PointEntity> pts = s.getControlPoints();
+        int n = pts.size();
+        if (n < 2) {
+            return;
+        }
+        boolean periodic = s.isClosed() && n > 2;
+        int degree = Math.min(3, n - 1);
+        int count = periodic ? n + degree : n;
+        int knotCount = count + degree + 1;
+
+        entity("SPLINE");
+        // 8 planar, 1 closed, 2 periodic
+        group(70, periodic ? 11 : 8);
+        group(71, degree);
+        group(72, knotCount);
+        group(73, count);
+        for (int i = 0; i < knotCount; i++) {
+            double knot;
+            if (periodic) {
+                knot = (double) (i - degree) / n;
+            } else if (i <= degree) {
+                knot = 0.0;
+            } else if (i >= n) {
+                knot = 1.0;
+            } else {
+                knot = (double) (i - degree) / (n - degree);
+            }
+            group(40, knot);
+        }
+        for (int i = 0; i < count; i++) {
+            Sketch.PointEntity p = pts.get(i % n);
+            group(10, p.getX());
+            group(20, p.getY());
+            group(30, 0.0);
+        }
+    }
+
+    private static double normalizeDegrees(double deg) {
+        double d = deg % 360.0;
+        return d < 0 ? d + 360.0 : d;
+    }
+
+    private void section(String name) throws IOException {
+        group(0, "SECTION");
+        group(2, name);
+    }
+
+    private void entity(String type) throws IOException {
+        group(0, type);
+        group(8, "0");
+    }
+
+    private void group(int code, String value) throws IOException {
+        writeLong(code);
+        newline();
+        writeAscii(value);
+        newline();
+    }
+
+    private void group(int code, int value) throws IOException {
+        writeLong(code);
+        newline();
+        writeLong(value);
+        newline();
+    }
+
+    private void group(int code, double value) throws IOException {
+        writeLong(code);
+        newline();
+        writeDouble(value);
+        newline();
+    }
+
+    private void writeDouble(double v) throws IOException {
+        if (Double.isNaN(v) || Double.isInfinite(v)) {
+            writeAscii("0.0");
+            return;
+        }
+        if (Math.abs(v) >= maxFixed) {
+            writeAscii(Double.toString(v));
+            return;
+        }
+        boolean negative = v < 0;
+        long scale = POW10[precision];
+        long scaled = Math.round(Math.abs(v) * scale);
+        if (negative && scaled != 0) {
+            put((byte) '-');
+        }
+        writeLong(scaled / scale);
+        if (precision > 0) {
+            put((byte) '.');
+            long frac = scaled % scale;
+            for (long div = scale / 10; div > 0; div /= 10) {
+                put((byte) ('0' + (frac / div) % 10));
+            }
+        }
+    }
+
+    private void writeLong(long v) throws IOException {
+        if (v < 0) {
+            put((byte) '-');
+            v = -v;
+        }
+        int n = 0;
+        do {
+            digits[n++] = (byte) ('0' + (v % 10));
+            v /= 10;
+        } while (v > 0);
+        ensure(n);
+        while (n > 0) {
+            buffer[pos++] = digits[--n];
+        }
+    }
+
+    private void writeAscii(String s) throws IOException {
+        int len = s.length();
+        if (len > buffer.length) {
+            flush();
+            out.write(s.getBytes(StandardCharsets.US_ASCII));
+            return;
+        }
+        ensure(len);
+        for (int i = 0; i < len; i++) {
+            buffer[pos++] = (byte) s.charAt(i);
+        }
+    }
+
+    private void newline() throws IOException {
+        put((byte) '\n');
+    }
+
+    private void put(byte b) throws IOException {
+        if (pos == buffer.length) {
+            flush();
+        }
+        buffer[pos++] = b;
+    }
+
+    private void ensure(int n) throws IOException {
+        if (buffer.length - pos < n) {
+            flush();
+        }
+    }
+
+    private void flush() throws IOException {
+        if (pos > 0) {
+            out.write(buffer, 0, pos);
+            pos = 0;
+        }
+    }
+
+    public static void export(Sketch sketch, String filename) throws IOException {
+        WORKER_WRITERS.get().write(sketch, filename);
+    }
+
+    // Writes each sketch to the file at the same index, one reusable buffer per worker thread
+    public static List<String> exportAll(List<Sketch> sketches, List<String> filenames, int threads) {
+        if (sketches.size() != filenames.size()) {
+            throw new IllegalArgumentException("Sketch and filename counts differ: "
+                    + sketches.size() + " vs " + filenames.size());
+        }
+        int poolSize = Math.max(1, Math.min(threads, sketches.size()));
+        ExecutorService pool = Executors.newFixedThreadPool(poolSize);
+        List<Future<?>> futures = new ArrayList<>();
+        try {
+            for (int i = 0; i < sketches.size(); i++) {
+                Sketch sketch = sketches.get(i);
+                String filename = filenames.get(i);
+                futures.add(pool.submit(() -> {
+                    export(sketch, filename);
+                    return null;
+                }));
+            }
+
+            List<String> failures = new ArrayList<>();
+            for (int i = 0; i < futures.size(); i++) {
+                try {
+                    futures.get(i).get();
+                } catch (ExecutionException e) {
+                    failures.add(filenames.get(i) + ": " + e.getCause().getMessage());
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    failures.add(filenames.get(i) + ": interrupted");
+                }
+            }
+            return failures;
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+}
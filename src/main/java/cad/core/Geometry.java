@@ -1,5 +1,7 @@
 package cad.core;
 
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
 import java.io.FileWriter;
 import java.io.IOException;
 import java.io.PrintWriter;
@@ -7,12 +9,15 @@ import java.io.BufferedReader;
 import java.io.FileReader;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.concurrent.CancellationException;
 
 import com.jogamp.opengl.GL2;
 import com.jogamp.opengl.glu.GLU;
 import com.jogamp.opengl.glu.GLUquadric;
 
-import cad.gui.GuiFX;
+import cad.geometry.booleans.MeshBoolean;
+import cad.geometry.tessellation.BodyTessellator;
+import cad.geometry.tessellation.TessellationTolerance;
 
 import eu.mihosoft.jcsg.CSG;
 import eu.mihosoft.jcsg.Cube;
@@ -37,21 +42,25 @@ public class Geometry {
         NONE, UNION, DIFFERENCE, INTERSECTION
     }
 
-    private static Shape currShape = Shape.NONE;
-    private static Shape primitiveShapeType = Shape.NONE;
-    private static float param = 0.0f;
-    public static int cubeDivisions = 1;
-    public static int sphereLatDiv = 30;
-    public static int sphereLonDiv = 30;
+    // Zero divisions means the count is derived from the tessellation tolerance
+    public static final int AUTO_DIVISIONS = 0;
 
-    private static CSG currentCSG = null;
+    // The mesh boolean engine is opt-in (-Dcad.booleans=mesh) until it has a track record
+    private static final boolean MESH_BOOLEANS = "mesh".equalsIgnoreCase(System.getProperty("cad.booleans"));
 
-    private static List<float[]> extrudedTriangles = new ArrayList<>();
-
-    private static List<float[]> loadedStlTriangles = new ArrayList<>();
+    // All modeling state lives in the calling thread's ModelContext; see ModelContext.current
+    private static ModelContext model() {
+        return ModelContext.current();
+    }
 
-    // State Management for Undo/Redo
+    // State Management for Undo/Redo. Triangle lists are TriangleList snapshots that share unchanged
+    // chunks with the live model and with other states, so capture and restore copy no triangles.
+    // A state can be spilled to an UndoSpill, dropping its mesh from the heap until it is restored.
     public static class State {
+        // JCSG polygon with its vertex list and two Vector3d per vertex, roughly
+        private static final long POLYGON_BYTES = 96;
+        private static final long CSG_VERTEX_BYTES = 120;
+
         public Shape shape;
         public Shape primitiveType;
         public float param;
@@ -59,8 +68,11 @@ public class Geometry {
         public int sphereLat;
         public int sphereLon;
         public CSG csg;
-        public List<float[]> stlTriangles;
-        public List<float[]> extTriangles;
+        public TriangleList stlTriangles;
+        public TriangleList extTriangles;
+        private ModelContext context;
+        private UndoSpill spill;
+        private UndoSpill.Record record;
 
         public State(Shape s, Shape p, float pm, int cd, int sl, int slo, CSG c, List<float[]> stl, List<float[]> ext) {
             this.shape = s;
@@ -70,133 +82,302 @@ public class Geometry {
             this.sphereLat = sl;
             this.sphereLon = slo;
             this.csg = c;
-            this.stlTriangles = new ArrayList<>(stl);
-            this.extTriangles = new ArrayList<>(ext);
+            this.stlTriangles = TriangleList.copyOf(stl);
+            this.extTriangles = TriangleList.copyOf(ext);
+        }
+
+        // Heap bytes this state keeps alive beyond what the model it was captured from still
+        // references. Measured right after a command runs, that is the command's own undo cost.
+        public synchronized long getRetainedBytes() {
+            if (record != null || context == null) {
+                return 0;
+            }
+            long bytes = stlTriangles.exclusiveBytes(context.loadedStlTriangles, context.extrudedTriangles)
+                    + extTriangles.exclusiveBytes(context.loadedStlTriangles, context.extrudedTriangles);
+            if (csg != null && csg != context.currentCSG) {
+                for (Polygon polygon : csg.getPolygons()) {
+                    bytes += POLYGON_BYTES + CSG_VERTEX_BYTES * polygon.vertices.size();
+                }
+            }
+            return bytes;
+        }
+
+        public synchronized boolean isSpilled() {
+            return record != null;
+        }
+
+        // Writes the mesh and solid to the spill file and drops them; returns the bytes released
+        public synchronized long spill(UndoSpill store) {
+            if (record != null) {
+                return 0;
+            }
+            long released = getRetainedBytes();
+            try {
+                record = store.write(this::writeGeometry);
+            } catch (IOException e) {
+                System.err.println("Undo spill failed, keeping state in memory: " + e.getMessage());
+                return 0;
+            }
+            spill = store;
+            csg = null;
+            stlTriangles = null;
+            extTriangles = null;
+            return released;
+        }
+
+        // Frees the spilled record once the state can no longer be restored
+        public synchronized void discard() {
+            if (record != null) {
+                spill.release(record);
+                record = null;
+                spill = null;
+            }
+        }
+
+        // The state with its geometry in memory; a spilled state is read back into a new one and
+        // stays spilled itself
+        synchronized State loaded() throws IOException {
+            if (record == null) {
+                return this;
+            }
+            State copy = new State(shape, primitiveType, param, cubeDiv, sphereLat, sphereLon, null,
+                    new TriangleList(), new TriangleList());
+            spill.read(record, in -> {
+                copy.readGeometry(in);
+                return copy;
+            });
+            return copy;
+        }
+
+        // Floats and doubles are stored as raw bits XORed with the same slot of the previous
+        // triangle or vertex; neighbouring elements share coordinates, so the stream is mostly
+        // zero bytes and deflates well while staying lossless
+        private void writeGeometry(DataOutputStream out) throws IOException {
+            writeTriangles(out, stlTriangles);
+            writeTriangles(out, extTriangles);
+            out.writeBoolean(csg != null);
+            if (csg == null) {
+                return;
+            }
+            List<Polygon> polygons = csg.getPolygons();
+            out.writeInt(polygons.size());
+            long[] prev = new long[6];
+            for (Polygon polygon : polygons) {
+                out.writeInt(polygon.vertices.size());
+                for (Vertex v : polygon.vertices) {
+                    writeDeltas(out, prev, v.pos.getX(), v.pos.getY(), v.pos.getZ(),
+                            v.normal.getX(), v.normal.getY(), v.normal.getZ());
+                }
+            }
+        }
+
+        private void readGeometry(DataInputStream in) throws IOException {
+            readTriangles(in, stlTriangles);
+            readTriangles(in, extTriangles);
+            if (!in.readBoolean()) {
+                return;
+            }
+            int polygonCount = in.readInt();
+            List<Polygon> polygons = new ArrayList<>(polygonCount);
+            long[] prev = new long[6];
+            double[] values = new double[6];
+            for (int i = 0; i < polygonCount; i++) {
+                int vertexCount = in.readInt();
+                List<Vertex> vertices = new ArrayList<>(vertexCount);
+                for (int k = 0; k < vertexCount; k++) {
+                    readDeltas(in, prev, values);
+                    vertices.add(new Vertex(Vector3d.xyz(values[0], values[1], values[2]),
+                            Vector3d.xyz(values[3], values[4], values[5])));
+                }
+                polygons.add(new Polygon(vertices));
+            }
+            csg = CSG.fromPolygons(polygons);
+        }
+
+        private static void writeTriangles(DataOutputStream out, List<float[]> triangles) throws IOException {
+            out.writeInt(triangles.size());
+            int[] prev = new int[12];
+            for (float[] tri : triangles) {
+                for (int k = 0; k < 12; k++) {
+                    int bits = Float.floatToRawIntBits(tri[k]);
+                    out.writeInt(bits ^ prev[k]);
+                    prev[k] = bits;
+                }
+            }
+        }
+
+        private static void readTriangles(DataInputStream in, List<float[]> triangles) throws IOException {
+            int count = in.readInt();
+            int[] prev = new int[12];
+            for (int i = 0; i < count; i++) {
+                float[] tri = new float[12];
+                for (int k = 0; k < 12; k++) {
+                    prev[k] ^= in.readInt();
+                    tri[k] = Float.intBitsToFloat(prev[k]);
+                }
+                triangles.add(tri);
+            }
+        }
+
+        private static void writeDeltas(DataOutputStream out, long[] prev, double... values) throws IOException {
+            for (int k = 0; k < values.length; k++) {
+                long bits = Double.doubleToRawLongBits(values[k]);
+                out.writeLong(bits ^ prev[k]);
+                prev[k] = bits;
+            }
+        }
+
+        private static void readDeltas(DataInputStream in, long[] prev, double[] values) throws IOException {
+            for (int k = 0; k < values.length; k++) {
+                prev[k] ^= in.readLong();
+                values[k] = Double.longBitsToDouble(prev[k]);
+            }
         }
     }
 
     public static State captureState() {
-        return new State(currShape, primitiveShapeType, param, cubeDivisions, sphereLatDiv, sphereLonDiv, currentCSG,
-                loadedStlTriangles, extrudedTriangles);
+        ModelContext m = model();
+        State state = new State(m.currShape, m.primitiveShapeType, m.param, m.cubeDivisions, m.sphereLatDiv, m.sphereLonDiv,
+                m.currentCSG, m.loadedStlTriangles, m.extrudedTriangles);
+        state.context = m;
+        return state;
     }
 
     public static void restoreState(State state) {
-        currShape = state.shape;
-        primitiveShapeType = state.primitiveType;
-        param = state.param;
-        cubeDivisions = state.cubeDiv;
-        sphereLatDiv = state.sphereLat;
-        sphereLonDiv = state.sphereLon;
-        currentCSG = state.csg;
-        loadedStlTriangles = new ArrayList<>(state.stlTriangles);
-        extrudedTriangles = new ArrayList<>(state.extTriangles);
+        try {
+            state = state.loaded();
+        } catch (IOException e) {
+            throw new IllegalStateException("Could not reload undo state: " + e.getMessage(), e);
+        }
+        ModelContext m = model();
+        m.currShape = state.shape;
+        m.primitiveShapeType = state.primitiveType;
+        m.param = state.param;
+        m.cubeDivisions = state.cubeDiv;
+        m.sphereLatDiv = state.sphereLat;
+        m.sphereLonDiv = state.sphereLon;
+        m.currentCSG = state.csg;
+        m.loadedStlTriangles = TriangleList.copyOf(state.stlTriangles);
+        m.extrudedTriangles = TriangleList.copyOf(state.extTriangles);
         System.out.println("Geometry state restored.");
     }
 
     public static Shape getCurrentShape() {
-        return currShape;
+        return model().currShape;
     }
 
     public static Shape getPrimitiveShapeType() {
-        return primitiveShapeType;
+        return model().primitiveShapeType;
     }
 
     public static float getParam() {
-        return param;
+        return model().param;
     }
 
     public static int getCubeDivisions() {
-        return cubeDivisions;
+        return model().cubeDivisions;
+    }
+
+    public static void setCubeDivisions(int divisions) {
+        model().cubeDivisions = divisions;
+    }
+
+    public static int getSphereLatDiv() {
+        return model().sphereLatDiv;
+    }
+
+    public static int getSphereLonDiv() {
+        return model().sphereLonDiv;
+    }
+
+    public static void setSphereDivisions(int lat, int lon) {
+        ModelContext m = model();
+        m.sphereLatDiv = lat;
+        m.sphereLonDiv = lon;
     }
 
     public static List<float[]> getLoadedStlTriangles() {
-        return loadedStlTriangles;
+        return model().loadedStlTriangles;
     }
 
     public static List<float[]> getExtrudedTriangles() {
-        return extrudedTriangles;
+        return model().extrudedTriangles;
     }
 
     public static void setExtrudedTriangles(List<float[]> tris) {
-        extrudedTriangles.clear();
-        extrudedTriangles.addAll(tris);
+        model().extrudedTriangles.clear();
+        model().extrudedTriangles.addAll(tris);
     }
 
     public static List<float[]> convertBodyToTriangles(cad.topology.BRepBody body) {
-        List<float[]> triangles = new ArrayList<>();
-        if (body == null) return triangles;
-        for (cad.topology.Face face : body.getFaces()) {
-            List<cad.topology.Vertex> vertices = new ArrayList<>();
-            cad.topology.EdgeLoop outerLoop = face.getOuterLoop();
-            if (outerLoop != null) {
-                for (cad.topology.Edge edge : outerLoop.getEdges()) {
-                    if (!vertices.contains(edge.getStartVertex())) {
-                        vertices.add(edge.getStartVertex());
-                    }
-                }
+        if (body == null) return new ArrayList<>();
+        // Faces finish on pool threads, where the monitor is not bound; it counts them one at a time
+        OperationMonitor monitor = OperationMonitor.current();
+        monitor.begin("Tessellating faces", body.getFaces().size());
+        return BodyTessellator.tessellate(body, model().tessellationTolerance, () -> {
+            synchronized (monitor) {
+                monitor.step();
             }
-            if (vertices.size() >= 3) {
-                cad.math.Vector3d v0 = vertices.get(0).getPoint();
-                for (int i = 1; i < vertices.size() - 1; i++) {
-                    cad.math.Vector3d v1 = vertices.get(i).getPoint();
-                    cad.math.Vector3d v2 = vertices.get(i + 1).getPoint();
-                    cad.math.Vector3d normal = v1.subtract(v0).cross(v2.subtract(v0)).normalize();
-                    float[] tri = new float[12];
-                    tri[0] = (float)normal.getX();
-                    tri[1] = (float)normal.getY();
-                    tri[2] = (float)normal.getZ();
-                    tri[3] = (float)v0.getX();
-                    tri[4] = (float)v0.getY();
-                    tri[5] = (float)v0.getZ();
-                    tri[6] = (float)v1.getX();
-                    tri[7] = (float)v1.getY();
-                    tri[8] = (float)v1.getZ();
-                    tri[9] = (float)v2.getX();
-                    tri[10] = (float)v2.getY();
-                    tri[11] = (float)v2.getZ();
-                    triangles.add(tri);
-                }
-            }
-        }
-        return triangles;
+        }).toTriangles();
+    }
+
+    public static TessellationTolerance getTessellationTolerance() {
+        return model().tessellationTolerance;
+    }
+
+    public static void setTessellationTolerance(TessellationTolerance tolerance) {
+        model().tessellationTolerance = tolerance;
+    }
+
+    public static int circleSegments(double radius) {
+        return circleSegments(radius, model().tessellationTolerance);
+    }
+
+    public static int circleSegments(double radius, TessellationTolerance tolerance) {
+        return tolerance.segmentsForArc(radius, 2.0 * Math.PI);
+    }
+
+    private static int sphereLatSegments(float radius) {
+        ModelContext m = model();
+        return m.sphereLatDiv > 0 ? m.sphereLatDiv : m.tessellationTolerance.segmentsForArc(radius, Math.PI);
+    }
+
+    private static int sphereLonSegments(float radius) {
+        return model().sphereLonDiv > 0 ? model().sphereLonDiv : circleSegments(radius);
     }
 
     public static float getModelMaxDimension() {
-        List<float[]> trianglesToCheck = null;
+        ModelContext m = model();
+        return maxDimension(m.currShape, m.param, m.loadedStlTriangles, m.extrudedTriangles);
+    }
 
-        switch (currShape) {
+    static float maxDimension(Shape shape, float param, List<float[]> loadedStlTriangles,
+            List<float[]> extrudedTriangles) {
+        List<float[]> trianglesToCheck;
+        switch (shape) {
             case CUBE:
                 return param;
             case SPHERE:
                 return param * 2;
             case STL_LOADED:
-                if (!loadedStlTriangles.isEmpty()) {
-                    trianglesToCheck = loadedStlTriangles;
-                }
+                trianglesToCheck = loadedStlTriangles;
                 break;
             case EXTRUDED:
             case CSG_RESULT:
-                if (!extrudedTriangles.isEmpty()) {
-                    trianglesToCheck = extrudedTriangles;
-                }
+                trianglesToCheck = extrudedTriangles;
                 break;
             default:
                 return 2.0f;
         }
 
-        if (trianglesToCheck == null || trianglesToCheck.isEmpty()) {
+        if (trianglesToCheck.isEmpty()) {
             return 2.0f;
         }
 
-        List<float[]> trianglesCopy;
-        synchronized (trianglesToCheck) {
-            trianglesCopy = new ArrayList<>(trianglesToCheck);
-        }
-
         float minX = Float.MAX_VALUE, minY = Float.MAX_VALUE, minZ = Float.MAX_VALUE;
         float maxX = -Float.MAX_VALUE, maxY = -Float.MAX_VALUE, maxZ = -Float.MAX_VALUE;
 
-        for (float[] triData : trianglesCopy) {
+        for (float[] triData : trianglesToCheck) {
 
             for (int i = 0; i < 3; i++) {
                 float x = triData[3 + i * 3];
@@ -219,11 +400,15 @@ public class Geometry {
         return Math.max(Math.max(sizeX, sizeY), sizeZ);
     }
 
+    // Parses into a new list and only replaces the model's mesh once the whole file is read, so a
+    // cancelled or failed load leaves the current model as it was
     public static List<float[]> loadStl(String filename) throws IOException {
-        loadedStlTriangles.clear();
-        currShape = Shape.NONE;
+        ModelContext m = model();
+        OperationMonitor monitor = OperationMonitor.current();
+        TriangleList loaded = new TriangleList();
 
         System.out.println("Loading STL file: " + filename);
+        monitor.begin("Reading STL facets", 0);
 
         try (BufferedReader reader = new BufferedReader(new FileReader(filename))) {
             String line;
@@ -237,6 +422,7 @@ public class Geometry {
 
                 if (line.startsWith("facet normal")) {
                     facetCount++;
+                    monitor.step();
 
                     String[] parts = line.split("\\s+");
                     if (parts.length >= 5) {
@@ -307,7 +493,7 @@ public class Geometry {
                         float[] fullTriangleData = new float[12];
                         System.arraycopy(currentNormal, 0, fullTriangleData, 0, 3);
                         System.arraycopy(currentVertices, 0, fullTriangleData, 3, 9);
-                        loadedStlTriangles.add(fullTriangleData);
+                        loaded.add(fullTriangleData);
                     }
 
                     String endLoop = reader.readLine();
@@ -320,16 +506,16 @@ public class Geometry {
             }
 
             System.out.println("Finished reading STL. Facets processed: " + facetCount + ", Triangles loaded: "
-                    + loadedStlTriangles.size());
+                    + loaded.size());
             if (errorCount > 0) {
                 System.out.println("Warning: " + errorCount + " errors encountered during parsing");
             }
 
-            if (!loadedStlTriangles.isEmpty()) {
+            if (!loaded.isEmpty()) {
                 float minX = Float.MAX_VALUE, minY = Float.MAX_VALUE, minZ = Float.MAX_VALUE;
                 float maxX = -Float.MAX_VALUE, maxY = -Float.MAX_VALUE, maxZ = -Float.MAX_VALUE;
 
-                for (float[] triData : loadedStlTriangles) {
+                for (float[] triData : loaded) {
 
                     for (int i = 0; i < 3; i++) {
                         float x = triData[3 + i * 3];
@@ -359,20 +545,22 @@ public class Geometry {
                 System.out.println("  Center: (" + centerX + ", " + centerY + ", " + centerZ + ")");
                 System.out.println("  Max dimension: " + Math.max(Math.max(sizeX, sizeY), sizeZ));
 
-                centerModel(centerX, centerY, centerZ);
+                centerModel(loaded, centerX, centerY, centerZ);
                 System.out.println("Model centered at origin for proper rotation");
             }
 
-            currShape = Shape.STL_LOADED;
-            return loadedStlTriangles;
+            m.loadedStlTriangles = loaded;
+            m.currShape = Shape.STL_LOADED;
+            return loaded;
         } catch (NumberFormatException e) {
             throw new IOException("Error parsing numeric data in STL file: " + e.getMessage(), e);
         }
     }
 
-    private static void centerModel(float centerX, float centerY, float centerZ) {
+    // Only for freshly parsed triangles; meshes that may be shared with undo snapshots are never moved in place
+    private static void centerModel(List<float[]> triangles, float centerX, float centerY, float centerZ) {
 
-        for (float[] triData : loadedStlTriangles) {
+        for (float[] triData : triangles) {
 
             for (int i = 0; i < 3; i++) {
                 triData[3 + i * 3] -= centerX;
@@ -383,12 +571,13 @@ public class Geometry {
     }
 
     public static void createCube(float size, int divisions, BooleanOp op) {
+        ModelContext m = model();
         if (size < 0.1f || size > 100.0f) {
             throw new IllegalArgumentException("Cube size must be between 0.1 and 100.0");
         }
 
-        cubeDivisions = divisions;
-        param = size;
+        m.cubeDivisions = divisions;
+        m.param = size;
 
         CSG newShape;
         if (divisions > 1) {
@@ -396,7 +585,7 @@ public class Geometry {
             generateCubeTriangles(size, divisions);
             List<Polygon> polygons = new ArrayList<>();
 
-            for (float[] tri : loadedStlTriangles) {
+            for (float[] tri : m.loadedStlTriangles) {
 
                 Vector3d p1 = Vector3d.xyz(tri[3], tri[4], tri[5]);
                 Vector3d p2 = Vector3d.xyz(tri[6], tri[7], tri[8]);
@@ -414,8 +603,8 @@ public class Geometry {
 
         updateMeshFromCSG();
 
-        currShape = Shape.CSG_RESULT;
-        primitiveShapeType = Shape.CUBE;
+        m.currShape = Shape.CSG_RESULT;
+        m.primitiveShapeType = Shape.CUBE;
         System.out.println("Cube created with size " + size + ", divisions " + divisions + " Op: " + op);
     }
 
@@ -432,27 +621,29 @@ public class Geometry {
     }
 
     public static void createSphere(float radius, int latDiv, int lonDiv, BooleanOp op) {
+        ModelContext m = model();
         if (radius < 0.1f || radius > 80.0f) {
             throw new IllegalArgumentException("Sphere radius must be between 0.1 and 80.0");
         }
 
-        sphereLatDiv = latDiv;
-        sphereLonDiv = lonDiv;
-        param = radius;
+        m.sphereLatDiv = latDiv;
+        m.sphereLonDiv = lonDiv;
+        m.param = radius;
 
-        CSG newShape = new Sphere(radius, latDiv, lonDiv).toCSG();
+        CSG newShape = new Sphere(radius, sphereLatSegments(radius), sphereLonSegments(radius)).toCSG();
 
         applyBooleanOperation(newShape, op);
 
         updateMeshFromCSG();
 
-        currShape = Shape.CSG_RESULT;
-        primitiveShapeType = Shape.SPHERE;
+        m.currShape = Shape.CSG_RESULT;
+        m.primitiveShapeType = Shape.SPHERE;
         System.out.printf("Sphere created (JCSG) with radius %.2f Op: %s%n", radius, op);
     }
 
     private static void generateCubeTriangles(float size, int divisions) {
-        loadedStlTriangles.clear();
+        ModelContext m = model();
+        m.loadedStlTriangles.clear();
 
         float halfSize = size / 2.0f;
         float step = size / divisions;
@@ -578,39 +769,58 @@ public class Geometry {
                     System.arraycopy(p1, 0, tri1, 3, 3);
                     System.arraycopy(p2, 0, tri1, 6, 3);
                     System.arraycopy(p3, 0, tri1, 9, 3);
-                    loadedStlTriangles.add(tri1);
+                    m.loadedStlTriangles.add(tri1);
 
                     float[] tri2 = new float[12];
                     System.arraycopy(normal, 0, tri2, 0, 3);
                     System.arraycopy(p1, 0, tri2, 3, 3);
                     System.arraycopy(p3, 0, tri2, 6, 3);
                     System.arraycopy(p4, 0, tri2, 9, 3);
-                    loadedStlTriangles.add(tri2);
+                    m.loadedStlTriangles.add(tri2);
                 }
             }
         }
     }
 
     private static void applyBooleanOperation(CSG newShape, BooleanOp op) {
-        if (currentCSG == null || op == BooleanOp.NONE) {
-            currentCSG = newShape;
+        ModelContext m = model();
+        if (m.currentCSG == null || op == BooleanOp.NONE) {
+            m.currentCSG = newShape;
             return;
         }
 
-        switch (op) {
-            case UNION:
-                currentCSG = currentCSG.union(newShape);
-                break;
-            case DIFFERENCE:
-                currentCSG = currentCSG.difference(newShape);
-                break;
-            case INTERSECTION:
-                currentCSG = currentCSG.intersect(newShape);
-                break;
-            default:
-                currentCSG = newShape;
-                break;
+        // JCSG gives no progress, so the stage is indeterminate; the mesh engine reports its own stages
+        OperationMonitor.current().begin("Boolean " + op.name().toLowerCase(), 0);
+        m.currentCSG = combine(m.currentCSG, newShape, op);
+    }
+
+    // Runs a boolean with JCSG's BSP trees, or on the mesh engine in cad.geometry.booleans when
+    // started with -Dcad.booleans=mesh. Anything the mesh engine cannot handle falls back to JCSG.
+    // JCSG cannot be stepped, so it runs through the monitor's callOpaque and a cancel returns
+    // without waiting for it.
+    public static CSG combine(CSG first, CSG second, BooleanOp op) {
+        if (op == BooleanOp.NONE) {
+            return second;
         }
+        if (MESH_BOOLEANS) {
+            try {
+                return MeshBoolean.apply(first, second, MeshBoolean.Operation.valueOf(op.name()));
+            } catch (CancellationException e) {
+                throw e;
+            } catch (RuntimeException e) {
+                System.out.println("Mesh boolean failed (" + e + "), using JCSG instead.");
+            }
+        }
+        return OperationMonitor.current().callOpaque(() -> {
+            switch (op) {
+                case UNION:
+                    return first.union(second);
+                case DIFFERENCE:
+                    return first.difference(second);
+                default:
+                    return first.intersect(second);
+            }
+        });
     }
 
     public static void extrude(cad.core.Sketch sketch, float height, BooleanOp op) {
@@ -619,9 +829,34 @@ public class Geometry {
             return;
         }
 
+        CSG sketchCSG = extrudeSolid(sketch, height);
+        if (sketchCSG == null) {
+            System.out.println("No valid extrudable entities found in sketch.");
+            return;
+        }
+
+        applyBooleanOperation(sketchCSG, op);
+
+        updateMeshFromCSG();
+
+        model().currShape = Shape.CSG_RESULT;
+        System.out.printf("Extrusion performed (Height: %.2f, Op: %s)%n", height, op);
+    }
+
+    // The solid builders below only read their arguments and the tessellation tolerance. The overloads
+    // that take the tolerance touch no model at all, so feature tree nodes can evaluate them on worker
+    // threads where no context is bound.
+    public static CSG extrudeSolid(cad.core.Sketch sketch, float height) {
+        return extrudeSolid(sketch, height, model().tessellationTolerance);
+    }
+
+    public static CSG extrudeSolid(cad.core.Sketch sketch, float height, TessellationTolerance tolerance) {
         CSG sketchCSG = null;
+        OperationMonitor monitor = OperationMonitor.current();
+        monitor.begin("Extruding sketch entities", sketch.getEntities().size());
 
         for (cad.core.Sketch.Entity entity : sketch.getEntities()) {
+            monitor.step();
             CSG entityCSG = null;
 
             if (entity instanceof cad.core.Sketch.Polygon) {
@@ -640,33 +875,29 @@ public class Geometry {
                         Vector3d.xyz(circle.getX(), circle.getY(), 0),
                         Vector3d.xyz(circle.getX(), circle.getY(), height),
                         circle.getRadius(),
-                        32).toCSG();
+                        circleSegments(circle.getRadius(), tolerance)).toCSG();
             }
 
             if (entityCSG != null) {
                 if (sketchCSG == null) {
                     sketchCSG = entityCSG;
                 } else {
-                    sketchCSG = sketchCSG.union(entityCSG);
+                    sketchCSG = combine(sketchCSG, entityCSG, BooleanOp.UNION);
                 }
             }
         }
+        return sketchCSG;
+    }
 
-        if (sketchCSG == null) {
-            System.out.println("No valid extrudable entities found in sketch.");
-            return;
-        }
-
-        applyBooleanOperation(sketchCSG, op);
-
+    // Replaces the current model with a solid computed elsewhere, such as a feature tree result
+    public static void setCurrentSolid(CSG solid) {
+        model().currentCSG = solid;
         updateMeshFromCSG();
-
-        currShape = Shape.CSG_RESULT;
-        System.out.printf("Extrusion performed (Height: %.2f, Op: %s)%n", height, op);
+        model().currShape = solid != null ? Shape.CSG_RESULT : Shape.NONE;
     }
 
     public static void revolve(cad.core.Sketch sketch, String axisName, float angle, BooleanOp op) {
-        revolve(sketch, axisName, angle, 32, op);
+        revolve(sketch, axisName, angle, revolveSteps(sketch, axisName, angle, model().tessellationTolerance), op);
     }
 
     public static void revolve(cad.core.Sketch sketch, String axisName, float angle, int steps, BooleanOp op) {
@@ -675,9 +906,38 @@ public class Geometry {
             return;
         }
 
+        CSG revolveCSG = revolveSolid(sketch, axisName, angle, steps, model().tessellationTolerance);
+        if (revolveCSG == null)
+            return;
+
+        applyBooleanOperation(revolveCSG, op);
+
+        updateMeshFromCSG();
+
+        model().currShape = Shape.CSG_RESULT;
+        System.out.println("Revolve performed.");
+    }
+
+    public static CSG revolveSolid(cad.core.Sketch sketch, String axisName, float angle) {
+        return revolveSolid(sketch, axisName, angle, model().tessellationTolerance);
+    }
+
+    public static CSG revolveSolid(cad.core.Sketch sketch, String axisName, float angle,
+            TessellationTolerance tolerance) {
+        return revolveSolid(sketch, axisName, angle, revolveSteps(sketch, axisName, angle, tolerance), tolerance);
+    }
+
+    public static CSG revolveSolid(cad.core.Sketch sketch, String axisName, float angle, int steps) {
+        return revolveSolid(sketch, axisName, angle, steps, model().tessellationTolerance);
+    }
+
+    public static CSG revolveSolid(cad.core.Sketch sketch, String axisName, float angle, int steps,
+            TessellationTolerance tolerance) {
         List<Polygon> allPolygons = new ArrayList<>();
         double angleRad = Math.toRadians(angle);
         double stepAngle = angleRad / steps;
+        OperationMonitor monitor = OperationMonitor.current();
+        monitor.begin("Revolving profiles", (long) steps * sketch.getEntities().size());
 
         for (cad.core.Sketch.Entity entity : sketch.getEntities()) {
             List<Vector3d> profilePoints = new ArrayList<>();
@@ -689,7 +949,7 @@ public class Geometry {
             } else if (entity instanceof cad.core.Sketch.Circle) {
 
                 cad.core.Sketch.Circle c = (cad.core.Sketch.Circle) entity;
-                int circleSteps = 16;
+                int circleSteps = circleSegments(c.getRadius(), tolerance);
                 for (int i = 0; i < circleSteps; i++) {
                     double a = 2 * Math.PI * i / circleSteps;
                     profilePoints.add(Vector3d.xyz(
@@ -705,6 +965,7 @@ public class Geometry {
                 continue;
 
             for (int i = 0; i < steps; i++) {
+                monitor.step();
                 double theta1 = i * stepAngle;
                 double theta2 = (i + 1) * stepAngle;
 
@@ -729,16 +990,27 @@ public class Geometry {
         }
 
         if (allPolygons.isEmpty())
-            return;
-
-        CSG revolveCSG = CSG.fromPolygons(allPolygons);
-
-        applyBooleanOperation(revolveCSG, op);
+            return null;
 
-        updateMeshFromCSG();
+        return CSG.fromPolygons(allPolygons);
+    }
 
-        currShape = Shape.CSG_RESULT;
-        System.out.println("Revolve performed.");
+    // Sweep steps so the outermost profile point stays within the chordal tolerance
+    private static int revolveSteps(cad.core.Sketch sketch, String axisName, float angle,
+            TessellationTolerance tolerance) {
+        boolean aroundX = axisName.equalsIgnoreCase("x");
+        double maxRadius = 0.0;
+        for (cad.core.Sketch.Entity entity : sketch.getEntities()) {
+            if (entity instanceof cad.core.Sketch.Polygon poly) {
+                for (cad.core.Sketch.PointEntity p : poly.getSketchPoints()) {
+                    maxRadius = Math.max(maxRadius, Math.abs(aroundX ? p.getY() : p.getX()));
+                }
+            } else if (entity instanceof cad.core.Sketch.Circle c) {
+                double centre = Math.abs(aroundX ? c.getY() : c.getX());
+                maxRadius = Math.max(maxRadius, centre + c.getRadius());
+            }
+        }
+        return tolerance.segmentsForArc(maxRadius, Math.toRadians(angle));
     }
 
     private static Vector3d rotate(Vector3d p, String axis, double theta) {
@@ -773,15 +1045,22 @@ public class Geometry {
         return new float[] { nx, ny, nz };
     }
 
+    // Builds the new mesh aside and swaps it in whole, so a renderer holding the previous list never
+    // sees a half-built one
     private static void updateMeshFromCSG() {
-        if (currentCSG == null) {
-            extrudedTriangles.clear();
+        ModelContext m = model();
+        if (m.currentCSG == null) {
+            m.extrudedTriangles = new TriangleList();
             return;
         }
 
-        extrudedTriangles.clear();
+        OperationMonitor monitor = OperationMonitor.current();
+        List<Polygon> polygons = m.currentCSG.getPolygons();
+        monitor.begin("Triangulating solid", polygons.size());
+        TriangleList mesh = new TriangleList();
 
-        for (Polygon p : currentCSG.getPolygons()) {
+        for (Polygon p : polygons) {
+            monitor.step();
             List<Vertex> vertices = p.vertices;
             if (vertices.size() >= 3) {
 
@@ -806,35 +1085,38 @@ public class Geometry {
                     tri[10] = (float) v2.getY();
                     tri[11] = (float) v2.getZ();
 
-                    extrudedTriangles.add(tri);
+                    mesh.add(tri);
                 }
             }
         }
+        m.extrudedTriangles = mesh;
     }
 
     public static void performBoolean(String operation, CSG other) {
-        if (currentCSG == null || other == null)
+        ModelContext m = model();
+        if (m.currentCSG == null || other == null)
             return;
 
         switch (operation.toLowerCase()) {
             case "union":
-                currentCSG = currentCSG.union(other);
+                m.currentCSG = combine(m.currentCSG, other, BooleanOp.UNION);
                 break;
             case "difference":
-                currentCSG = currentCSG.difference(other);
+                m.currentCSG = combine(m.currentCSG, other, BooleanOp.DIFFERENCE);
                 break;
             case "intersection":
-                currentCSG = currentCSG.intersect(other);
+                m.currentCSG = combine(m.currentCSG, other, BooleanOp.INTERSECTION);
                 break;
         }
         updateMeshFromCSG();
     }
 
     public static void saveStl(String filename) throws IOException {
+        ModelContext m = model();
+        Sketch sketch = m.getSketch();
+        boolean hasExtrudedGeometry = sketch != null && !sketch.extrudedFaces.isEmpty();
 
-        boolean hasExtrudedGeometry = GuiFX.sketch != null && !GuiFX.sketch.extrudedFaces.isEmpty();
-
-        if (currShape == Shape.NONE && !hasExtrudedGeometry) {
+        if (m.currShape == Shape.NONE && !hasExtrudedGeometry) {
             System.out.println("No shape created yet");
             return;
         }
@@ -844,14 +1126,16 @@ public class Geometry {
 
             if (hasExtrudedGeometry) {
 
-                writeExtrudedSketchToStl(out, GuiFX.sketch);
-            } else if (currShape == Shape.CUBE) {
-                generateCubeStl(out, param, cubeDivisions);
-            } else if (currShape == Shape.SPHERE) {
-                generateSphereStl(out, param, sphereLatDiv, sphereLonDiv);
-            } else if (currShape == Shape.STL_LOADED && !loadedStlTriangles.isEmpty()) {
+                writeExtrudedSketchToStl(out, sketch);
+            } else if (m.currShape == Shape.CUBE) {
+                generateCubeStl(out, m.param, m.cubeDivisions);
+            } else if (m.currShape == Shape.SPHERE) {
+                generateSphereStl(out, m.param, sphereLatSegments(m.param), sphereLonSegments(m.param));
+            } else if (m.currShape == Shape.STL_LOADED && !m.loadedStlTriangles.isEmpty()) {
 
-                writeLoadedStlTriangles(out);
+                writeTriangles(out, m.loadedStlTriangles);
+            } else if (m.currShape == Shape.CSG_RESULT || m.currShape == Shape.EXTRUDED) {
+                writeTriangles(out, m.extrudedTriangles);
             }
 
             out.println("endsolid shape");
@@ -860,8 +1144,8 @@ public class Geometry {
         System.out.println("Saved STL file: " + filename);
     }
 
-    private static void writeLoadedStlTriangles(PrintWriter out) {
-        for (float[] triData : loadedStlTriangles) {
+    private static void writeTriangles(PrintWriter out, List<float[]> triangles) {
+        for (float[] triData : triangles) {
 
             writeTriangle(out,
                     triData[0], triData[1], triData[2],
@@ -1061,22 +1345,28 @@ public class Geometry {
         writeTriangle(out, nx, ny, nz, ax, ay, az, bx, by, bz, cx, cy, cz);
     }
 
+    // Draws the last published state, so the GL thread never reads the model while it changes
     public static void drawCurrentShape(GL2 gl) {
-        System.out.println("drawCurrentShape called with shape: " + currShape);
-        switch (currShape) {
+        drawShape(gl, model().snapshot());
+    }
+
+    public static void drawShape(GL2 gl, ModelSnapshot snapshot) {
+        float param = snapshot.getParam();
+        System.out.println("drawCurrentShape called with shape: " + snapshot.getShape());
+        switch (snapshot.getShape()) {
             case CUBE:
                 if (param > 0) {
-                    drawCube(gl, param, cubeDivisions);
+                    drawCube(gl, param, snapshot.getCubeDivisions());
                 }
                 break;
             case SPHERE:
                 if (param > 0) {
-                    drawSphere(gl, param, sphereLatDiv, sphereLonDiv);
+                    drawSphere(gl, param, sphereLatSegments(param), sphereLonSegments(param));
                 }
                 break;
             case STL_LOADED:
                 System.out.println("About to call drawLoadedStl");
-                drawLoadedStl(gl);
+                drawLoadedStl(gl, snapshot.getLoadedStlTriangles());
                 break;
 
             case NONE:
@@ -1142,14 +1432,18 @@ public class Geometry {
     }
 
     public static void drawLoadedStl(GL2 gl) {
-        System.out.println("drawLoadedStl called. Triangle count: " + loadedStlTriangles.size());
-        if (loadedStlTriangles.isEmpty()) {
+        drawLoadedStl(gl, model().loadedStlTriangles);
+    }
+
+    public static void drawLoadedStl(GL2 gl, List<float[]> triangles) {
+        System.out.println("drawLoadedStl called. Triangle count: " + triangles.size());
+        if (triangles.isEmpty()) {
             System.out.println("No triangles to draw - returning early");
             return;
         }
 
         gl.glBegin(GL2.GL_TRIANGLES);
-        for (float[] triData : loadedStlTriangles) {
+        for (float[] triData : triangles) {
 
             gl.glNormal3f(triData[0], triData[1], triData[2]);
 
@@ -1158,10 +1452,11 @@ public class Geometry {
             gl.glVertex3f(triData[9], triData[10], triData[11]);
         }
         gl.glEnd();
-        System.out.println("Finished drawing " + loadedStlTriangles.size() + " triangles");
+        System.out.println("Finished drawing " + triangles.size() + " triangles");
     }
 
     public static float[] calculateCentroid() {
+        ModelContext m = model();
         double totalVolume = 0;
         double momentX = 0;
         double momentY = 0;
@@ -1169,10 +1464,10 @@ public class Geometry {
 
         List<float[]> triangles = new ArrayList<>();
 
-        if (!loadedStlTriangles.isEmpty())
-            triangles.addAll(loadedStlTriangles);
-        if (!extrudedTriangles.isEmpty())
-            triangles.addAll(extrudedTriangles);
+        if (!m.loadedStlTriangles.isEmpty())
+            triangles.addAll(m.loadedStlTriangles);
+        if (!m.extrudedTriangles.isEmpty())
+            triangles.addAll(m.extrudedTriangles);
 
         for (float[] tri : triangles) {
 
@@ -1206,7 +1501,7 @@ public class Geometry {
     }
 
     public static void revolve(Sketch sketch, float angleDegrees, int steps) {
-        extrudedTriangles.clear();
+        model().extrudedTriangles.clear();
 
         List<Sketch.Polygon> polygons = sketch.getPolygons();
         if (polygons.isEmpty()) {
@@ -1276,9 +1571,9 @@ public class Geometry {
         jcsgPolygons.add(new Polygon(topCap));
 
         if (!jcsgPolygons.isEmpty()) {
-            currentCSG = CSG.fromPolygons(jcsgPolygons);
+            model().currentCSG = CSG.fromPolygons(jcsgPolygons);
             updateMeshFromCSG();
-            currShape = Shape.CSG_RESULT;
+            model().currShape = Shape.CSG_RESULT;
             System.out.println("Loft performed (JCSG).");
         }
     }
@@ -1362,15 +1657,18 @@ public class Geometry {
         }
 
         if (!jcsgPolygons.isEmpty()) {
-            currentCSG = CSG.fromPolygons(jcsgPolygons);
+            model().currentCSG = CSG.fromPolygons(jcsgPolygons);
             updateMeshFromCSG();
-            currShape = Shape.CSG_RESULT;
+            model().currShape = Shape.CSG_RESULT;
             System.out.println("Sweep performed (JCSG) along path.");
         }
     }
 
     public static float calculateSurfaceArea() {
-        List<float[]> trianglesToCheck = getActiveTriangles();
+        return calculateSurfaceArea(getActiveTriangles());
+    }
+
+    public static float calculateSurfaceArea(List<float[]> trianglesToCheck) {
         if (trianglesToCheck == null || trianglesToCheck.isEmpty()) {
             return 0.0f;
         }
@@ -1395,7 +1693,11 @@ public class Geometry {
     }
 
     public static float calculateVolume() {
-        List<float[]> trianglesToCheck = getActiveTriangles();
+        return calculateVolume(getActiveTriangles());
+    }
+
+    // Signed-tetrahedron sum over a closed mesh in the triangle layout used throughout (normal, v1, v2, v3)
+    public static float calculateVolume(List<float[]> trianglesToCheck) {
         if (trianglesToCheck == null || trianglesToCheck.isEmpty()) {
             return 0.0f;
         }
@@ -1421,37 +1723,12 @@ public class Geometry {
     }
 
     public static void extrudeCut(cad.core.Sketch sketch, float depth) {
-        if (currentCSG == null) {
+        if (model().currentCSG == null) {
             System.out.println("No target body to cut from.");
             return;
         }
 
-        CSG toolCSG = null;
-        for (cad.core.Sketch.Entity entity : sketch.getEntities()) {
-            CSG entityCSG = null;
-            if (entity instanceof cad.core.Sketch.Polygon) {
-                cad.core.Sketch.Polygon poly = (cad.core.Sketch.Polygon) entity;
-                List<Vector3d> points = new ArrayList<>();
-                for (cad.core.Sketch.PointEntity p : poly.getSketchPoints()) {
-                    points.add(Vector3d.xyz(p.getX(), p.getY(), 0));
-                }
-                entityCSG = Extrude.points(Vector3d.xyz(0, 0, depth), points);
-            } else if (entity instanceof cad.core.Sketch.Circle) {
-                cad.core.Sketch.Circle circle = (cad.core.Sketch.Circle) entity;
-                entityCSG = new eu.mihosoft.jcsg.Cylinder(
-                        Vector3d.xyz(circle.getX(), circle.getY(), 0),
-                        Vector3d.xyz(circle.getX(), circle.getY(), depth),
-                        circle.getRadius(), 32).toCSG();
-            }
-
-            if (entityCSG != null) {
-                if (toolCSG == null)
-                    toolCSG = entityCSG;
-                else
-                    toolCSG = toolCSG.union(entityCSG);
-            }
-        }
-
+        CSG toolCSG = extrudeSolid(sketch, depth);
         if (toolCSG == null)
             return;
 
@@ -1461,10 +1738,11 @@ public class Geometry {
     }
 
     public static void shell(float thickness) {
-        if (currentCSG == null)
+        ModelContext m = model();
+        if (m.currentCSG == null)
             return;
 
-        List<Polygon> oldPolygons = currentCSG.getPolygons();
+        List<Polygon> oldPolygons = m.currentCSG.getPolygons();
         List<Polygon> shellPolygons = new ArrayList<>();
 
         for (Polygon p : oldPolygons) {
@@ -1484,26 +1762,35 @@ public class Geometry {
         }
 
         if (!shellPolygons.isEmpty()) {
-            currentCSG = CSG.fromPolygons(shellPolygons);
+            m.currentCSG = CSG.fromPolygons(shellPolygons);
             updateMeshFromCSG();
-            currShape = Shape.CSG_RESULT;
+            m.currShape = Shape.CSG_RESULT;
             System.out.println("Shell performed (JCSG) (Thickness: " + thickness + ")");
         }
     }
 
     private static List<float[]> getActiveTriangles() {
-        if (currShape == Shape.STL_LOADED) {
-            return loadedStlTriangles;
-        } else if (currShape == Shape.EXTRUDED || currShape == Shape.CSG_RESULT) {
-            return extrudedTriangles;
-        } else if (currShape == Shape.CUBE || currShape == Shape.SPHERE) {
-            return loadedStlTriangles;
+        ModelContext m = model();
+        if (m.currShape == Shape.STL_LOADED) {
+            return m.loadedStlTriangles;
+        } else if (m.currShape == Shape.EXTRUDED || m.currShape == Shape.CSG_RESULT) {
+            return m.extrudedTriangles;
+        } else if (m.currShape == Shape.CUBE || m.currShape == Shape.SPHERE) {
+            return m.loadedStlTriangles;
         }
         return new ArrayList<>();
     }
 
     public static float[] pickFace(float[] rayOrigin, float[] rayDir) {
-        List<float[]> triangles = getActiveTriangles();
+        return pickFace(getActiveTriangles(), rayOrigin, rayDir);
+    }
+
+    // Picking from the UI thread works on a published snapshot
+    public static float[] pickFace(ModelSnapshot snapshot, float[] rayOrigin, float[] rayDir) {
+        return pickFace(snapshot.getActiveTriangles(), rayOrigin, rayDir);
+    }
+
+    private static float[] pickFace(List<float[]> triangles, float[] rayOrigin, float[] rayDir) {
         if (triangles == null || triangles.isEmpty())
             return null;
 
@@ -1526,7 +1813,14 @@ public class Geometry {
     }
 
     public static float[] pickEdge(float[] rayOrigin, float[] rayDir) {
-        float[] closestTri = pickFace(rayOrigin, rayDir);
+        return edgeNearHit(pickFace(rayOrigin, rayDir), rayOrigin, rayDir);
+    }
+
+    public static float[] pickEdge(ModelSnapshot snapshot, float[] rayOrigin, float[] rayDir) {
+        return edgeNearHit(pickFace(snapshot, rayOrigin, rayDir), rayOrigin, rayDir);
+    }
+
+    private static float[] edgeNearHit(float[] closestTri, float[] rayOrigin, float[] rayDir) {
         if (closestTri == null)
             return null;
 
@@ -1585,9 +1879,25 @@ public class Geometry {
     }
 
     public static void filletEdge(float[] edgePoints, float radius) {
-        if (currentCSG == null || edgePoints == null || edgePoints.length < 6)
+        ModelContext m = model();
+        if (m.currentCSG == null || edgePoints == null || edgePoints.length < 6)
             return;
 
+        CSG newCSG = combine(m.currentCSG, filletCutter(edgePoints, radius), BooleanOp.DIFFERENCE);
+
+        m.currentCSG = newCSG;
+        updateMeshFromCSG();
+        m.currShape = Shape.CSG_RESULT;
+
+        System.out.println("Fillet applied (Approximation).");
+    }
+
+    // Material to remove along the edge for an approximate fillet of the given radius
+    public static CSG filletCutter(float[] edgePoints, float radius) {
+        return filletCutter(edgePoints, radius, model().tessellationTolerance);
+    }
+
+    public static CSG filletCutter(float[] edgePoints, float radius, TessellationTolerance tolerance) {
         Vector3d p1 = Vector3d.xyz(edgePoints[0], edgePoints[1], edgePoints[2]);
         Vector3d p2 = Vector3d.xyz(edgePoints[3], edgePoints[4], edgePoints[5]);
 
@@ -1595,11 +1905,11 @@ public class Geometry {
         double length = edgeVec.magnitude();
 
         CSG box = new Cube(radius * 2, radius * 2, length + 2.0).toCSG(); // slightly longer
-        CSG cyl = new eu.mihosoft.jcsg.Cylinder(radius, length + 4.0, 32).toCSG();
+        CSG cyl = new eu.mihosoft.jcsg.Cylinder(radius, length + 4.0, circleSegments(radius, tolerance)).toCSG();
 
         cyl = cyl.transformed(eu.mihosoft.vvecmath.Transform.unity().translateX(radius).translateY(radius));
 
-        CSG cutter = box.difference(cyl);
+        CSG cutter = combine(box, cyl, BooleanOp.DIFFERENCE);
 
         Vector3d zAxis = Vector3d.z(1);
         Vector3d axis = zAxis.crossed(edgeVec).normalized();
@@ -1614,13 +1924,7 @@ public class Geometry {
         cutter = cutter.transformed(eu.mihosoft.vvecmath.Transform.unity()
                 .translate(midPoint.getX() - radius, midPoint.getY() - radius, midPoint.getZ() - length / 2));
 
-        CSG newCSG = currentCSG.difference(cutter);
-
-        currentCSG = newCSG;
-        updateMeshFromCSG();
-        currShape = Shape.CSG_RESULT;
-
-        System.out.println("Fillet applied (Approximation).");
+        return cutter;
     }
 
     private static Float intersectRayTriangle(float[] rayOrigin, float[] rayVector,
@@ -1696,8 +2000,8 @@ public class Geometry {
     }
 
     public static void sweep(cad.core.Sketch profileSketch, cad.core.Sketch pathSketch, BooleanOp op) {
-        List<Vector3d> pathPoints = extractPathPoints(pathSketch);
-        List<Vector3d> baseProfile = extractProfilePoints(profileSketch);
+        List<Vector3d> pathPoints = extractPathPoints(pathSketch, model().tessellationTolerance);
+        List<Vector3d> baseProfile = extractProfilePoints(profileSketch, model().tessellationTolerance);
         sweepInternal(baseProfile, pathPoints, op);
     }
 
@@ -1712,12 +2016,12 @@ public class Geometry {
             if (e instanceof cad.core.Sketch.Polygon || e instanceof cad.core.Sketch.Circle) {
 
                 if (baseProfile == null) {
-                    baseProfile = extractPointsFromEntity(e);
+                    baseProfile = extractPointsFromEntity(e, model().tessellationTolerance);
                 }
             } else if (e instanceof cad.core.Sketch.Line || e instanceof cad.core.Sketch.Spline) {
 
                 if (pathPoints == null) {
-                    pathPoints = extractPointsFromEntity(e);
+                    pathPoints = extractPointsFromEntity(e, model().tessellationTolerance);
                 }
             }
         }
@@ -1736,6 +2040,26 @@ public class Geometry {
             return;
         }
 
+        loftInternal(sweepSections(baseProfile, pathPoints), op, true);
+        System.out.println("Sweep operation completed.");
+    }
+
+    // Null when the profile or path is degenerate
+    public static CSG sweepSolid(cad.core.Sketch profileSketch, cad.core.Sketch pathSketch) {
+        return sweepSolid(profileSketch, pathSketch, model().tessellationTolerance);
+    }
+
+    public static CSG sweepSolid(cad.core.Sketch profileSketch, cad.core.Sketch pathSketch,
+            TessellationTolerance tolerance) {
+        List<Vector3d> baseProfile = extractProfilePoints(profileSketch, tolerance);
+        List<Vector3d> pathPoints = extractPathPoints(pathSketch, tolerance);
+        if (baseProfile.size() < 3 || pathPoints.size() < 2) {
+            return null;
+        }
+        return loftSolid(sweepSections(baseProfile, pathPoints), true);
+    }
+
+    private static List<List<Vector3d>> sweepSections(List<Vector3d> baseProfile, List<Vector3d> pathPoints) {
         List<List<Vector3d>> sections = new ArrayList<>();
         Vector3d pathStart = pathPoints.get(0);
 
@@ -1748,16 +2072,14 @@ public class Geometry {
             }
             sections.add(section);
         }
-
-        loftInternal(sections, op, true);
-        System.out.println("Sweep operation completed.");
+        return sections;
     }
 
     public static void loft(List<cad.core.Sketch> profiles, BooleanOp op) {
         List<List<Vector3d>> sections = new ArrayList<>();
         if (profiles != null) {
             for (cad.core.Sketch s : profiles) {
-                List<Vector3d> p = extractProfilePoints(s);
+                List<Vector3d> p = extractProfilePoints(s, model().tessellationTolerance);
                 if (!p.isEmpty())
                     sections.add(p);
             }
@@ -1770,7 +2092,7 @@ public class Geometry {
             return;
         List<List<Vector3d>> sections = new ArrayList<>();
         for (cad.core.Sketch.Entity e : sketch.getEntities()) {
-            List<Vector3d> p = extractPointsFromEntity(e);
+            List<Vector3d> p = extractPointsFromEntity(e, model().tessellationTolerance);
             if (p != null && !p.isEmpty()
                     && (e instanceof cad.core.Sketch.Polygon || e instanceof cad.core.Sketch.Circle)) {
                 sections.add(p);
@@ -1792,6 +2114,28 @@ public class Geometry {
         if (sections.size() < 2)
             return;
 
+        CSG newShape = loftSolid(sections, caps);
+        applyBooleanOperation(newShape, op);
+        updateMeshFromCSG();
+        model().currShape = Shape.CSG_RESULT;
+    }
+
+    // One profile per sketch, each sketch contributing its polygons and circles
+    public static CSG loftSolid(List<cad.core.Sketch> profiles) {
+        return loftSolid(profiles, model().tessellationTolerance);
+    }
+
+    public static CSG loftSolid(List<cad.core.Sketch> profiles, TessellationTolerance tolerance) {
+        List<List<Vector3d>> sections = new ArrayList<>();
+        for (cad.core.Sketch s : profiles) {
+            List<Vector3d> p = extractProfilePoints(s, tolerance);
+            if (!p.isEmpty())
+                sections.add(p);
+        }
+        return sections.size() < 2 ? null : loftSolid(sections, true);
+    }
+
+    private static CSG loftSolid(List<List<Vector3d>> sections, boolean caps) {
         List<Polygon> polygons = new ArrayList<>();
 
         for (int i = 0; i < sections.size() - 1; i++) {
@@ -1818,13 +2162,10 @@ public class Geometry {
             polygons.add(Polygon.fromPoints(endCap));
         }
 
-        CSG newShape = CSG.fromPolygons(polygons);
-        applyBooleanOperation(newShape, op);
-        updateMeshFromCSG();
-        currShape = Shape.CSG_RESULT;
+        return CSG.fromPolygons(polygons);
     }
 
-    private static List<Vector3d> extractPointsFromEntity(cad.core.Sketch.Entity e) {
+    private static List<Vector3d> extractPointsFromEntity(cad.core.Sketch.Entity e, TessellationTolerance tolerance) {
         List<Vector3d> points = new ArrayList<>();
         if (e instanceof cad.core.Sketch.Polygon) {
             for (cad.core.Sketch.PointEntity pe : ((cad.core.Sketch.Polygon) e).getSketchPoints()) {
@@ -1832,7 +2173,7 @@ public class Geometry {
             }
         } else if (e instanceof cad.core.Sketch.Circle) {
             cad.core.Sketch.Circle c = (cad.core.Sketch.Circle) e;
-            int steps = 32;
+            int steps = circleSegments(c.getRadius(), tolerance);
             for (int i = 0; i < steps; i++) {
                 double angle = 2 * Math.PI * i / steps;
                 double x = c.getX() + c.getRadius() * Math.cos(angle);
@@ -1853,25 +2194,25 @@ public class Geometry {
         return points;
     }
 
-    private static List<Vector3d> extractPathPoints(cad.core.Sketch sketch) {
+    private static List<Vector3d> extractPathPoints(cad.core.Sketch sketch, TessellationTolerance tolerance) {
         List<Vector3d> points = new ArrayList<>();
         if (sketch == null)
             return points;
         for (cad.core.Sketch.Entity e : sketch.getEntities()) {
             if (e instanceof cad.core.Sketch.Line || e instanceof cad.core.Sketch.Spline) {
-                points.addAll(extractPointsFromEntity(e));
+                points.addAll(extractPointsFromEntity(e, tolerance));
             }
         }
         return points;
     }
 
-    private static List<Vector3d> extractProfilePoints(cad.core.Sketch sketch) {
+    private static List<Vector3d> extractProfilePoints(cad.core.Sketch sketch, TessellationTolerance tolerance) {
         List<Vector3d> points = new ArrayList<>();
         if (sketch == null)
             return points;
         for (cad.core.Sketch.Entity e : sketch.getEntities()) {
             if (e instanceof cad.core.Sketch.Polygon || e instanceof cad.core.Sketch.Circle) {
-                points.addAll(extractPointsFromEntity(e));
+                points.addAll(extractPointsFromEntity(e, tolerance));
             }
         }
         return points;
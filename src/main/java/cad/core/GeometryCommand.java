@@ -0,0 +1,38 @@
+package cad.core;
+
+// Base for commands that change the 3D model and undo by restoring the state captured before they ran
+public abstract class GeometryCommand implements Command {
+    private Geometry.State previousState;
+
+    protected void captureState() {
+        if (previousState != null) {
+            previousState.discard();
+        }
+        previousState = Geometry.captureState();
+    }
+
+    @Override
+    public void undo() {
+        if (previousState != null) {
+            Geometry.restoreState(previousState);
+        }
+    }
+
+    @Override
+    public long getRetainedBytes() {
+        return previousState != null ? previousState.getRetainedBytes() : 0;
+    }
+
+    @Override
+    public long spill(UndoSpill store) {
+        return previousState != null ? previousState.spill(store) : 0;
+    }
+
+    @Override
+    public void discard() {
+        if (previousState != null) {
+            previousState.discard();
+            previousState = null;
+        }
+    }
+}
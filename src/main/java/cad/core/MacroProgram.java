@@ -0,0 +1,331 @@
+package cad.core;
+
+import cad.aerodynamics.NacaAirfoilGenerator;
+import java.io.File;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+// A macro compiled once into typed instructions: parameters are parsed and validated up front, so
+// playback is a tight loop over the model with no string handling and no UI work per step. Runs on
+// any thread against a model context; the caller decides how and when to refresh the view.
+public class MacroProgram {
+
+    public interface Instruction {
+        MacroRecorder.ActionType getAction();
+
+        void execute(Sketch sketch) throws Exception;
+
+        // Number of the recorded step this was compiled from, as the errors report it
+        int getStep();
+
+        // True when the step replaces the 3D mesh, so the viewer needs the new triangles
+        default boolean changesMesh() {
+            return false;
+        }
+    }
+
+    public interface ProgressListener {
+        void onProgress(int completed, int total);
+    }
+
+    public static class Result {
+        private final int executed;
+        private final int total;
+        private final List<String> errors;
+        private final boolean cancelled;
+        private final boolean meshChanged;
+        private final long elapsedNanos;
+
+        Result(int executed, int total, List<String> errors, boolean cancelled, boolean meshChanged,
+                long elapsedNanos) {
+            this.executed = executed;
+            this.total = total;
+            this.errors = Collections.unmodifiableList(errors);
+            this.cancelled = cancelled;
+            this.meshChanged = meshChanged;
+            this.elapsedNanos = elapsedNanos;
+        }
+
+        public int getExecuted() {
+            return executed;
+        }
+
+        public int getTotal() {
+            return total;
+        }
+
+        public List<String> getErrors() {
+            return errors;
+        }
+
+        public boolean isCancelled() {
+            return cancelled;
+        }
+
+        public boolean isMeshChanged() {
+            return meshChanged;
+        }
+
+        public long getElapsedNanos() {
+            return elapsedNanos;
+        }
+    }
+
+    private final List<Instruction> instructions;
+    private final List<String> compileErrors;
+    private long progressIntervalNanos = 100_000_000L;
+
+    private MacroProgram(List<Instruction> instructions, List<String> compileErrors) {
+        this.instructions = Collections.unmodifiableList(instructions);
+        this.compileErrors = Collections.unmodifiableList(compileErrors);
+    }
+
+    // Steps that cannot be compiled are reported and left out rather than failing the whole macro,
+    // matching how playback used to skip steps that threw
+    public static MacroProgram compile(List<MacroRecorder.MacroCommand> commands) {
+        return compile(commands, null);
+    }
+
+    // Programs compiled with the same profile cache generate each NACA profile once and share the
+    // coordinates; every run still gets its own sketch entities
+    public static MacroProgram compile(List<MacroRecorder.MacroCommand> commands, Map<String, float[]> profileCache) {
+        return compile(commands, profileCache, 1);
+    }
+
+    // For the tail of a longer macro: errors number the steps from firstStep
+    public static MacroProgram compile(List<MacroRecorder.MacroCommand> commands, Map<String, float[]> profileCache,
+            int firstStep) {
+        List<Instruction> instructions = new ArrayList<>(commands.size());
+        List<String> errors = new ArrayList<>();
+        for (int i = 0; i < commands.size(); i++) {
+            MacroRecorder.MacroCommand cmd = commands.get(i);
+            try {
+                StepInstruction instruction = compile(cmd.action, cmd.parameters, profileCache);
+                if (instruction != null) {
+                    instructions.add(instruction.numbered(i + firstStep));
+                }
+            } catch (IllegalArgumentException e) {
+                errors.add("Step " + (i + firstStep) + " (" + cmd.action + "): " + e.getMessage());
+            }
+        }
+        return new MacroProgram(instructions, errors);
+    }
+
+    public List<Instruction> getInstructions() {
+        return instructions;
+    }
+
+    public List<String> getCompileErrors() {
+        return compileErrors;
+    }
+
+    public int size() {
+        return instructions.size();
+    }
+
+    // Minimum time between progress callbacks; the last step always reports
+    public void setProgressIntervalMillis(long millis) {
+        this.progressIntervalNanos = millis * 1_000_000L;
+    }
+
+    // Runs every instruction in the context, checking for cancellation between steps. A failing
+    // step is recorded and playback continues with the next one. The model is published as a new
+    // snapshot at each progress report and when playback stops.
+    public Result run(ModelContext context, Sketch sketch, ProgressListener listener, AtomicBoolean cancel) {
+        List<String> errors = new ArrayList<>();
+        int total = instructions.size();
+        int executed = 0;
+        boolean meshChanged = false;
+        long start = System.nanoTime();
+        long lastReport = start;
+        for (Instruction instruction : instructions) {
+            if (cancel != null && cancel.get()) {
+                break;
+            }
+            try {
+                context.call(() -> {
+                    instruction.execute(sketch);
+                    return null;
+                });
+                meshChanged |= instruction.changesMesh();
+            } catch (Exception e) {
+                errors.add("Step " + instruction.getStep() + " (" + instruction.getAction() + "): " + e.getMessage());
+            }
+            executed++;
+            long now = System.nanoTime();
+            if (executed == total || now - lastReport >= progressIntervalNanos) {
+                context.publish();
+                if (listener != null) {
+                    listener.onProgress(executed, total);
+                }
+                lastReport = now;
+            }
+        }
+        boolean cancelled = executed < total;
+        if (cancelled) {
+            context.publish();
+        }
+        return new Result(executed, total, errors, cancelled, meshChanged, System.nanoTime() - start);
+    }
+
+    private static StepInstruction compile(MacroRecorder.ActionType action, Map<String, Object> params,
+            Map<String, float[]> profileCache) {
+        switch (action) {
+            case CLEAR_SKETCH:
+                return instruction(action, Sketch::clearSketch);
+            case CLEAR_ALL:
+                return instruction(action, Sketch::clearAll);
+            case SKETCH_POINT: {
+                float x = floatParam(params, "x");
+                float y = floatParam(params, "y");
+                return instruction(action, sketch -> sketch.addPoint(x, y));
+            }
+            case SKETCH_LINE: {
+                float x1 = floatParam(params, "x1");
+                float y1 = floatParam(params, "y1");
+                float x2 = floatParam(params, "x2");
+                float y2 = floatParam(params, "y2");
+                return instruction(action, sketch -> sketch.addLine(x1, y1, x2, y2));
+            }
+            case SKETCH_CIRCLE: {
+                float x = floatParam(params, "x");
+                float y = floatParam(params, "y");
+                float radius = floatParam(params, "radius");
+                return instruction(action, sketch -> sketch.addCircle(x, y, radius));
+            }
+            case SKETCH_POLYGON: {
+                float x = floatParam(params, "centerX");
+                float y = floatParam(params, "centerY");
+                float radius = floatParam(params, "radius");
+                int sides = intParam(params, "sides");
+                return instruction(action, sketch -> sketch.addNSidedPolygon(x, y, radius, sides));
+            }
+            case SKETCH_NACA: {
+                String profile = stringParam(params, "profile");
+                float chord = floatParam(params, "chord");
+                return instruction(action, sketch -> {
+                    float[] xy = profileCache != null
+                            ? profileCache.computeIfAbsent(profile + "@" + chord, k -> nacaProfile(profile, chord))
+                            : nacaProfile(profile, chord);
+                    List<Sketch.PointEntity> points = new ArrayList<>(xy.length / 2);
+                    for (int i = 0; i < xy.length; i += 2) {
+                        points.add(new Sketch.PointEntity(xy[i], xy[i + 1]));
+                    }
+                    sketch.addPolygon(points);
+                });
+            }
+            case EXTRUDE: {
+                float depth = floatParam(params, "depth");
+                return meshInstruction(action, sketch -> sketch.extrude(depth));
+            }
+            case REVOLVE: {
+                String axis = stringParam(params, "axis");
+                float angle = floatParam(params, "angle");
+                return meshInstruction(action, sketch -> Geometry.revolve(sketch, axis, angle, Geometry.BooleanOp.UNION));
+            }
+            case SAVE_FILE: {
+                String path = new File(stringParam(params, "filename")).getAbsolutePath();
+                return instruction(action, sketch -> Geometry.saveStl(path));
+            }
+            case SET_UNITS:
+                // Units are chosen at startup; recorded changes have nothing to replay
+                return null;
+            default:
+                throw new IllegalArgumentException("Command not implemented");
+        }
+    }
+
+    @FunctionalInterface
+    private interface Step {
+        void execute(Sketch sketch) throws Exception;
+    }
+
+    private static StepInstruction instruction(MacroRecorder.ActionType action, Step step) {
+        return new StepInstruction(action, step, false, 0);
+    }
+
+    private static StepInstruction meshInstruction(MacroRecorder.ActionType action, Step step) {
+        return new StepInstruction(action, step, true, 0);
+    }
+
+    private static class StepInstruction implements Instruction {
+        private final MacroRecorder.ActionType action;
+        private final Step step;
+        private final boolean changesMesh;
+        private final int sourceStep;
+
+        StepInstruction(MacroRecorder.ActionType action, Step step, boolean changesMesh, int sourceStep) {
+            this.action = action;
+            this.step = step;
+            this.changesMesh = changesMesh;
+            this.sourceStep = sourceStep;
+        }
+
+        // Steps such as SET_UNITS compile to nothing, so an instruction's index is not its step number
+        StepInstruction numbered(int sourceStep) {
+            return new StepInstruction(action, step, changesMesh, sourceStep);
+        }
+
+        public MacroRecorder.ActionType getAction() {
+            return action;
+        }
+
+        public void execute(Sketch sketch) throws Exception {
+            step.execute(sketch);
+        }
+
+        public int getStep() {
+            return sourceStep;
+        }
+
+        @Override
+        public boolean changesMesh() {
+            return changesMesh;
+        }
+    }
+
+    private static float[] nacaProfile(String profile, float chord) {
+        List<Sketch.PointEntity> points = NacaAirfoilGenerator.generate(profile, chord, 100);
+        float[] xy = new float[points.size() * 2];
+        for (int i = 0; i < points.size(); i++) {
+            xy[2 * i] = points.get(i).getX();
+            xy[2 * i + 1] = points.get(i).getY();
+        }
+        return xy;
+    }
+
+    private static String stringParam(Map<String, Object> params, String key) {
+        Object value = params.get(key);
+        if (value == null) {
+            throw new IllegalArgumentException("Missing parameter " + key);
+        }
+        return value.toString();
+    }
+
+    private static float floatParam(Map<String, Object> params, String key) {
+        Object value = params.get(key);
+        if (value instanceof Number number) {
+            return number.floatValue();
+        }
+        try {
+            return Float.parseFloat(stringParam(params, key));
+        } catch (NumberFormatException e) {
+            throw new IllegalArgumentException("Invalid number for " + key + ": " + value);
+        }
+    }
+
+    private static int intParam(Map<String, Object> params, String key) {
+        Object value = params.get(key);
+        if (value instanceof Number number) {
+            return number.intValue();
+        }
+        try {
+            return Integer.parseInt(stringParam(params, key));
+        } catch (NumberFormatException e) {
+            throw new IllegalArgumentException("Invalid integer for " + key + ": " + value);
+        }
+    }
+}
@@ -3,6 +3,8 @@ package cad.core;
 import java.io.*;
 import java.util.*;
 import java.text.SimpleDateFormat;
+import java.time.LocalDateTime;
+import java.time.format.DateTimeFormatter;
 
 public class MacroRecorder {
 
@@ -31,6 +33,8 @@ public class MacroRecorder {
     }
 
     public static class MacroCommand {
+        private static final DateTimeFormatter TIMESTAMP = DateTimeFormatter.ofPattern("yyyy-MM-dd HH:mm:ss.SSS");
+
         public ActionType action;
         public Map<String, Object> parameters;
         public String timestamp;
@@ -38,7 +42,7 @@ public class MacroRecorder {
         public MacroCommand(ActionType action, Map<String, Object> params) {
             this.action = action;
             this.parameters = params;
-            this.timestamp = new SimpleDateFormat("yyyy-MM-dd HH:mm:ss.SSS").format(new Date());
+            this.timestamp = TIMESTAMP.format(LocalDateTime.now());
         }
 
         public String toScriptLine() {
@@ -48,23 +52,25 @@ public class MacroRecorder {
             return sb.toString().trim();
         }
 
+        // Single pass over the line: "ACTION key=value key=value ..."
         public static MacroCommand fromScriptLine(String line) {
-            String[] parts = line.split(" ", 2);
-            ActionType action = ActionType.valueOf(parts[0]);
+            int end = line.indexOf(' ');
+            ActionType action = ActionType.valueOf(end < 0 ? line : line.substring(0, end));
             Map<String, Object> params = new HashMap<>();
 
-            if (parts.length > 1) {
-                String[] paramPairs = parts[1].split(" ");
-                for (String pair : paramPairs) {
-                    String[] kv = pair.split("=", 2);
-                    if (kv.length == 2) {
-                        params.put(kv[0], kv[1]);
-                    }
+            int pos = end;
+            while (pos >= 0 && pos < line.length()) {
+                int start = pos + 1;
+                int next = line.indexOf(' ', start);
+                int stop = next < 0 ? line.length() : next;
+                int eq = line.indexOf('=', start);
+                if (eq > start && eq < stop) {
+                    params.put(line.substring(start, eq), line.substring(eq + 1, stop));
                 }
+                pos = next;
             }
 
-            MacroCommand cmd = new MacroCommand(action, params);
-            return cmd;
+            return new MacroCommand(action, params);
         }
     }
 
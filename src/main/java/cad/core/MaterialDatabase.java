@@ -14,7 +14,6 @@ import java.util.List;
 import java.util.stream.Collectors;
 
 public class MaterialDatabase {
-        private static MaterialDatabase instance;
         private List<Material> materials;
         private String dataFilePath;
         private Gson gson;
@@ -31,11 +30,13 @@ public class MaterialDatabase {
                 load();
         }
 
+        // Loaded on first use only; the CLI never reads or writes materials.json unless asked to
+        private static class Holder {
+                static final MaterialDatabase INSTANCE = new MaterialDatabase();
+        }
+
         public static MaterialDatabase getInstance() {
-                if (instance == null) {
-                        instance = new MaterialDatabase();
-                }
-                return instance;
+                return Holder.INSTANCE;
         }
 
         public void load() {
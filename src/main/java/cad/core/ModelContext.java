@@ -0,0 +1,148 @@
+package cad.core;
+
+import cad.features.tree.FeatureTree;
+import cad.geometry.tessellation.TessellationTolerance;
+import eu.mihosoft.jcsg.CSG;
+import java.util.concurrent.Callable;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.locks.ReentrantLock;
+
+// One open document: the modeling state the static Geometry API used to keep in static fields.
+// Geometry works on the context bound to the calling thread, or on the default context when none is
+// bound, so the GUI keeps using the static API unchanged while servers and batch jobs run each model
+// in its own context via run/call. A context is used by one thread at a time; run and call take
+// its lock. Other threads read the model through snapshot(), which the writer publishes after each
+// command or operation.
+public class ModelContext {
+    private static final ModelContext DEFAULT = new ModelContext("default");
+    private static final ThreadLocal<ModelContext> BOUND = new ThreadLocal<>();
+    private static final AtomicInteger NEXT_ID = new AtomicInteger();
+
+    private final String name;
+    private final ReentrantLock lock = new ReentrantLock();
+
+    Geometry.Shape currShape = Geometry.Shape.NONE;
+    Geometry.Shape primitiveShapeType = Geometry.Shape.NONE;
+    float param = 0.0f;
+    int cubeDivisions = 1;
+    int sphereLatDiv = Geometry.AUTO_DIVISIONS;
+    int sphereLonDiv = Geometry.AUTO_DIVISIONS;
+    TessellationTolerance tessellationTolerance = TessellationTolerance.DEFAULT;
+    CSG currentCSG = null;
+    TriangleList extrudedTriangles = new TriangleList();
+    TriangleList loadedStlTriangles = new TriangleList();
+
+    private volatile Sketch sketch;
+    private volatile ModelSnapshot snapshot = ModelSnapshot.EMPTY;
+    private FeatureTree featureTree;
+
+    public ModelContext() {
+        this("model" + NEXT_ID.incrementAndGet());
+    }
+
+    public ModelContext(String name) {
+        this.name = name;
+    }
+
+    public static ModelContext getDefault() {
+        return DEFAULT;
+    }
+
+    // The context Geometry operates on for the calling thread
+    public static ModelContext current() {
+        ModelContext bound = BOUND.get();
+        return bound != null ? bound : DEFAULT;
+    }
+
+    public String getName() {
+        return name;
+    }
+
+    // Runs the task with this context bound to the calling thread, restoring the previous binding after
+    public void run(Runnable task) {
+        call(() -> {
+            task.run();
+            return null;
+        });
+    }
+
+    public <T> T call(Callable<T> task) {
+        lock.lock();
+        ModelContext previous = BOUND.get();
+        BOUND.set(this);
+        try {
+            return task.call();
+        } catch (RuntimeException e) {
+            throw e;
+        } catch (Exception e) {
+            throw new IllegalStateException(e.getMessage(), e);
+        } finally {
+            if (previous != null) {
+                BOUND.set(previous);
+            } else {
+                BOUND.remove();
+            }
+            lock.unlock();
+        }
+    }
+
+    // An edit made outside commands and operations, such as the GUI changing the sketch. The change
+    // and the publish of its result happen on the calling thread with the context held throughout.
+    public void update(Runnable change) {
+        update(() -> {
+            change.run();
+            return null;
+        });
+    }
+
+    public <T> T update(Callable<T> change) {
+        return call(() -> {
+            T result = change.call();
+            publish();
+            return result;
+        });
+    }
+
+    // The last published state; safe to read from any thread without the lock
+    public ModelSnapshot snapshot() {
+        return snapshot;
+    }
+
+    // Freezes the current model as the next version and makes it visible to readers at once. Called
+    // by the thread that modified the model, before it releases the context (run, call and update
+    // hold it), once a command or operation has finished with it. Never blocks: when another thread
+    // holds the context it is mid-change and publishes when done, so the current snapshot is
+    // returned unchanged.
+    public ModelSnapshot publish() {
+        if (!lock.tryLock()) {
+            return snapshot;
+        }
+        try {
+            snapshot = ModelSnapshot.capture(this, snapshot);
+            return snapshot;
+        } finally {
+            lock.unlock();
+        }
+    }
+
+    // Sketch whose extruded faces saveStl writes, if any; the GUI binds its sketch here
+    public Sketch getSketch() {
+        return sketch;
+    }
+
+    public void setSketch(Sketch sketch) {
+        this.sketch = sketch;
+    }
+
+    public synchronized FeatureTree getFeatureTree() {
+        if (featureTree == null) {
+            featureTree = new FeatureTree();
+        }
+        return featureTree;
+    }
+
+    @Override
+    public String toString() {
+        return "ModelContext{" + name + "}";
+    }
+}
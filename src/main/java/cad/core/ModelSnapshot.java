@@ -0,0 +1,233 @@
+package cad.core;
+
+import com.jogamp.opengl.GL2;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+// Immutable view of one document at a version: the mesh, the primitive parameters and the sketch
+// geometry as they were when a writer published them. ModelContext.publish() builds one after each
+// command or operation and swaps it in with a single volatile write, so renderers and analyses read
+// a consistent model without locks while commands go on modifying the live one. Meshes share chunks
+// with the live TriangleLists copy-on-write, so publishing costs one pass over the sketch entities
+// plus O(chunks), never a copy of the triangles.
+public final class ModelSnapshot {
+    public static final ModelSnapshot EMPTY = new ModelSnapshot(0, Geometry.Shape.NONE, 0.0f, 1,
+            List.of(), List.of(), List.of(), List.of(), List.of());
+
+    public enum StrokeMode {
+        POINTS, LINES, LINE_LOOP, LINE_STRIP
+    }
+
+    // A sketch entity reduced to the 2D vertices it is drawn with. Preview strokes come from the
+    // entities being drawn interactively and are shown stippled.
+    public static final class Stroke {
+        private final StrokeMode mode;
+        private final float[] xy;
+        private final boolean preview;
+
+        Stroke(StrokeMode mode, float[] xy, boolean preview) {
+            this.mode = mode;
+            this.xy = xy;
+            this.preview = preview;
+        }
+
+        public StrokeMode getMode() {
+            return mode;
+        }
+
+        public int getVertexCount() {
+            return xy.length / 2;
+        }
+
+        public float getX(int i) {
+            return xy[2 * i];
+        }
+
+        public float getY(int i) {
+            return xy[2 * i + 1];
+        }
+
+        public boolean isPreview() {
+            return preview;
+        }
+    }
+
+    private final long version;
+    private final Geometry.Shape shape;
+    private final float param;
+    private final int cubeDivisions;
+    private final List<float[]> loadedStlTriangles;
+    private final List<float[]> extrudedTriangles;
+    private final List<Stroke> strokes;
+    private final List<Dimension> dimensions;
+    private final List<Sketch.Face3D> extrudedFaces;
+    // Computed on first use; racing readers compute the same value
+    private volatile float maxDimension = -1.0f;
+
+    private ModelSnapshot(long version, Geometry.Shape shape, float param, int cubeDivisions,
+            List<float[]> loadedStlTriangles, List<float[]> extrudedTriangles, List<Stroke> strokes,
+            List<Dimension> dimensions, List<Sketch.Face3D> extrudedFaces) {
+        this.version = version;
+        this.shape = shape;
+        this.param = param;
+        this.cubeDivisions = cubeDivisions;
+        this.loadedStlTriangles = loadedStlTriangles;
+        this.extrudedTriangles = extrudedTriangles;
+        this.strokes = strokes;
+        this.dimensions = dimensions;
+        this.extrudedFaces = extrudedFaces;
+    }
+
+    // Runs with the context locked: taking the mesh snapshots hands the live lists new ownership
+    // tokens. Faces identical to the previous version's keep its list, so viewers that cache GPU
+    // buffers per faces list only upload again when the solid changed.
+    static ModelSnapshot capture(ModelContext m, ModelSnapshot previous) {
+        Sketch sketch = m.getSketch();
+        List<Stroke> strokes = List.of();
+        List<Dimension> dimensions = List.of();
+        List<Sketch.Face3D> faces = List.of();
+        if (sketch != null) {
+            strokes = Collections.unmodifiableList(sketch.strokes());
+            dimensions = Collections.unmodifiableList(sketch.getDimensions());
+            faces = sameElements(previous.extrudedFaces, sketch.extrudedFaces) ? previous.extrudedFaces
+                    : Collections.unmodifiableList(new ArrayList<>(sketch.extrudedFaces));
+        }
+        return new ModelSnapshot(previous.version + 1, m.currShape, m.param, m.cubeDivisions,
+                frozen(m.loadedStlTriangles), frozen(m.extrudedTriangles), strokes, dimensions, faces);
+    }
+
+    private static <T> boolean sameElements(List<T> a, List<T> b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (int i = 0; i < a.size(); i++) {
+            if (a.get(i) != b.get(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private static List<float[]> frozen(TriangleList triangles) {
+        return Collections.unmodifiableList(triangles.snapshot());
+    }
+
+    public long getVersion() {
+        return version;
+    }
+
+    public Geometry.Shape getShape() {
+        return shape;
+    }
+
+    public float getParam() {
+        return param;
+    }
+
+    public int getCubeDivisions() {
+        return cubeDivisions;
+    }
+
+    public List<float[]> getLoadedStlTriangles() {
+        return loadedStlTriangles;
+    }
+
+    public List<float[]> getExtrudedTriangles() {
+        return extrudedTriangles;
+    }
+
+    // The mesh picking and measurement work on for the current shape
+    public List<float[]> getActiveTriangles() {
+        switch (shape) {
+            case STL_LOADED:
+            case CUBE:
+            case SPHERE:
+                return loadedStlTriangles;
+            case EXTRUDED:
+            case CSG_RESULT:
+                return extrudedTriangles;
+            default:
+                return List.of();
+        }
+    }
+
+    public List<Stroke> getStrokes() {
+        return strokes;
+    }
+
+    public List<Dimension> getDimensions() {
+        return dimensions;
+    }
+
+    public List<Sketch.Face3D> getExtrudedFaces() {
+        return extrudedFaces;
+    }
+
+    public float getMaxDimension() {
+        float value = maxDimension;
+        if (value < 0) {
+            value = Geometry.maxDimension(shape, param, loadedStlTriangles, extrudedTriangles);
+            maxDimension = value;
+        }
+        return value;
+    }
+
+    public void drawSketch(GL2 gl) {
+        drawSketch(gl, strokes, dimensions);
+    }
+
+    static void drawSketch(GL2 gl, List<Stroke> strokes, List<Dimension> dimensions) {
+        for (Stroke stroke : strokes) {
+            if (!stroke.preview) {
+                drawStroke(gl, stroke);
+            }
+        }
+        gl.glColor3f(0.5f, 0.5f, 0.5f);
+        for (Stroke stroke : strokes) {
+            if (stroke.preview) {
+                drawStroke(gl, stroke);
+            }
+        }
+        for (Dimension dim : dimensions) {
+            if (dim != null) {
+                dim.draw(gl);
+            }
+        }
+    }
+
+    private static void drawStroke(GL2 gl, Stroke stroke) {
+        boolean stipple = stroke.preview && stroke.mode != StrokeMode.POINTS;
+        if (stroke.mode == StrokeMode.POINTS) {
+            gl.glPointSize(5.0f);
+        }
+        if (stipple) {
+            gl.glEnable(GL2.GL_LINE_STIPPLE);
+            gl.glLineStipple(1, (short) 0x00FF);
+        }
+        gl.glBegin(glMode(stroke.mode));
+        try {
+            for (int i = 0; i < stroke.xy.length; i += 2) {
+                gl.glVertex2f(stroke.xy[i], stroke.xy[i + 1]);
+            }
+        } finally {
+            gl.glEnd();
+            if (stipple) {
+                gl.glDisable(GL2.GL_LINE_STIPPLE);
+            }
+        }
+    }
+
+    private static int glMode(StrokeMode mode) {
+        switch (mode) {
+            case POINTS:
+                return GL2.GL_POINTS;
+            case LINES:
+                return GL2.GL_LINES;
+            case LINE_LOOP:
+                return GL2.GL_LINE_LOOP;
+            default:
+                return GL2.GL_LINE_STRIP;
+        }
+    }
+}
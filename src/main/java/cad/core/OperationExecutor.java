@@ -0,0 +1,97 @@
+package cad.core;
+
+import java.util.concurrent.Callable;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.BiConsumer;
+
+// Runs long kernel operations (extrude, revolve, loft, sweep, booleans, STL load) on a worker pool
+// instead of the UI thread. Each operation runs inside its model context with an OperationMonitor
+// bound, so progress comes from inside the kernel loops and cancel() stops them at the next step.
+// A cancelled or failed operation rolls the model geometry back to where it started; either way the
+// result is published as the context's next snapshot. Progress and completion callbacks run on the
+// callback executor, e.g. Platform::runLater.
+public class OperationExecutor {
+    private final ExecutorService workers;
+    private final Executor callbacks;
+
+    public OperationExecutor(int threads, Executor callbacks) {
+        AtomicInteger n = new AtomicInteger();
+        this.workers = Executors.newFixedThreadPool(threads, r -> {
+            Thread t = new Thread(r, "kernel-operation-" + n.incrementAndGet());
+            t.setDaemon(true);
+            return t;
+        });
+        this.callbacks = callbacks;
+    }
+
+    public static class Operation<T> {
+        private final String name;
+        private final OperationMonitor monitor;
+        private final CompletableFuture<T> future = new CompletableFuture<>();
+        private final Executor callbacks;
+
+        Operation(String name, OperationMonitor.Listener listener, Executor callbacks) {
+            this.name = name;
+            this.monitor = new OperationMonitor(listener);
+            this.callbacks = callbacks;
+        }
+
+        public String getName() {
+            return name;
+        }
+
+        // Requests cancellation; the kernel stops at its next checkpoint
+        public void cancel() {
+            monitor.cancel();
+        }
+
+        public boolean isDone() {
+            return future.isDone();
+        }
+
+        public CompletableFuture<T> getFuture() {
+            return future;
+        }
+
+        // Called once with the result, or with the error (a CancellationException when cancelled)
+        public void whenDone(BiConsumer<T, Throwable> callback) {
+            future.whenCompleteAsync(callback, callbacks);
+        }
+    }
+
+    public <T> Operation<T> submit(String name, ModelContext context, Callable<T> work,
+            OperationMonitor.Listener progress) {
+        OperationMonitor.Listener listener = progress == null ? null
+                : (phase, done, total) -> callbacks.execute(() -> progress.onProgress(phase, done, total));
+        Operation<T> operation = new Operation<>(name, listener, callbacks);
+        workers.execute(() -> {
+            try {
+                T result = context.call(() -> {
+                    Geometry.State before = Geometry.captureState();
+                    try {
+                        return operation.monitor.call(work);
+                    } catch (Exception | StackOverflowError e) {
+                        Geometry.restoreState(before);
+                        throw e;
+                    } finally {
+                        context.publish();
+                    }
+                });
+                operation.future.complete(result);
+            } catch (RuntimeException | StackOverflowError e) {
+                // ModelContext.call wraps checked exceptions such as IOException
+                boolean wrapped = e.getClass() == IllegalStateException.class && e.getCause() instanceof Exception;
+                operation.future.completeExceptionally(wrapped ? e.getCause() : e);
+            }
+        });
+        return operation;
+    }
+
+    public void shutdown() {
+        workers.shutdownNow();
+    }
+}
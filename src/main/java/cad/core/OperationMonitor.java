@@ -0,0 +1,141 @@
+package cad.core;
+
+import java.util.concurrent.Callable;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.Supplier;
+
+// Progress and cooperative cancellation for one long kernel operation. Like ModelContext, a monitor
+// is bound to the thread doing the work, so the kernel loops (STL facets, CSG polygons, tessellated
+// faces) fetch it once with current() and call step() per item without any API changes. When no
+// monitor is bound, current() returns one that never reports and is never cancelled.
+public class OperationMonitor {
+    private static final ThreadLocal<OperationMonitor> BOUND = new ThreadLocal<>();
+    private static final OperationMonitor NONE = new OperationMonitor(null);
+    private static final long REPORT_INTERVAL_NANOS = 50_000_000L;
+    private static final long CANCEL_POLL_MILLIS = 50;
+    private static final ExecutorService OPAQUE_WORKERS = Executors.newCachedThreadPool(r -> {
+        Thread t = new Thread(r, "opaque-operation");
+        t.setDaemon(true);
+        return t;
+    });
+
+    public interface Listener {
+        // total is 0 when the amount of work is not known up front
+        void onProgress(String phase, long done, long total);
+    }
+
+    private final Listener listener;
+    private volatile boolean cancelled;
+    private volatile String phase = "";
+    private volatile long total;
+    private final AtomicLong done = new AtomicLong();
+    private long lastReport;
+
+    public OperationMonitor(Listener listener) {
+        this.listener = listener;
+    }
+
+    public static OperationMonitor current() {
+        OperationMonitor bound = BOUND.get();
+        return bound != null ? bound : NONE;
+    }
+
+    public <T> T call(Callable<T> task) throws Exception {
+        OperationMonitor previous = BOUND.get();
+        BOUND.set(this);
+        try {
+            return task.call();
+        } finally {
+            if (previous != null) {
+                BOUND.set(previous);
+            } else {
+                BOUND.remove();
+            }
+        }
+    }
+
+    public void cancel() {
+        cancelled = true;
+    }
+
+    public boolean isCancelled() {
+        return cancelled;
+    }
+
+    // Starts a new stage of the operation and always reports it
+    public void begin(String phase, long total) {
+        checkCancelled();
+        if (listener == null) {
+            return;
+        }
+        this.phase = phase;
+        this.total = total;
+        done.set(0);
+        synchronized (this) {
+            lastReport = System.nanoTime();
+        }
+        listener.onProgress(phase, 0, total);
+    }
+
+    // One unit of work done; throws CancellationException once cancel() has been called. Safe to
+    // call from the worker threads of a parallel loop started by the bound thread.
+    public void step() {
+        checkCancelled();
+        if (listener == null) {
+            return;
+        }
+        long count = done.incrementAndGet();
+        if ((count & 0xFF) == 0) {
+            synchronized (this) {
+                long now = System.nanoTime();
+                if (now - lastReport >= REPORT_INTERVAL_NANOS) {
+                    lastReport = now;
+                    listener.onProgress(phase, count, total);
+                }
+            }
+        }
+    }
+
+    // Runs work that cannot step a monitor, such as a JCSG boolean, on a helper thread and waits for
+    // it while watching for cancel(). A cancelled wait throws at once; the helper runs on to the end
+    // and its result is dropped. Without a bound monitor the work simply runs on this thread.
+    public <T> T callOpaque(Supplier<T> work) {
+        checkCancelled();
+        if (this == NONE) {
+            return work.get();
+        }
+        CompletableFuture<T> future = CompletableFuture.supplyAsync(work, OPAQUE_WORKERS);
+        while (true) {
+            try {
+                return future.get(CANCEL_POLL_MILLIS, TimeUnit.MILLISECONDS);
+            } catch (TimeoutException e) {
+                checkCancelled();
+            } catch (ExecutionException e) {
+                Throwable cause = e.getCause();
+                if (cause instanceof RuntimeException runtime) {
+                    throw runtime;
+                }
+                if (cause instanceof Error error) {
+                    throw error;
+                }
+                throw new IllegalStateException(cause);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+                throw new CancellationException("Operation interrupted");
+            }
+        }
+    }
+
+    public void checkCancelled() {
+        if (cancelled) {
+            throw new CancellationException("Operation cancelled");
+        }
+    }
+}
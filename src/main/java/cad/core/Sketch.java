@@ -1,14 +1,16 @@
 package cad.core;
 
+import cad.geometry.tessellation.TessellationTolerance;
 import com.jogamp.opengl.GL2;
 import java.util.ArrayList;
 import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.HashSet;
+import java.util.IdentityHashMap;
 import java.util.List;
+import java.util.Map;
 import java.util.Set;
-import java.io.FileWriter;
 import java.io.IOException;
-import java.io.PrintWriter;
 import java.io.FileReader;
 import java.io.BufferedReader;
 
@@ -24,7 +26,16 @@ public class Sketch {
     }
 
     public static abstract class Entity {
+        private static final AtomicInteger NEXT_ID = new AtomicInteger();
+
         TypeSketch type;
+        private final int id = NEXT_ID.incrementAndGet();
+
+        // Unique for the session and kept while the entity is edited in place; the persistent
+        // names of faces and edges swept from this entity refer to it
+        public int getId() {
+            return id;
+        }
     }
 
     public static class PointEntity extends Entity {
@@ -476,6 +487,85 @@ public class Sketch {
 
     private boolean isDirty = false;
 
+    public Sketch() {
+    }
+
+    // Deep copy of the entities and extruded faces, so that the copy can be edited and extruded
+    // without touching this sketch. Points shared between entities stay shared in the copy.
+    // Constraints and dimensions refer to the entities they act on and are not copied, so a sketch
+    // that has any is rejected.
+    public Sketch(Sketch other) {
+        if (!other.constraints.isEmpty() || !other.dimensions.isEmpty()) {
+            throw new IllegalArgumentException("Cannot copy a sketch with constraints or dimensions");
+        }
+        Map<Object, Object> copies = new IdentityHashMap<>();
+        for (Entity entity : other.sketchEntities) {
+            sketchEntities.add(copyEntity(entity, copies));
+        }
+        for (Polygon polygon : other.polygons) {
+            polygons.add((Polygon) copyEntity(polygon, copies));
+        }
+        for (Spline spline : other.splines) {
+            splines.add((Spline) copyEntity(spline, copies));
+        }
+        for (Face3D face : other.extrudedFaces) {
+            Face3D copy = new Face3D(face.getVertices());
+            if (face.getVertexNormals() != null) {
+                List<float[]> normals = new ArrayList<>(face.getVertexNormals().size());
+                for (float[] normal : face.getVertexNormals()) {
+                    normals.add(normal.clone());
+                }
+                copy.setVertexNormals(normals);
+            }
+            extrudedFaces.add(copy);
+        }
+        this.material = other.material;
+        this.thickness = other.thickness;
+        this.unitSystem = other.unitSystem;
+        this.isDirty = other.isDirty;
+        this.isModified = other.isModified;
+    }
+
+    private static Entity copyEntity(Entity entity, Map<Object, Object> copies) {
+        Entity copy = (Entity) copies.get(entity);
+        if (copy != null) {
+            return copy;
+        }
+        if (entity instanceof Line) {
+            Line line = (Line) entity;
+            copy = new Line(copyPoint(line.getStartPoint(), copies), copyPoint(line.getEndPoint(), copies));
+        } else if (entity instanceof Circle) {
+            Circle circle = (Circle) entity;
+            copy = new Circle(copyPoint(circle.getCenterPoint(), copies), circle.getRadius());
+        } else if (entity instanceof Arc) {
+            Arc arc = (Arc) entity;
+            copy = new Arc(arc.getX(), arc.getY(), arc.getRadius(), arc.getStartAngle(), arc.getEndAngle());
+        } else if (entity instanceof Polygon) {
+            copy = new Polygon(copyPoints(((Polygon) entity).getSketchPoints(), copies));
+        } else if (entity instanceof Spline) {
+            Spline spline = (Spline) entity;
+            copy = new Spline(copyPoints(spline.getControlPoints(), copies), spline.isClosed());
+        } else if (entity instanceof PointEntity) {
+            copy = new PointEntity(copyPoint(((PointEntity) entity).getPoint(), copies));
+        } else {
+            throw new IllegalArgumentException("Cannot copy sketch entity " + entity);
+        }
+        copies.put(entity, copy);
+        return copy;
+    }
+
+    private static List<PointEntity> copyPoints(List<PointEntity> points, Map<Object, Object> copies) {
+        List<PointEntity> copied = new ArrayList<>(points.size());
+        for (PointEntity point : points) {
+            copied.add((PointEntity) copyEntity(point, copies));
+        }
+        return copied;
+    }
+
+    private static Point copyPoint(Point point, Map<Object, Object> copies) {
+        return (Point) copies.computeIfAbsent(point, p -> new Point(point.x, point.y));
+    }
+
     public boolean isDirty() {
         return isDirty;
     }
@@ -691,6 +781,46 @@ public class Sketch {
         return new ArrayList<>(sketchEntities);
     }
 
+    // Hash of entity identities and geometry. Features compare it with the value they were last
+    // generated from to skip regeneration when the sketch has not changed.
+    public long getGeometrySignature() {
+        long hash = 17;
+        for (Entity entity : sketchEntities) {
+            hash = 31 * hash + entity.getId();
+            if (entity instanceof Line) {
+                Line line = (Line) entity;
+                hash = mix(hash, line.getX1(), line.getY1(), line.getX2(), line.getY2());
+            } else if (entity instanceof Circle) {
+                Circle circle = (Circle) entity;
+                hash = mix(hash, circle.getX(), circle.getY(), circle.getRadius());
+            } else if (entity instanceof Arc) {
+                Arc arc = (Arc) entity;
+                hash = mix(hash, arc.getX(), arc.getY(), arc.getRadius(), arc.getStartAngle(), arc.getEndAngle());
+            } else if (entity instanceof Polygon) {
+                for (PointEntity p : ((Polygon) entity).getSketchPoints()) {
+                    hash = mix(hash, p.getX(), p.getY());
+                }
+            } else if (entity instanceof Spline) {
+                Spline spline = (Spline) entity;
+                for (PointEntity p : spline.getControlPoints()) {
+                    hash = mix(hash, p.getX(), p.getY());
+                }
+                hash = 31 * hash + (spline.isClosed() ? 1 : 0);
+            } else if (entity instanceof PointEntity) {
+                PointEntity p = (PointEntity) entity;
+                hash = mix(hash, p.getX(), p.getY());
+            }
+        }
+        return hash;
+    }
+
+    private static long mix(long hash, float... values) {
+        for (float value : values) {
+            hash = 31 * hash + Float.floatToIntBits(value);
+        }
+        return hash;
+    }
+
     public boolean removeEntity(Entity entity) {
         boolean removed = sketchEntities.remove(entity);
         if (removed && entity instanceof Polygon) {
@@ -734,93 +864,8 @@ public class Sketch {
     }
 
     public void exportSketchToDXF(String filename) {
-        try (PrintWriter out = new PrintWriter(new FileWriter(filename))) {
-            out.println("0");
-            out.println("SECTION");
-            out.println("2");
-            out.println("HEADER");
-
-            out.println("9");
-            out.println("$INSUNITS");
-            out.println("70");
-            out.println(this.unitSystem.getDXFCode());
-
-            out.println("0");
-            out.println("ENDSEC");
-
-            out.println("0");
-            out.println("SECTION");
-            out.println("2");
-            out.println("ENTITIES");
-
-            for (Entity e : sketchEntities) {
-                if (e instanceof PointEntity) {
-                    PointEntity p = (PointEntity) e;
-                    out.println("0");
-                    out.println("POINT");
-                    out.println("8");
-                    out.println("0");
-                    out.println("10");
-                    out.println(p.getX());
-                    out.println("20");
-                    out.println(p.getY());
-                } else if (e instanceof Line l) {
-                    out.println("0");
-                    out.println("LINE");
-                    out.println("8");
-                    out.println("0");
-                    out.println("10");
-                    out.println(l.getX1());
-                    out.println("20");
-                    out.println(l.getY1());
-                    out.println("11");
-                    out.println(l.getX2());
-                    out.println("21");
-                    out.println(l.getY2());
-                } else if (e instanceof Circle c) {
-                    out.println("0");
-                    out.println("CIRCLE");
-                    out.println("8");
-                    out.println("0");
-                    out.println("10");
-                    out.println(c.getX());
-                    out.println("20");
-                    out.println(c.getY());
-                    out.println("40");
-                    out.println(c.getRadius());
-                } else if (e instanceof Polygon poly) {
-                    out.println("0");
-                    out.println("POLYLINE");
-                    out.println("8");
-                    out.println("0");
-                    out.println("66");
-                    out.println("1");
-                    out.println("70");
-                    out.println("1");
-
-                    for (PointEntity p : poly.points) {
-                        out.println("0");
-                        out.println("VERTEX");
-                        out.println("8");
-                        out.println("0");
-                        out.println("10");
-                        out.println(p.getX());
-                        out.println("20");
-                        out.println(p.getY());
-                    }
-
-                    out.println("0");
-                    out.println("SEQEND");
-                    out.println("8");
-                    out.println("0");
-                }
-            }
-
-            out.println("0");
-            out.println("ENDSEC");
-            out.println("0");
-            out.println("EOF");
-
+        try {
+            DxfWriter.export(this, filename);
             System.out.println("Sketch exported to " + filename);
         } catch (IOException e) {
             System.out.println("Error exporting DXF: " + e.getMessage());
@@ -917,6 +962,10 @@ public class Sketch {
             String line;
             String currentEntity = null;
             float x1 = 0, y1 = 0, x2 = 0, y2 = 0, cx = 0, cy = 0, radius = 0;
+            float startAngle = 0, endAngle = 0;
+            boolean splineClosed = false;
+            boolean splinePeriodic = false;
+            int splineDegree = 0;
             List<PointEntity> polyPoints = null;
             float tempVertexX = 0, tempVertexY = 0;
 
@@ -980,8 +1029,19 @@ public class Sketch {
                                 case "CIRCLE":
                                     addEntity("CIRCLE", 0, 0, 0, 0, cx, cy, radius, null);
                                     break;
+                                case "ARC":
+                                    addEntity(new Arc(cx, cy, radius, startAngle, endAngle));
+                                    break;
+                                case "LWPOLYLINE":
+                                    addEntity("POLYLINE", 0, 0, 0, 0, 0, 0, 0, polyPoints);
+                                    break;
+                                case "SPLINE":
+                                    if (polyPoints != null)
+                                        addSpline(unwrapPeriodic(polyPoints, splinePeriodic ? splineDegree : 0), splineClosed);
+                                    break;
                             }
                         }
+                        currentEntity = null;
                         break;
                     }
 
@@ -998,6 +1058,16 @@ public class Sketch {
                             case "CIRCLE":
                                 addEntity("CIRCLE", 0, 0, 0, 0, cx, cy, radius, null);
                                 break;
+                            case "ARC":
+                                addEntity(new Arc(cx, cy, radius, startAngle, endAngle));
+                                break;
+                            case "LWPOLYLINE":
+                                addEntity("POLYLINE", 0, 0, 0, 0, 0, 0, 0, polyPoints);
+                                break;
+                            case "SPLINE":
+                                if (polyPoints != null)
+                                    addSpline(unwrapPeriodic(polyPoints, splinePeriodic ? splineDegree : 0), splineClosed);
+                                break;
 
                         }
                         currentEntity = null;
@@ -1007,11 +1077,18 @@ public class Sketch {
                         currentEntity = entityTypeOrSection;
 
                         x1 = y1 = x2 = y2 = cx = cy = radius = 0;
+                        startAngle = endAngle = 0;
 
                         if (currentEntity.equals("POLYLINE")) {
                             inPolylineEntity = true;
                             polyPoints = new ArrayList<>();
 
+                        } else if (currentEntity.equals("LWPOLYLINE") || currentEntity.equals("SPLINE")) {
+                            polyPoints = new ArrayList<>();
+                            splineClosed = false;
+                            splinePeriodic = false;
+                            splineDegree = 0;
+
                         } else if (currentEntity.equals("VERTEX")) {
 
                             if (!inPolylineEntity) {
@@ -1078,12 +1155,13 @@ public class Sketch {
                         switch (groupCode) {
                             case 10:
 
-                                if (currentEntity.equals("VERTEX") && waitingForVertexCoords) {
+                                if ((currentEntity.equals("VERTEX") && waitingForVertexCoords)
+                                        || currentEntity.equals("LWPOLYLINE") || currentEntity.equals("SPLINE")) {
                                     tempVertexX = Float.parseFloat(valueLine) * scale;
                                 } else {
                                     if (currentEntity.equals("POINT") || currentEntity.equals("LINE"))
                                         x1 = Float.parseFloat(valueLine) * scale;
-                                    else if (currentEntity.equals("CIRCLE"))
+                                    else if (currentEntity.equals("CIRCLE") || currentEntity.equals("ARC"))
                                         cx = Float.parseFloat(valueLine) * scale;
                                 }
                                 break;
@@ -1096,10 +1174,13 @@ public class Sketch {
                                         polyPoints.add(new PointEntity(tempVertexX, tempVertexY));
                                     }
                                     waitingForVertexCoords = false;
+                                } else if (currentEntity.equals("LWPOLYLINE") || currentEntity.equals("SPLINE")) {
+                                    tempVertexY = Float.parseFloat(valueLine) * scale;
+                                    polyPoints.add(new PointEntity(tempVertexX, tempVertexY));
                                 } else {
                                     if (currentEntity.equals("POINT") || currentEntity.equals("LINE"))
                                         y1 = Float.parseFloat(valueLine) * scale;
-                                    else if (currentEntity.equals("CIRCLE"))
+                                    else if (currentEntity.equals("CIRCLE") || currentEntity.equals("ARC"))
                                         cy = Float.parseFloat(valueLine) * scale;
                                 }
                                 break;
@@ -1113,14 +1194,32 @@ public class Sketch {
                                 break;
                             case 40:
 
-                                if (currentEntity.equals("CIRCLE"))
+                                if (currentEntity.equals("CIRCLE") || currentEntity.equals("ARC"))
                                     radius = Float.parseFloat(valueLine) * scale;
                                 break;
+                            case 50:
+                                if (currentEntity.equals("ARC"))
+                                    startAngle = Float.parseFloat(valueLine);
+                                break;
+                            case 51:
+                                if (currentEntity.equals("ARC"))
+                                    endAngle = Float.parseFloat(valueLine);
+                                break;
+                            case 70:
+                                if (currentEntity.equals("SPLINE")) {
+                                    int flags = Integer.parseInt(valueLine);
+                                    splineClosed = (flags & 1) != 0;
+                                    splinePeriodic = (flags & 2) != 0;
+                                }
+                                break;
+                            case 71:
+                                if (currentEntity.equals("SPLINE"))
+                                    splineDegree = Integer.parseInt(valueLine);
+                                break;
                             case 8:
                             case 6:
                             case 62:
                             case 39:
-                            case 70:
                             case 66:
 
                                 break;
@@ -1151,6 +1250,16 @@ public class Sketch {
                     case "CIRCLE":
                         addEntity("CIRCLE", 0, 0, 0, 0, cx, cy, radius, null);
                         break;
+                    case "ARC":
+                        addEntity(new Arc(cx, cy, radius, startAngle, endAngle));
+                        break;
+                    case "LWPOLYLINE":
+                        addEntity("POLYLINE", 0, 0, 0, 0, 0, 0, 0, polyPoints);
+                        break;
+                    case "SPLINE":
+                        if (polyPoints != null)
+                            addSpline(unwrapPeriodic(polyPoints, splinePeriodic ? splineDegree : 0), splineClosed);
+                        break;
                 }
             }
 
@@ -1167,6 +1276,22 @@ public class Sketch {
         System.out.println("Finished loading DXF. Entities loaded: " + sketchEntities.size());
     }
 
+    // A periodic spline repeats its first degree control points at the end; the sketch keeps each once
+    private static List<PointEntity> unwrapPeriodic(List<PointEntity> points, int degree) {
+        int n = points.size() - degree;
+        if (degree <= 0 || n < 3) {
+            return points;
+        }
+        for (int i = 0; i < degree; i++) {
+            PointEntity a = points.get(i);
+            PointEntity b = points.get(n + i);
+            if (a.getX() != b.getX() || a.getY() != b.getY()) {
+                return points;
+            }
+        }
+        return new ArrayList<>(points.subList(0, n));
+    }
+
     private void addEntity(String type, float x1, float y1, float x2, float y2, float cx, float cy, float radius,
             List<PointEntity> polyPoints) {
         switch (type) {
@@ -1320,220 +1445,106 @@ public class Sketch {
     }
 
     public void draw(GL2 gl) {
+        ModelSnapshot.drawSketch(gl, strokes(), dimensions);
+    }
 
+    // The entities reduced to the vertices they are drawn with, for a ModelSnapshot. Reads the
+    // entities, so it runs on the thread that edits the sketch.
+    List<ModelSnapshot.Stroke> strokes() {
+        List<ModelSnapshot.Stroke> strokes = new ArrayList<>(sketchEntities.size() + tempEntities.size());
         for (Entity e : sketchEntities) {
-            switch (e.type) {
-                case POINT:
-                    PointEntity p = (PointEntity) e;
-                    gl.glPointSize(5.0f);
-                    gl.glBegin(GL2.GL_POINTS);
-                    try {
-                        gl.glVertex2f(p.getX(), p.getY());
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-                case LINE:
-                    Line l = (Line) e;
-                    gl.glBegin(GL2.GL_LINES);
-                    try {
-                        gl.glVertex2f(l.getX1(), l.getY1());
-                        gl.glVertex2f(l.getX2(), l.getY2());
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-                case CIRCLE:
-                    Circle c = (Circle) e;
-                    gl.glBegin(GL2.GL_LINE_LOOP);
-                    try {
-                        int segments = 50;
-                        for (int i = 0; i < segments; i++) {
-                            double angle = 2.0 * Math.PI * i / segments;
-                            float x = c.getX() + c.getRadius() * (float) Math.cos(angle);
-                            float y = c.getY() + c.getRadius() * (float) Math.sin(angle);
-                            gl.glVertex2f(x, y);
-                        }
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-                case ARC:
-                    Arc arc = (Arc) e;
-                    gl.glBegin(GL2.GL_LINE_STRIP);
-                    try {
-                        int segments = 50;
-                        float start = (float) Math.toRadians(arc.getStartAngle());
-                        float end = (float) Math.toRadians(arc.getEndAngle());
-
-                        if (end < start) {
-                            end += (float) (2.0 * Math.PI);
-                        }
-
-                        float angleDiff = end - start;
-
-                        for (int i = 0; i <= segments; i++) {
-                            float angle = start + (angleDiff * i / segments);
-                            float x = arc.getX() + arc.getRadius() * (float) Math.cos(angle);
-                            float y = arc.getY() + arc.getRadius() * (float) Math.sin(angle);
-                            gl.glVertex2f(x, y);
-                        }
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-                case POLYGON:
-                    Polygon poly = (Polygon) e;
-                    gl.glBegin(GL2.GL_LINE_LOOP);
-                    try {
-                        if (poly.points != null) {
-                            for (PointEntity vert : poly.points) {
-                                if (vert != null) {
-                                    gl.glVertex2f(vert.getX(), vert.getY());
-                                }
-                            }
-                        }
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-                case SPLINE:
-                    Spline spline = (Spline) e;
-                    gl.glBegin(GL2.GL_LINE_STRIP);
-                    try {
-                        if (spline.getControlPoints() != null) {
-                            for (PointEntity sp : spline.getControlPoints()) {
-                                gl.glVertex2f(sp.getX(), sp.getY());
-                            }
-                            if (spline.isClosed() && !spline.getControlPoints().isEmpty()) {
-                                PointEntity first = spline.getControlPoints().get(0);
-                                gl.glVertex2f(first.getX(), first.getY());
-                            }
-                        }
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-            }
+            addStroke(strokes, e, false);
         }
+        for (Entity e : tempEntities) {
+            addStroke(strokes, e, true);
+        }
+        return strokes;
+    }
 
-        gl.glColor3f(0.5f, 0.5f, 0.5f);
-        for (
-
-        Entity e : tempEntities) {
-            switch (e.type) {
-                case POINT:
-                    PointEntity p = (PointEntity) e;
-                    gl.glPointSize(5.0f);
-                    gl.glBegin(GL2.GL_POINTS);
-                    try {
-                        gl.glVertex2f(p.getX(), p.getY());
-                    } finally {
-                        gl.glEnd();
-                    }
-                    break;
-                case LINE:
-                    Line l = (Line) e;
-                    gl.glEnable(GL2.GL_LINE_STIPPLE);
-                    gl.glLineStipple(1, (short) 0x00FF);
-                    gl.glBegin(GL2.GL_LINES);
-                    try {
-                        gl.glVertex2f(l.getX1(), l.getY1());
-                        gl.glVertex2f(l.getX2(), l.getY2());
-                    } finally {
-                        gl.glEnd();
-                        gl.glDisable(GL2.GL_LINE_STIPPLE);
-                    }
-                    break;
-                case CIRCLE:
-                    Circle c = (Circle) e;
-                    gl.glEnable(GL2.GL_LINE_STIPPLE);
-                    gl.glLineStipple(1, (short) 0x00FF);
-                    gl.glBegin(GL2.GL_LINE_LOOP);
-                    try {
-                        int segments = 50;
-                        for (int i = 0; i < segments; i++) {
-                            double angle = 2.0 * Math.PI * i / segments;
-                            float x = c.getX() + c.getRadius() * (float) Math.cos(angle);
-                            float y = c.getY() + c.getRadius() * (float) Math.sin(angle);
-                            gl.glVertex2f(x, y);
-                        }
-                    } finally {
-                        gl.glEnd();
-                        gl.glDisable(GL2.GL_LINE_STIPPLE);
-                    }
-                    break;
-                case ARC:
-                    Arc arc = (Arc) e;
-                    gl.glEnable(GL2.GL_LINE_STIPPLE);
-                    gl.glLineStipple(1, (short) 0x00FF);
-                    gl.glBegin(GL2.GL_LINE_STRIP);
-                    try {
-                        int segments = 50;
-                        float start = (float) Math.toRadians(arc.getStartAngle());
-                        float end = (float) Math.toRadians(arc.getEndAngle());
-                        if (end < start)
-                            end += (float) (2.0 * Math.PI);
-                        float angleDiff = end - start;
-
-                        for (int i = 0; i <= segments; i++) {
-                            float angle = start + (angleDiff * i / segments);
-                            float x = arc.getX() + arc.getRadius() * (float) Math.cos(angle);
-                            float y = arc.getY() + arc.getRadius() * (float) Math.sin(angle);
-                            gl.glVertex2f(x, y);
-                        }
-                    } finally {
-                        gl.glEnd();
-                        gl.glDisable(GL2.GL_LINE_STIPPLE);
-                    }
-                    break;
-                case SPLINE:
-                    Spline spline = (Spline) e;
-                    gl.glEnable(GL2.GL_LINE_STIPPLE);
-                    gl.glLineStipple(1, (short) 0x00FF);
-                    gl.glBegin(GL2.GL_LINE_STRIP);
-                    try {
-                        if (spline.getControlPoints() != null) {
-                            for (PointEntity sp : spline.getControlPoints()) {
-                                gl.glVertex2f(sp.getX(), sp.getY());
-                            }
-                            if (spline.isClosed() && !spline.getControlPoints().isEmpty()) {
-                                PointEntity first = spline.getControlPoints().get(0);
-                                gl.glVertex2f(first.getX(), first.getY());
-                            }
-                        }
-                    } finally {
-                        gl.glEnd();
-                        gl.glDisable(GL2.GL_LINE_STIPPLE);
-                    }
-                    break;
-                case POLYGON:
-                    Polygon poly = (Polygon) e;
-                    gl.glEnable(GL2.GL_LINE_STIPPLE);
-                    gl.glLineStipple(1, (short) 0x00FF);
-                    gl.glBegin(GL2.GL_LINE_LOOP);
-                    try {
-                        if (poly.points != null) {
-                            for (PointEntity vert : poly.points) {
-                                if (vert != null) {
-                                    gl.glVertex2f(vert.getX(), vert.getY());
-                                }
-                            }
+    private static void addStroke(List<ModelSnapshot.Stroke> strokes, Entity e, boolean preview) {
+        switch (e.type) {
+            case POINT: {
+                PointEntity p = (PointEntity) e;
+                strokes.add(new ModelSnapshot.Stroke(ModelSnapshot.StrokeMode.POINTS,
+                        new float[] { p.getX(), p.getY() }, preview));
+                break;
+            }
+            case LINE: {
+                Line l = (Line) e;
+                strokes.add(new ModelSnapshot.Stroke(ModelSnapshot.StrokeMode.LINES,
+                        new float[] { l.getX1(), l.getY1(), l.getX2(), l.getY2() }, preview));
+                break;
+            }
+            case CIRCLE: {
+                Circle c = (Circle) e;
+                int segments = TessellationTolerance.DISPLAY.segmentsForArc(c.getRadius(), 2.0 * Math.PI);
+                float[] xy = new float[2 * segments];
+                for (int i = 0; i < segments; i++) {
+                    double angle = 2.0 * Math.PI * i / segments;
+                    xy[2 * i] = c.getX() + c.getRadius() * (float) Math.cos(angle);
+                    xy[2 * i + 1] = c.getY() + c.getRadius() * (float) Math.sin(angle);
+                }
+                strokes.add(new ModelSnapshot.Stroke(ModelSnapshot.StrokeMode.LINE_LOOP, xy, preview));
+                break;
+            }
+            case ARC: {
+                Arc arc = (Arc) e;
+                float start = (float) Math.toRadians(arc.getStartAngle());
+                float end = (float) Math.toRadians(arc.getEndAngle());
+                if (end < start) {
+                    end += (float) (2.0 * Math.PI);
+                }
+                float angleDiff = end - start;
+                int segments = TessellationTolerance.DISPLAY.segmentsForArc(arc.getRadius(), angleDiff);
+                float[] xy = new float[2 * (segments + 1)];
+                for (int i = 0; i <= segments; i++) {
+                    float angle = start + (angleDiff * i / segments);
+                    xy[2 * i] = arc.getX() + arc.getRadius() * (float) Math.cos(angle);
+                    xy[2 * i + 1] = arc.getY() + arc.getRadius() * (float) Math.sin(angle);
+                }
+                strokes.add(new ModelSnapshot.Stroke(ModelSnapshot.StrokeMode.LINE_STRIP, xy, preview));
+                break;
+            }
+            case POLYGON: {
+                Polygon poly = (Polygon) e;
+                List<PointEntity> vertices = new ArrayList<>();
+                if (poly.points != null) {
+                    for (PointEntity vert : poly.points) {
+                        if (vert != null) {
+                            vertices.add(vert);
                         }
-                    } finally {
-                        gl.glEnd();
-                        gl.glDisable(GL2.GL_LINE_STIPPLE);
                     }
-                    break;
-
+                }
+                strokes.add(new ModelSnapshot.Stroke(ModelSnapshot.StrokeMode.LINE_LOOP, coordinates(vertices, false),
+                        preview));
+                break;
             }
+            case SPLINE: {
+                Spline spline = (Spline) e;
+                List<PointEntity> controlPoints = spline.getControlPoints() != null ? spline.getControlPoints()
+                        : List.of();
+                strokes.add(new ModelSnapshot.Stroke(ModelSnapshot.StrokeMode.LINE_STRIP,
+                        coordinates(controlPoints, spline.isClosed()), preview));
+                break;
+            }
+            default:
+                break;
         }
+    }
 
-        for (Dimension dim : dimensions) {
-            if (dim != null) {
-                dim.draw(gl);
-            }
+    private static float[] coordinates(List<PointEntity> points, boolean close) {
+        int n = points.size();
+        boolean repeatFirst = close && n > 0;
+        float[] xy = new float[2 * (repeatFirst ? n + 1 : n)];
+        for (int i = 0; i < n; i++) {
+            xy[2 * i] = points.get(i).getX();
+            xy[2 * i + 1] = points.get(i).getY();
+        }
+        if (repeatFirst) {
+            xy[2 * n] = xy[0];
+            xy[2 * n + 1] = xy[1];
         }
+        return xy;
     }
 
     public Entity findClosestEntity(float x, float y, float threshold) {
@@ -1891,7 +1902,7 @@ public class Sketch {
     }
 
     private void extrudeCircle(Circle circle, double height) {
-        int segments = 32;
+        int segments = Geometry.circleSegments(circle.getRadius());
         List<Point2D> circlePoints = new ArrayList<>();
 
         for (int i = 0; i < segments; i++) {
@@ -2034,8 +2045,11 @@ public class Sketch {
 
     public List<float[]> getExtrudedTriangles() {
         List<float[]> triangles = new ArrayList<>();
+        OperationMonitor monitor = OperationMonitor.current();
+        monitor.begin("Tessellating faces", extrudedFaces.size());
 
         for (Face3D face : extrudedFaces) {
+            monitor.step();
 
             List<float[]> faceTriangles = triangulateFace(face);
             triangles.addAll(faceTriangles);
@@ -0,0 +1,173 @@
+package cad.core;
+
+import java.util.AbstractList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.Collections;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.RandomAccess;
+import java.util.Set;
+
+// Triangle list stored in fixed-size chunks that snapshots share copy-on-write. A snapshot copies only
+// the chunk index; the first write to a shared chunk copies that chunk alone, so undo history holds
+// one copy of unchanged geometry and capture/restore cost scales with the chunk count, not the
+// triangle count. Triangle arrays themselves are shared and must not be modified in place.
+public class TriangleList extends AbstractList<float[]> implements RandomAccess {
+    static final int CHUNK_SHIFT = 12;
+    static final int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+    private static final int CHUNK_MASK = CHUNK_SIZE - 1;
+    // Array header plus references, and a float[12] with its header, on a compressed-oops JVM
+    static final long CHUNK_BYTES = 16 + 4L * CHUNK_SIZE;
+    static final long TRIANGLE_BYTES = 16 + 4 * 12;
+
+    static final class Chunk {
+        final float[][] items;
+        final Object owner;
+
+        Chunk(float[][] items, Object owner) {
+            this.items = items;
+            this.owner = owner;
+        }
+    }
+
+    private Chunk[] chunks = new Chunk[4];
+    private int chunkCount;
+    private int size;
+    // Chunks tagged with this token belong to this list alone and may be written in place
+    private Object owner = new Object();
+
+    public TriangleList() {
+    }
+
+    public TriangleList(Collection<? extends float[]> triangles) {
+        addAll(triangles);
+    }
+
+    // Shares chunks when the source is a TriangleList, otherwise copies the references
+    public static TriangleList copyOf(List<float[]> triangles) {
+        if (triangles instanceof TriangleList list) {
+            return list.snapshot();
+        }
+        return new TriangleList(triangles);
+    }
+
+    // O(size / CHUNK_SIZE): both lists keep the chunks and copy one on their next write to it
+    public TriangleList snapshot() {
+        TriangleList copy = new TriangleList();
+        copy.chunks = Arrays.copyOf(chunks, Math.max(chunkCount, 4));
+        copy.chunkCount = chunkCount;
+        copy.size = size;
+        owner = new Object();
+        return copy;
+    }
+
+    @Override
+    public float[] get(int index) {
+        if (index < 0 || index >= size) {
+            throw new IndexOutOfBoundsException("Index " + index + ", size " + size);
+        }
+        return chunks[index >>> CHUNK_SHIFT].items[index & CHUNK_MASK];
+    }
+
+    @Override
+    public int size() {
+        return size;
+    }
+
+    @Override
+    public boolean add(float[] triangle) {
+        int c = size >>> CHUNK_SHIFT;
+        if (c == chunkCount) {
+            if (c == chunks.length) {
+                chunks = Arrays.copyOf(chunks, 2 * c);
+            }
+            chunks[c] = new Chunk(new float[CHUNK_SIZE][], owner);
+            chunkCount++;
+        }
+        writable(c).items[size & CHUNK_MASK] = triangle;
+        size++;
+        modCount++;
+        return true;
+    }
+
+    @Override
+    public float[] set(int index, float[] triangle) {
+        float[] old = get(index);
+        writable(index >>> CHUNK_SHIFT).items[index & CHUNK_MASK] = triangle;
+        return old;
+    }
+
+    @Override
+    public void add(int index, float[] triangle) {
+        if (index < 0 || index > size) {
+            throw new IndexOutOfBoundsException("Index " + index + ", size " + size);
+        }
+        if (index == size) {
+            add(triangle);
+            return;
+        }
+        add(get(size - 1));
+        for (int i = size - 2; i > index; i--) {
+            set(i, get(i - 1));
+        }
+        set(index, triangle);
+    }
+
+    @Override
+    public float[] remove(int index) {
+        float[] old = get(index);
+        for (int i = index; i < size - 1; i++) {
+            set(i, get(i + 1));
+        }
+        set(size - 1, null);
+        size--;
+        if ((size & CHUNK_MASK) == 0) {
+            chunks[--chunkCount] = null;
+        }
+        modCount++;
+        return old;
+    }
+
+    @Override
+    public void clear() {
+        chunks = new Chunk[4];
+        chunkCount = 0;
+        size = 0;
+        modCount++;
+    }
+
+    // Distinct chunk arrays referenced by this list, for accounting shared storage across snapshots
+    Chunk[] chunks() {
+        return Arrays.copyOf(chunks, chunkCount);
+    }
+
+    // Estimated heap bytes of the chunks this list holds that none of the others reference. The
+    // triangles of such a chunk are counted too, which is exact when a command rebuilt the mesh and
+    // an overestimate when it only replaced a few triangles of the chunk.
+    long exclusiveBytes(TriangleList... others) {
+        Set<Chunk> shared = Collections.newSetFromMap(new IdentityHashMap<>());
+        for (TriangleList other : others) {
+            if (other != null) {
+                shared.addAll(Arrays.asList(other.chunks).subList(0, other.chunkCount));
+            }
+        }
+        long bytes = 0;
+        for (int c = 0; c < chunkCount; c++) {
+            if (!shared.contains(chunks[c])) {
+                int used = Math.min(CHUNK_SIZE, size - (c << CHUNK_SHIFT));
+                bytes += CHUNK_BYTES + (long) used * TRIANGLE_BYTES;
+            }
+        }
+        return bytes;
+    }
+
+    private Chunk writable(int c) {
+        Chunk chunk = chunks[c];
+        if (chunk.owner != owner) {
+            chunk = new Chunk(chunk.items.clone(), owner);
+            chunks[c] = chunk;
+        }
+        return chunk;
+    }
+}
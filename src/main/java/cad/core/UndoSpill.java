@@ -0,0 +1,177 @@
+package cad.core;
+
+import java.io.BufferedOutputStream;
+import java.io.ByteArrayInputStream;
+import java.io.Closeable;
+import java.io.DataInputStream;
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.zip.Deflater;
+import java.util.zip.DeflaterOutputStream;
+import java.util.zip.InflaterInputStream;
+
+// Temp file holding compressed undo data that CommandManager moved off the heap to stay within its
+// memory budget. Records are deflated at the fastest level and appended; the file is created on first
+// write. Once released records take up more of it than live ones, the live records are moved down
+// over the gaps and the file is truncated, so it never grows past about twice the live data.
+public class UndoSpill implements Closeable {
+
+    @FunctionalInterface
+    public interface Writer {
+        void write(DataOutputStream out) throws IOException;
+    }
+
+    @FunctionalInterface
+    public interface Reader<T> {
+        T read(DataInputStream in) throws IOException;
+    }
+
+    public static final class Record {
+        private long offset;
+        private final int length;
+
+        private Record(long offset, int length) {
+            this.offset = offset;
+            this.length = length;
+        }
+
+        public int getLength() {
+            return length;
+        }
+    }
+
+    private Path path;
+    private RandomAccessFile file;
+    private long end;
+    private final Set<Record> live = new HashSet<>();
+    private long liveBytes;
+
+    public synchronized Record write(Writer writer) throws IOException {
+        FileChannel channel = channel();
+        long offset = end;
+        channel.position(offset);
+        Deflater deflater = new Deflater(Deflater.BEST_SPEED);
+        try {
+            // The channel stays open across records, so the streams are finished rather than closed
+            BufferedOutputStream buffered = new BufferedOutputStream(Channels.newOutputStream(channel), 1 << 16);
+            DeflaterOutputStream deflated = new DeflaterOutputStream(buffered, deflater, 1 << 16);
+            DataOutputStream out = new DataOutputStream(deflated);
+            writer.write(out);
+            out.flush();
+            deflated.finish();
+            buffered.flush();
+        } finally {
+            deflater.end();
+        }
+        long length = channel.position() - offset;
+        if (length > Integer.MAX_VALUE) {
+            throw new IOException("Spilled record too large: " + length + " bytes");
+        }
+        end = channel.position();
+        Record record = new Record(offset, (int) length);
+        live.add(record);
+        liveBytes += length;
+        return record;
+    }
+
+    public synchronized <T> T read(Record record, Reader<T> reader) throws IOException {
+        ByteBuffer buffer = ByteBuffer.allocate(record.length);
+        FileChannel channel = channel();
+        long position = record.offset;
+        while (buffer.hasRemaining()) {
+            int n = channel.read(buffer, position);
+            if (n < 0) {
+                throw new IOException("Undo spill file truncated");
+            }
+            position += n;
+        }
+        try (DataInputStream in = new DataInputStream(new InflaterInputStream(new ByteArrayInputStream(buffer.array())))) {
+            return reader.read(in);
+        }
+    }
+
+    public synchronized void release(Record record) {
+        if (record == null || !live.remove(record)) {
+            return;
+        }
+        liveBytes -= record.length;
+        if (file == null || end - liveBytes <= liveBytes) {
+            return;
+        }
+        try {
+            compact();
+        } catch (IOException e) {
+            System.err.println("Could not compact undo spill file: " + e.getMessage());
+        }
+    }
+
+    // Moves the live records to the front in file order, updating their offsets, and truncates
+    private void compact() throws IOException {
+        List<Record> records = new ArrayList<>(live);
+        records.sort(Comparator.comparingLong(r -> r.offset));
+        FileChannel channel = file.getChannel();
+        ByteBuffer buffer = ByteBuffer.allocate(1 << 16);
+        long to = 0;
+        for (Record record : records) {
+            if (record.offset != to) {
+                // The target is always below the source, so copying front to back is safe
+                long from = record.offset;
+                long remaining = record.length;
+                while (remaining > 0) {
+                    buffer.clear().limit((int) Math.min(buffer.capacity(), remaining));
+                    int n = channel.read(buffer, from);
+                    if (n < 0) {
+                        throw new IOException("Undo spill file truncated");
+                    }
+                    buffer.flip();
+                    while (buffer.hasRemaining()) {
+                        to += channel.write(buffer, to);
+                    }
+                    from += n;
+                    remaining -= n;
+                }
+                record.offset = to - record.length;
+            } else {
+                to += record.length;
+            }
+        }
+        file.setLength(to);
+        end = to;
+    }
+
+    public synchronized long getFileSize() {
+        return end;
+    }
+
+    private FileChannel channel() throws IOException {
+        if (file == null) {
+            path = Files.createTempFile("cad-undo", ".spill");
+            path.toFile().deleteOnExit();
+            file = new RandomAccessFile(path.toFile(), "rw");
+        }
+        return file.getChannel();
+    }
+
+    @Override
+    public synchronized void close() throws IOException {
+        if (file != null) {
+            file.close();
+            Files.deleteIfExists(path);
+            file = null;
+            end = 0;
+            live.clear();
+            liveBytes = 0;
+        }
+    }
+}
@@ -4,7 +4,7 @@ import cad.gui.GuiFX;
 
 public class ViewChangeCommand implements Command {
     private final GuiFX gui;
-    private final boolean newState; 
+    private boolean newState;
     private final boolean oldState;
 
     public ViewChangeCommand(GuiFX gui, boolean newState, boolean oldState) {
@@ -23,6 +23,16 @@ public class ViewChangeCommand implements Command {
         gui.setViewMode(oldState);
     }
 
+    // Toggling back and forth is one step that restores the view before the first toggle
+    @Override
+    public boolean mergeWith(Command next) {
+        if (next instanceof ViewChangeCommand other && other.gui == gui) {
+            newState = other.newState;
+            return true;
+        }
+        return false;
+    }
+
     @Override
     public String getDescription() {
         return newState ? "Switch to Sketch Mode" : "Switch to 3D Mode";
@@ -3,9 +3,12 @@ package cad.features.extrusion;
 import cad.topology.*;
 import cad.geometry.surfaces.*;
 import cad.geometry.curves.*;
+import cad.geometry.tessellation.TessellationTolerance;
 import cad.core.*;
+import cad.math.MutableVector3d;
 import cad.math.Vector3d;
 import java.util.*;
+import java.util.concurrent.atomic.AtomicInteger;
 
 public class LinearSweepFeature {
     private Sketch sketch;
@@ -13,6 +16,12 @@ public class LinearSweepFeature {
     private Vector3d direction;
     private boolean addDraft;
     private double draftAngle;
+    private TessellationTolerance tolerance = TessellationTolerance.DEFAULT;
+    private String featureId = "extrude" + NEXT_ID.incrementAndGet();
+    private BRepBody lastBody;
+    private long lastSignature;
+
+    private static final AtomicInteger NEXT_ID = new AtomicInteger();
 
     public LinearSweepFeature(Sketch sketch, double distance, Vector3d direction) {
         this(sketch, distance, direction, false, 0.0);
@@ -27,19 +36,32 @@ public class LinearSweepFeature {
     }
 
     public BRepBody generate() throws TopologyException {
-        validateInput();
-        
         BRepBody body = new BRepBody();
+        appendTo(body);
+        lastBody = body;
+        lastSignature = inputSignature();
+        return body;
+    }
+
+    // Adds the sweep to an existing body as a separate lump. Only the elements added here are
+    // validated, so the returned report covers this feature rather than the whole body.
+    public ValidationReport appendTo(BRepBody body) throws TopologyException {
+        validateInput();
         
-        List<Vertex> lowerVertices = createVerticesFromSketch(body, 0.0);
-        List<Vertex> upperVertices = createVerticesFromSketch(body, distance);
+        List<Vertex> lowerVertices = createVerticesFromSketch(body, 0.0, TopologicalName.START);
+        List<Vertex> upperVertices = createVerticesFromSketch(body, distance, TopologicalName.END);
         
-        List<Edge> lowerEdges = createEdgesFromVertices(body, lowerVertices, 0.0);
-        List<Edge> upperEdges = createEdgesFromVertices(body, upperVertices, distance);
+        List<Edge> lowerEdges = createEdgesFromVertices(body, lowerVertices, 0.0, TopologicalName.START);
+        List<Edge> upperEdges = createEdgesFromVertices(body, upperVertices, distance, TopologicalName.END);
         List<Edge> sideEdges = createSideEdges(body, lowerVertices, upperVertices);
         
-        Face lowerFace = createCapFace(body, lowerEdges, direction.negated());
+        // The side faces walk the lower edges in sketch order, so the lower cap walks them backwards
+        List<Edge> lowerLoop = new ArrayList<>(lowerEdges);
+        Collections.reverse(lowerLoop);
+        Face lowerFace = createCapFace(body, lowerLoop, direction.negated());
         Face upperFace = createCapFace(body, upperEdges, direction);
+        lowerFace.setName(TopologicalName.of(featureId, TopologicalName.START));
+        upperFace.setName(TopologicalName.of(featureId, TopologicalName.END));
         
         List<Face> sideFaces = createSideFaces(body, lowerEdges, upperEdges, sideEdges);
         
@@ -60,8 +82,37 @@ public class LinearSweepFeature {
             body.addFace(sideFace);
         }
         
-        body.validateTopology();
-        return body;
+        return body.validateTopology();
+    }
+
+    // Returns the body from the last generate() when neither the sketch nor any parameter changed;
+    // its faces and edges keep their identities, so references into it stay bound
+    public BRepBody regenerate() throws TopologyException {
+        return isUpToDate() ? lastBody : generate();
+    }
+
+    public boolean isUpToDate() {
+        return lastBody != null && lastSignature == inputSignature();
+    }
+
+    private long inputSignature() {
+        long hash = sketch != null ? sketch.getGeometrySignature() : 0;
+        hash = 31 * hash + Double.hashCode(distance);
+        hash = 31 * hash + direction.hashCode();
+        hash = 31 * hash + (addDraft ? Double.hashCode(draftAngle) : 0);
+        return 31 * hash + tolerance.hashCode();
+    }
+
+    public String getFeatureId() {
+        return featureId;
+    }
+
+    // Prefix of the persistent names of everything this feature generates
+    public void setFeatureId(String featureId) {
+        if (featureId == null || featureId.isEmpty() || featureId.contains("/")) {
+            throw new IllegalArgumentException("Feature id must be non-empty and must not contain '/'");
+        }
+        this.featureId = featureId;
     }
 
     private void validateInput() throws TopologyException {
@@ -126,7 +177,7 @@ public class LinearSweepFeature {
         return true;
     }
 
-    private List<Vertex> createVerticesFromSketch(BRepBody body, double offset) throws TopologyException {
+    private List<Vertex> createVerticesFromSketch(BRepBody body, double offset, String role) throws TopologyException {
         List<Vertex> vertices = new ArrayList<>();
         Set<Vector3d> uniquePoints = new HashSet<>();
         
@@ -140,36 +191,33 @@ public class LinearSweepFeature {
                 Vector3d end3d = new Vector3d(end.x, end.y, offset);
                 
                 if (!uniquePoints.contains(start3d)) {
-                    Vertex vertex = new Vertex(start3d);
-                    body.addVertex(vertex);
+                    Vertex vertex = newVertex(body, start3d, role, entity, 0);
                     vertices.add(vertex);
                     uniquePoints.add(start3d);
                 }
                 
                 if (!uniquePoints.contains(end3d)) {
-                    Vertex vertex = new Vertex(end3d);
-                    body.addVertex(vertex);
+                    Vertex vertex = newVertex(body, end3d, role, entity, 1);
                     vertices.add(vertex);
                     uniquePoints.add(end3d);
                 }
             } else if (entity instanceof Sketch.Arc) {
                 Sketch.Arc arc = (Sketch.Arc) entity;
-                int segments = 12;
+                int segments = arcSegments(arc);
                 for (int i = 0; i <= segments; i++) {
                     double t = (double) i / segments;
                     Vector3d point = getArcPointAt(arc, t);
                     point = new Vector3d(point.x(), point.y(), offset);
                     
                     if (!uniquePoints.contains(point)) {
-                        Vertex vertex = new Vertex(point);
-                        body.addVertex(vertex);
+                        Vertex vertex = newVertex(body, point, role, entity, i);
                         vertices.add(vertex);
                         uniquePoints.add(point);
                     }
                 }
             } else if (entity instanceof Sketch.Circle) {
                 Sketch.Circle circle = (Sketch.Circle) entity;
-                int segments = 24;
+                int segments = circleSegments(circle);
                 for (int i = 0; i <= segments; i++) {
                     double t = (double) i / segments;
                     double angle = 2 * Math.PI * t;
@@ -178,20 +226,19 @@ public class LinearSweepFeature {
                     Vector3d point = new Vector3d(x, y, offset);
                     
                     if (!uniquePoints.contains(point)) {
-                        Vertex vertex = new Vertex(point);
-                        body.addVertex(vertex);
+                        Vertex vertex = newVertex(body, point, role, entity, i);
                         vertices.add(vertex);
                         uniquePoints.add(point);
                     }
                 }
             } else if (entity instanceof Sketch.Polygon) {
                 Sketch.Polygon polygon = (Sketch.Polygon) entity;
-                for (Sketch.PointEntity pointEntity : polygon.getSketchPoints()) {
-                    Vector3d point = new Vector3d(pointEntity.getX(), pointEntity.getY(), offset);
+                List<Sketch.PointEntity> points = polygon.getSketchPoints();
+                for (int i = 0; i < points.size(); i++) {
+                    Vector3d point = new Vector3d(points.get(i).getX(), points.get(i).getY(), offset);
                     
                     if (!uniquePoints.contains(point)) {
-                        Vertex vertex = new Vertex(point);
-                        body.addVertex(vertex);
+                        Vertex vertex = newVertex(body, point, role, entity, i);
                         vertices.add(vertex);
                         uniquePoints.add(point);
                     }
@@ -202,6 +249,28 @@ public class LinearSweepFeature {
         return vertices;
     }
 
+    // Named after the sketch entity and point it came from; the first entity to reach a shared
+    // corner names it
+    private Vertex newVertex(BRepBody body, Vector3d point, String role, Sketch.Entity entity, int index) {
+        Vertex vertex = new Vertex(point);
+        vertex.setName(TopologicalName.of(featureId, role, entity.getId(), index));
+        body.addVertex(vertex);
+        return vertex;
+    }
+
+    public void setTolerance(TessellationTolerance tolerance) {
+        this.tolerance = tolerance;
+    }
+
+    private int arcSegments(Sketch.Arc arc) {
+        double sweep = Math.toRadians(arc.getEndAngle() - arc.getStartAngle());
+        return tolerance.segmentsForArc(arc.getRadius(), sweep);
+    }
+
+    private int circleSegments(Sketch.Circle circle) {
+        return tolerance.segmentsForArc(circle.getRadius(), 2 * Math.PI);
+    }
+
     private Vector3d getArcPointAt(Sketch.Arc arc, double t) {
         double startAngle = Math.toRadians(arc.getStartAngle());
         double endAngle = Math.toRadians(arc.getEndAngle());
@@ -213,8 +282,9 @@ public class LinearSweepFeature {
         return new Vector3d(x, y, 0);
     }
 
-    private List<Edge> createEdgesFromVertices(BRepBody body, List<Vertex> vertices, double z) {
+    private List<Edge> createEdgesFromVertices(BRepBody body, List<Vertex> vertices, double z, String role) {
         List<Edge> edges = new ArrayList<>();
+        Map<Vector3d, Vertex> index = indexVertices(vertices);
         
         for (Sketch.Entity entity : sketch.getEntities()) {
             if (entity instanceof Sketch.Line) {
@@ -222,12 +292,13 @@ public class LinearSweepFeature {
                 Vector3d start = new Vector3d(line.getX1(), line.getY1(), z);
                 Vector3d end = new Vector3d(line.getX2(), line.getY2(), z);
                 
-                Vertex startVertex = findVertex(vertices, start);
-                Vertex endVertex = findVertex(vertices, end);
+                Vertex startVertex = findVertex(index, vertices, start);
+                Vertex endVertex = findVertex(index, vertices, end);
                 
                 if (startVertex != null && endVertex != null) {
                     LineCurve curve = new LineCurve(startVertex.getPoint(), endVertex.getPoint());
                     Edge edge = new Edge(startVertex, endVertex, curve);
+                    edge.setName(TopologicalName.of(featureId, role, entity.getId(), 0));
                     body.addEdge(edge);
                     edges.add(edge);
                     
@@ -237,7 +308,7 @@ public class LinearSweepFeature {
                 }
             } else if (entity instanceof Sketch.Arc) {
                 Sketch.Arc arc = (Sketch.Arc) entity;
-                int segments = 12;
+                int segments = arcSegments(arc);
                 
                 for (int i = 0; i < segments; i++) {
                     double t1 = (double) i / segments;
@@ -248,20 +319,21 @@ public class LinearSweepFeature {
                     p1 = new Vector3d(p1.x(), p1.y(), z);
                     p2 = new Vector3d(p2.x(), p2.y(), z);
                     
-                    Vertex v1 = findVertex(vertices, p1);
-                    Vertex v2 = findVertex(vertices, p2);
+                    Vertex v1 = findVertex(index, vertices, p1);
+                    Vertex v2 = findVertex(index, vertices, p2);
                     
                     if (v1 != null && v2 != null) {
                         Vector3d center = new Vector3d(arc.getX(), arc.getY(), z);
                         LineCurve curve = new LineCurve(v1.getPoint(), v2.getPoint());
                         Edge edge = new Edge(v1, v2, curve);
+                        edge.setName(TopologicalName.of(featureId, role, entity.getId(), i));
                         body.addEdge(edge);
                         edges.add(edge);
                     }
                 }
             } else if (entity instanceof Sketch.Circle) {
                 Sketch.Circle circle = (Sketch.Circle) entity;
-                int segments = 24;
+                int segments = circleSegments(circle);
                 
                 for (int i = 0; i < segments; i++) {
                     double angle1 = 2 * Math.PI * i / segments;
@@ -272,12 +344,13 @@ public class LinearSweepFeature {
                     Vector3d p2 = new Vector3d(circle.getX() + circle.getRadius() * Math.cos(angle2),
                                              circle.getY() + circle.getRadius() * Math.sin(angle2), z);
                     
-                    Vertex v1 = findVertex(vertices, p1);
-                    Vertex v2 = findVertex(vertices, p2);
+                    Vertex v1 = findVertex(index, vertices, p1);
+                    Vertex v2 = findVertex(index, vertices, p2);
                     
                     if (v1 != null && v2 != null) {
                         LineCurve curve = new LineCurve(v1.getPoint(), v2.getPoint());
                         Edge edge = new Edge(v1, v2, curve);
+                        edge.setName(TopologicalName.of(featureId, role, entity.getId(), i));
                         body.addEdge(edge);
                         edges.add(edge);
                     }
@@ -293,12 +366,13 @@ public class LinearSweepFeature {
                     Vector3d v1_3d = new Vector3d(p1.getX(), p1.getY(), z);
                     Vector3d v2_3d = new Vector3d(p2.getX(), p2.getY(), z);
                     
-                    Vertex v1 = findVertex(vertices, v1_3d);
-                    Vertex v2 = findVertex(vertices, v2_3d);
+                    Vertex v1 = findVertex(index, vertices, v1_3d);
+                    Vertex v2 = findVertex(index, vertices, v2_3d);
                     
                     if (v1 != null && v2 != null) {
                         LineCurve curve = new LineCurve(v1.getPoint(), v2.getPoint());
                         Edge edge = new Edge(v1, v2, curve);
+                        edge.setName(TopologicalName.of(featureId, role, entity.getId(), i));
                         body.addEdge(edge);
                         edges.add(edge);
                     }
@@ -312,34 +386,20 @@ public class LinearSweepFeature {
     private List<Edge> createSideEdges(BRepBody body, List<Vertex> lowerVertices, List<Vertex> upperVertices) {
         List<Edge> sideEdges = new ArrayList<>();
         
+        Map<Vector3d, Vertex> index = indexVertices(upperVertices);
+        MutableVector3d upperPoint = new MutableVector3d();
         for (int i = 0; i < lowerVertices.size(); i++) {
             Vertex lower = lowerVertices.get(i);
-            Vector3d upperPoint = lower.getPoint().plus(direction.multiply(distance));
-            Vertex upper = findVertex(upperVertices, upperPoint);
+            upperPoint.set(lower.getPoint()).addScaled(direction, distance);
+            Vertex upper = findVertex(index, upperVertices, upperPoint.toVector3d());
             
             if (upper != null) {
-                if (addDraft && Math.abs(draftAngle) > 1e-6) {
-                    Vector3d offset = upper.getPoint().minus(lower.getPoint());
-                    Vector3d center = lower.getPoint().plus(upper.getPoint()).multiply(0.5);
-                    double draftRadius = Math.max(0.1, offset.magnitude() * Math.tan(draftAngle));
-                    
-                    Vector3d radial = offset.cross(direction);
-                    if (radial.magnitude() < 1e-6) {
-                        radial = Vector3d.X_AXIS;
-                    } else {
-                        radial = radial.normalize();
-                    }
-                    
-                    LineCurve curve = new LineCurve(lower.getPoint(), upper.getPoint());
-                    Edge edge = new Edge(lower, upper, curve);
-                    body.addEdge(edge);
-                    sideEdges.add(edge);
-                } else {
-                    LineCurve curve = new LineCurve(lower.getPoint(), upper.getPoint());
-                    Edge edge = new Edge(lower, upper, curve);
-                    body.addEdge(edge);
-                    sideEdges.add(edge);
-                }
+                // Drafted sides still run straight between the two caps
+                LineCurve curve = new LineCurve(lower.getPoint(), upper.getPoint());
+                Edge edge = new Edge(lower, upper, curve);
+                edge.setName(derivedName(lower.getName(), TopologicalName.LATERAL));
+                body.addEdge(edge);
+                sideEdges.add(edge);
             }
         }
         
@@ -370,16 +430,26 @@ public class LinearSweepFeature {
             vertexToEdges.computeIfAbsent(edge.getEndVertex(), k -> new ArrayList<>()).add(edge);
         }
         
+        Map<Vertex, Edge> sideByLower = new IdentityHashMap<>();
+        for (Edge side : sideEdges) {
+            sideByLower.putIfAbsent(side.getStartVertex(), side);
+        }
+        
+        // Each side runs its lower edge the way the sketch loop does, which is against the lower cap
+        List<Vertex> origins = new EdgeLoop(lowerEdges).getWalkOrigins();
         for (int i = 0; i < lowerEdges.size(); i++) {
             Edge lowerEdge = lowerEdges.get(i);
-            Vertex v1 = lowerEdge.getStartVertex();
-            Vertex v2 = lowerEdge.getEndVertex();
+            Vertex v1 = origins.get(i);
+            Vertex v2 = lowerEdge.getStartVertex() == v1 ? lowerEdge.getEndVertex() : lowerEdge.getStartVertex();
             
-            Edge side1 = findSideEdge(sideEdges, v1, v1.getPoint().plus(direction.multiply(distance)));
-            Edge side2 = findSideEdge(sideEdges, v2, v2.getPoint().plus(direction.multiply(distance)));
+            Edge side1 = findSideEdge(sideByLower, v1);
+            Edge side2 = findSideEdge(sideByLower, v2);
             
             if (side1 != null && side2 != null) {
-                List<Edge> faceEdges = Arrays.asList(lowerEdge, side2, side1);
+                Edge upperEdge = findEdgeBetween(vertexToEdges, side1.getEndVertex(), side2.getEndVertex());
+                List<Edge> faceEdges = upperEdge != null
+                        ? Arrays.asList(lowerEdge, side2, upperEdge, side1)
+                        : Arrays.asList(lowerEdge, side2, side1);
                 EdgeLoop loop = new EdgeLoop(faceEdges);
                 
                 Surface surface;
@@ -393,6 +463,7 @@ public class LinearSweepFeature {
                 }
                 
                 Face face = new Face(surface, loop);
+                face.setName(derivedName(lowerEdge.getName(), TopologicalName.SIDE));
                 sideFaces.add(face);
             }
         }
@@ -400,26 +471,56 @@ public class LinearSweepFeature {
         return sideFaces;
     }
 
-    private Vertex findVertex(List<Vertex> vertices, Vector3d point) {
-        for (Vertex vertex : vertices) {
-            if (vertex.getPoint().distance(point) < 1e-6) {
-                return vertex;
+    private static TopologicalName derivedName(TopologicalName generator, String role) {
+        return generator != null ? generator.withRole(role) : null;
+    }
+
+    private Edge findEdgeBetween(Map<Vertex, List<Edge>> vertexToEdges, Vertex a, Vertex b) {
+        for (Edge edge : vertexToEdges.getOrDefault(a, Collections.emptyList())) {
+            if ((edge.getStartVertex().equals(a) && edge.getEndVertex().equals(b))
+                    || (edge.getStartVertex().equals(b) && edge.getEndVertex().equals(a))) {
+                return edge;
             }
         }
         return null;
     }
 
-    private Edge findSideEdge(List<Edge> sideEdges, Vertex start, Vector3d end) {
-        for (Edge edge : sideEdges) {
-            if (edge.getStartVertex().equals(start)) {
-                if (edge.getEndVertex().getPoint().distance(end) < 1e-6) {
-                    return edge;
-                }
+    // Exact hits come from the hash index; the tolerance scan only runs on a miss
+    private Vertex findVertex(Map<Vector3d, Vertex> index, List<Vertex> vertices, Vector3d point) {
+        Vertex vertex = index.get(point);
+        return vertex != null ? vertex : findVertex(vertices, point.x(), point.y(), point.z());
+    }
+
+    private Map<Vector3d, Vertex> indexVertices(List<Vertex> vertices) {
+        Map<Vector3d, Vertex> index = new HashMap<>(2 * vertices.size());
+        for (Vertex vertex : vertices) {
+            index.putIfAbsent(vertex.getPoint(), vertex);
+        }
+        return index;
+    }
+
+    private Vertex findVertex(List<Vertex> vertices, double x, double y, double z) {
+        for (Vertex vertex : vertices) {
+            if (vertex.getPoint().distanceSquared(x, y, z) < 1e-12) {
+                return vertex;
             }
         }
         return null;
     }
 
+    // Side edge leaving start whose far end is start swept by the extrusion offset
+    private Edge findSideEdge(Map<Vertex, Edge> sideByLower, Vertex start) {
+        Edge edge = sideByLower.get(start);
+        if (edge == null) {
+            return null;
+        }
+        Vector3d p = start.getPoint();
+        double x = p.x() + direction.x() * distance;
+        double y = p.y() + direction.y() * distance;
+        double z = p.z() + direction.z() * distance;
+        return edge.getEndVertex().getPoint().distanceSquared(x, y, z) < 1e-12 ? edge : null;
+    }
+
     public static LinearSweepBuilder builder() {
         return new LinearSweepBuilder();
     }
@@ -430,6 +531,8 @@ public class LinearSweepFeature {
         private Vector3d direction = Vector3d.Z_AXIS;
         private boolean addDraft = false;
         private double draftAngle = 0.0;
+        private TessellationTolerance tolerance = TessellationTolerance.DEFAULT;
+        private String featureId;
 
         public LinearSweepBuilder sketch(Sketch sketch) {
             this.sketch = sketch;
@@ -452,8 +555,23 @@ public class LinearSweepFeature {
             return this;
         }
 
+        public LinearSweepBuilder tolerance(TessellationTolerance tolerance) {
+            this.tolerance = tolerance;
+            return this;
+        }
+
+        public LinearSweepBuilder id(String featureId) {
+            this.featureId = featureId;
+            return this;
+        }
+
         public LinearSweepFeature build() {
-            return new LinearSweepFeature(sketch, distance, direction, addDraft, draftAngle);
+            LinearSweepFeature feature = new LinearSweepFeature(sketch, distance, direction, addDraft, draftAngle);
+            feature.setTolerance(tolerance);
+            if (featureId != null) {
+                feature.setFeatureId(featureId);
+            }
+            return feature;
         }
     }
 }
\ No newline at end of file
@@ -4,14 +4,26 @@ import cad.topology.*;
 import cad.geometry.surfaces.*;
 import cad.geometry.curves.*;
 import cad.core.*;
+import cad.math.MutableVector3d;
 import cad.math.Vector3d;
 import java.util.*;
+import java.util.concurrent.atomic.AtomicInteger;
 
 public class RotationalSweepFeature {
     private Sketch sketch;
     private Vector3d axisOrigin;
     private Vector3d axisDirection;
     private double angle;
+    private String featureId = "revolve" + NEXT_ID.incrementAndGet();
+    private BRepBody lastBody;
+    private long lastSignature;
+
+    private static final AtomicInteger NEXT_ID = new AtomicInteger();
+
+    private final MutableVector3d scratch = new MutableVector3d();
+    private double cachedTheta = Double.NaN;
+    private double cachedCos;
+    private double cachedSin;
 
     public RotationalSweepFeature(Sketch sketch, Vector3d axisOrigin, Vector3d axisDirection, double angle) {
         this.sketch = sketch;
@@ -60,18 +72,57 @@ public class RotationalSweepFeature {
         // 5. Create cap faces if not full revolve
         if (!isFullRevolve) {
             Vector3d startNormal = rotateVector(getSketchNormal(), 0.0);
-            Face startFace = createCapFace(body, startProfileEdges, startNormal.negated());
+            // The swept faces walk the start profile in sketch order, so its cap walks it backwards
+            List<Edge> startLoop = new ArrayList<>(startProfileEdges);
+            Collections.reverse(startLoop);
+            Face startFace = createCapFace(body, startLoop, startNormal.negated());
+            startFace.setName(TopologicalName.of(featureId, TopologicalName.START));
             body.addFace(startFace);
             
             Vector3d endNormal = rotateVector(getSketchNormal(), angle);
             Face endFace = createCapFace(body, endProfileEdges, endNormal);
+            endFace.setName(TopologicalName.of(featureId, TopologicalName.END));
             body.addFace(endFace);
         }
         
         body.validateTopology();
+        lastBody = body;
+        lastSignature = inputSignature();
         return body;
     }
 
+    // Returns the body from the last generate() when neither the sketch nor any parameter changed
+    public BRepBody regenerate() throws TopologyException {
+        return isUpToDate() ? lastBody : generate();
+    }
+
+    public boolean isUpToDate() {
+        return lastBody != null && lastSignature == inputSignature();
+    }
+
+    private long inputSignature() {
+        long hash = sketch != null ? sketch.getGeometrySignature() : 0;
+        hash = 31 * hash + axisOrigin.hashCode();
+        hash = 31 * hash + axisDirection.hashCode();
+        return 31 * hash + Double.hashCode(angle);
+    }
+
+    public String getFeatureId() {
+        return featureId;
+    }
+
+    // Prefix of the persistent names of everything this feature generates
+    public void setFeatureId(String featureId) {
+        if (featureId == null || featureId.isEmpty() || featureId.contains("/")) {
+            throw new IllegalArgumentException("Feature id must be non-empty and must not contain '/'");
+        }
+        this.featureId = featureId;
+    }
+
+    private static String roleAt(double currentAngle) {
+        return currentAngle == 0.0 ? TopologicalName.START : TopologicalName.END;
+    }
+
     private void validateInput() throws TopologyException {
         if (sketch == null) throw new TopologyException("Sketch cannot be null");
         if (angle <= 0 || angle > 2 * Math.PI + 1e-6) throw new TopologyException("Angle must be between 0 and 360 degrees");
@@ -84,75 +135,80 @@ public class RotationalSweepFeature {
         return Vector3d.Z_AXIS; // By default sketch is on XY plane
     }
 
+    // Every profile point is rotated by the same one or two angles, so cos/sin are cached
+    // and the rotation runs in a scratch vector
     private Vector3d rotatePoint(Vector3d point, double theta) {
-        Vector3d toPoint = point.subtract(axisOrigin);
-        double axialDist = axisDirection.dot(toPoint);
-        Vector3d axialComp = axisDirection.multiply(axialDist);
-        Vector3d radialComp = toPoint.subtract(axialComp);
-        
-        if (radialComp.magnitude() < 1e-6) {
+        if (theta == 0.0) {
             return point;
         }
-        
-        Vector3d radialDir = radialComp.normalize();
-        Vector3d tangentDir = axisDirection.cross(radialDir).normalize();
-        
-        Vector3d rotatedRadial = radialDir.multiply(Math.cos(theta)).plus(tangentDir.multiply(Math.sin(theta)));
-        return axisOrigin.plus(axialComp).plus(rotatedRadial.multiply(radialComp.magnitude()));
+        updateRotation(theta);
+        return scratch.set(point).sub(axisOrigin).rotate(axisDirection, cachedCos, cachedSin)
+                .add(axisOrigin).toVector3d();
     }
 
     private Vector3d rotateVector(Vector3d vec, double theta) {
-        double axialDist = axisDirection.dot(vec);
-        Vector3d axialComp = axisDirection.multiply(axialDist);
-        Vector3d radialComp = vec.subtract(axialComp);
-        
-        if (radialComp.magnitude() < 1e-6) {
+        if (theta == 0.0) {
             return vec;
         }
-        
-        Vector3d radialDir = radialComp.normalize();
-        Vector3d tangentDir = axisDirection.cross(radialDir).normalize();
-        
-        Vector3d rotatedRadial = radialDir.multiply(Math.cos(theta)).plus(tangentDir.multiply(Math.sin(theta)));
-        return axialComp.plus(rotatedRadial.multiply(radialComp.magnitude()));
+        updateRotation(theta);
+        return scratch.set(vec).rotate(axisDirection, cachedCos, cachedSin).toVector3d();
+    }
+
+    private void updateRotation(double theta) {
+        if (theta != cachedTheta) {
+            cachedTheta = theta;
+            cachedCos = Math.cos(theta);
+            cachedSin = Math.sin(theta);
+        }
     }
 
     private List<Vertex> createVerticesFromSketch(BRepBody body, double currentAngle) throws TopologyException {
         List<Vertex> vertices = new ArrayList<>();
         Set<Vector3d> uniquePoints = new HashSet<>();
+        OperationMonitor monitor = OperationMonitor.current();
         
         for (Sketch.Entity entity : sketch.getEntities()) {
+            // Deduplication is quadratic in the profile size, so large sketches can be cancelled here
+            monitor.checkCancelled();
             if (entity instanceof Sketch.Line) {
                 Sketch.Line line = (Sketch.Line) entity;
                 Vector3d start3d = rotatePoint(new Vector3d(line.getStartPoint().x, line.getStartPoint().y, 0), currentAngle);
                 Vector3d end3d = rotatePoint(new Vector3d(line.getEndPoint().x, line.getEndPoint().y, 0), currentAngle);
                 
-                addUniqueVertex(body, vertices, uniquePoints, start3d);
-                addUniqueVertex(body, vertices, uniquePoints, end3d);
+                addUniqueVertex(body, vertices, uniquePoints, start3d, nameAt(currentAngle, entity, 0));
+                addUniqueVertex(body, vertices, uniquePoints, end3d, nameAt(currentAngle, entity, 1));
             } else if (entity instanceof Sketch.Polygon) {
                 Sketch.Polygon poly = (Sketch.Polygon) entity;
-                for (Sketch.PointEntity p : poly.getSketchPoints()) {
-                    Vector3d pt3d = rotatePoint(new Vector3d(p.getX(), p.getY(), 0), currentAngle);
-                    addUniqueVertex(body, vertices, uniquePoints, pt3d);
+                List<Sketch.PointEntity> pts = poly.getSketchPoints();
+                for (int i = 0; i < pts.size(); i++) {
+                    Vector3d pt3d = rotatePoint(new Vector3d(pts.get(i).getX(), pts.get(i).getY(), 0), currentAngle);
+                    addUniqueVertex(body, vertices, uniquePoints, pt3d, nameAt(currentAngle, entity, i));
                 }
             }
         }
         return vertices;
     }
 
-    private void addUniqueVertex(BRepBody body, List<Vertex> vertices, Set<Vector3d> uniquePoints, Vector3d point) {
+    private TopologicalName nameAt(double currentAngle, Sketch.Entity entity, int index) {
+        return TopologicalName.of(featureId, roleAt(currentAngle), entity.getId(), index);
+    }
+
+    private void addUniqueVertex(BRepBody body, List<Vertex> vertices, Set<Vector3d> uniquePoints, Vector3d point,
+            TopologicalName name) {
         for (Vector3d p : uniquePoints) {
-            if (p.distance(point) < 1e-6) return;
+            if (p.distanceSquared(point.x(), point.y(), point.z()) < 1e-12) return;
         }
         Vertex v = new Vertex(point);
+        v.setName(name);
         body.addVertex(v);
         vertices.add(v);
         uniquePoints.add(point);
     }
 
     private Vertex findVertex(List<Vertex> vertices, Vector3d point) {
+        double x = point.x(), y = point.y(), z = point.z();
         for (Vertex v : vertices) {
-            if (v.getPoint().distance(point) < 1e-6) return v;
+            if (v.getPoint().distanceSquared(x, y, z) < 1e-12) return v;
         }
         return null;
     }
@@ -171,6 +227,7 @@ public class RotationalSweepFeature {
                 if (v1 != null && v2 != null) {
                     LineCurve curve = new LineCurve(v1.getPoint(), v2.getPoint());
                     Edge edge = new Edge(v1, v2, curve);
+                    edge.setName(nameAt(currentAngle, entity, 0));
                     body.addEdge(edge);
                     edges.add(edge);
                     v1.addIncidentEdge(edge);
@@ -189,6 +246,7 @@ public class RotationalSweepFeature {
                     if (v1 != null && v2 != null) {
                         LineCurve curve = new LineCurve(v1.getPoint(), v2.getPoint());
                         Edge edge = new Edge(v1, v2, curve);
+                        edge.setName(nameAt(currentAngle, entity, i));
                         body.addEdge(edge);
                         edges.add(edge);
                         v1.addIncidentEdge(edge);
@@ -207,20 +265,21 @@ public class RotationalSweepFeature {
             Vertex vEnd = endVertices.get(i); // If isFullRevolve, vEnd == vStart
             
             // Check if vertex is on the axis
-            Vector3d toPoint = vStart.getPoint().subtract(axisOrigin);
-            Vector3d radial = toPoint.subtract(axisDirection.multiply(axisDirection.dot(toPoint)));
-            if (radial.magnitude() < 1e-6) {
+            scratch.set(vStart.getPoint()).sub(axisOrigin);
+            scratch.addScaled(axisDirection, -scratch.dot(axisDirection));
+            if (scratch.magnitudeSquared() < 1e-12) {
                 edges.add(null); // No trajectory edge for point on axis
                 continue;
             }
             
-            // Create an ArcCurve for the trajectory
-            // We approximate it with a LineCurve for now if angle is small, or use a generic Curve
-            // Since we need a Curve object, let's just use LineCurve between start and end.
-            // In a real BRep, this should be an ArcCurve! But since cad.geometry.curves.ArcCurve doesn't support 3D arcs directly easily,
-            // we will use a placeholder linecurve. This is only used for edge geometry.
-            LineCurve curve = new LineCurve(vStart.getPoint(), vEnd.getPoint());
+            // The circle the vertex sweeps. Both faces on either side tessellate this edge, so it
+            // carries the true arc rather than a chord and they share its samples.
+            Vector3d center = vStart.getPoint().minus(scratch.toVector3d());
+            ArcCurve curve = ArcCurve.fromStart(center, vStart.getPoint(), angle, axisDirection);
             Edge edge = new Edge(vStart, vEnd, curve);
+            if (vStart.getName() != null) {
+                edge.setName(vStart.getName().withRole(TopologicalName.LATERAL));
+            }
             body.addEdge(edge);
             edges.add(edge);
             
@@ -243,13 +302,18 @@ public class RotationalSweepFeature {
 
     private List<Face> createSweptFaces(BRepBody body, List<Edge> startEdges, List<Edge> endEdges, List<Edge> trajectoryEdges) throws TopologyException {
         List<Face> sweptFaces = new ArrayList<>();
+        OperationMonitor monitor = OperationMonitor.current();
+        monitor.begin("Revolving profile", startEdges.size());
         
+        // Each face runs its start edge the way the profile loop does, which is against the start cap
+        List<Vertex> origins = new EdgeLoop(startEdges).getWalkOrigins();
         for (int i = 0; i < startEdges.size(); i++) {
+            monitor.step();
             Edge startEdge = startEdges.get(i);
             Edge endEdge = endEdges.get(i);
             
-            Vertex v1 = startEdge.getStartVertex();
-            Vertex v2 = startEdge.getEndVertex();
+            Vertex v1 = origins.get(i);
+            Vertex v2 = startEdge.getStartVertex() == v1 ? startEdge.getEndVertex() : startEdge.getStartVertex();
             
             Edge traj1 = findTrajectoryEdge(trajectoryEdges, v1);
             Edge traj2 = findTrajectoryEdge(trajectoryEdges, v2);
@@ -257,7 +321,8 @@ public class RotationalSweepFeature {
             List<Edge> faceEdges = new ArrayList<>();
             faceEdges.add(startEdge);
             if (traj2 != null) faceEdges.add(traj2);
-            if (startEdge != endEdge) faceEdges.add(endEdge);
+            // A full revolution closes the face on its profile edge, which the loop then runs twice
+            faceEdges.add(endEdge);
             if (traj1 != null) faceEdges.add(traj1); // In proper order, need to reverse if needed
             
             // Surface of revolution
@@ -266,6 +331,9 @@ public class RotationalSweepFeature {
             
             EdgeLoop loop = new EdgeLoop(faceEdges);
             Face face = new Face(surface, loop);
+            if (startEdge.getName() != null) {
+                face.setName(startEdge.getName().withRole(TopologicalName.SIDE));
+            }
             sweptFaces.add(face);
         }
         return sweptFaces;
@@ -287,6 +355,7 @@ public class RotationalSweepFeature {
         private Vector3d axisOrigin = Vector3d.zero();
         private Vector3d axisDirection = Vector3d.Y_AXIS;
         private double angle = 2 * Math.PI;
+        private String featureId;
 
         public RotationalSweepBuilder sketch(Sketch sketch) {
             this.sketch = sketch;
@@ -304,8 +373,16 @@ public class RotationalSweepFeature {
             this.angle = angle;
             return this;
         }
+        public RotationalSweepBuilder id(String featureId) {
+            this.featureId = featureId;
+            return this;
+        }
         public RotationalSweepFeature build() {
-            return new RotationalSweepFeature(sketch, axisOrigin, axisDirection, angle);
+            RotationalSweepFeature feature = new RotationalSweepFeature(sketch, axisOrigin, axisDirection, angle);
+            if (featureId != null) {
+                feature.setFeatureId(featureId);
+            }
+            return feature;
         }
     }
 }
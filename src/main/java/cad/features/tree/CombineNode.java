@@ -0,0 +1,36 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.geometry.tessellation.TessellationTolerance;
+import eu.mihosoft.jcsg.CSG;
+import java.util.List;
+
+// Boolean of two solid features
+public class CombineNode extends FeatureNode {
+    private volatile Geometry.BooleanOp op;
+
+    public CombineNode(String id, FeatureNode first, FeatureNode second, Geometry.BooleanOp op) {
+        super(id, first, second);
+        this.op = op;
+    }
+
+    public Geometry.BooleanOp getOp() {
+        return op;
+    }
+
+    public void setOp(Geometry.BooleanOp op) {
+        this.op = op;
+    }
+
+    @Override
+    protected long signature() {
+        return op.ordinal();
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        CSG first = (CSG) inputValues.get(0);
+        CSG second = (CSG) inputValues.get(1);
+        return Geometry.combine(first, second, op);
+    }
+}
@@ -0,0 +1,37 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.core.Sketch;
+import cad.geometry.tessellation.TessellationTolerance;
+import eu.mihosoft.jcsg.CSG;
+import java.util.List;
+
+// Subtracts the tool sketch extruded by depth from the target solid
+public class CutNode extends FeatureNode {
+    private volatile float depth;
+
+    public CutNode(String id, FeatureNode target, SketchNode tool, float depth) {
+        super(id, target, tool);
+        this.depth = depth;
+    }
+
+    public float getDepth() {
+        return depth;
+    }
+
+    public void setDepth(float depth) {
+        this.depth = depth;
+    }
+
+    @Override
+    protected long signature() {
+        return Float.floatToIntBits(depth);
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        CSG target = (CSG) inputValues.get(0);
+        CSG tool = Geometry.extrudeSolid((Sketch) inputValues.get(1), depth, tolerance);
+        return tool != null ? Geometry.combine(target, tool, Geometry.BooleanOp.DIFFERENCE) : target;
+    }
+}
@@ -0,0 +1,56 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.core.Sketch;
+import cad.features.extrusion.LinearSweepFeature;
+import cad.geometry.tessellation.TessellationTolerance;
+import cad.topology.BRepBody;
+import cad.topology.TopologyException;
+import java.util.List;
+
+public class ExtrudeNode extends FeatureNode {
+    private volatile float height;
+
+    private LinearSweepFeature topology;
+    private float topologyHeight;
+
+    public ExtrudeNode(String id, SketchNode profile, float height) {
+        super(id, profile);
+        this.height = height;
+    }
+
+    public float getHeight() {
+        return height;
+    }
+
+    public void setHeight(float height) {
+        this.height = height;
+    }
+
+    // The same extrusion as a B-rep whose faces and edges are named after this node, for features
+    // that refer to them by TopologicalName. Rebuilt only when the sketch, height or tolerance changed.
+    public synchronized BRepBody getBody(TessellationTolerance tolerance) {
+        float current = height;
+        if (topology == null || topologyHeight != current) {
+            Sketch sketch = ((SketchNode) getInputs().get(0)).getSketch();
+            topology = LinearSweepFeature.builder().sketch(sketch).distance(current).id(getId()).build();
+            topologyHeight = current;
+        }
+        topology.setTolerance(tolerance);
+        try {
+            return topology.regenerate();
+        } catch (TopologyException e) {
+            throw new IllegalArgumentException(e.getMessage(), e);
+        }
+    }
+
+    @Override
+    protected long signature() {
+        return Float.floatToIntBits(height);
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        return Geometry.extrudeSolid((Sketch) inputValues.get(0), height, tolerance);
+    }
+}
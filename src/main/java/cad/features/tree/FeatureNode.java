@@ -0,0 +1,105 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.geometry.tessellation.TessellationTolerance;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+// A step of the parametric history with explicit inputs and a cached output. A node is stale when
+// its own parameters (including any sketch it reads) no longer match the signature it was last
+// evaluated with, or when one of its inputs was re-evaluated in the same pass.
+public abstract class FeatureNode {
+    private final String id;
+    private final List<FeatureNode> inputs;
+
+    private Object output;
+    private String error;
+    private boolean evaluated;
+    private long evaluatedSignature;
+
+    protected FeatureNode(String id, FeatureNode... inputs) {
+        if (id == null || id.isEmpty() || id.contains("/")) {
+            throw new IllegalArgumentException("Feature id must be non-empty and must not contain '/'");
+        }
+        this.id = id;
+        List<FeatureNode> list = new ArrayList<>();
+        for (FeatureNode input : inputs) {
+            if (input == null) {
+                throw new IllegalArgumentException("Feature '" + id + "' has a null input");
+            }
+            list.add(input);
+        }
+        this.inputs = Collections.unmodifiableList(list);
+    }
+
+    public String getId() {
+        return id;
+    }
+
+    public List<FeatureNode> getInputs() {
+        return inputs;
+    }
+
+    // Hash of everything besides the inputs' outputs that the result depends on
+    protected abstract long signature();
+
+    // Computes the output from the inputs' outputs, in input order. Runs on a worker thread, where no
+    // ModelContext is bound, so circle and arc segment counts must come from the given tolerance.
+    protected abstract Object compute(List<Object> inputValues, TessellationTolerance tolerance);
+
+    public synchronized Object getOutput() {
+        return output;
+    }
+
+    public synchronized String getError() {
+        return error;
+    }
+
+    public synchronized boolean isStale() {
+        return !evaluated || evaluatedSignature != fullSignature(Geometry.getTessellationTolerance());
+    }
+
+    // Re-evaluates when stale or when an input changed; returns whether the output was replaced
+    synchronized boolean refresh(boolean inputsChanged, TessellationTolerance tolerance) {
+        long signature = fullSignature(tolerance);
+        if (evaluated && !inputsChanged && signature == evaluatedSignature) {
+            return false;
+        }
+        List<Object> values = new ArrayList<>(inputs.size());
+        String failedInput = null;
+        for (FeatureNode input : inputs) {
+            Object value = input.getOutput();
+            if (value == null) {
+                failedInput = input.getId();
+                break;
+            }
+            values.add(value);
+        }
+        if (failedInput != null) {
+            output = null;
+            error = "Input '" + failedInput + "' has no result";
+        } else {
+            try {
+                output = compute(values, tolerance);
+                error = output == null ? "Feature '" + id + "' produced no geometry" : null;
+            } catch (RuntimeException e) {
+                output = null;
+                error = e.getMessage() != null ? e.getMessage() : e.toString();
+            }
+        }
+        evaluated = true;
+        evaluatedSignature = signature;
+        return true;
+    }
+
+    // Circle and arc segment counts follow the tolerance, so a tolerance change invalidates every node
+    private long fullSignature(TessellationTolerance tolerance) {
+        return 31 * signature() + tolerance.hashCode();
+    }
+
+    @Override
+    public String toString() {
+        return getClass().getSimpleName() + "{" + id + "}";
+    }
+}
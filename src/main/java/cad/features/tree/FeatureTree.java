@@ -0,0 +1,172 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.geometry.tessellation.TessellationTolerance;
+import eu.mihosoft.jcsg.CSG;
+import java.util.ArrayList;
+import java.util.ArrayDeque;
+import java.util.Collections;
+import java.util.Deque;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ForkJoinPool;
+
+// Dependency DAG of modeling features. Nodes are added after their inputs, so insertion order is a
+// topological order and cycles cannot be formed. Regeneration chains one future per node onto its
+// inputs' futures: only the downstream cone of a changed node recomputes, and branches that do not
+// depend on each other run concurrently on the executor.
+public class FeatureTree {
+    private final List<FeatureNode> nodes = new ArrayList<>();
+    private final Map<String, FeatureNode> byId = new HashMap<>();
+    private final Executor executor;
+
+    public FeatureTree() {
+        this(ForkJoinPool.commonPool());
+    }
+
+    public FeatureTree(Executor executor) {
+        this.executor = executor;
+    }
+
+    public synchronized <T extends FeatureNode> T add(T node) {
+        if (byId.containsKey(node.getId())) {
+            throw new IllegalArgumentException("Duplicate feature id: " + node.getId());
+        }
+        for (FeatureNode input : node.getInputs()) {
+            if (byId.get(input.getId()) != input) {
+                throw new IllegalArgumentException("Input '" + input.getId() + "' of '" + node.getId() + "' is not in the tree");
+            }
+        }
+        nodes.add(node);
+        byId.put(node.getId(), node);
+        return node;
+    }
+
+    // Only leaves can be removed; removing a node others depend on would orphan them
+    public synchronized void remove(String id) {
+        FeatureNode node = require(id);
+        for (FeatureNode other : nodes) {
+            if (other.getInputs().contains(node)) {
+                throw new IllegalArgumentException("Feature '" + id + "' is used by '" + other.getId() + "'");
+            }
+        }
+        nodes.remove(node);
+        byId.remove(id);
+    }
+
+    public synchronized FeatureNode get(String id) {
+        return byId.get(id);
+    }
+
+    public synchronized List<FeatureNode> getNodes() {
+        return Collections.unmodifiableList(new ArrayList<>(nodes));
+    }
+
+    public synchronized List<FeatureNode> getDependents(String id) {
+        FeatureNode node = require(id);
+        List<FeatureNode> result = new ArrayList<>();
+        for (FeatureNode other : nodes) {
+            if (other.getInputs().contains(node)) {
+                result.add(other);
+            }
+        }
+        return result;
+    }
+
+    // The node and everything that transitively reads it, in topological order
+    public synchronized List<FeatureNode> downstreamCone(String id) {
+        Set<FeatureNode> cone = Collections.newSetFromMap(new IdentityHashMap<>());
+        cone.add(require(id));
+        List<FeatureNode> result = new ArrayList<>();
+        for (FeatureNode node : nodes) {
+            if (cone.contains(node) || node.getInputs().stream().anyMatch(cone::contains)) {
+                cone.add(node);
+                result.add(node);
+            }
+        }
+        return result;
+    }
+
+    // Everything the node transitively reads, in topological order
+    public synchronized List<FeatureNode> upstream(String id) {
+        Set<FeatureNode> seen = Collections.newSetFromMap(new IdentityHashMap<>());
+        Deque<FeatureNode> pending = new ArrayDeque<>();
+        pending.push(require(id));
+        while (!pending.isEmpty()) {
+            for (FeatureNode input : pending.pop().getInputs()) {
+                if (seen.add(input)) {
+                    pending.push(input);
+                }
+            }
+        }
+        List<FeatureNode> result = new ArrayList<>();
+        for (FeatureNode node : nodes) {
+            if (seen.contains(node)) {
+                result.add(node);
+            }
+        }
+        return result;
+    }
+
+    // Re-evaluates stale nodes and their downstream cones; returns the ids that were recomputed, in
+    // topological order. Failures are recorded on the nodes (see FeatureNode.getError) rather than thrown.
+    // The tolerance is read here, from the caller's context: the executor's threads have none bound.
+    public synchronized Set<String> regenerate() {
+        TessellationTolerance tolerance = Geometry.getTessellationTolerance();
+        Map<FeatureNode, CompletableFuture<Boolean>> futures = new IdentityHashMap<>();
+        for (FeatureNode node : nodes) {
+            List<CompletableFuture<Boolean>> inputs = new ArrayList<>();
+            for (FeatureNode input : node.getInputs()) {
+                inputs.add(futures.get(input));
+            }
+            CompletableFuture<Boolean> future = CompletableFuture
+                    .allOf(inputs.toArray(new CompletableFuture[0]))
+                    .thenApplyAsync(ignored -> {
+                        boolean inputsChanged = false;
+                        for (CompletableFuture<Boolean> input : inputs) {
+                            inputsChanged |= input.join();
+                        }
+                        return node.refresh(inputsChanged, tolerance);
+                    }, executor);
+            futures.put(node, future);
+        }
+
+        Set<String> recomputed = new LinkedHashSet<>();
+        for (FeatureNode node : nodes) {
+            try {
+                if (futures.get(node).join()) {
+                    recomputed.add(node.getId());
+                }
+            } catch (CompletionException e) {
+                throw new IllegalStateException("Regeneration of '" + node.getId() + "' failed", e.getCause());
+            }
+        }
+        return recomputed;
+    }
+
+    public CSG getSolid(String id) {
+        Object output = require(id).getOutput();
+        return output instanceof CSG ? (CSG) output : null;
+    }
+
+    // Regenerates and makes the node's solid the current model
+    public void show(String id) {
+        regenerate();
+        Geometry.setCurrentSolid(getSolid(id));
+    }
+
+    private synchronized FeatureNode require(String id) {
+        FeatureNode node = byId.get(id);
+        if (node == null) {
+            throw new IllegalArgumentException("Unknown feature: " + id);
+        }
+        return node;
+    }
+}
@@ -0,0 +1,76 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.geometry.tessellation.TessellationTolerance;
+import cad.math.Vector3d;
+import cad.topology.Edge;
+import cad.topology.TopologicalName;
+import eu.mihosoft.jcsg.CSG;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.List;
+
+// Approximate fillet along an edge of an upstream extrusion, referred to by its TopologicalName. The
+// name is resolved against the extrusion's current body on every evaluation, so the fillet follows
+// the edge when the sketch is edited rather than staying at the coordinates it was picked at.
+public class FilletNode extends FeatureNode {
+    private final TopologicalName edge;
+    private final ExtrudeNode edgeSource;
+    private volatile float radius;
+
+    public FilletNode(String id, FeatureNode target, TopologicalName edge, float radius) {
+        super(id, target);
+        if (edge == null) {
+            throw new IllegalArgumentException("Fillet needs an edge");
+        }
+        this.edge = edge;
+        this.edgeSource = findSource(target, edge.getFeatureId());
+        this.radius = radius;
+    }
+
+    // The extrusion that named the edge, which must be the target or one of its inputs
+    private static ExtrudeNode findSource(FeatureNode target, String featureId) {
+        Deque<FeatureNode> pending = new ArrayDeque<>();
+        pending.push(target);
+        while (!pending.isEmpty()) {
+            FeatureNode node = pending.pop();
+            if (node.getId().equals(featureId) && node instanceof ExtrudeNode) {
+                return (ExtrudeNode) node;
+            }
+            for (FeatureNode input : node.getInputs()) {
+                pending.push(input);
+            }
+        }
+        throw new IllegalArgumentException("No extrusion '" + featureId + "' upstream of '" + target.getId() + "'");
+    }
+
+    public TopologicalName getEdge() {
+        return edge;
+    }
+
+    public float getRadius() {
+        return radius;
+    }
+
+    public void setRadius(float radius) {
+        this.radius = radius;
+    }
+
+    @Override
+    protected long signature() {
+        return 31L * edge.hashCode() + Float.floatToIntBits(radius);
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        Edge resolved = edgeSource.getBody(tolerance).resolveEdge(edge);
+        if (resolved == null) {
+            throw new IllegalArgumentException("Edge " + edge + " no longer exists");
+        }
+        Vector3d a = resolved.getStartVertex().getPoint();
+        Vector3d b = resolved.getEndVertex().getPoint();
+        float[] edgePoints = { (float) a.x(), (float) a.y(), (float) a.z(), (float) b.x(), (float) b.y(), (float) b.z() };
+        return Geometry.combine((CSG) inputValues.get(0), Geometry.filletCutter(edgePoints, radius, tolerance),
+                Geometry.BooleanOp.DIFFERENCE);
+    }
+}
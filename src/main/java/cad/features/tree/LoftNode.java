@@ -0,0 +1,32 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.core.Sketch;
+import cad.geometry.tessellation.TessellationTolerance;
+import java.util.ArrayList;
+import java.util.List;
+
+// Lofts through one section per input sketch, in input order
+public class LoftNode extends FeatureNode {
+
+    public LoftNode(String id, SketchNode... sections) {
+        super(id, sections);
+        if (sections.length < 2) {
+            throw new IllegalArgumentException("Loft requires at least 2 profiles");
+        }
+    }
+
+    @Override
+    protected long signature() {
+        return 0;
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        List<Sketch> profiles = new ArrayList<>(inputValues.size());
+        for (Object value : inputValues) {
+            profiles.add((Sketch) value);
+        }
+        return Geometry.loftSolid(profiles, tolerance);
+    }
+}
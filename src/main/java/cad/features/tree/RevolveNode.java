@@ -0,0 +1,44 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.core.Sketch;
+import cad.geometry.tessellation.TessellationTolerance;
+import java.util.List;
+
+public class RevolveNode extends FeatureNode {
+    private volatile String axis;
+    private volatile float angle;
+
+    // Axis is "X" or "Y", as for Geometry.revolve; angle in degrees
+    public RevolveNode(String id, SketchNode profile, String axis, float angle) {
+        super(id, profile);
+        this.axis = axis;
+        this.angle = angle;
+    }
+
+    public String getAxis() {
+        return axis;
+    }
+
+    public void setAxis(String axis) {
+        this.axis = axis;
+    }
+
+    public float getAngle() {
+        return angle;
+    }
+
+    public void setAngle(float angle) {
+        this.angle = angle;
+    }
+
+    @Override
+    protected long signature() {
+        return 31L * axis.toUpperCase().hashCode() + Float.floatToIntBits(angle);
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        return Geometry.revolveSolid((Sketch) inputValues.get(0), axis, angle, tolerance);
+    }
+}
@@ -0,0 +1,32 @@
+package cad.features.tree;
+
+import cad.core.Sketch;
+import cad.geometry.tessellation.TessellationTolerance;
+import java.util.List;
+
+// Source node: its output is the sketch itself, and editing the sketch in place makes it stale
+public class SketchNode extends FeatureNode {
+    private final Sketch sketch;
+
+    public SketchNode(String id, Sketch sketch) {
+        super(id);
+        if (sketch == null) {
+            throw new IllegalArgumentException("Sketch cannot be null");
+        }
+        this.sketch = sketch;
+    }
+
+    public Sketch getSketch() {
+        return sketch;
+    }
+
+    @Override
+    protected long signature() {
+        return sketch.getGeometrySignature();
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        return sketch;
+    }
+}
@@ -0,0 +1,24 @@
+package cad.features.tree;
+
+import cad.core.Geometry;
+import cad.core.Sketch;
+import cad.geometry.tessellation.TessellationTolerance;
+import java.util.List;
+
+// Translates the profile's polygons and circles along the path's lines and splines
+public class SweepNode extends FeatureNode {
+
+    public SweepNode(String id, SketchNode profile, SketchNode path) {
+        super(id, profile, path);
+    }
+
+    @Override
+    protected long signature() {
+        return 0;
+    }
+
+    @Override
+    protected Object compute(List<Object> inputValues, TessellationTolerance tolerance) {
+        return Geometry.sweepSolid((Sketch) inputValues.get(0), (Sketch) inputValues.get(1), tolerance);
+    }
+}
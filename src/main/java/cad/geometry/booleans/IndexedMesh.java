@@ -0,0 +1,238 @@
+package cad.geometry.booleans;
+
+import cad.core.OperationMonitor;
+import eu.mihosoft.jcsg.CSG;
+import eu.mihosoft.jcsg.Polygon;
+import eu.mihosoft.jcsg.Vertex;
+import eu.mihosoft.vvecmath.Vector3d;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+// Triangle mesh with shared vertices: positions packed as xyz triples and three vertex indices per
+// triangle, counterclockwise seen from outside. The boolean engine works on these instead of JCSG
+// polygon soups so that neighbouring triangles agree on their edges.
+public final class IndexedMesh {
+    private final double[] positions;
+    private final int[] triangles;
+
+    public IndexedMesh(double[] positions, int[] triangles) {
+        if (positions.length % 3 != 0 || triangles.length % 3 != 0) {
+            throw new IllegalArgumentException("Positions and triangles must come in triples");
+        }
+        this.positions = positions;
+        this.triangles = triangles;
+    }
+
+    // Fans each (convex) polygon and welds vertices with identical coordinates. Steps the bound
+    // monitor once per polygon.
+    public static IndexedMesh fromCSG(CSG csg) {
+        OperationMonitor monitor = OperationMonitor.current();
+        Welder welder = new Welder();
+        List<Integer> tris = new ArrayList<>();
+        for (Polygon polygon : csg.getPolygons()) {
+            monitor.step();
+            List<Vertex> vertices = polygon.vertices;
+            if (vertices.size() < 3) {
+                continue;
+            }
+            int first = welder.index(vertices.get(0).pos);
+            int previous = welder.index(vertices.get(1).pos);
+            for (int i = 2; i < vertices.size(); i++) {
+                int next = welder.index(vertices.get(i).pos);
+                welder.addTriangle(tris, first, previous, next);
+                previous = next;
+            }
+        }
+        return new IndexedMesh(welder.positions(), toArray(tris));
+    }
+
+    // Triangles in the viewer layout: normal, then three vertices
+    public static IndexedMesh fromTriangles(List<float[]> triangles) {
+        Welder welder = new Welder();
+        List<Integer> tris = new ArrayList<>();
+        for (float[] t : triangles) {
+            welder.addTriangle(tris, welder.index(t[3], t[4], t[5]), welder.index(t[6], t[7], t[8]),
+                    welder.index(t[9], t[10], t[11]));
+        }
+        return new IndexedMesh(welder.positions(), toArray(tris));
+    }
+
+    // Steps the bound monitor once per triangle
+    public CSG toCSG() {
+        OperationMonitor monitor = OperationMonitor.current();
+        List<Polygon> polygons = new ArrayList<>(getTriangleCount());
+        for (int t = 0; t < getTriangleCount(); t++) {
+            monitor.step();
+            polygons.add(Polygon.fromPoints(vertex(triangles[3 * t]), vertex(triangles[3 * t + 1]),
+                    vertex(triangles[3 * t + 2])));
+        }
+        return CSG.fromPolygons(polygons);
+    }
+
+    public double[] getPositions() {
+        return positions;
+    }
+
+    public int[] getTriangles() {
+        return triangles;
+    }
+
+    public int getVertexCount() {
+        return positions.length / 3;
+    }
+
+    public int getTriangleCount() {
+        return triangles.length / 3;
+    }
+
+    // Signed volume; positive for a closed mesh with outward winding
+    public double volume() {
+        double sum = 0;
+        for (int t = 0; t < triangles.length; t += 3) {
+            int a = 3 * triangles[t], b = 3 * triangles[t + 1], c = 3 * triangles[t + 2];
+            sum += positions[a] * (positions[b + 1] * positions[c + 2] - positions[b + 2] * positions[c + 1])
+                    + positions[a + 1] * (positions[b + 2] * positions[c] - positions[b] * positions[c + 2])
+                    + positions[a + 2] * (positions[b] * positions[c + 1] - positions[b + 1] * positions[c]);
+        }
+        return sum / 6.0;
+    }
+
+    // Merges vertices closer than relativeTolerance times the bounding box diagonal and drops the
+    // triangles that collapse. Closes the hairline seams left where a curved surface was sampled
+    // twice, such as the last slice of a sphere meeting the first one.
+    public IndexedMesh welded(double relativeTolerance) {
+        int n = getVertexCount();
+        if (n == 0) {
+            return this;
+        }
+        double[] min = { Double.POSITIVE_INFINITY, Double.POSITIVE_INFINITY, Double.POSITIVE_INFINITY };
+        double[] max = { Double.NEGATIVE_INFINITY, Double.NEGATIVE_INFINITY, Double.NEGATIVE_INFINITY };
+        for (int v = 0; v < n; v++) {
+            for (int k = 0; k < 3; k++) {
+                min[k] = Math.min(min[k], positions[3 * v + k]);
+                max[k] = Math.max(max[k], positions[3 * v + k]);
+            }
+        }
+        double dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+        double tolerance = relativeTolerance * Math.sqrt(dx * dx + dy * dy + dz * dz);
+        if (!(tolerance > 0)) {
+            return this;
+        }
+        // Grid of tolerance-sized cells; a match is always in the same or a neighbouring cell
+        Map<PointKey, List<Integer>> cells = new HashMap<>();
+        List<double[]> points = new ArrayList<>();
+        int[] remap = new int[n];
+        for (int v = 0; v < n; v++) {
+            double x = positions[3 * v], y = positions[3 * v + 1], z = positions[3 * v + 2];
+            double cx = Math.floor((x - min[0]) / tolerance);
+            double cy = Math.floor((y - min[1]) / tolerance);
+            double cz = Math.floor((z - min[2]) / tolerance);
+            int found = -1;
+            for (int i = -1; i <= 1 && found < 0; i++) {
+                for (int j = -1; j <= 1 && found < 0; j++) {
+                    for (int k = -1; k <= 1 && found < 0; k++) {
+                        for (int candidate : cells.getOrDefault(new PointKey(cx + i, cy + j, cz + k), List.of())) {
+                            double[] p = points.get(candidate);
+                            if (Math.abs(p[0] - x) <= tolerance && Math.abs(p[1] - y) <= tolerance
+                                    && Math.abs(p[2] - z) <= tolerance) {
+                                found = candidate;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            if (found < 0) {
+                found = points.size();
+                points.add(new double[] { x, y, z });
+                cells.computeIfAbsent(new PointKey(cx, cy, cz), key -> new ArrayList<>()).add(found);
+            }
+            remap[v] = found;
+        }
+        if (points.size() == n) {
+            return this;
+        }
+        Welder welder = new Welder();
+        List<Integer> tris = new ArrayList<>();
+        for (double[] p : points) {
+            welder.index(p[0], p[1], p[2]);
+        }
+        for (int t = 0; t < triangles.length; t += 3) {
+            welder.addTriangle(tris, remap[triangles[t]], remap[triangles[t + 1]], remap[triangles[t + 2]]);
+        }
+        return new IndexedMesh(welder.positions(), toArray(tris));
+    }
+
+    // Edges used by exactly one triangle, counting both directions together; 0 for a watertight mesh
+    public int countOpenEdges() {
+        Map<Long, Integer> uses = new HashMap<>();
+        for (int t = 0; t < triangles.length; t += 3) {
+            for (int k = 0; k < 3; k++) {
+                uses.merge(edgeKey(triangles[t + k], triangles[t + (k + 1) % 3]), 1, Integer::sum);
+            }
+        }
+        int open = 0;
+        for (int count : uses.values()) {
+            if (count == 1) {
+                open++;
+            }
+        }
+        return open;
+    }
+
+    private Vector3d vertex(int index) {
+        return Vector3d.xyz(positions[3 * index], positions[3 * index + 1], positions[3 * index + 2]);
+    }
+
+    static long edgeKey(int u, int v) {
+        return u < v ? ((long) u << 32) | v : ((long) v << 32) | u;
+    }
+
+    private static int[] toArray(List<Integer> values) {
+        int[] array = new int[values.size()];
+        for (int i = 0; i < array.length; i++) {
+            array[i] = values.get(i);
+        }
+        return array;
+    }
+
+    private static final class Welder {
+        private final Map<PointKey, Integer> indices = new HashMap<>();
+        private final List<double[]> points = new ArrayList<>();
+
+        int index(Vector3d p) {
+            return index(p.getX(), p.getY(), p.getZ());
+        }
+
+        int index(double x, double y, double z) {
+            // -0.0 and 0.0 are the same point
+            PointKey key = new PointKey(x + 0.0, y + 0.0, z + 0.0);
+            return indices.computeIfAbsent(key, k -> {
+                points.add(new double[] { k.x, k.y, k.z });
+                return points.size() - 1;
+            });
+        }
+
+        // Triangles that lost an edge to welding carry no area
+        void addTriangle(List<Integer> tris, int a, int b, int c) {
+            if (a != b && b != c && c != a) {
+                tris.add(a);
+                tris.add(b);
+                tris.add(c);
+            }
+        }
+
+        double[] positions() {
+            double[] xyz = new double[3 * points.size()];
+            for (int i = 0; i < points.size(); i++) {
+                System.arraycopy(points.get(i), 0, xyz, 3 * i, 3);
+            }
+            return xyz;
+        }
+    }
+
+    private record PointKey(double x, double y, double z) {
+    }
+}
@@ -0,0 +1,869 @@
+package cad.geometry.booleans;
+
+import cad.core.OperationMonitor;
+import eu.mihosoft.jcsg.CSG;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.stream.IntStream;
+
+// Booleans of closed triangle meshes, an alternative to JCSG's BSP trees (-Dcad.booleans=mesh). The steps:
+//  1. Triangle pairs whose boxes overlap come from a BVH over the second mesh, one query per
+//     triangle of the first mesh, in parallel.
+//  2. Each pair is intersected with exact orientation predicates. Every intersection point is named
+//     by what produced it (an input vertex, an edge through a triangle, or two crossing edges), so
+//     all triangles that meet at a point share one vertex and the result stays watertight.
+//  3. Triangles holding intersection segments are retriangulated in parallel (TriangleSplitter).
+//  4. Pieces are grouped into patches that no segment separates, and each patch is classified
+//     inside or outside the other mesh by the generalized winding number at one of its triangles.
+//     Pieces lying on the other surface are told apart by which side of them is inside.
+// Predicates decide every branch exactly; intersection points themselves are rounded to doubles,
+// and vertices that rounding leaves a hair apart are welded on the way in and out.
+public final class MeshBoolean {
+    public enum Operation {
+        UNION, DIFFERENCE, INTERSECTION
+    }
+
+    // Relative to the bounding box diagonal; far below modelling precision, far above rounding
+    private static final double WELD_TOLERANCE = 1e-10;
+
+    private static final long CORNER = -2;
+    private static final long FACE = -1;
+    private static final long OUTSIDE = -3;
+
+    private static final int VERTEX = 0;
+    private static final int EDGE_FACE = 1;
+    private static final int EDGE_EDGE = 2;
+
+    private static final int CLASS_OUTSIDE = 0;
+    private static final int CLASS_INSIDE = 1;
+    // On the other surface, facing the same way or the opposite way
+    private static final int CLASS_SAME = 2;
+    private static final int CLASS_OPPOSITE = 3;
+
+    // Names an intersection point: VERTEX (id), EDGE_FACE (mesh of the edge, edge ends, triangle
+    // of the other mesh) or EDGE_EDGE (edge of the first mesh, edge of the second)
+    private record PointKey(int kind, int i0, int i1, int i2, int i3) {
+    }
+
+    // An intersection point and where it sits on each mesh: CORNER, FACE or an edge key
+    private record Endpoint(PointKey key, long placeA, long placeB) {
+    }
+
+    private record Segment(int a, int b, Endpoint p, Endpoint q) {
+    }
+
+    private final double[] xyz;
+    private final int vertexCount;
+    // Triangles of each operand over the shared vertex ids
+    private final int[][] tris = new int[2][];
+    private final int[] dropAxis0;
+    private final int[] dropAxis1;
+
+    private MeshBoolean(IndexedMesh a, IndexedMesh b) {
+        // Weld the second mesh onto the first so coincident vertices share one id
+        Map<List<Double>, Integer> ids = new HashMap<>();
+        double[] pa = a.getPositions(), pb = b.getPositions();
+        double[] combined = Arrays.copyOf(pa, pa.length + pb.length);
+        for (int i = 0; i < a.getVertexCount(); i++) {
+            ids.putIfAbsent(coordinateKey(pa, i), i);
+        }
+        int next = a.getVertexCount();
+        int[] remap = new int[b.getVertexCount()];
+        for (int i = 0; i < remap.length; i++) {
+            Integer same = ids.get(coordinateKey(pb, i));
+            if (same != null) {
+                remap[i] = same;
+            } else {
+                System.arraycopy(pb, 3 * i, combined, 3 * next, 3);
+                remap[i] = next++;
+            }
+        }
+        xyz = Arrays.copyOf(combined, 3 * next);
+        vertexCount = next;
+        int[] tb = b.getTriangles().clone();
+        for (int i = 0; i < tb.length; i++) {
+            tb[i] = remap[tb[i]];
+        }
+        tris[0] = nonDegenerate(a.getTriangles());
+        tris[1] = nonDegenerate(tb);
+        dropAxis0 = dropAxes(tris[0]);
+        dropAxis1 = dropAxes(tris[1]);
+    }
+
+    // Throws IllegalStateException when rounding leaves a case the exact predicates cannot settle
+    // consistently, rather than returning a mesh with holes or an impossible volume
+    public static IndexedMesh apply(IndexedMesh a, IndexedMesh b, Operation op) {
+        IndexedMesh first = a.welded(WELD_TOLERANCE), second = b.welded(WELD_TOLERANCE);
+        IndexedMesh result = new MeshBoolean(first, second).run(op).welded(WELD_TOLERANCE);
+        if (first.countOpenEdges() == 0 && second.countOpenEdges() == 0) {
+            if (result.countOpenEdges() > 0) {
+                throw new IllegalStateException("Boolean result is not watertight");
+            }
+            checkVolume(op, first.volume(), second.volume(), result.volume());
+        }
+        return result;
+    }
+
+    // Closed results must fall inside the volume bounds the operation allows
+    private static void checkVolume(Operation op, double a, double b, double result) {
+        if (!(a > 0 && b > 0)) {
+            return;
+        }
+        double low, high;
+        switch (op) {
+            case UNION:
+                low = Math.max(a, b);
+                high = a + b;
+                break;
+            case DIFFERENCE:
+                low = Math.max(0, a - b);
+                high = a;
+                break;
+            default:
+                low = 0;
+                high = Math.min(a, b);
+                break;
+        }
+        double slack = 1e-6 * (a + b);
+        if (!(result >= low - slack && result <= high + slack)) {
+            throw new IllegalStateException("Boolean result has volume " + result + " outside [" + low + ", "
+                    + high + "]");
+        }
+    }
+
+    public static CSG apply(CSG a, CSG b, Operation op) {
+        OperationMonitor monitor = OperationMonitor.current();
+        monitor.begin("Converting polygons", a.getPolygons().size() + b.getPolygons().size());
+        IndexedMesh first = IndexedMesh.fromCSG(a), second = IndexedMesh.fromCSG(b);
+        IndexedMesh result = apply(first, second, op);
+        monitor.begin("Converting triangles", result.getTriangleCount());
+        return result.toCSG();
+    }
+
+    public static IndexedMesh union(IndexedMesh a, IndexedMesh b) {
+        return apply(a, b, Operation.UNION);
+    }
+
+    public static IndexedMesh difference(IndexedMesh a, IndexedMesh b) {
+        return apply(a, b, Operation.DIFFERENCE);
+    }
+
+    public static IndexedMesh intersection(IndexedMesh a, IndexedMesh b) {
+        return apply(a, b, Operation.INTERSECTION);
+    }
+
+    // Each parallel stage steps the caller's monitor once per item, so it reports progress and stops
+    // at the next item once the operation is cancelled
+    private IndexedMesh run(Operation op) {
+        OperationMonitor monitor = OperationMonitor.current();
+        int countA = tris[0].length / 3;
+        TriangleBvh bvh = new TriangleBvh(xyz, tris[1]);
+
+        // 1-2. Pairs and their intersection segments
+        @SuppressWarnings("unchecked")
+        List<Segment>[] found = new List[countA];
+        monitor.begin("Intersecting triangles", countA);
+        IntStream.range(0, countA).parallel().forEach(a -> {
+            monitor.step();
+            found[a] = intersectWithMesh(bvh, a);
+        });
+
+        // Number the new points in a fixed order so results do not depend on scheduling
+        Map<PointKey, Integer> pointIds = new LinkedHashMap<>();
+        List<Segment> segments = new ArrayList<>();
+        for (List<Segment> list : found) {
+            for (Segment s : list) {
+                segments.add(s);
+                for (Endpoint e : new Endpoint[] { s.p, s.q }) {
+                    if (e.key.kind != VERTEX) {
+                        pointIds.putIfAbsent(e.key, vertexCount + pointIds.size());
+                    }
+                }
+            }
+        }
+        List<PointKey> newPoints = new ArrayList<>(pointIds.keySet());
+        double[] positions = Arrays.copyOf(xyz, 3 * (vertexCount + newPoints.size()));
+        IntStream.range(0, newPoints.size()).parallel().forEach(i -> {
+            double[] p = construct(newPoints.get(i));
+            System.arraycopy(p, 0, positions, 3 * (vertexCount + i), 3);
+        });
+
+        // Which triangles each point and segment has to be inserted into
+        List<Map<Integer, List<int[]>>> faceSegments = List.of(new HashMap<>(), new HashMap<>());
+        List<Map<Integer, Set<Integer>>> facePoints = List.of(new HashMap<>(), new HashMap<>());
+        List<Map<Long, Set<Integer>>> edgePoints = List.of(new HashMap<>(), new HashMap<>());
+        List<Set<Integer>> coplanar = List.of(new HashSet<>(), new HashSet<>());
+        for (Segment s : segments) {
+            int p = id(pointIds, s.p.key), q = id(pointIds, s.q.key);
+            if (p == q) {
+                continue;
+            }
+            faceSegments.get(0).computeIfAbsent(s.a, k -> new ArrayList<>()).add(new int[] { p, q });
+            faceSegments.get(1).computeIfAbsent(s.b, k -> new ArrayList<>()).add(new int[] { p, q });
+            register(facePoints.get(0), edgePoints.get(0), s.a, p, s.p.placeA);
+            register(facePoints.get(0), edgePoints.get(0), s.a, q, s.q.placeA);
+            register(facePoints.get(1), edgePoints.get(1), s.b, p, s.p.placeB);
+            register(facePoints.get(1), edgePoints.get(1), s.b, q, s.q.placeB);
+            if (isCoplanar(s.a, s.b)) {
+                coplanar.get(0).add(s.a);
+                coplanar.get(1).add(s.b);
+            }
+        }
+
+        // 3. Split the touched triangles
+        List<int[]> jobs = new ArrayList<>();
+        for (int mesh = 0; mesh < 2; mesh++) {
+            int[] t = tris[mesh];
+            for (int i = 0; i < t.length / 3; i++) {
+                boolean touched = faceSegments.get(mesh).containsKey(i) || facePoints.get(mesh).containsKey(i);
+                for (int k = 0; k < 3 && !touched; k++) {
+                    touched = edgePoints.get(mesh).containsKey(IndexedMesh.edgeKey(t[3 * i + k], t[3 * i + (k + 1) % 3]));
+                }
+                if (touched) {
+                    jobs.add(new int[] { mesh, i });
+                }
+            }
+        }
+        TriangleSplitter.Result[] results = new TriangleSplitter.Result[jobs.size()];
+        monitor.begin("Splitting triangles", jobs.size());
+        IntStream.range(0, jobs.size()).parallel().forEach(j -> {
+            monitor.step();
+            int mesh = jobs.get(j)[0], i = jobs.get(j)[1];
+            int[] t = tris[mesh];
+            int[] corners = { t[3 * i], t[3 * i + 1], t[3 * i + 2] };
+            int[][] sides = new int[3][];
+            for (int k = 0; k < 3; k++) {
+                Set<Integer> on = edgePoints.get(mesh).get(IndexedMesh.edgeKey(corners[k], corners[(k + 1) % 3]));
+                sides[k] = on != null ? toArray(on) : new int[0];
+            }
+            Set<Integer> inside = facePoints.get(mesh).get(i);
+            List<int[]> segs = faceSegments.get(mesh).getOrDefault(i, List.of());
+            results[j] = TriangleSplitter.split(positions, corners[0], corners[1], corners[2], sides,
+                    inside != null ? toArray(inside) : new int[0], segs.toArray(new int[0][]));
+        });
+
+        int total = vertexCount + newPoints.size();
+        boolean[] onCurve = new boolean[total];
+        for (Segment s : segments) {
+            onCurve[id(pointIds, s.p.key)] = true;
+            onCurve[id(pointIds, s.q.key)] = true;
+        }
+        Pieces pieces = new Pieces();
+        int[] split = new int[2 * Math.max(1, Math.max(tris[0].length, tris[1].length) / 3)];
+        Arrays.fill(split, -1);
+        for (int j = 0; j < results.length; j++) {
+            TriangleSplitter.Result r = results[j];
+            for (int v : r.cutEdges) {
+                onCurve[v] = true;
+            }
+            int mesh = jobs.get(j)[0], parent = jobs.get(j)[1];
+            split[2 * parent + mesh] = j;
+            int first = pieces.size();
+            int[] out = r.triangles;
+            for (int t = 0; t < out.length / 3; t++) {
+                pieces.add(mesh, parent, out[3 * t], out[3 * t + 1], out[3 * t + 2]);
+            }
+            for (int t = 0; t < out.length / 3; t++) {
+                pieces.union(first + t, first + r.components[t]);
+            }
+        }
+        for (int mesh = 0; mesh < 2; mesh++) {
+            int[] t = tris[mesh];
+            for (int i = 0; i < t.length / 3; i++) {
+                if (split[2 * i + mesh] < 0) {
+                    pieces.add(mesh, i, t[3 * i], t[3 * i + 1], t[3 * i + 2]);
+                }
+            }
+        }
+
+        // 4. Patches: pieces sharing a vertex off the intersection curve lie on the same side
+        for (int mesh = 0; mesh < 2; mesh++) {
+            int[] firstPiece = new int[total];
+            Arrays.fill(firstPiece, -1);
+            for (int p = 0; p < pieces.size(); p++) {
+                if (pieces.mesh(p) != mesh) {
+                    continue;
+                }
+                for (int k = 0; k < 3; k++) {
+                    int v = pieces.vertex(p, k);
+                    if (onCurve[v]) {
+                        continue;
+                    }
+                    if (firstPiece[v] < 0) {
+                        firstPiece[v] = p;
+                    } else {
+                        pieces.union(p, firstPiece[v]);
+                    }
+                }
+            }
+        }
+        int[] roots = pieces.roots();
+        int[] representative = new int[pieces.size()];
+        double[] bestArea = new double[pieces.size()];
+        Arrays.fill(representative, -1);
+        for (int p = 0; p < pieces.size(); p++) {
+            double area = pieces.area(positions, p);
+            int root = roots[p];
+            if (representative[root] < 0 || area > bestArea[root]) {
+                representative[root] = p;
+                bestArea[root] = area;
+            }
+        }
+        int[] patches = IntStream.range(0, pieces.size()).filter(p -> roots[p] == p).toArray();
+        double offset = 1e-6 * diagonal(xyz, vertexCount);
+        int[] classes = new int[pieces.size()];
+        monitor.begin("Classifying patches", patches.length);
+        IntStream.range(0, patches.length).parallel().forEach(i -> {
+            monitor.step();
+            int rep = representative[patches[i]];
+            int mesh = pieces.mesh(rep);
+            boolean onSurface = coplanar.get(mesh).contains(pieces.parent(rep));
+            classes[patches[i]] = classify(positions, pieces, rep, tris[1 - mesh], onSurface, offset);
+        });
+
+        // Keep what the operation asks for; the subtracted mesh's kept pieces turn inside out
+        List<int[]> kept = new ArrayList<>();
+        for (int p = 0; p < pieces.size(); p++) {
+            int c = classes[roots[p]];
+            int a = pieces.vertex(p, 0), b = pieces.vertex(p, 1), d = pieces.vertex(p, 2);
+            if (pieces.mesh(p) == 0) {
+                boolean keep = op == Operation.UNION ? c == CLASS_OUTSIDE || c == CLASS_SAME
+                        : op == Operation.INTERSECTION ? c == CLASS_INSIDE || c == CLASS_SAME
+                        : c == CLASS_OUTSIDE || c == CLASS_OPPOSITE;
+                if (keep) {
+                    kept.add(new int[] { a, b, d });
+                }
+            } else if (op == Operation.UNION ? c == CLASS_OUTSIDE : c == CLASS_INSIDE) {
+                kept.add(op == Operation.DIFFERENCE ? new int[] { a, d, b } : new int[] { a, b, d });
+            }
+        }
+        return compact(positions, kept);
+    }
+
+    private List<Segment> intersectWithMesh(TriangleBvh bvh, int a) {
+        int[] ta = tris[0];
+        double minX = Double.POSITIVE_INFINITY, minY = Double.POSITIVE_INFINITY, minZ = Double.POSITIVE_INFINITY;
+        double maxX = Double.NEGATIVE_INFINITY, maxY = Double.NEGATIVE_INFINITY, maxZ = Double.NEGATIVE_INFINITY;
+        for (int k = 0; k < 3; k++) {
+            int v = 3 * ta[3 * a + k];
+            minX = Math.min(minX, xyz[v]);
+            minY = Math.min(minY, xyz[v + 1]);
+            minZ = Math.min(minZ, xyz[v + 2]);
+            maxX = Math.max(maxX, xyz[v]);
+            maxY = Math.max(maxY, xyz[v + 1]);
+            maxZ = Math.max(maxZ, xyz[v + 2]);
+        }
+        List<Segment> out = new ArrayList<>(0);
+        bvh.query(minX, minY, minZ, maxX, maxY, maxZ, b -> intersectPair(a, b, out));
+        return out;
+    }
+
+    private void intersectPair(int a, int b, List<Segment> out) {
+        int[] ta = corners(0, a), tb = corners(1, b);
+        int[] sb = new int[3], sa = new int[3];
+        for (int k = 0; k < 3; k++) {
+            sb[k] = Predicates.orient3d(xyz, ta[0], ta[1], ta[2], tb[k]);
+            sa[k] = Predicates.orient3d(xyz, tb[0], tb[1], tb[2], ta[k]);
+        }
+        if (sameSide(sb) || sameSide(sa)) {
+            return;
+        }
+        if (sb[0] == 0 && sb[1] == 0 && sb[2] == 0) {
+            coplanarPair(a, b, ta, tb, out);
+            return;
+        }
+        Map<PointKey, Endpoint> points = new LinkedHashMap<>();
+        for (int k = 0; k < 3; k++) {
+            int u = tb[k], v = tb[(k + 1) % 3];
+            long edgeB = IndexedMesh.edgeKey(u, v);
+            if (sb[k] * sb[(k + 1) % 3] < 0) {
+                int[] hit = edgeThroughTriangle(u, v, ta);
+                if (hit[0] == 0) {
+                    add(points, new Endpoint(edgeFace(1, u, v, a), FACE, edgeB));
+                } else if (hit[0] == 1) {
+                    int p = ta[hit[1]], q = ta[(hit[1] + 1) % 3];
+                    add(points, new Endpoint(edgeEdge(p, q, u, v), IndexedMesh.edgeKey(p, q), edgeB));
+                } else if (hit[0] == 2) {
+                    add(points, new Endpoint(vertex(ta[hit[1]]), CORNER, edgeB));
+                }
+            }
+            if (sb[k] == 0) {
+                long place = placeInTriangle(u, ta, dropAxis0[a]);
+                if (place != OUTSIDE) {
+                    add(points, new Endpoint(vertex(u), place, CORNER));
+                }
+            }
+        }
+        for (int k = 0; k < 3; k++) {
+            int u = ta[k], v = ta[(k + 1) % 3];
+            long edgeA = IndexedMesh.edgeKey(u, v);
+            if (sa[k] * sa[(k + 1) % 3] < 0) {
+                int[] hit = edgeThroughTriangle(u, v, tb);
+                if (hit[0] == 0) {
+                    add(points, new Endpoint(edgeFace(0, u, v, b), edgeA, FACE));
+                } else if (hit[0] == 1) {
+                    int p = tb[hit[1]], q = tb[(hit[1] + 1) % 3];
+                    add(points, new Endpoint(edgeEdge(u, v, p, q), edgeA, IndexedMesh.edgeKey(p, q)));
+                } else if (hit[0] == 2) {
+                    add(points, new Endpoint(vertex(tb[hit[1]]), edgeA, CORNER));
+                }
+            }
+            if (sa[k] == 0) {
+                long place = placeInTriangle(u, tb, dropAxis1[b]);
+                if (place != OUTSIDE) {
+                    add(points, new Endpoint(vertex(u), CORNER, place));
+                }
+            }
+        }
+        if (points.size() < 2) {
+            return;
+        }
+        List<Endpoint> ends = new ArrayList<>(points.values());
+        if (ends.size() > 2) {
+            ends = farthestPair(ends);
+        }
+        out.add(new Segment(a, b, ends.get(0), ends.get(1)));
+    }
+
+    // Both triangles in one plane: the parts of each one's sides inside the other become segments
+    private void coplanarPair(int a, int b, int[] ta, int[] tb, List<Segment> out) {
+        int axis = dropAxis0[a];
+        long[] bInA = new long[3], aInB = new long[3];
+        for (int k = 0; k < 3; k++) {
+            bInA[k] = placeInTriangle(tb[k], ta, axis);
+            aInB[k] = placeInTriangle(ta[k], tb, axis);
+        }
+        for (int k = 0; k < 3; k++) {
+            int r = tb[k], s = tb[(k + 1) % 3];
+            long edgeB = IndexedMesh.edgeKey(r, s);
+            List<Endpoint> on = new ArrayList<>();
+            if (bInA[k] != OUTSIDE) {
+                on.add(new Endpoint(vertex(r), bInA[k], CORNER));
+            }
+            if (bInA[(k + 1) % 3] != OUTSIDE) {
+                on.add(new Endpoint(vertex(s), bInA[(k + 1) % 3], CORNER));
+            }
+            for (int i = 0; i < 3; i++) {
+                int p = ta[i], q = ta[(i + 1) % 3];
+                if (properCrossing(p, q, r, s, axis)) {
+                    on.add(new Endpoint(edgeEdge(p, q, r, s), IndexedMesh.edgeKey(p, q), edgeB));
+                }
+                if (aInB[i] == edgeB) {
+                    on.add(new Endpoint(vertex(p), CORNER, edgeB));
+                }
+            }
+            addChain(a, b, r, s, on, out);
+        }
+        for (int k = 0; k < 3; k++) {
+            int p = ta[k], q = ta[(k + 1) % 3];
+            long edgeA = IndexedMesh.edgeKey(p, q);
+            List<Endpoint> on = new ArrayList<>();
+            if (aInB[k] != OUTSIDE) {
+                on.add(new Endpoint(vertex(p), CORNER, aInB[k]));
+            }
+            if (aInB[(k + 1) % 3] != OUTSIDE) {
+                on.add(new Endpoint(vertex(q), CORNER, aInB[(k + 1) % 3]));
+            }
+            for (int i = 0; i < 3; i++) {
+                int r = tb[i], s = tb[(i + 1) % 3];
+                if (properCrossing(p, q, r, s, axis)) {
+                    on.add(new Endpoint(edgeEdge(p, q, r, s), edgeA, IndexedMesh.edgeKey(r, s)));
+                }
+                if (bInA[i] == edgeA) {
+                    on.add(new Endpoint(vertex(r), edgeA, CORNER));
+                }
+            }
+            addChain(a, b, p, q, on, out);
+        }
+    }
+
+    // Points on the side from u to v, all inside the other triangle, become consecutive segments
+    private void addChain(int a, int b, int u, int v, List<Endpoint> on, List<Segment> out) {
+        Map<PointKey, Endpoint> unique = new LinkedHashMap<>();
+        for (Endpoint e : on) {
+            add(unique, e);
+        }
+        if (unique.size() < 2) {
+            return;
+        }
+        List<Endpoint> chain = new ArrayList<>(unique.values());
+        double[] from = point(u), to = point(v);
+        double dx = to[0] - from[0], dy = to[1] - from[1], dz = to[2] - from[2];
+        Map<PointKey, Double> along = new HashMap<>();
+        for (Endpoint e : chain) {
+            double[] p = point(e.key);
+            along.put(e.key, (p[0] - from[0]) * dx + (p[1] - from[1]) * dy + (p[2] - from[2]) * dz);
+        }
+        chain.sort((x, y) -> Double.compare(along.get(x.key), along.get(y.key)));
+        for (int i = 0; i + 1 < chain.size(); i++) {
+            out.add(new Segment(a, b, chain.get(i), chain.get(i + 1)));
+        }
+    }
+
+    // {0} through the interior, {1, side} through a side, {2, corner} through a corner, {-1} misses.
+    // The line through u and v passes the triangle where the three tetrahedra it spans with the
+    // triangle's sides agree in orientation.
+    private int[] edgeThroughTriangle(int u, int v, int[] t) {
+        int[] s = new int[3];
+        boolean positive = false, negative = false;
+        int zeros = 0;
+        for (int i = 0; i < 3; i++) {
+            s[i] = Predicates.orient3d(xyz, u, v, t[i], t[(i + 1) % 3]);
+            positive |= s[i] > 0;
+            negative |= s[i] < 0;
+            zeros += s[i] == 0 ? 1 : 0;
+        }
+        if (positive && negative || zeros == 3) {
+            return new int[] { -1 };
+        }
+        if (zeros == 0) {
+            return new int[] { 0 };
+        }
+        if (zeros == 1) {
+            return new int[] { 1, s[0] == 0 ? 0 : s[1] == 0 ? 1 : 2 };
+        }
+        // Sides i and i + 1 meet at corner i + 1
+        int side = s[0] != 0 ? 1 : s[1] != 0 ? 2 : 0;
+        return new int[] { 2, (side + 1) % 3 };
+    }
+
+    // Where point v, known to lie in the triangle's plane, falls: CORNER, FACE, a side, or OUTSIDE
+    private long placeInTriangle(int v, int[] t, int axis) {
+        for (int k = 0; k < 3; k++) {
+            if (t[k] == v) {
+                return CORNER;
+            }
+        }
+        int orientation = orient2d(t[0], t[1], t[2], axis);
+        int zeroSide = -1;
+        for (int k = 0; k < 3; k++) {
+            int o = orient2d(t[k], t[(k + 1) % 3], v, axis) * orientation;
+            if (o < 0) {
+                return OUTSIDE;
+            }
+            if (o == 0) {
+                if (zeroSide >= 0) {
+                    // Same projected spot as a corner but a different vertex: treat as outside
+                    return OUTSIDE;
+                }
+                zeroSide = k;
+            }
+        }
+        return zeroSide < 0 ? FACE : IndexedMesh.edgeKey(t[zeroSide], t[(zeroSide + 1) % 3]);
+    }
+
+    private boolean properCrossing(int p, int q, int r, int s, int axis) {
+        if (p == r || p == s || q == r || q == s) {
+            return false;
+        }
+        return orient2d(p, q, r, axis) * orient2d(p, q, s, axis) < 0
+                && orient2d(r, s, p, axis) * orient2d(r, s, q, axis) < 0;
+    }
+
+    private int orient2d(int a, int b, int c, int axis) {
+        int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        return Predicates.orient2d(xyz[3 * a + u], xyz[3 * a + v], xyz[3 * b + u], xyz[3 * b + v],
+                xyz[3 * c + u], xyz[3 * c + v]);
+    }
+
+    private boolean isCoplanar(int a, int b) {
+        int[] ta = corners(0, a), tb = corners(1, b);
+        for (int k = 0; k < 3; k++) {
+            if (Predicates.orient3d(xyz, ta[0], ta[1], ta[2], tb[k]) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    private static boolean sameSide(int[] s) {
+        return (s[0] > 0 && s[1] > 0 && s[2] > 0) || (s[0] < 0 && s[1] < 0 && s[2] < 0);
+    }
+
+    private static void add(Map<PointKey, Endpoint> points, Endpoint e) {
+        points.putIfAbsent(e.key, e);
+    }
+
+    private List<Endpoint> farthestPair(List<Endpoint> ends) {
+        Endpoint best0 = ends.get(0), best1 = ends.get(1);
+        double best = -1;
+        for (int i = 0; i < ends.size(); i++) {
+            double[] p = point(ends.get(i).key);
+            for (int j = i + 1; j < ends.size(); j++) {
+                double[] q = point(ends.get(j).key);
+                double d = (p[0] - q[0]) * (p[0] - q[0]) + (p[1] - q[1]) * (p[1] - q[1]) + (p[2] - q[2]) * (p[2] - q[2]);
+                if (d > best) {
+                    best = d;
+                    best0 = ends.get(i);
+                    best1 = ends.get(j);
+                }
+            }
+        }
+        return List.of(best0, best1);
+    }
+
+    private static PointKey vertex(int v) {
+        return new PointKey(VERTEX, v, 0, 0, 0);
+    }
+
+    private static PointKey edgeFace(int mesh, int u, int v, int triangle) {
+        return new PointKey(EDGE_FACE, mesh, Math.min(u, v), Math.max(u, v), triangle);
+    }
+
+    // Edge pq of the first mesh, edge rs of the second
+    private static PointKey edgeEdge(int p, int q, int r, int s) {
+        return new PointKey(EDGE_EDGE, Math.min(p, q), Math.max(p, q), Math.min(r, s), Math.max(r, s));
+    }
+
+    private double[] point(PointKey key) {
+        return key.kind == VERTEX ? point(key.i0) : construct(key);
+    }
+
+    private double[] point(int v) {
+        return new double[] { xyz[3 * v], xyz[3 * v + 1], xyz[3 * v + 2] };
+    }
+
+    // Coordinates depend only on the key, so every triangle naming a point gets the same one
+    private double[] construct(PointKey key) {
+        if (key.kind == EDGE_FACE) {
+            int[] t = corners(1 - key.i0, key.i3);
+            double[] c0 = point(t[0]), c1 = point(t[1]), c2 = point(t[2]);
+            double[] n = cross(sub(c1, c0), sub(c2, c0));
+            double[] u = point(key.i1), v = point(key.i2);
+            double du = dot(n, sub(u, c0)), dv = dot(n, sub(v, c0));
+            double s = du / (du - dv);
+            return lerp(u, v, Double.isFinite(s) ? Math.max(0.0, Math.min(1.0, s)) : 0.5);
+        }
+        // Closest point of line pq to line rs; the lines meet exactly
+        double[] p = point(key.i0), q = point(key.i1), r = point(key.i2), s = point(key.i3);
+        double[] d1 = sub(q, p), d2 = sub(s, r), w = sub(p, r);
+        double aa = dot(d1, d1), ab = dot(d1, d2), bb = dot(d2, d2), d = dot(d1, w), e = dot(d2, w);
+        double den = aa * bb - ab * ab;
+        double t = den > 0 ? (ab * e - bb * d) / den : 0.5;
+        return lerp(p, q, Double.isFinite(t) ? Math.max(0.0, Math.min(1.0, t)) : 0.5);
+    }
+
+    // Generalized winding number of the other mesh at one triangle of the patch: 1 inside, 0 outside.
+    // Pieces lying on the other surface sit at 1/2, so those are probed just in front and behind.
+    private static int classify(double[] xyz, Pieces pieces, int rep, int[] other, boolean onSurface,
+            double offset) {
+        int a = pieces.vertex(rep, 0), b = pieces.vertex(rep, 1), c = pieces.vertex(rep, 2);
+        double[] center = new double[3];
+        for (int k = 0; k < 3; k++) {
+            center[k] = (xyz[3 * a + k] + xyz[3 * b + k] + xyz[3 * c + k]) / 3.0;
+        }
+        if (!onSurface) {
+            return windingNumber(xyz, other, center) > 0.5 ? CLASS_INSIDE : CLASS_OUTSIDE;
+        }
+        double[] n = cross(sub3(xyz, b, a), sub3(xyz, c, a));
+        double length = Math.sqrt(dot(n, n));
+        double[] front = new double[3], back = new double[3];
+        for (int k = 0; k < 3; k++) {
+            double step = length > 0 ? offset * n[k] / length : 0;
+            front[k] = center[k] + step;
+            back[k] = center[k] - step;
+        }
+        boolean frontInside = windingNumber(xyz, other, front) > 0.5;
+        boolean backInside = windingNumber(xyz, other, back) > 0.5;
+        if (frontInside == backInside) {
+            return frontInside ? CLASS_INSIDE : CLASS_OUTSIDE;
+        }
+        return backInside ? CLASS_SAME : CLASS_OPPOSITE;
+    }
+
+    // Sum of the solid angles the triangles subtend at q (Van Oosterom and Strackee), over 4 pi
+    static double windingNumber(double[] xyz, int[] triangles, double[] q) {
+        double sum = 0;
+        for (int t = 0; t < triangles.length; t += 3) {
+            int ia = 3 * triangles[t], ib = 3 * triangles[t + 1], ic = 3 * triangles[t + 2];
+            double ax = xyz[ia] - q[0], ay = xyz[ia + 1] - q[1], az = xyz[ia + 2] - q[2];
+            double bx = xyz[ib] - q[0], by = xyz[ib + 1] - q[1], bz = xyz[ib + 2] - q[2];
+            double cx = xyz[ic] - q[0], cy = xyz[ic + 1] - q[1], cz = xyz[ic + 2] - q[2];
+            double la = Math.sqrt(ax * ax + ay * ay + az * az);
+            double lb = Math.sqrt(bx * bx + by * by + bz * bz);
+            double lc = Math.sqrt(cx * cx + cy * cy + cz * cz);
+            double det = ax * (by * cz - bz * cy) + ay * (bz * cx - bx * cz) + az * (bx * cy - by * cx);
+            double den = la * lb * lc + (ax * bx + ay * by + az * bz) * lc
+                    + (bx * cx + by * cy + bz * cz) * la + (cx * ax + cy * ay + cz * az) * lb;
+            sum += Math.atan2(det, den);
+        }
+        return sum / (2.0 * Math.PI);
+    }
+
+    private static IndexedMesh compact(double[] xyz, List<int[]> kept) {
+        int[] remap = new int[xyz.length / 3];
+        Arrays.fill(remap, -1);
+        int count = 0;
+        int[] triangles = new int[3 * kept.size()];
+        for (int t = 0; t < kept.size(); t++) {
+            for (int k = 0; k < 3; k++) {
+                int v = kept.get(t)[k];
+                if (remap[v] < 0) {
+                    remap[v] = count++;
+                }
+                triangles[3 * t + k] = remap[v];
+            }
+        }
+        double[] positions = new double[3 * count];
+        for (int v = 0; v < remap.length; v++) {
+            if (remap[v] >= 0) {
+                System.arraycopy(xyz, 3 * v, positions, 3 * remap[v], 3);
+            }
+        }
+        return new IndexedMesh(positions, triangles);
+    }
+
+    private int[] nonDegenerate(int[] triangles) {
+        int[] out = new int[triangles.length];
+        int n = 0;
+        for (int t = 0; t < triangles.length; t += 3) {
+            int a = triangles[t], b = triangles[t + 1], c = triangles[t + 2];
+            if (a == b || b == c || c == a) {
+                continue;
+            }
+            boolean flat = true;
+            for (int axis = 0; axis < 3 && flat; axis++) {
+                flat = orient2d(a, b, c, axis) == 0;
+            }
+            if (!flat) {
+                out[n++] = a;
+                out[n++] = b;
+                out[n++] = c;
+            }
+        }
+        return Arrays.copyOf(out, n);
+    }
+
+    private int[] dropAxes(int[] triangles) {
+        int[] axes = new int[triangles.length / 3];
+        for (int t = 0; t < axes.length; t++) {
+            axes[t] = TriangleSplitter.dominantAxis(xyz, triangles[3 * t], triangles[3 * t + 1], triangles[3 * t + 2]);
+        }
+        return axes;
+    }
+
+    private int[] corners(int mesh, int t) {
+        int[] tri = tris[mesh];
+        return new int[] { tri[3 * t], tri[3 * t + 1], tri[3 * t + 2] };
+    }
+
+    private static void register(Map<Integer, Set<Integer>> facePoints, Map<Long, Set<Integer>> edgePoints,
+            int triangle, int point, long place) {
+        if (place == FACE) {
+            facePoints.computeIfAbsent(triangle, k -> new LinkedHashSet<>()).add(point);
+        } else if (place >= 0) {
+            edgePoints.computeIfAbsent(place, k -> new LinkedHashSet<>()).add(point);
+        }
+    }
+
+    private static int id(Map<PointKey, Integer> ids, PointKey key) {
+        return key.kind == VERTEX ? key.i0 : ids.get(key);
+    }
+
+    private static List<Double> coordinateKey(double[] xyz, int i) {
+        // -0.0 and 0.0 are the same point
+        return List.of(xyz[3 * i] + 0.0, xyz[3 * i + 1] + 0.0, xyz[3 * i + 2] + 0.0);
+    }
+
+    private static double diagonal(double[] xyz, int count) {
+        double[] min = { Double.POSITIVE_INFINITY, Double.POSITIVE_INFINITY, Double.POSITIVE_INFINITY };
+        double[] max = { Double.NEGATIVE_INFINITY, Double.NEGATIVE_INFINITY, Double.NEGATIVE_INFINITY };
+        for (int v = 0; v < count; v++) {
+            for (int k = 0; k < 3; k++) {
+                min[k] = Math.min(min[k], xyz[3 * v + k]);
+                max[k] = Math.max(max[k], xyz[3 * v + k]);
+            }
+        }
+        double[] d = sub(max, min);
+        return count > 0 ? Math.sqrt(dot(d, d)) : 1.0;
+    }
+
+    private static int[] toArray(Set<Integer> values) {
+        return values.stream().mapToInt(Integer::intValue).toArray();
+    }
+
+    private static double[] sub(double[] a, double[] b) {
+        return new double[] { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+    }
+
+    private static double[] sub3(double[] xyz, int a, int b) {
+        return new double[] { xyz[3 * a] - xyz[3 * b], xyz[3 * a + 1] - xyz[3 * b + 1], xyz[3 * a + 2] - xyz[3 * b + 2] };
+    }
+
+    private static double[] cross(double[] a, double[] b) {
+        return new double[] { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    }
+
+    private static double dot(double[] a, double[] b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    private static double[] lerp(double[] a, double[] b, double t) {
+        return new double[] { a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1]), a[2] + t * (b[2] - a[2]) };
+    }
+
+    // Output triangles of both operands with their source triangle, grouped by union-find
+    private static final class Pieces {
+        private int[] data = new int[5 * 64];
+        private int[] parent = new int[64];
+        private int size;
+
+        void add(int mesh, int source, int a, int b, int c) {
+            if (size == parent.length) {
+                parent = Arrays.copyOf(parent, 2 * size);
+                data = Arrays.copyOf(data, 10 * size);
+            }
+            int o = 5 * size;
+            data[o] = mesh;
+            data[o + 1] = source;
+            data[o + 2] = a;
+            data[o + 3] = b;
+            data[o + 4] = c;
+            parent[size] = size;
+            size++;
+        }
+
+        int size() {
+            return size;
+        }
+
+        int mesh(int p) {
+            return data[5 * p];
+        }
+
+        int parent(int p) {
+            return data[5 * p + 1];
+        }
+
+        int vertex(int p, int k) {
+            return data[5 * p + 2 + k];
+        }
+
+        double area(double[] xyz, int p) {
+            double[] n = cross(sub3(xyz, vertex(p, 1), vertex(p, 0)), sub3(xyz, vertex(p, 2), vertex(p, 0)));
+            return Math.sqrt(dot(n, n));
+        }
+
+        void union(int x, int y) {
+            int rx = TriangleSplitter.find(parent, x), ry = TriangleSplitter.find(parent, y);
+            if (rx != ry) {
+                parent[Math.max(rx, ry)] = Math.min(rx, ry);
+            }
+        }
+
+        int[] roots() {
+            int[] roots = new int[size];
+            for (int p = 0; p < size; p++) {
+                roots[p] = TriangleSplitter.find(parent, p);
+            }
+            return roots;
+        }
+    }
+}
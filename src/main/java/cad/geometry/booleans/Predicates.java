@@ -0,0 +1,87 @@
+package cad.geometry.booleans;
+
+import java.math.BigDecimal;
+
+// Orientation tests with exact signs. Each evaluates the determinant in double first and trusts
+// the result when it clears Shewchuk's forward error bound; only the near-degenerate cases fall
+// back to BigDecimal, where products and differences of doubles are exact.
+public final class Predicates {
+    private static final double EPSILON = 0x1p-53;
+    private static final double ORIENT2D_BOUND = (3.0 + 16.0 * EPSILON) * EPSILON;
+    private static final double ORIENT3D_BOUND = (7.0 + 56.0 * EPSILON) * EPSILON;
+
+    private Predicates() {
+    }
+
+    // 1 when a, b, c turn counterclockwise, -1 when clockwise, 0 when collinear
+    public static int orient2d(double ax, double ay, double bx, double by, double cx, double cy) {
+        double detLeft = (ax - cx) * (by - cy);
+        double detRight = (ay - cy) * (bx - cx);
+        double det = detLeft - detRight;
+        double bound = ORIENT2D_BOUND * (Math.abs(detLeft) + Math.abs(detRight));
+        if (det > bound || -det > bound) {
+            return det > 0 ? 1 : -1;
+        }
+        return orient2dExact(ax, ay, bx, by, cx, cy);
+    }
+
+    // 1 when d lies on the side of plane abc that its counterclockwise normal (b - a) x (c - a)
+    // points to, -1 on the other side, 0 when the four points are coplanar
+    public static int orient3d(double ax, double ay, double az, double bx, double by, double bz,
+            double cx, double cy, double cz, double dx, double dy, double dz) {
+        double adx = ax - dx, ady = ay - dy, adz = az - dz;
+        double bdx = bx - dx, bdy = by - dy, bdz = bz - dz;
+        double cdx = cx - dx, cdy = cy - dy, cdz = cz - dz;
+
+        double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+        double cdxady = cdx * ady, adxcdy = adx * cdy;
+        double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+        // Shewchuk's orientation, positive when d is below the plane, hence the negated signs
+        double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+        double permanent = (Math.abs(bdxcdy) + Math.abs(cdxbdy)) * Math.abs(adz)
+                + (Math.abs(cdxady) + Math.abs(adxcdy)) * Math.abs(bdz)
+                + (Math.abs(adxbdy) + Math.abs(bdxady)) * Math.abs(cdz);
+        double bound = ORIENT3D_BOUND * permanent;
+        if (det > bound || -det > bound) {
+            return det > 0 ? -1 : 1;
+        }
+        return -orient3dExact(ax, ay, az, bx, by, bz, cx, cy, cz, dx, dy, dz);
+    }
+
+    // Points packed as xyz triples, addressed by vertex index
+    public static int orient3d(double[] xyz, int a, int b, int c, int d) {
+        int ia = 3 * a, ib = 3 * b, ic = 3 * c, id = 3 * d;
+        return orient3d(xyz[ia], xyz[ia + 1], xyz[ia + 2], xyz[ib], xyz[ib + 1], xyz[ib + 2],
+                xyz[ic], xyz[ic + 1], xyz[ic + 2], xyz[id], xyz[id + 1], xyz[id + 2]);
+    }
+
+    private static int orient2dExact(double ax, double ay, double bx, double by, double cx, double cy) {
+        BigDecimal acx = exact(ax).subtract(exact(cx));
+        BigDecimal bcy = exact(by).subtract(exact(cy));
+        BigDecimal acy = exact(ay).subtract(exact(cy));
+        BigDecimal bcx = exact(bx).subtract(exact(cx));
+        return acx.multiply(bcy).subtract(acy.multiply(bcx)).signum();
+    }
+
+    private static int orient3dExact(double ax, double ay, double az, double bx, double by, double bz,
+            double cx, double cy, double cz, double dx, double dy, double dz) {
+        BigDecimal adx = exact(ax).subtract(exact(dx));
+        BigDecimal ady = exact(ay).subtract(exact(dy));
+        BigDecimal adz = exact(az).subtract(exact(dz));
+        BigDecimal bdx = exact(bx).subtract(exact(dx));
+        BigDecimal bdy = exact(by).subtract(exact(dy));
+        BigDecimal bdz = exact(bz).subtract(exact(dz));
+        BigDecimal cdx = exact(cx).subtract(exact(dx));
+        BigDecimal cdy = exact(cy).subtract(exact(dy));
+        BigDecimal cdz = exact(cz).subtract(exact(dz));
+        return adz.multiply(bdx.multiply(cdy).subtract(cdx.multiply(bdy)))
+                .add(bdz.multiply(cdx.multiply(ady).subtract(adx.multiply(cdy))))
+                .add(cdz.multiply(adx.multiply(bdy).subtract(bdx.multiply(ady))))
+                .signum();
+    }
+
+    private static BigDecimal exact(double value) {
+        return new BigDecimal(value);
+    }
+}
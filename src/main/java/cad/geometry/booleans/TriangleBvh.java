@@ -0,0 +1,158 @@
+package cad.geometry.booleans;
+
+import java.util.Arrays;
+import java.util.function.IntConsumer;
+
+// Bounding volume hierarchy over the triangles of one mesh, stored in flat arrays. Nodes split at
+// the median centroid along their longest axis; leaves hold a few triangles. Boxes are built from
+// the exact vertex coordinates and compared inclusively, so touching triangles still pair up.
+public final class TriangleBvh {
+    private static final int LEAF_SIZE = 4;
+
+    private final int[] order;
+    // Per node: bounds as min xyz, max xyz
+    private final double[] bounds;
+    // Per node: first child, or -1 for a leaf
+    private final int[] left;
+    private final int[] right;
+    // Per leaf: range in order
+    private final int[] start;
+    private final int[] end;
+    private final double[] triangleBounds;
+    private int nodeCount;
+
+    public TriangleBvh(double[] positions, int[] triangles) {
+        int n = triangles.length / 3;
+        order = new int[n];
+        triangleBounds = new double[6 * n];
+        double[] centroids = new double[3 * n];
+        for (int t = 0; t < n; t++) {
+            order[t] = t;
+            int o = 6 * t;
+            for (int axis = 0; axis < 3; axis++) {
+                double a = positions[3 * triangles[3 * t] + axis];
+                double b = positions[3 * triangles[3 * t + 1] + axis];
+                double c = positions[3 * triangles[3 * t + 2] + axis];
+                triangleBounds[o + axis] = Math.min(a, Math.min(b, c));
+                triangleBounds[o + 3 + axis] = Math.max(a, Math.max(b, c));
+                centroids[3 * t + axis] = (a + b + c) / 3.0;
+            }
+        }
+        int maxNodes = Math.max(1, 2 * n);
+        bounds = new double[6 * maxNodes];
+        left = new int[maxNodes];
+        right = new int[maxNodes];
+        start = new int[maxNodes];
+        end = new int[maxNodes];
+        build(centroids, 0, n);
+    }
+
+    public int getTriangleCount() {
+        return order.length;
+    }
+
+    // Calls visitor for every triangle whose bounds overlap the given box
+    public void query(double minX, double minY, double minZ, double maxX, double maxY, double maxZ,
+            IntConsumer visitor) {
+        if (order.length == 0) {
+            return;
+        }
+        int[] stack = new int[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            int node = stack[--top];
+            if (!overlaps(bounds, 6 * node, minX, minY, minZ, maxX, maxY, maxZ)) {
+                continue;
+            }
+            if (left[node] < 0) {
+                for (int i = start[node]; i < end[node]; i++) {
+                    int t = order[i];
+                    if (overlaps(triangleBounds, 6 * t, minX, minY, minZ, maxX, maxY, maxZ)) {
+                        visitor.accept(t);
+                    }
+                }
+            } else {
+                if (top + 2 > stack.length) {
+                    stack = Arrays.copyOf(stack, stack.length * 2);
+                }
+                stack[top++] = left[node];
+                stack[top++] = right[node];
+            }
+        }
+    }
+
+    private static boolean overlaps(double[] box, int o, double minX, double minY, double minZ,
+            double maxX, double maxY, double maxZ) {
+        return box[o] <= maxX && box[o + 3] >= minX
+                && box[o + 1] <= maxY && box[o + 4] >= minY
+                && box[o + 2] <= maxZ && box[o + 5] >= minZ;
+    }
+
+    private int build(double[] centroids, int from, int to) {
+        int node = nodeCount++;
+        int o = 6 * node;
+        for (int axis = 0; axis < 3; axis++) {
+            bounds[o + axis] = Double.POSITIVE_INFINITY;
+            bounds[o + 3 + axis] = Double.NEGATIVE_INFINITY;
+        }
+        double[] centroidMin = { Double.POSITIVE_INFINITY, Double.POSITIVE_INFINITY, Double.POSITIVE_INFINITY };
+        double[] centroidMax = { Double.NEGATIVE_INFINITY, Double.NEGATIVE_INFINITY, Double.NEGATIVE_INFINITY };
+        for (int i = from; i < to; i++) {
+            int t = order[i];
+            for (int axis = 0; axis < 3; axis++) {
+                bounds[o + axis] = Math.min(bounds[o + axis], triangleBounds[6 * t + axis]);
+                bounds[o + 3 + axis] = Math.max(bounds[o + 3 + axis], triangleBounds[6 * t + 3 + axis]);
+                centroidMin[axis] = Math.min(centroidMin[axis], centroids[3 * t + axis]);
+                centroidMax[axis] = Math.max(centroidMax[axis], centroids[3 * t + axis]);
+            }
+        }
+        if (to - from <= LEAF_SIZE) {
+            left[node] = -1;
+            start[node] = from;
+            end[node] = to;
+            return node;
+        }
+        int axis = 0;
+        for (int a = 1; a < 3; a++) {
+            if (centroidMax[a] - centroidMin[a] > centroidMax[axis] - centroidMin[axis]) {
+                axis = a;
+            }
+        }
+        int mid = (from + to) >>> 1;
+        select(centroids, axis, from, to - 1, mid);
+        left[node] = build(centroids, from, mid);
+        right[node] = build(centroids, mid, to);
+        return node;
+    }
+
+    // Quickselect on order so that position k holds the median centroid along axis
+    private void select(double[] centroids, int axis, int lo, int hi, int k) {
+        while (hi > lo) {
+            double pivot = centroids[3 * order[(lo + hi) >>> 1] + axis];
+            int i = lo, j = hi;
+            while (i <= j) {
+                while (centroids[3 * order[i] + axis] < pivot) {
+                    i++;
+                }
+                while (centroids[3 * order[j] + axis] > pivot) {
+                    j--;
+                }
+                if (i <= j) {
+                    int swap = order[i];
+                    order[i] = order[j];
+                    order[j] = swap;
+                    i++;
+                    j--;
+                }
+            }
+            if (k <= j) {
+                hi = j;
+            } else if (k >= i) {
+                lo = i;
+            } else {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,421 @@
+package cad.geometry.booleans;
+
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Deque;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+// Retriangulates one input triangle so that every intersection segment lying in it becomes a chain
+// of edges. Points on the triangle's sides split those sides in the order they sit along them, so
+// the neighbouring triangle ends up with the same vertices. Points inside are inserted by exact
+// point location in the projection onto the triangle's dominant plane, and segments are recovered
+// by flipping the edges they cross. No vertices are created, so both meshes keep sharing every
+// point on the intersection curve.
+final class TriangleSplitter {
+    static final class Result {
+        // Global vertex ids, three per triangle, with the input's winding
+        final int[] triangles;
+        final int[] cutEdges;
+        // Label per output triangle; equal labels are connected without crossing a segment
+        final int[] components;
+
+        Result(int[] triangles, int[] cutEdges, int[] components) {
+            this.triangles = triangles;
+            this.cutEdges = cutEdges;
+            this.components = components;
+        }
+    }
+
+    private final double[] xyz;
+    private final int axisU;
+    private final int axisV;
+    private final int sign;
+
+    private int[] ids = new int[16];
+    private double[] us = new double[16];
+    private double[] vs = new double[16];
+    private int vertexCount;
+    private final Map<Integer, Integer> local = new HashMap<>();
+    private final List<int[]> triangles = new ArrayList<>();
+    private final List<List<Integer>> sides = new ArrayList<>();
+    private final Set<Long> boundary = new HashSet<>();
+    private final Set<Long> cut = new HashSet<>();
+
+    private TriangleSplitter(double[] xyz, int c0, int c1, int c2) {
+        this.xyz = xyz;
+        int axis = dominantAxis(xyz, c0, c1, c2);
+        this.axisU = (axis + 1) % 3;
+        this.axisV = (axis + 2) % 3;
+        int l0 = addGlobal(c0), l1 = addGlobal(c1), l2 = addGlobal(c2);
+        this.sign = rawOrient(l0, l1, l2);
+        if (sign == 0) {
+            throw new IllegalArgumentException("Degenerate triangle");
+        }
+        triangles.add(new int[] { l0, l1, l2 });
+    }
+
+    // sidePoints[i] lie on the side from corner i to corner i + 1
+    static Result split(double[] xyz, int c0, int c1, int c2, int[][] sidePoints, int[] facePoints,
+            int[][] segments) {
+        TriangleSplitter splitter = new TriangleSplitter(xyz, c0, c1, c2);
+        splitter.buildBoundary(new int[] { c0, c1, c2 }, sidePoints);
+        for (int id : facePoints) {
+            splitter.insertFacePoint(id);
+        }
+        for (int[] segment : segments) {
+            splitter.insertSegment(segment[0], segment[1]);
+        }
+        return splitter.result();
+    }
+
+    static int dominantAxis(double[] xyz, int a, int b, int c) {
+        int ia = 3 * a, ib = 3 * b, ic = 3 * c;
+        double ux = xyz[ib] - xyz[ia], uy = xyz[ib + 1] - xyz[ia + 1], uz = xyz[ib + 2] - xyz[ia + 2];
+        double vx = xyz[ic] - xyz[ia], vy = xyz[ic + 1] - xyz[ia + 1], vz = xyz[ic + 2] - xyz[ia + 2];
+        double nx = Math.abs(uy * vz - uz * vy);
+        double ny = Math.abs(uz * vx - ux * vz);
+        double nz = Math.abs(ux * vy - uy * vx);
+        return nx >= ny && nx >= nz ? 0 : ny >= nz ? 1 : 2;
+    }
+
+    private void buildBoundary(int[] corners, int[][] sidePoints) {
+        for (int side = 0; side < 3; side++) {
+            int from = corners[side], to = corners[(side + 1) % 3];
+            int[] points = sidePoints[side];
+            double[] params = new double[points.length];
+            Integer[] order = new Integer[points.length];
+            for (int i = 0; i < points.length; i++) {
+                params[i] = alongEdge(from, to, points[i]);
+                order[i] = i;
+            }
+            Arrays.sort(order, (x, y) -> Double.compare(params[x], params[y]));
+            List<Integer> chain = new ArrayList<>();
+            chain.add(local.get(from));
+            for (int i : order) {
+                if (local.containsKey(points[i])) {
+                    continue;
+                }
+                int p = addGlobal(points[i]);
+                splitEdge(chain.get(chain.size() - 1), local.get(to), p);
+                chain.add(p);
+            }
+            chain.add(local.get(to));
+            sides.add(chain);
+            for (int i = 0; i + 1 < chain.size(); i++) {
+                boundary.add(key(chain.get(i), chain.get(i + 1)));
+            }
+        }
+    }
+
+    private void insertFacePoint(int id) {
+        if (local.containsKey(id)) {
+            return;
+        }
+        int p = addGlobal(id);
+        nudgeInside(p);
+        int fallback = -1;
+        int fallbackScore = -4;
+        for (int t = 0; t < triangles.size(); t++) {
+            int[] tri = triangles.get(t);
+            int o0 = orient(tri[0], tri[1], p), o1 = orient(tri[1], tri[2], p), o2 = orient(tri[2], tri[0], p);
+            int score = o0 + o1 + o2;
+            if (score > fallbackScore) {
+                fallback = t;
+                fallbackScore = score;
+            }
+            if (o0 < 0 || o1 < 0 || o2 < 0) {
+                continue;
+            }
+            int zeros = (o0 == 0 ? 1 : 0) + (o1 == 0 ? 1 : 0) + (o2 == 0 ? 1 : 0);
+            if (zeros == 2) {
+                // Same place as an existing vertex in this plane; reuse it
+                int same = o0 != 0 ? tri[2] : o1 != 0 ? tri[0] : tri[1];
+                local.put(id, same);
+                return;
+            }
+            if (zeros == 1) {
+                int e = o0 == 0 ? 0 : o1 == 0 ? 1 : 2;
+                int x = tri[e], y = tri[(e + 1) % 3];
+                if (!boundary.contains(key(x, y))) {
+                    splitEdge(x, y, p);
+                    return;
+                }
+            }
+            splitTriangle(t, p);
+            return;
+        }
+        splitTriangle(fallback, p);
+    }
+
+    // A point that is inside the triangle in exact terms can round to just outside it. Only its
+    // projected position moves, by as little as it takes, so the output coordinates are untouched.
+    private void nudgeInside(int p) {
+        double u0 = us[p], v0 = vs[p];
+        double cu = (us[0] + us[1] + us[2]) / 3.0, cv = (vs[0] + vs[1] + vs[2]) / 3.0;
+        for (double lambda = 1e-12; lambda < 1 && !strictlyInside(p); lambda *= 16) {
+            us[p] = u0 + lambda * (cu - u0);
+            vs[p] = v0 + lambda * (cv - v0);
+        }
+    }
+
+    private boolean strictlyInside(int p) {
+        return orient(0, 1, p) > 0 && orient(1, 2, p) > 0 && orient(2, 0, p) > 0;
+    }
+
+    private void insertSegment(int globalP, int globalQ) {
+        Integer lp = local.get(globalP), lq = local.get(globalQ);
+        if (lp == null || lq == null) {
+            throw new IllegalStateException("Segment endpoint was not placed in its triangle");
+        }
+        if (lp.intValue() == lq.intValue() || alongBoundary(lp, lq)) {
+            return;
+        }
+        insertLocal(lp, lq);
+    }
+
+    private void insertLocal(int p, int q) {
+        // A vertex lying on the segment splits it in two
+        for (int v = 0; v < vertexCount; v++) {
+            if (v != p && v != q && orient(p, q, v) == 0 && ahead(p, v, q) && ahead(q, v, p) && used(v)) {
+                insertLocal(p, v);
+                insertLocal(v, q);
+                return;
+            }
+        }
+        Deque<int[]> crossing = crossingEdges(p, q);
+        int guard = 64 + 4 * crossing.size() * crossing.size() + 4 * triangles.size();
+        while (!crossing.isEmpty()) {
+            if (--guard < 0) {
+                throw new IllegalStateException("Segment could not be recovered");
+            }
+            int[] edge = crossing.poll();
+            int x = edge[0], y = edge[1];
+            if (cut.contains(key(x, y)) || boundary.contains(key(x, y))) {
+                throw new IllegalStateException("Segments cross");
+            }
+            int t1 = triangleWith(x, y), t2 = triangleWith(y, x);
+            int a = opposite(triangles.get(t1), x, y), b = opposite(triangles.get(t2), y, x);
+            if (orient(a, b, x) * orient(a, b, y) < 0) {
+                // The quad is convex, so the diagonal can flip
+                triangles.set(t1, new int[] { x, b, a });
+                triangles.set(t2, new int[] { b, y, a });
+                if (crosses(p, q, a, b)) {
+                    crossing.add(new int[] { a, b });
+                }
+            } else {
+                crossing.add(edge);
+            }
+        }
+        if (!hasEdge(p, q)) {
+            throw new IllegalStateException("Segment could not be recovered");
+        }
+        cut.add(key(p, q));
+    }
+
+    private Deque<int[]> crossingEdges(int p, int q) {
+        Deque<int[]> out = new ArrayDeque<>();
+        Set<Long> seen = new HashSet<>();
+        for (int[] tri : triangles) {
+            for (int k = 0; k < 3; k++) {
+                int x = tri[k], y = tri[(k + 1) % 3];
+                if (seen.add(key(x, y)) && crosses(p, q, x, y)) {
+                    out.add(new int[] { x, y });
+                }
+            }
+        }
+        return out;
+    }
+
+    private boolean crosses(int p, int q, int x, int y) {
+        if (x == p || x == q || y == p || y == q) {
+            return false;
+        }
+        return orient(p, q, x) * orient(p, q, y) < 0 && orient(x, y, p) * orient(x, y, q) < 0;
+    }
+
+    private int triangleWith(int x, int y) {
+        for (int t = 0; t < triangles.size(); t++) {
+            int[] tri = triangles.get(t);
+            for (int k = 0; k < 3; k++) {
+                if (tri[k] == x && tri[(k + 1) % 3] == y) {
+                    return t;
+                }
+            }
+        }
+        throw new IllegalStateException("Edge has no triangle on one side");
+    }
+
+    private static int opposite(int[] tri, int x, int y) {
+        for (int v : tri) {
+            if (v != x && v != y) {
+                return v;
+            }
+        }
+        return -1;
+    }
+
+    private boolean used(int v) {
+        for (int[] tri : triangles) {
+            if (tri[0] == v || tri[1] == v || tri[2] == v) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Segments between two points of the same side need no edges, only the cut marks
+    private boolean alongBoundary(int p, int q) {
+        for (List<Integer> chain : sides) {
+            int i = chain.indexOf(p), j = chain.indexOf(q);
+            if (i >= 0 && j >= 0) {
+                for (int k = Math.min(i, j); k < Math.max(i, j); k++) {
+                    cut.add(key(chain.get(k), chain.get(k + 1)));
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private void splitTriangle(int t, int p) {
+        int[] tri = triangles.get(t);
+        triangles.set(t, new int[] { tri[0], tri[1], p });
+        triangles.add(new int[] { tri[1], tri[2], p });
+        triangles.add(new int[] { tri[2], tri[0], p });
+    }
+
+    // Splits edge xy at p in every triangle that uses it
+    private void splitEdge(int x, int y, int p) {
+        int count = triangles.size();
+        for (int t = 0; t < count; t++) {
+            int[] tri = triangles.get(t);
+            for (int k = 0; k < 3; k++) {
+                int a = tri[k], b = tri[(k + 1) % 3], c = tri[(k + 2) % 3];
+                if ((a == x && b == y) || (a == y && b == x)) {
+                    triangles.set(t, new int[] { a, p, c });
+                    triangles.add(new int[] { p, b, c });
+                    break;
+                }
+            }
+        }
+        if (cut.remove(key(x, y))) {
+            cut.add(key(x, p));
+            cut.add(key(p, y));
+        }
+    }
+
+    private boolean hasEdge(int a, int b) {
+        for (int[] tri : triangles) {
+            for (int k = 0; k < 3; k++) {
+                int x = tri[k], y = tri[(k + 1) % 3];
+                if ((x == a && y == b) || (x == b && y == a)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    private boolean ahead(int from, int via, int to) {
+        return (us[via] - us[from]) * (us[to] - us[from]) + (vs[via] - vs[from]) * (vs[to] - vs[from]) > 0;
+    }
+
+    private double alongEdge(int from, int to, int point) {
+        double sum = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            sum += (xyz[3 * point + axis] - xyz[3 * from + axis]) * (xyz[3 * to + axis] - xyz[3 * from + axis]);
+        }
+        return sum;
+    }
+
+    private Result result() {
+        int[] out = new int[3 * triangles.size()];
+        for (int t = 0; t < triangles.size(); t++) {
+            int[] tri = triangles.get(t);
+            for (int k = 0; k < 3; k++) {
+                out[3 * t + k] = ids[tri[k]];
+            }
+        }
+        int[] cutEdges = new int[2 * cut.size()];
+        int i = 0;
+        for (long edge : cut) {
+            cutEdges[i++] = ids[(int) (edge >>> 32)];
+            cutEdges[i++] = ids[(int) edge];
+        }
+        return new Result(out, cutEdges, components());
+    }
+
+    // Groups triangles that share an edge not on any segment
+    private int[] components() {
+        int n = triangles.size();
+        int[] parent = new int[n];
+        for (int t = 0; t < n; t++) {
+            parent[t] = t;
+        }
+        Map<Long, Integer> firstUse = new HashMap<>();
+        for (int t = 0; t < n; t++) {
+            int[] tri = triangles.get(t);
+            for (int k = 0; k < 3; k++) {
+                long edge = key(tri[k], tri[(k + 1) % 3]);
+                if (cut.contains(edge)) {
+                    continue;
+                }
+                Integer other = firstUse.putIfAbsent(edge, t);
+                if (other != null) {
+                    parent[find(parent, t)] = find(parent, other);
+                }
+            }
+        }
+        for (int t = 0; t < n; t++) {
+            parent[t] = find(parent, t);
+        }
+        return parent;
+    }
+
+    static int find(int[] parent, int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    private int orient(int a, int b, int c) {
+        return sign * rawOrient(a, b, c);
+    }
+
+    private int rawOrient(int a, int b, int c) {
+        return Predicates.orient2d(us[a], vs[a], us[b], vs[b], us[c], vs[c]);
+    }
+
+    private int addGlobal(int id) {
+        Integer existing = local.get(id);
+        if (existing != null) {
+            return existing;
+        }
+        int l = addVertex(id, xyz[3 * id + axisU], xyz[3 * id + axisV]);
+        local.put(id, l);
+        return l;
+    }
+
+    private int addVertex(int id, double u, double v) {
+        if (vertexCount == ids.length) {
+            ids = Arrays.copyOf(ids, 2 * vertexCount);
+            us = Arrays.copyOf(us, 2 * vertexCount);
+            vs = Arrays.copyOf(vs, 2 * vertexCount);
+        }
+        ids[vertexCount] = id;
+        us[vertexCount] = u;
+        vs[vertexCount] = v;
+        return vertexCount++;
+    }
+
+    private static long key(int a, int b) {
+        return IndexedMesh.edgeKey(a, b);
+    }
+}
@@ -27,18 +27,16 @@ public class ArcCurve extends Curve {
         this.startAngle = startAngle;
         this.endAngle = endAngle;
         this.normal = normal.normalize();
-        
-        Vector3d radialX = getRadialX();
-        Vector3d radialY = normal.cross(radialX);
-        
-        this.start = center.plus(
-            radialX.multiply(radius * Math.cos(startAngle))
-                .plus(radialY.multiply(radius * Math.sin(startAngle)))
-        );
-        this.end = center.plus(
-            radialX.multiply(radius * Math.cos(endAngle))
-                .plus(radialY.multiply(radius * Math.sin(endAngle)))
-        );
+        this.start = getPointAtAngle(startAngle);
+        this.end = getPointAtAngle(endAngle);
+    }
+
+    // Starts at start and turns sweep radians counterclockwise about normal; a sweep of 2 pi closes
+    // the circle back on start
+    public static ArcCurve fromStart(Vector3d center, Vector3d start, double sweep, Vector3d normal) {
+        Vector3d axis = normal.normalize();
+        double startAngle = calculateAngle(center, start, axis);
+        return new ArcCurve(center, center.distance(start), startAngle, startAngle + sweep, axis);
     }
 
     @Override
@@ -49,25 +47,40 @@ public class ArcCurve extends Curve {
 
     @Override
     public Vector3d tangent(double t) {
-        double angle = startAngle + t * (endAngle - startAngle);
-        Vector3d radialX = getRadialX();
-        Vector3d radialY = normal.cross(radialX);
-        
-        Vector3d tangent = radialX.multiply(-Math.sin(angle))
-            .plus(radialY.multiply(Math.cos(angle)));
-        
-        if ((endAngle - startAngle) < 0) {
-            tangent = tangent.negated();
-        }
-        
-        return tangent.normalize();
+        return derivative(t).normalize();
     }
 
+    // P = C + r (cos X + sin Y) with angle = startAngle + t * sweep
     @Override
     public Vector3d derivative(double t) {
-        double angleRange = endAngle - startAngle;
-        Vector3d tangent = tangent(t);
-        return tangent.multiply(Math.abs(angleRange) * radius);
+        double sweep = endAngle - startAngle;
+        double angle = startAngle + t * sweep;
+        Vector3d radialX = getRadialX(center, normal);
+        Vector3d radialY = normal.cross(radialX);
+
+        return radialX.multiply(-Math.sin(angle))
+            .plus(radialY.multiply(Math.cos(angle)))
+            .multiply(radius * sweep);
+    }
+
+    @Override
+    public Vector3d secondDerivative(double t) {
+        double sweep = endAngle - startAngle;
+        return getPointAtAngle(startAngle + t * sweep).subtract(center).multiply(-sweep * sweep);
+    }
+
+    @Override
+    public CurveDerivatives evaluateWithDerivatives(double t) {
+        double sweep = endAngle - startAngle;
+        double angle = startAngle + t * sweep;
+        double cos = Math.cos(angle);
+        double sin = Math.sin(angle);
+        Vector3d radialX = getRadialX(center, normal);
+        Vector3d radialY = normal.cross(radialX);
+
+        Vector3d radial = radialX.multiply(cos).plus(radialY.multiply(sin)).multiply(radius);
+        Vector3d first = radialX.multiply(-sin).plus(radialY.multiply(cos)).multiply(radius * sweep);
+        return new CurveDerivatives(center.plus(radial), first, radial.multiply(-sweep * sweep));
     }
 
     @Override
@@ -86,8 +99,16 @@ public class ArcCurve extends Curve {
         return radius * angleRange;
     }
 
+    @Override
+    public double paramAtLength(double s) {
+        double total = length();
+        return total > 0 ? Math.max(0.0, Math.min(1.0, s / total)) : 0.0;
+    }
+
+    // Angles are measured in the fixed frame from getRadialX(center, normal), the same one
+    // calculateAngle uses, so stored angles round-trip to the original start and end points
     private Vector3d getPointAtAngle(double angle) {
-        Vector3d radialX = getRadialX();
+        Vector3d radialX = getRadialX(center, normal);
         Vector3d radialY = normal.cross(radialX);
         
         return center.plus(
@@ -96,16 +117,6 @@ public class ArcCurve extends Curve {
         );
     }
 
-    private Vector3d getRadialX() {
-        Vector3d toStart = start.minus(center);
-        if (toStart.magnitude() > 1e-10) {
-            return toStart.normalize();
-        }
-        
-        Vector3d test = Math.abs(normal.dot(Vector3d.Z_AXIS)) < 0.9 ? Vector3d.Z_AXIS : Vector3d.X_AXIS;
-        return normal.cross(test).normalize();
-    }
-
     private static double calculateAngle(Vector3d center, Vector3d point, Vector3d normal) {
         Vector3d toPoint = point.minus(center);
         if (toPoint.magnitude() < 1e-10) return 0.0;
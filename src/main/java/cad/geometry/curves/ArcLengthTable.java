@@ -0,0 +1,175 @@
+package cad.geometry.curves;
+
+import cad.math.GaussLegendre;
+import java.util.Arrays;
+import java.util.function.DoubleUnaryOperator;
+
+// Cumulative arc length at the breakpoints of an adaptive Gauss-Legendre integration of |C'(t)|.
+// Breakpoints are the accepted leaf intervals, so a single five-point rule is accurate inside each one.
+public class ArcLengthTable {
+    private static final int INITIAL_PANELS = 16;
+    private static final double RELATIVE_TOLERANCE = 1e-10;
+
+    private final DoubleUnaryOperator speed;
+    private double[] params;
+    private double[] lengths;
+    private int size;
+
+    public ArcLengthTable(Curve curve) {
+        this(curve, curve.startParam(), curve.endParam());
+    }
+
+    public ArcLengthTable(Curve curve, double t0, double t1) {
+        this.speed = t -> curve.derivative(t).magnitude();
+        this.params = new double[4 * INITIAL_PANELS + 1];
+        this.lengths = new double[params.length];
+
+        double[] panelLengths = new double[INITIAL_PANELS];
+        double estimate = 0.0;
+        double dt = (t1 - t0) / INITIAL_PANELS;
+        for (int i = 0; i < INITIAL_PANELS; i++) {
+            panelLengths[i] = GaussLegendre.integrate5(speed, t0 + i * dt, t0 + (i + 1) * dt);
+            estimate += panelLengths[i];
+        }
+        double tolerance = RELATIVE_TOLERANCE * Math.max(estimate, 1e-12) / INITIAL_PANELS;
+
+        append(t0, 0.0);
+        for (int i = 0; i < INITIAL_PANELS; i++) {
+            double a = t0 + i * dt;
+            double b = i == INITIAL_PANELS - 1 ? t1 : a + dt;
+            subdivide(a, b, panelLengths[i], tolerance, 0);
+        }
+        params = Arrays.copyOf(params, size);
+        lengths = Arrays.copyOf(lengths, size);
+    }
+
+    private void subdivide(double a, double b, double whole, double tolerance, int depth) {
+        double m = 0.5 * (a + b);
+        double left = GaussLegendre.integrate5(speed, a, m);
+        double right = GaussLegendre.integrate5(speed, m, b);
+        if (depth >= GaussLegendre.MAX_DEPTH || Math.abs(left + right - whole) <= tolerance) {
+            append(m, lengths[size - 1] + left);
+            append(b, lengths[size - 1] + right);
+            return;
+        }
+        subdivide(a, m, left, 0.5 * tolerance, depth + 1);
+        subdivide(m, b, right, 0.5 * tolerance, depth + 1);
+    }
+
+    private void append(double t, double length) {
+        if (size == params.length) {
+            params = Arrays.copyOf(params, 2 * size);
+            lengths = Arrays.copyOf(lengths, 2 * size);
+        }
+        params[size] = t;
+        lengths[size] = length;
+        size++;
+    }
+
+    public double getTotalLength() {
+        return lengths[size - 1];
+    }
+
+    public double getStartParam() {
+        return params[0];
+    }
+
+    public double getEndParam() {
+        return params[size - 1];
+    }
+
+    public int getBreakpointCount() {
+        return size;
+    }
+
+    public double lengthAtParam(double t) {
+        if (t <= params[0]) {
+            return 0.0;
+        }
+        if (t >= params[size - 1]) {
+            return getTotalLength();
+        }
+        int i = segmentForParam(t);
+        return lengths[i] + GaussLegendre.integrate5(speed, params[i], t);
+    }
+
+    // Binary search for the segment, then safeguarded Newton on s(t) inside it
+    public double paramAtLength(double s) {
+        if (s <= 0.0) {
+            return params[0];
+        }
+        if (s >= getTotalLength()) {
+            return params[size - 1];
+        }
+        int i = segmentForLength(s);
+        double a = params[i];
+        double b = params[i + 1];
+        double target = s - lengths[i];
+        double segment = lengths[i + 1] - lengths[i];
+        if (segment <= 0.0) {
+            return a;
+        }
+
+        double lo = a, hi = b;
+        double t = a + (b - a) * (target / segment);
+        for (int iter = 0; iter < 20; iter++) {
+            double f = GaussLegendre.integrate5(speed, a, t) - target;
+            if (Math.abs(f) <= 1e-12 * Math.max(1.0, segment)) {
+                break;
+            }
+            if (f > 0) {
+                hi = t;
+            } else {
+                lo = t;
+            }
+            double v = speed.applyAsDouble(t);
+            double next = v > 1e-300 ? t - f / v : 0.5 * (lo + hi);
+            if (next <= lo || next >= hi) {
+                next = 0.5 * (lo + hi);
+            }
+            t = next;
+        }
+        return t;
+    }
+
+    // count parameters whose arc-length spacing is equal, including both ends
+    public double[] equalLengthParams(int count) {
+        if (count < 2) {
+            throw new IllegalArgumentException("At least two samples are required");
+        }
+        double[] result = new double[count];
+        double total = getTotalLength();
+        for (int k = 0; k < count; k++) {
+            result[k] = paramAtLength(total * k / (count - 1));
+        }
+        result[0] = params[0];
+        result[count - 1] = params[size - 1];
+        return result;
+    }
+
+    private int segmentForLength(double s) {
+        int lo = 0, hi = size - 1;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) >>> 1;
+            if (lengths[mid] <= s) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    private int segmentForParam(double t) {
+        int lo = 0, hi = size - 1;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) >>> 1;
+            if (params[mid] <= t) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+}
@@ -1,8 +1,14 @@
 package cad.geometry.curves;
 
+import cad.math.GaussLegendre;
 import cad.math.Vector3d;
+import java.util.function.DoubleUnaryOperator;
 
 public abstract class Curve {
+    private static final int LENGTH_ESTIMATE_PANELS = 8;
+
+    private volatile ArcLengthTable arcLengthTable;
+
     public abstract Vector3d value(double t);
 
     public abstract Vector3d tangent(double t);
@@ -17,9 +23,52 @@ public abstract class Curve {
         Vector3d p2 = value(t + delta);
         return p2.subtract(p1).multiply(1.0 / (2.0 * delta));
     }
+
+    // Fallback for curves without a closed form; the built-in subclasses override this
+    public Vector3d secondDerivative(double t) {
+        double delta = 1e-5;
+        Vector3d d1 = derivative(t - delta);
+        Vector3d d2 = derivative(t + delta);
+        return d2.subtract(d1).multiply(1.0 / (2.0 * delta));
+    }
+
+    public CurveDerivatives evaluateWithDerivatives(double t) {
+        return new CurveDerivatives(value(t), derivative(t), secondDerivative(t));
+    }
     
     public double length() {
-        return length(startParam(), endParam(), 100);
+        return getArcLengthTable().getTotalLength();
+    }
+
+    // Tolerance is relative to a coarse estimate of the length itself; the chord is no guide, being
+    // zero for a closed loop
+    public double length(double t1, double t2) {
+        DoubleUnaryOperator speed = t -> derivative(t).magnitude();
+        double estimate = 0.0;
+        double dt = (t2 - t1) / LENGTH_ESTIMATE_PANELS;
+        for (int i = 0; i < LENGTH_ESTIMATE_PANELS; i++) {
+            estimate += Math.abs(GaussLegendre.integrate5(speed, t1 + i * dt, t1 + (i + 1) * dt));
+        }
+        double tolerance = 1e-10 * Math.max(estimate, 1e-12);
+        return GaussLegendre.integrate(speed, t1, t2, tolerance);
+    }
+
+    // Built on first use; curves are immutable once constructed so the table never goes stale
+    public ArcLengthTable getArcLengthTable() {
+        ArcLengthTable table = arcLengthTable;
+        if (table == null) {
+            table = new ArcLengthTable(this);
+            arcLengthTable = table;
+        }
+        return table;
+    }
+
+    public double paramAtLength(double s) {
+        return getArcLengthTable().paramAtLength(s);
+    }
+
+    public double[] equalLengthParams(int count) {
+        return getArcLengthTable().equalLengthParams(count);
     }
     
     public double length(double t1, double t2, int segments) {
@@ -0,0 +1,28 @@
+package cad.geometry.curves;
+
+import cad.math.Vector3d;
+
+public class CurveDerivatives {
+    public final Vector3d point;
+    public final Vector3d first;
+    public final Vector3d second;
+
+    public CurveDerivatives(Vector3d point, Vector3d first, Vector3d second) {
+        this.point = point;
+        this.first = first;
+        this.second = second;
+    }
+
+    public Vector3d tangent() {
+        return first.normalize();
+    }
+
+    // |C' x C''| / |C'|^3
+    public double curvature() {
+        double speed = first.magnitude();
+        if (speed < 1e-12) {
+            return 0.0;
+        }
+        return first.cross(second).magnitude() / (speed * speed * speed);
+    }
+}
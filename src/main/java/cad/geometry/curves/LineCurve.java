@@ -37,6 +37,17 @@ public class LineCurve extends Curve {
         return endPoint.subtract(startPoint);
     }
 
+    @Override
+    public Vector3d secondDerivative(double t) {
+        return Vector3d.ZERO;
+    }
+
+    @Override
+    public CurveDerivatives evaluateWithDerivatives(double t) {
+        Vector3d d = endPoint.subtract(startPoint);
+        return new CurveDerivatives(startPoint.plus(d.multiply(t)), d, Vector3d.ZERO);
+    }
+
     public Vector3d getStartPoint() {
         return startPoint;
     }
@@ -49,6 +60,17 @@ public class LineCurve extends Curve {
         return startPoint.distance(endPoint);
     }
 
+    @Override
+    public double length() {
+        return getLength();
+    }
+
+    @Override
+    public double paramAtLength(double s) {
+        double total = getLength();
+        return total > 0 ? Math.max(0.0, Math.min(1.0, s / total)) : 0.0;
+    }
+
     public boolean isPoint() {
         return startPoint.distance(endPoint) < 1e-10;
     }
@@ -1,155 +1,211 @@
 package cad.geometry.curves;
 
+import cad.math.BSplineBasis;
 import cad.math.Vector3d;
+import cad.math.VectorArrays;
 
 public class NurbsCurve extends Curve {
+    private static final ThreadLocal<BSplineBasis.Workspace> WORKSPACE = ThreadLocal
+            .withInitial(BSplineBasis.Workspace::new);
+
     private int degree;
     private int controlPoints;
     private Vector3d[] controlPointArray;
     private double[] weights;
     private double[] knots;
+    // Weighted control points packed as (wx, wy, wz, w)
+    private final double[] homogeneousPoints;
 
     public NurbsCurve(int degree, Vector3d[] controlPoints, double[] weights, double[] knots) {
+        if (knots.length != controlPoints.length + degree + 1) {
+            throw new IllegalArgumentException("Knot vector length must be control points + degree + 1");
+        }
         this.degree = degree;
         this.controlPointArray = controlPoints;
         this.weights = weights;
         this.knots = knots;
         this.controlPoints = controlPoints.length;
+        this.homogeneousPoints = new double[4 * controlPoints.length];
+        for (int i = 0; i < controlPoints.length; i++) {
+            double w = weights[i];
+            homogeneousPoints[4 * i] = controlPoints[i].x() * w;
+            homogeneousPoints[4 * i + 1] = controlPoints[i].y() * w;
+            homogeneousPoints[4 * i + 2] = controlPoints[i].z() * w;
+            homogeneousPoints[4 * i + 3] = w;
+        }
     }
 
     @Override
     public Vector3d value(double t) {
-        double scaledT = scaleParameter(t);
-        
-        Vector3d numerator = Vector3d.zero();
-        double denominator = 0.0;
-        
-        for (int i = 0; i < controlPoints; i++) {
-            double basis = calculateBasis(i, degree, scaledT, knots);
-            double weight = weights[i];
-            
-            double blendedWeight = basis * weight;
-            numerator = numerator.plus(controlPointArray[i].multiply(blendedWeight));
-            denominator += blendedWeight;
-        }
-        
-        return denominator > 0 ? numerator.multiply(1.0 / denominator) : Vector3d.zero();
+        BSplineBasis.Workspace ws = WORKSPACE.get();
+        ws.ensure(degree, 0);
+        evaluate(t, 0, ws.point, 0, ws);
+        return new Vector3d(ws.point[0], ws.point[1], ws.point[2]);
     }
 
     @Override
     public Vector3d tangent(double t) {
-        Vector3d derivative = derivative(t);
-        return derivative.normalize();
+        BSplineBasis.Workspace ws = WORKSPACE.get();
+        ws.ensure(degree, 1);
+        evaluate(t, 1, ws.point, 0, ws);
+        VectorArrays.normalize(ws.point, 2);
+        return VectorArrays.get(ws.point, 1);
     }
 
     @Override
     public Vector3d derivative(double t) {
-        double scaledT = scaleParameter(t);
-        
-        Vector3d dNumerator = Vector3d.zero();
-        double dDenominator = 0.0;
-        double denominator = 0.0;
-        
-        for (int i = 0; i < controlPoints; i++) {
-            double basis = calculateBasis(i, degree, scaledT, knots);
-            double dBasis = calculateBasisDerivative(i, degree, scaledT, knots);
-            double weight = weights[i];
-            
-            double blendedWeight = basis * weight;
-            double dBlendedWeight = dBasis * weight;
-            
-            dNumerator = dNumerator.plus(controlPointArray[i].multiply(dBlendedWeight));
-            dDenominator += dBlendedWeight;
-            denominator += blendedWeight;
-        }
-        
-        if (denominator == 0) return Vector3d.zero();
-        
-        Vector3d term1 = dNumerator.multiply(1.0 / denominator);
-        Vector3d term2 = value(t).multiply(dDenominator / (denominator * denominator));
-        return term1.minus(term2);
+        return derivative(t, 1);
+    }
+
+    public Vector3d derivative(double t, int order) {
+        BSplineBasis.Workspace ws = WORKSPACE.get();
+        ws.ensure(degree, order);
+        evaluate(t, order, ws.point, 0, ws);
+        int o = 3 * order;
+        return new Vector3d(ws.point[o], ws.point[o + 1], ws.point[o + 2]);
     }
 
     @Override
-    public double startParam() {
-        return 0.0;
+    public Vector3d secondDerivative(double t) {
+        return derivative(t, 2);
     }
 
     @Override
-    public double endParam() {
-        return 1.0;
+    public CurveDerivatives evaluateWithDerivatives(double t) {
+        BSplineBasis.Workspace ws = WORKSPACE.get();
+        ws.ensure(degree, 2);
+        evaluate(t, 2, ws.point, 0, ws);
+        double[] p = ws.point;
+        return new CurveDerivatives(new Vector3d(p[0], p[1], p[2]), new Vector3d(p[3], p[4], p[5]),
+                new Vector3d(p[6], p[7], p[8]));
     }
 
-    private double scaleParameter(double t) {
-        double tMin = knots[degree];
-        double tMax = knots[knots.length - degree - 1];
-        return tMin + t * (tMax - tMin);
+    // Writes the point and its first nDers derivatives as consecutive xyz triples starting at offset
+    public void evaluate(double t, int nDers, double[] out, int offset) {
+        evaluate(t, nDers, out, offset, WORKSPACE.get());
     }
 
-    private double calculateBasis(int i, int degree, double t, double[] knots) {
-        if (degree == 0) {
-            return (t >= knots[i] && t < knots[i + 1]) ? 1.0 : 0.0;
+    public void evaluate(double[] ts, double[] outXYZ) {
+        if (outXYZ.length < 3 * ts.length) {
+            throw new IllegalArgumentException("Output array too small: need " + (3 * ts.length));
         }
-        
-        double left = 0.0, right = 0.0;
-        
-        double denominator1 = knots[i + degree] - knots[i];
-        if (denominator1 != 0) {
-            left = ((t - knots[i]) / denominator1) * calculateBasis(i, degree - 1, t, knots);
+        BSplineBasis.Workspace ws = WORKSPACE.get();
+        for (int i = 0; i < ts.length; i++) {
+            evaluate(ts[i], 0, outXYZ, 3 * i, ws);
         }
-        
-        double denominator2 = knots[i + degree + 1] - knots[i + 1];
-        if (denominator2 != 0) {
-            right = ((knots[i + degree + 1] - t) / denominator2) * calculateBasis(i + 1, degree - 1, t, knots);
+    }
+
+    // Same as evaluate(double[], double[]) but each sample occupies 3 * (nDers + 1) entries
+    public void evaluate(double[] ts, int nDers, double[] out) {
+        int stride = 3 * (nDers + 1);
+        if (out.length < stride * ts.length) {
+            throw new IllegalArgumentException("Output array too small: need " + (stride * ts.length));
+        }
+        BSplineBasis.Workspace ws = WORKSPACE.get();
+        for (int i = 0; i < ts.length; i++) {
+            evaluate(ts[i], nDers, out, stride * i, ws);
         }
-        
-        return left + right;
     }
 
-    private double calculateBasisDerivative(int i, int degree, double t, double[] knots) {
-        if (degree == 0) {
-            return 0.0; 
+    private void evaluate(double t, int nDers, double[] out, int offset, BSplineBasis.Workspace ws) {
+        double u = scaleParameter(t);
+        int span = BSplineBasis.findSpan(controlPoints - 1, degree, u, knots);
+        BSplineBasis.dersBasisFuns(span, u, degree, nDers, knots, ws);
+
+        double[][] ders = ws.ders;
+        double[] aw = ws.homogeneous;
+        int first = span - degree;
+        for (int k = 0; k <= nDers; k++) {
+            double x = 0.0, y = 0.0, z = 0.0, w = 0.0;
+            double[] row = ders[k];
+            for (int j = 0; j <= degree; j++) {
+                int idx = 4 * (first + j);
+                double b = row[j];
+                x += b * homogeneousPoints[idx];
+                y += b * homogeneousPoints[idx + 1];
+                z += b * homogeneousPoints[idx + 2];
+                w += b * homogeneousPoints[idx + 3];
+            }
+            aw[4 * k] = x;
+            aw[4 * k + 1] = y;
+            aw[4 * k + 2] = z;
+            aw[4 * k + 3] = w;
         }
-        
-        double leftDerivative = 0.0, rightDerivative = 0.0;
-        
-        double denominator1 = knots[i + degree] - knots[i];
-        if (denominator1 != 0) {
-            double basis1 = calculateBasis(i, degree - 1, t, knots);
-            double derivative1 = calculateBasisDerivative(i, degree - 1, t, knots);
-            leftDerivative = (basis1 + (t - knots[i]) * derivative1) / denominator1;
+
+        double w0 = aw[3];
+        if (w0 == 0.0) {
+            for (int i = 0; i < 3 * (nDers + 1); i++) {
+                out[offset + i] = 0.0;
+            }
+            return;
         }
-        
-        double denominator2 = knots[i + degree + 1] - knots[i + 1];
-        if (denominator2 != 0) {
-            double basis2 = calculateBasis(i + 1, degree - 1, t, knots);
-            double derivative2 = calculateBasisDerivative(i + 1, degree - 1, t, knots);
-            rightDerivative = (-basis2 + (knots[i + degree + 1] - t) * derivative2) / denominator2;
+
+        // Rational derivatives from the homogeneous ones (A4.2)
+        for (int k = 0; k <= nDers; k++) {
+            double x = aw[4 * k];
+            double y = aw[4 * k + 1];
+            double z = aw[4 * k + 2];
+            for (int i = 1; i <= k; i++) {
+                double c = BSplineBasis.binomial(k, i) * aw[4 * i + 3];
+                int o = offset + 3 * (k - i);
+                x -= c * out[o];
+                y -= c * out[o + 1];
+                z -= c * out[o + 2];
+            }
+            int o = offset + 3 * k;
+            out[o] = x / w0;
+            out[o + 1] = y / w0;
+            out[o + 2] = z / w0;
         }
-        
-        return leftDerivative + rightDerivative;
+
+        // Chain rule for the [0, 1] -> knot domain mapping
+        double range = knots[knots.length - degree - 1] - knots[degree];
+        double chain = range;
+        for (int k = 1; k <= nDers; k++) {
+            int o = offset + 3 * k;
+            out[o] *= chain;
+            out[o + 1] *= chain;
+            out[o + 2] *= chain;
+            chain *= range;
+        }
+    }
+
+    @Override
+    public double startParam() {
+        return 0.0;
+    }
+
+    @Override
+    public double endParam() {
+        return 1.0;
+    }
+
+    private double scaleParameter(double t) {
+        double tMin = knots[degree];
+        double tMax = knots[knots.length - degree - 1];
+        return tMin + t * (tMax - tMin);
     }
 
     public static NurbsCurve createCircle(Vector3d center, double radius, Vector3d normal) {
         int degree = 2;
-        int numPoints = 7;
+        int numPoints = 9;
         
         Vector3d[] controlPoints = new Vector3d[numPoints];
         double[] weights = new double[numPoints];
-        double[] knots = {0, 0, 0, 0.25, 0.5, 0.75, 1, 1, 1};
+        double[] knots = {0, 0, 0, 0.25, 0.25, 0.5, 0.5, 0.75, 0.75, 1, 1, 1};
         
         Vector3d radialX = Math.abs(normal.dot(Vector3d.Z_AXIS)) < 0.9 ? normal.cross(Vector3d.Z_AXIS).normalize() : normal.cross(Vector3d.X_AXIS).normalize();
         Vector3d radialY = normal.cross(radialX);
         
         for (int i = 0; i < numPoints; i++) {
-            double angle = 2 * Math.PI * i / 6.0;
+            double angle = 2 * Math.PI * i / 8.0;
             if (i % 2 == 0) {
                 controlPoints[i] = center.plus(radialX.multiply(radius * Math.cos(angle)).plus(radialY.multiply(radius * Math.sin(angle))));
                 weights[i] = 1.0;
             } else {
-                double scale = 1.0 / Math.cos(Math.PI / 6.0);
+                double scale = 1.0 / Math.cos(Math.PI / 4.0);
                 controlPoints[i] = center.plus(radialX.multiply(radius * scale * Math.cos(angle)).plus(radialY.multiply(radius * scale * Math.sin(angle))));
-                weights[i] = Math.cos(Math.PI / 6.0);
+                weights[i] = Math.cos(Math.PI / 4.0);
             }
         }
         
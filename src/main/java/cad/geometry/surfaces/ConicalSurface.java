@@ -39,6 +39,55 @@ public class ConicalSurface extends Surface {
         return dU.cross(dV).normalize();
     }
 
+    @Override
+    public Vector3d derivativeU(double u, double v) {
+        return evaluateWithDerivatives(u, v).du;
+    }
+
+    @Override
+    public Vector3d derivativeV(double u, double v) {
+        return evaluateWithDerivatives(u, v).dv;
+    }
+
+    @Override
+    public Vector3d derivativeUU(double u, double v) {
+        return evaluateWithDerivatives(u, v).duu;
+    }
+
+    @Override
+    public Vector3d derivativeUV(double u, double v) {
+        return evaluateWithDerivatives(u, v).duv;
+    }
+
+    @Override
+    public Vector3d derivativeVV(double u, double v) {
+        return Vector3d.ZERO;
+    }
+
+    // P = O + h A + (r0 + h tan a)(cos X + sin Y) with angle = 2 pi u, h = minV + v (maxV - minV)
+    @Override
+    public SurfaceDerivatives evaluateWithDerivatives(double u, double v) {
+        double angle = u * 2 * Math.PI;
+        double cos = Math.cos(angle);
+        double sin = Math.sin(angle);
+        double span = maxV - minV;
+        double heightPos = minV + v * span;
+        double slope = Math.tan(halfAngle);
+        double currentRadius = baseRadius + heightPos * slope;
+
+        Vector3d radialX = getPerpendicularX();
+        Vector3d radialY = axisDirection.cross(radialX).normalize();
+        Vector3d radial = radialX.multiply(cos).plus(radialY.multiply(sin));
+        Vector3d tangent = radialX.multiply(-sin).plus(radialY.multiply(cos));
+
+        Vector3d point = axisOrigin.plus(axisDirection.multiply(heightPos)).plus(radial.multiply(currentRadius));
+        Vector3d du = tangent.multiply(2 * Math.PI * currentRadius);
+        Vector3d dv = axisDirection.plus(radial.multiply(slope)).multiply(span);
+        Vector3d duu = radial.multiply(-4 * Math.PI * Math.PI * currentRadius);
+        Vector3d duv = tangent.multiply(2 * Math.PI * span * slope);
+        return new SurfaceDerivatives(point, du, dv, duu, duv, Vector3d.ZERO);
+    }
+
     @Override
     public double getUMin() { return 0.0; }
     
@@ -63,6 +63,58 @@ public class CylindricalSurface extends Surface {
         return axisDirection.multiply(height);
     }
 
+    @Override
+    public double[] parametersOf(Vector3d p) {
+        Vector3d d = p.subtract(axisOrigin);
+        Vector3d radialX = getPerpendicularX();
+        Vector3d radialY = axisDirection.cross(radialX);
+        double angle = Math.atan2(d.dot(radialY), d.dot(radialX));
+        if (angle < 0) angle += 2 * Math.PI;
+        double v = height > 0 ? (d.dot(axisDirection) + height / 2.0) / height : 0.5;
+        return new double[] { angle / (2 * Math.PI), v };
+    }
+
+    @Override
+    public Vector3d derivativeUU(double u, double v) {
+        double angle = u * 2 * Math.PI;
+        Vector3d radialX = getPerpendicularX();
+        Vector3d radialY = axisDirection.cross(radialX);
+
+        Vector3d radial = radialX.multiply(Math.cos(angle)).plus(radialY.multiply(Math.sin(angle)));
+        return radial.multiply(-4 * Math.PI * Math.PI * radius);
+    }
+
+    @Override
+    public Vector3d derivativeUV(double u, double v) {
+        return Vector3d.ZERO;
+    }
+
+    @Override
+    public Vector3d derivativeVV(double u, double v) {
+        return Vector3d.ZERO;
+    }
+
+    @Override
+    public SurfaceDerivatives evaluateWithDerivatives(double u, double v) {
+        double angle = u * 2 * Math.PI;
+        double cos = Math.cos(angle);
+        double sin = Math.sin(angle);
+        Vector3d radialX = getPerpendicularX();
+        Vector3d radialY = axisDirection.cross(radialX);
+
+        Vector3d radial = radialX.multiply(cos).plus(radialY.multiply(sin));
+        Vector3d tangent = radialX.multiply(-sin).plus(radialY.multiply(cos));
+        Vector3d point = axisOrigin
+            .plus(radial.multiply(radius))
+            .plus(axisDirection.multiply(v * height - height / 2.0));
+        return new SurfaceDerivatives(point,
+            tangent.multiply(2 * Math.PI * radius),
+            axisDirection.multiply(height),
+            radial.multiply(-4 * Math.PI * Math.PI * radius),
+            Vector3d.ZERO,
+            Vector3d.ZERO);
+    }
+
     @Override
     public double getUMin() { return 0.0; }
     @Override
@@ -1,8 +1,14 @@
 package cad.geometry.surfaces;
 
+import cad.math.BSplineBasis;
 import cad.math.Vector3d;
+import cad.math.VectorArrays;
+import java.util.stream.IntStream;
 
 public class NurbsSurface extends Surface {
+    private static final ThreadLocal<BSplineBasis.Workspace[]> WORKSPACES = ThreadLocal.withInitial(
+            () -> new BSplineBasis.Workspace[] { new BSplineBasis.Workspace(), new BSplineBasis.Workspace() });
+
     private int uDegree;
     private int vDegree;
     private int uControlPoints;
@@ -11,9 +17,17 @@ public class NurbsSurface extends Surface {
     private double[][] weights;
     private double[] uKnots;
     private double[] vKnots;
+    // Weighted control points packed as (wx, wy, wz, w), row-major in u
+    private final double[] homogeneousPoints;
+    private final double uRange;
+    private final double vRange;
     
     public NurbsSurface(int uDegree, int vDegree, Vector3d[][] controlPoints, double[][] weights, 
                        double[] uKnots, double[] vKnots) {
+        if (uKnots.length != controlPoints.length + uDegree + 1
+                || vKnots.length != controlPoints[0].length + vDegree + 1) {
+            throw new IllegalArgumentException("Knot vector length must be control points + degree + 1");
+        }
         this.uDegree = uDegree;
         this.vDegree = vDegree;
         this.controlPoints = controlPoints;
@@ -22,150 +36,189 @@ public class NurbsSurface extends Surface {
         this.vKnots = vKnots;
         this.uControlPoints = controlPoints.length;
         this.vControlPoints = controlPoints[0].length;
-    }
-    
-    @Override
-    public Vector3d value(double u, double v) {
-        double scaledU = scaleParameter(u, uKnots);
-        double scaledV = scaleParameter(v, vKnots);
-        
-        Vector3d numerator = Vector3d.zero();
-        double denominator = 0.0;
-        
+        this.uRange = uKnots[uKnots.length - uDegree - 1] - uKnots[uDegree];
+        this.vRange = vKnots[vKnots.length - vDegree - 1] - vKnots[vDegree];
+
+        this.homogeneousPoints = new double[4 * uControlPoints * vControlPoints];
         for (int i = 0; i < uControlPoints; i++) {
             for (int j = 0; j < vControlPoints; j++) {
-                double basisU = calculateBasis(i, uDegree, scaledU, uKnots);
-                double basisV = calculateBasis(j, vDegree, scaledV, vKnots);
-                double weight = weights[i][j];
-                
-                double blendedWeight = basisU * basisV * weight;
-                numerator = numerator.plus(controlPoints[i][j].multiply(blendedWeight));
-                denominator += blendedWeight;
+                int idx = 4 * (i * vControlPoints + j);
+                double w = weights[i][j];
+                homogeneousPoints[idx] = controlPoints[i][j].x() * w;
+                homogeneousPoints[idx + 1] = controlPoints[i][j].y() * w;
+                homogeneousPoints[idx + 2] = controlPoints[i][j].z() * w;
+                homogeneousPoints[idx + 3] = w;
             }
         }
-        
-        return denominator > 0 ? numerator.multiply(1.0 / denominator) : Vector3d.zero();
+    }
+    
+    @Override
+    public Vector3d value(double u, double v) {
+        double[] s = evaluate(u, v);
+        return new Vector3d(s[0], s[1], s[2]);
     }
     
     @Override
     public Vector3d normal(double u, double v) {
-        Vector3d dU = derivativeU(u, v);
-        Vector3d dV = derivativeV(u, v);
-        return dU.cross(dV).normalize();
+        // Su x Sv written over the point slot of the scratch array
+        double[] s = evaluate(u, v);
+        VectorArrays.cross(s, 1, s, 2, s, 0);
+        VectorArrays.normalize(s, 1);
+        return VectorArrays.get(s, 0);
     }
     
     @Override
     public Vector3d derivativeU(double u, double v) {
-        double scaledU = scaleParameter(u, uKnots);
-        double scaledV = scaleParameter(v, vKnots);
-        
-        Vector3d dNumerator = Vector3d.zero();
-        double dDenominator = 0.0;
-        double denominator = 0.0;
-        
-        for (int i = 0; i < uControlPoints; i++) {
-            for (int j = 0; j < vControlPoints; j++) {
-                double basisU = calculateBasis(i, uDegree, scaledU, uKnots);
-                double dBasisU = calculateBasisDerivative(i, uDegree, scaledU, uKnots);
-                double basisV = calculateBasis(j, vDegree, scaledV, vKnots);
-                double weight = weights[i][j];
-                
-                double blendedWeight = basisU * basisV * weight;
-                double dBlendedWeight = dBasisU * basisV * weight;
-                
-                dNumerator = dNumerator.plus(controlPoints[i][j].multiply(dBlendedWeight));
-                dDenominator += dBlendedWeight;
-                denominator += blendedWeight;
-            }
-        }
-        
-        if (denominator == 0) return Vector3d.zero();
-        
-        Vector3d term1 = dNumerator.multiply(1.0 / denominator);
-        Vector3d term2 = value(u, v).multiply(dDenominator / (denominator * denominator));
-        return term1.minus(term2);
+        double[] s = evaluate(u, v);
+        return new Vector3d(s[3], s[4], s[5]);
     }
     
     @Override
     public Vector3d derivativeV(double u, double v) {
-        double scaledU = scaleParameter(u, uKnots);
-        double scaledV = scaleParameter(v, vKnots);
-        
-        Vector3d dNumerator = Vector3d.zero();
-        double dDenominator = 0.0;
-        double denominator = 0.0;
-        
-        for (int i = 0; i < uControlPoints; i++) {
-            for (int j = 0; j < vControlPoints; j++) {
-                double basisU = calculateBasis(i, uDegree, scaledU, uKnots);
-                double basisV = calculateBasis(j, vDegree, scaledV, vKnots);
-                double dBasisV = calculateBasisDerivative(j, vDegree, scaledV, vKnots);
-                double weight = weights[i][j];
-                
-                double blendedWeight = basisU * basisV * weight;
-                double dBlendedWeight = basisU * dBasisV * weight;
-                
-                dNumerator = dNumerator.plus(controlPoints[i][j].multiply(dBlendedWeight));
-                dDenominator += dBlendedWeight;
-                denominator += blendedWeight;
-            }
+        double[] s = evaluate(u, v);
+        return new Vector3d(s[6], s[7], s[8]);
+    }
+
+    // Point followed by the u and v partials, in a per-thread scratch array
+    private double[] evaluate(double u, double v) {
+        BSplineBasis.Workspace[] ws = WORKSPACES.get();
+        double su = scaleParameter(u, uKnots, uDegree);
+        double sv = scaleParameter(v, vKnots, vDegree);
+        int uSpan = BSplineBasis.findSpan(uControlPoints - 1, uDegree, su, uKnots);
+        int vSpan = BSplineBasis.findSpan(vControlPoints - 1, vDegree, sv, vKnots);
+        BSplineBasis.dersBasisFuns(uSpan, su, uDegree, 1, uKnots, ws[0]);
+        BSplineBasis.dersBasisFuns(vSpan, sv, vDegree, 1, vKnots, ws[1]);
+
+        double[] out = ws[0].point;
+        if (out.length < 9) {
+            out = new double[9];
+            ws[0].point = out;
         }
-        
-        if (denominator == 0) return Vector3d.zero();
-        
-        Vector3d term1 = dNumerator.multiply(1.0 / denominator);
-        Vector3d term2 = value(u, v).multiply(dDenominator / (denominator * denominator));
-        return term1.minus(term2);
+        accumulate(uSpan, ws[0].ders[0], ws[0].ders[1], 0, vSpan, ws[1].ders[0], ws[1].ders[1], 0, out);
+        return out;
     }
-    
-    private double scaleParameter(double t, double[] knots) {
-        double tMin = knots[uDegree];
-        double tMax = knots[knots.length - uDegree - 1];
-        return tMin + t * (tMax - tMin);
+
+    @Override
+    public void evaluateGrid(double[] us, double[] vs, double[] positions, double[] normals) {
+        checkGridArrays(us, vs, positions, normals);
+        int nu = us.length;
+        int pu = uDegree + 1;
+        int pv = vDegree + 1;
+
+        int[] uSpans = new int[nu];
+        double[] uBasis = new double[nu * pu];
+        double[] uDers = new double[nu * pu];
+        basisRows(us, uKnots, uDegree, uControlPoints, uSpans, uBasis, uDers);
+
+        int[] vSpans = new int[vs.length];
+        double[] vBasis = new double[vs.length * pv];
+        double[] vDers = new double[vs.length * pv];
+        basisRows(vs, vKnots, vDegree, vControlPoints, vSpans, vBasis, vDers);
+
+        IntStream.range(0, vs.length).parallel().forEach(j -> {
+            double[] sample = new double[9];
+            for (int i = 0; i < nu; i++) {
+                accumulate(uSpans[i], uBasis, uDers, i * pu, vSpans[j], vBasis, vDers, j * pv, sample);
+                int o = (j * nu + i) * 3;
+                positions[o] = sample[0];
+                positions[o + 1] = sample[1];
+                positions[o + 2] = sample[2];
+                if (normals != null) {
+                    double nx = sample[4] * sample[8] - sample[5] * sample[7];
+                    double ny = sample[5] * sample[6] - sample[3] * sample[8];
+                    double nz = sample[3] * sample[7] - sample[4] * sample[6];
+                    double len = Math.sqrt(nx * nx + ny * ny + nz * nz);
+                    double inv = len > 0 ? 1.0 / len : 0.0;
+                    normals[o] = nx * inv;
+                    normals[o + 1] = ny * inv;
+                    normals[o + 2] = nz * inv;
+                }
+            }
+        });
     }
-    
-    private double calculateBasis(int i, int degree, double t, double[] knots) {
-        if (degree == 0) {
-            return (t >= knots[i] && t < knots[i + 1]) ? 1.0 : 0.0;
+
+    private void basisRows(double[] params, double[] knots, int degree, int count,
+                           int[] spans, double[] basis, double[] ders) {
+        BSplineBasis.Workspace ws = WORKSPACES.get()[0];
+        int width = degree + 1;
+        for (int i = 0; i < params.length; i++) {
+            double t = scaleParameter(params[i], knots, degree);
+            int span = BSplineBasis.findSpan(count - 1, degree, t, knots);
+            BSplineBasis.dersBasisFuns(span, t, degree, 1, knots, ws);
+            spans[i] = span;
+            System.arraycopy(ws.ders[0], 0, basis, i * width, width);
+            System.arraycopy(ws.ders[1], 0, ders, i * width, width);
         }
-        
-        double left = 0.0, right = 0.0;
-        
-        double denominator1 = knots[i + degree] - knots[i];
-        if (denominator1 != 0) {
-            left = ((t - knots[i]) / denominator1) * calculateBasis(i, degree - 1, t, knots);
+    }
+
+    // Tensor-product sum over the (uDegree + 1) x (vDegree + 1) non-zero control points
+    private void accumulate(int uSpan, double[] nu, double[] dnu, int uOff,
+                            int vSpan, double[] nv, double[] dnv, int vOff, double[] out) {
+        double ax = 0, ay = 0, az = 0, aw = 0;
+        double ux = 0, uy = 0, uz = 0, uw = 0;
+        double vx = 0, vy = 0, vz = 0, vw = 0;
+        int vFirst = vSpan - vDegree;
+
+        for (int k = 0; k <= uDegree; k++) {
+            int row = (uSpan - uDegree + k) * vControlPoints + vFirst;
+            double tx = 0, ty = 0, tz = 0, tw = 0;
+            double dx = 0, dy = 0, dz = 0, dw = 0;
+            for (int l = 0; l <= vDegree; l++) {
+                int idx = 4 * (row + l);
+                double bv = nv[vOff + l];
+                double dbv = dnv[vOff + l];
+                double px = homogeneousPoints[idx];
+                double py = homogeneousPoints[idx + 1];
+                double pz = homogeneousPoints[idx + 2];
+                double pw = homogeneousPoints[idx + 3];
+                tx += bv * px;
+                ty += bv * py;
+                tz += bv * pz;
+                tw += bv * pw;
+                dx += dbv * px;
+                dy += dbv * py;
+                dz += dbv * pz;
+                dw += dbv * pw;
+            }
+            double bu = nu[uOff + k];
+            double dbu = dnu[uOff + k];
+            ax += bu * tx;
+            ay += bu * ty;
+            az += bu * tz;
+            aw += bu * tw;
+            ux += dbu * tx;
+            uy += dbu * ty;
+            uz += dbu * tz;
+            uw += dbu * tw;
+            vx += bu * dx;
+            vy += bu * dy;
+            vz += bu * dz;
+            vw += bu * dw;
         }
-        
-        double denominator2 = knots[i + degree + 1] - knots[i + 1];
-        if (denominator2 != 0) {
-            right = ((knots[i + degree + 1] - t) / denominator2) * calculateBasis(i + 1, degree - 1, t, knots);
+
+        if (aw == 0) {
+            java.util.Arrays.fill(out, 0, 9, 0.0);
+            return;
         }
-        
-        return left + right;
+        double inv = 1.0 / aw;
+        double sx = ax * inv;
+        double sy = ay * inv;
+        double sz = az * inv;
+        out[0] = sx;
+        out[1] = sy;
+        out[2] = sz;
+        out[3] = (ux - uw * sx) * inv * uRange;
+        out[4] = (uy - uw * sy) * inv * uRange;
+        out[5] = (uz - uw * sz) * inv * uRange;
+        out[6] = (vx - vw * sx) * inv * vRange;
+        out[7] = (vy - vw * sy) * inv * vRange;
+        out[8] = (vz - vw * sz) * inv * vRange;
     }
     
-    private double calculateBasisDerivative(int i, int degree, double t, double[] knots) {
-        if (degree == 0) {
-            return 0.0; // Constant basis function
-        }
-        
-        double leftDerivative = 0.0, rightDerivative = 0.0;
-        
-        double denominator1 = knots[i + degree] - knots[i];
-        if (denominator1 != 0) {
-            double basis1 = calculateBasis(i, degree - 1, t, knots);
-            double derivative1 = calculateBasisDerivative(i, degree - 1, t, knots);
-            leftDerivative = (basis1 + (t - knots[i]) * derivative1) / denominator1;
-        }
-        
-        double denominator2 = knots[i + degree + 1] - knots[i + 1];
-        if (denominator2 != 0) {
-            double basis2 = calculateBasis(i + 1, degree - 1, t, knots);
-            double derivative2 = calculateBasisDerivative(i + 1, degree - 1, t, knots);
-            rightDerivative = (-basis2 + (knots[i + degree + 1] - t) * derivative2) / denominator2;
-        }
-        
-        return leftDerivative + rightDerivative;
+    private static double scaleParameter(double t, double[] knots, int degree) {
+        double tMin = knots[degree];
+        double tMax = knots[knots.length - degree - 1];
+        return tMin + t * (tMax - tMin);
     }
     
     @Override
@@ -193,11 +246,11 @@ public class NurbsSurface extends Surface {
     
     public static NurbsSurface createCylindricalSurface(Vector3d origin, Vector3d axis, double radius, double height) {
         int uDegree = 2, vDegree = 1;
-        int uPoints = 5, vPoints = 3;
+        int uPoints = 9, vPoints = 2;
         
         Vector3d[][] controlPoints = new Vector3d[uPoints][vPoints];
         double[][] weights = new double[uPoints][vPoints];
-        double[] uKnots = {0, 0, 0, 0.5, 1, 1, 1};
+        double[] uKnots = {0, 0, 0, 0.25, 0.25, 0.5, 0.5, 0.75, 0.75, 1, 1, 1};
         double[] vKnots = {0, 0, 1, 1};
         
         Vector3d radialX = Math.abs(axis.dot(Vector3d.Z_AXIS)) < 0.9 ? axis.cross(Vector3d.Z_AXIS).normalize() : axis.cross(Vector3d.X_AXIS).normalize();
@@ -205,12 +258,14 @@ public class NurbsSurface extends Surface {
         
         for (int i = 0; i < uPoints; i++) {
             double angle = 2 * Math.PI * i / (uPoints - 1);
-            Vector3d radial = radialX.multiply(Math.cos(angle)).plus(radialY.multiply(Math.sin(angle))).multiply(radius);
+            double scale = i % 2 == 0 ? 1.0 : 1.0 / Math.cos(Math.PI / 4.0);
+            double weight = i % 2 == 0 ? 1.0 : Math.cos(Math.PI / 4.0);
+            Vector3d radial = radialX.multiply(Math.cos(angle)).plus(radialY.multiply(Math.sin(angle))).multiply(radius * scale);
             
             for (int j = 0; j < vPoints; j++) {
                 double h = height * j / (vPoints - 1) - height / 2.0;
                 controlPoints[i][j] = origin.plus(radial).plus(axis.multiply(h));
-                weights[i][j] = 1.0;
+                weights[i][j] = weight;
             }
         }
         
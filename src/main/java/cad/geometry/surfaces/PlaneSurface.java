@@ -65,6 +65,33 @@ public class PlaneSurface extends Surface {
         return vDirection.multiply(vSize);
     }
 
+    @Override
+    public double[] parametersOf(Vector3d p) {
+        Vector3d d = p.subtract(origin);
+        return new double[] { d.dot(uDirection) / uSize, d.dot(vDirection) / vSize };
+    }
+
+    @Override
+    public Vector3d derivativeUU(double u, double v) {
+        return Vector3d.ZERO;
+    }
+
+    @Override
+    public Vector3d derivativeUV(double u, double v) {
+        return Vector3d.ZERO;
+    }
+
+    @Override
+    public Vector3d derivativeVV(double u, double v) {
+        return Vector3d.ZERO;
+    }
+
+    @Override
+    public SurfaceDerivatives evaluateWithDerivatives(double u, double v) {
+        return new SurfaceDerivatives(value(u, v), derivativeU(u, v), derivativeV(u, v),
+                Vector3d.ZERO, Vector3d.ZERO, Vector3d.ZERO);
+    }
+
     @Override
     public double getUMin() { return uSize == Double.MAX_VALUE ? -Double.MAX_VALUE / 2 : 0.0; }
     @Override
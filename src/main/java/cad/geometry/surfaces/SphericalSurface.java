@@ -67,6 +67,53 @@ public class SphericalSurface extends Surface {
         return new Vector3d(x, y, z);
     }
 
+    @Override
+    public double[] parametersOf(Vector3d p) {
+        double[] angles = getAnglesForPoint(p);
+        return new double[] { angles[0] / (2 * Math.PI), angles[1] / Math.PI };
+    }
+
+    @Override
+    public Vector3d derivativeUU(double u, double v) {
+        double theta = u * 2 * Math.PI;
+        double phi = v * Math.PI;
+        double k = -4 * Math.PI * Math.PI * radius * Math.sin(phi);
+        return new Vector3d(k * Math.cos(theta), k * Math.sin(theta), 0);
+    }
+
+    @Override
+    public Vector3d derivativeUV(double u, double v) {
+        double theta = u * 2 * Math.PI;
+        double phi = v * Math.PI;
+        double k = 2 * Math.PI * Math.PI * radius * Math.cos(phi);
+        return new Vector3d(-k * Math.sin(theta), k * Math.cos(theta), 0);
+    }
+
+    @Override
+    public Vector3d derivativeVV(double u, double v) {
+        return value(u, v).subtract(center).multiply(-Math.PI * Math.PI);
+    }
+
+    @Override
+    public SurfaceDerivatives evaluateWithDerivatives(double u, double v) {
+        double theta = u * 2 * Math.PI;
+        double phi = v * Math.PI;
+        double sinPhi = Math.sin(phi);
+        double cosPhi = Math.cos(phi);
+        double sinTheta = Math.sin(theta);
+        double cosTheta = Math.cos(theta);
+
+        Vector3d offset = new Vector3d(radius * sinPhi * cosTheta, radius * sinPhi * sinTheta, radius * cosPhi);
+        double twoPi = 2 * Math.PI;
+        Vector3d du = new Vector3d(-offset.y() * twoPi, offset.x() * twoPi, 0);
+        Vector3d dv = new Vector3d(radius * cosPhi * cosTheta * Math.PI, radius * cosPhi * sinTheta * Math.PI,
+            -radius * sinPhi * Math.PI);
+        Vector3d duu = new Vector3d(-offset.x() * twoPi * twoPi, -offset.y() * twoPi * twoPi, 0);
+        Vector3d duv = new Vector3d(-dv.y() * twoPi, dv.x() * twoPi, 0);
+        Vector3d dvv = offset.multiply(-Math.PI * Math.PI);
+        return new SurfaceDerivatives(center.plus(offset), du, dv, duu, duv, dvv);
+    }
+
     @Override
     public double getUMin() { return 0.0; }
     @Override
@@ -1,6 +1,7 @@
 package cad.geometry.surfaces;
 
 import cad.math.Vector3d;
+import java.util.stream.IntStream;
 
 public abstract class Surface {
     public abstract Vector3d value(double u, double v);
@@ -19,7 +20,117 @@ public abstract class Surface {
         Vector3d p2 = value(u, v + delta);
         return p2.subtract(p1).multiply(1.0 / (2.0 * delta));
     }
+
+    // Second derivative fallbacks difference the first derivatives; analytic surfaces override
+    // evaluateWithDerivatives and these
+    public Vector3d derivativeUU(double u, double v) {
+        double delta = 1e-5;
+        return derivativeU(u + delta, v).subtract(derivativeU(u - delta, v)).multiply(1.0 / (2.0 * delta));
+    }
+
+    public Vector3d derivativeUV(double u, double v) {
+        double delta = 1e-5;
+        return derivativeU(u, v + delta).subtract(derivativeU(u, v - delta)).multiply(1.0 / (2.0 * delta));
+    }
+
+    public Vector3d derivativeVV(double u, double v) {
+        double delta = 1e-5;
+        return derivativeV(u, v + delta).subtract(derivativeV(u, v - delta)).multiply(1.0 / (2.0 * delta));
+    }
+
+    public SurfaceDerivatives evaluateWithDerivatives(double u, double v) {
+        return new SurfaceDerivatives(value(u, v), derivativeU(u, v), derivativeV(u, v),
+                derivativeUU(u, v), derivativeUV(u, v), derivativeVV(u, v));
+    }
     
+    // Samples every (us[i], vs[j]) pair. Results are xyz triples at index (j * us.length + i) * 3;
+    // normals may be null when only positions are needed.
+    public void evaluateGrid(double[] us, double[] vs, double[] positions, double[] normals) {
+        checkGridArrays(us, vs, positions, normals);
+        int nu = us.length;
+        IntStream.range(0, vs.length).parallel().forEach(j -> {
+            double v = vs[j];
+            for (int i = 0; i < nu; i++) {
+                int o = (j * nu + i) * 3;
+                Vector3d p = value(us[i], v);
+                positions[o] = p.x();
+                positions[o + 1] = p.y();
+                positions[o + 2] = p.z();
+                if (normals != null) {
+                    Vector3d n = normal(us[i], v);
+                    normals[o] = n.x();
+                    normals[o + 1] = n.y();
+                    normals[o + 2] = n.z();
+                }
+            }
+        });
+    }
+
+    protected static void checkGridArrays(double[] us, double[] vs, double[] positions, double[] normals) {
+        int required = 3 * us.length * vs.length;
+        if (positions.length < required || (normals != null && normals.length < required)) {
+            throw new IllegalArgumentException("Grid output arrays need at least " + required + " entries");
+        }
+    }
+
+    public static double[] uniformSamples(double min, double max, int count) {
+        double[] samples = new double[count];
+        if (count == 1) {
+            samples[0] = min;
+            return samples;
+        }
+        for (int i = 0; i < count; i++) {
+            samples[i] = min + (max - min) * i / (count - 1);
+        }
+        samples[count - 1] = max;
+        return samples;
+    }
+    
+    // Parameters of the surface point closest to p: the best node of a coarse grid, refined by
+    // Gauss-Newton on |S(u,v) - p|^2 and clamped to the domain. Analytic surfaces override this.
+    public double[] parametersOf(Vector3d p) {
+        int n = 8;
+        double uMin = getUMin(), uMax = getUMax(), vMin = getVMin(), vMax = getVMax();
+        double bestU = uMin, bestV = vMin, best = Double.MAX_VALUE;
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j <= n; j++) {
+                double u = uMin + (uMax - uMin) * i / n;
+                double v = vMin + (vMax - vMin) * j / n;
+                Vector3d q = value(u, v);
+                double d = q.distanceSquared(p.x(), p.y(), p.z());
+                if (d < best) {
+                    best = d;
+                    bestU = u;
+                    bestV = v;
+                }
+            }
+        }
+        return refineParameters(p, bestU, bestV);
+    }
+
+    protected double[] refineParameters(Vector3d p, double u, double v) {
+        double uMin = getUMin(), uMax = getUMax(), vMin = getVMin(), vMax = getVMax();
+        for (int iter = 0; iter < 20; iter++) {
+            Vector3d r = value(u, v).subtract(p);
+            Vector3d su = derivativeU(u, v);
+            Vector3d sv = derivativeV(u, v);
+            double a = su.dot(su), b = su.dot(sv), c = sv.dot(sv);
+            double ru = su.dot(r), rv = sv.dot(r);
+            double det = a * c - b * b;
+            if (Math.abs(det) < 1e-20) {
+                break;
+            }
+            double du = (c * ru - b * rv) / det;
+            double dv = (a * rv - b * ru) / det;
+            u = Math.max(uMin, Math.min(uMax, u - du));
+            v = Math.max(vMin, Math.min(vMax, v - dv));
+            if (Math.abs(du) + Math.abs(dv) < 1e-12) {
+                break;
+            }
+        }
+        return new double[] { u, v };
+    }
+
     public double getUMin() { return 0.0; }
     public double getUMax() { return 1.0; }
     public double getVMin() { return 0.0; }
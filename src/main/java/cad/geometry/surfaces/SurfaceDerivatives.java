@@ -0,0 +1,25 @@
+package cad.geometry.surfaces;
+
+import cad.math.Vector3d;
+
+public class SurfaceDerivatives {
+    public final Vector3d point;
+    public final Vector3d du;
+    public final Vector3d dv;
+    public final Vector3d duu;
+    public final Vector3d duv;
+    public final Vector3d dvv;
+
+    public SurfaceDerivatives(Vector3d point, Vector3d du, Vector3d dv, Vector3d duu, Vector3d duv, Vector3d dvv) {
+        this.point = point;
+        this.du = du;
+        this.dv = dv;
+        this.duu = duu;
+        this.duv = duv;
+        this.dvv = dvv;
+    }
+
+    public Vector3d normal() {
+        return du.cross(dv).normalize();
+    }
+}
@@ -1,7 +1,9 @@
 package cad.geometry.surfaces;
 
 import cad.geometry.curves.Curve;
+import cad.geometry.curves.CurveDerivatives;
 import cad.math.Vector3d;
+import java.util.stream.IntStream;
 
 public class SurfaceOfRevolution extends Surface {
     private Curve baseCurve;
@@ -59,6 +61,134 @@ public class SurfaceOfRevolution extends Surface {
         return dU.cross(dV).normalize();
     }
 
+    @Override
+    public Vector3d derivativeU(double u, double v) {
+        return evaluateWithDerivatives(u, v).du;
+    }
+
+    @Override
+    public Vector3d derivativeV(double u, double v) {
+        return evaluateWithDerivatives(u, v).dv;
+    }
+
+    @Override
+    public Vector3d derivativeUU(double u, double v) {
+        return evaluateWithDerivatives(u, v).duu;
+    }
+
+    @Override
+    public Vector3d derivativeUV(double u, double v) {
+        return evaluateWithDerivatives(u, v).duv;
+    }
+
+    @Override
+    public Vector3d derivativeVV(double u, double v) {
+        return evaluateWithDerivatives(u, v).dvv;
+    }
+
+    // P = B + cos R + sin (A x R), where B and R are the axial and radial parts of the profile point;
+    // the v derivatives differentiate B and R through the profile curve
+    @Override
+    public SurfaceDerivatives evaluateWithDerivatives(double u, double v) {
+        double sweep = endAngle - startAngle;
+        double angle = startAngle + u * sweep;
+        double c = Math.cos(angle);
+        double s = Math.sin(angle);
+
+        double tRange = baseCurve.endParam() - baseCurve.startParam();
+        double t = baseCurve.startParam() + v * tRange;
+        CurveDerivatives curve = baseCurve.evaluateWithDerivatives(t);
+
+        Vector3d toPoint = curve.point.subtract(axisOrigin);
+        Vector3d r = toPoint.subtract(axisDirection.multiply(axisDirection.dot(toPoint)));
+        Vector3d q = axisDirection.cross(r);
+        Vector3d base = curve.point.subtract(r);
+
+        Vector3d dc = curve.first.multiply(tRange);
+        Vector3d dr = dc.subtract(axisDirection.multiply(axisDirection.dot(dc)));
+        Vector3d dq = axisDirection.cross(dr);
+        Vector3d dBase = dc.subtract(dr);
+
+        Vector3d ddc = curve.second.multiply(tRange * tRange);
+        Vector3d ddr = ddc.subtract(axisDirection.multiply(axisDirection.dot(ddc)));
+        Vector3d ddq = axisDirection.cross(ddr);
+        Vector3d ddBase = ddc.subtract(ddr);
+
+        Vector3d point = base.plus(r.multiply(c)).plus(q.multiply(s));
+        Vector3d du = q.multiply(c).subtract(r.multiply(s)).multiply(sweep);
+        Vector3d dv = dBase.plus(dr.multiply(c)).plus(dq.multiply(s));
+        Vector3d duu = r.multiply(c).plus(q.multiply(s)).multiply(-sweep * sweep);
+        Vector3d duv = dq.multiply(c).subtract(dr.multiply(s)).multiply(sweep);
+        Vector3d dvv = ddBase.plus(ddr.multiply(c)).plus(ddq.multiply(s));
+        return new SurfaceDerivatives(point, du, dv, duu, duv, dvv);
+    }
+
+    // The profile curve is evaluated once per v row and each u column reuses its cos/sin,
+    // so the cost is dominated by nv curve evaluations rather than nu * nv
+    @Override
+    public void evaluateGrid(double[] us, double[] vs, double[] positions, double[] normals) {
+        checkGridArrays(us, vs, positions, normals);
+        int nu = us.length;
+        double sweep = endAngle - startAngle;
+        double[] cos = new double[nu];
+        double[] sin = new double[nu];
+        for (int i = 0; i < nu; i++) {
+            double angle = startAngle + us[i] * sweep;
+            cos[i] = Math.cos(angle);
+            sin[i] = Math.sin(angle);
+        }
+
+        double tStart = baseCurve.startParam();
+        double tRange = baseCurve.endParam() - tStart;
+        double ax = axisDirection.x(), ay = axisDirection.y(), az = axisDirection.z();
+
+        IntStream.range(0, vs.length).parallel().forEach(j -> {
+            double t = tStart + vs[j] * tRange;
+            Vector3d toPoint = baseCurve.value(t).subtract(axisOrigin);
+            double axial = axisDirection.dot(toPoint);
+            Vector3d base = axisOrigin.plus(axisDirection.multiply(axial));
+            Vector3d r = toPoint.subtract(axisDirection.multiply(axial));
+            Vector3d q = axisDirection.cross(r);
+
+            Vector3d dc = normals != null ? baseCurve.derivative(t).multiply(tRange) : Vector3d.ZERO;
+            double dAxial = axisDirection.dot(dc);
+            Vector3d dr = dc.subtract(axisDirection.multiply(dAxial));
+            Vector3d dq = axisDirection.cross(dr);
+
+            for (int i = 0; i < nu; i++) {
+                int o = (j * nu + i) * 3;
+                double c = cos[i];
+                double s = sin[i];
+                positions[o] = base.x() + c * r.x() + s * q.x();
+                positions[o + 1] = base.y() + c * r.y() + s * q.y();
+                positions[o + 2] = base.z() + c * r.z() + s * q.z();
+                if (normals == null) {
+                    continue;
+                }
+                double dux = sweep * (c * q.x() - s * r.x());
+                double duy = sweep * (c * q.y() - s * r.y());
+                double duz = sweep * (c * q.z() - s * r.z());
+                double dvx = ax * dAxial + c * dr.x() + s * dq.x();
+                double dvy = ay * dAxial + c * dr.y() + s * dq.y();
+                double dvz = az * dAxial + c * dr.z() + s * dq.z();
+                double nx = duy * dvz - duz * dvy;
+                double ny = duz * dvx - dux * dvz;
+                double nz = dux * dvy - duy * dvx;
+                double len = Math.sqrt(nx * nx + ny * ny + nz * nz);
+                if (len > 1e-12) {
+                    normals[o] = nx / len;
+                    normals[o + 1] = ny / len;
+                    normals[o + 2] = nz / len;
+                } else {
+                    Vector3d n = normal(us[i], vs[j]);
+                    normals[o] = n.x();
+                    normals[o + 1] = n.y();
+                    normals[o + 2] = n.z();
+                }
+            }
+        });
+    }
+
     @Override
     public double getUMin() { return 0.0; }
     
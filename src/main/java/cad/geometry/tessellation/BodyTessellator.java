@@ -0,0 +1,123 @@
+package cad.geometry.tessellation;
+
+import cad.geometry.curves.Curve;
+import cad.math.Vector3d;
+import cad.topology.BRepBody;
+import cad.topology.Edge;
+import cad.topology.EdgeLoop;
+import cad.topology.Face;
+import cad.topology.Vertex;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.Map;
+import java.util.Objects;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.stream.Collectors;
+
+// Each edge is discretised once and shared by both adjacent faces, so face meshes meet without cracks
+public final class BodyTessellator {
+
+    private BodyTessellator() {
+    }
+
+    // Faces are tessellated in parallel. Edge samples are computed on first use and shared through a
+    // concurrent map; a face whose cached mesh matches the tolerance is reused as is.
+    public static TriangleMesh tessellate(BRepBody body, TessellationTolerance tolerance) {
+        return tessellate(body, tolerance, () -> { });
+    }
+
+    // faceDone runs after each face, from whichever pool thread tessellated it; an exception it
+    // throws (such as a cancellation) abandons the remaining faces and propagates to the caller
+    public static TriangleMesh tessellate(BRepBody body, TessellationTolerance tolerance, Runnable faceDone) {
+        Map<Edge, List<Vector3d>> edgeSamples = new ConcurrentHashMap<>();
+        List<TriangleMesh> faceMeshes = body.getFaces().parallelStream()
+                .map(face -> {
+                    TriangleMesh mesh = tessellateFace(face, edgeSamples, tolerance);
+                    faceDone.run();
+                    return mesh;
+                })
+                .filter(Objects::nonNull)
+                .collect(Collectors.toList());
+        return TriangleMesh.merge(faceMeshes);
+    }
+
+    public static TriangleMesh tessellateFace(Face face, Map<Edge, List<Vector3d>> edgeSamples,
+            TessellationTolerance tolerance) {
+        TriangleMesh cached = face.getCachedMesh(tolerance);
+        if (cached != null) {
+            return cached;
+        }
+        TriangleMesh mesh = FaceTessellator.tessellate(face, edgeSamples, tolerance);
+        if (mesh != null) {
+            face.setCachedMesh(tolerance, mesh);
+        }
+        return mesh;
+    }
+
+    // Points around a loop in traversal order, without repeating the closing point. A closed edge inside
+    // a longer loop, such as the circle a full revolution sweeps, gives no direction to follow from its
+    // vertices and contributes just its vertex; FaceTessellator rebuilds those faces from the edges.
+    static List<Vector3d> loopPolyline(EdgeLoop loop, Map<Edge, List<Vector3d>> edgeSamples,
+            TessellationTolerance tolerance) {
+        List<Edge> edges = loop.getEdges();
+        List<Vector3d> points = new ArrayList<>();
+        if (edges.size() == 1) {
+            List<Vector3d> samples = edgeSamples.computeIfAbsent(edges.get(0), e -> sampleEdge(e, tolerance));
+            points.addAll(samples.subList(0, samples.size() - 1));
+            return points;
+        }
+
+        Edge first = edges.get(0);
+        Edge second = edges.get(1);
+        boolean firstForward = first.getEndVertex().equals(second.getStartVertex())
+                || first.getEndVertex().equals(second.getEndVertex());
+        Vertex current = firstForward ? first.getStartVertex() : first.getEndVertex();
+
+        for (Edge edge : edges) {
+            if (isClosed(edge)) {
+                points.add(current.getPoint());
+                continue;
+            }
+            List<Vector3d> samples = edgeSamples.computeIfAbsent(edge, e -> sampleEdge(e, tolerance));
+            boolean forward = edge.getStartVertex().equals(current);
+            if (forward) {
+                for (int i = 0; i < samples.size() - 1; i++) {
+                    points.add(samples.get(i));
+                }
+                current = edge.getEndVertex();
+            } else {
+                for (int i = samples.size() - 1; i > 0; i--) {
+                    points.add(samples.get(i));
+                }
+                current = edge.getStartVertex();
+            }
+        }
+        return points;
+    }
+
+    static boolean isClosed(Edge edge) {
+        return edge.getStartVertex() == edge.getEndVertex();
+    }
+
+    // Samples run from the start vertex to the end vertex, with the end points snapped to the vertices
+    public static List<Vector3d> sampleEdge(Edge edge, TessellationTolerance tolerance) {
+        Vector3d start = edge.getStartVertex().getPoint();
+        Vector3d end = edge.getEndVertex().getPoint();
+        Curve curve = edge.getCurve();
+        List<Vector3d> points = new ArrayList<>();
+        if (curve == null) {
+            points.add(start);
+            points.add(end);
+            return points;
+        }
+
+        points.addAll(CurveTessellator.tessellate(curve, tolerance));
+        if (!isClosed(edge) && points.get(0).distance(start) > points.get(points.size() - 1).distance(start)) {
+            Collections.reverse(points);
+        }
+        points.set(0, start);
+        points.set(points.size() - 1, end);
+        return points;
+    }
+}
@@ -0,0 +1,122 @@
+package cad.geometry.tessellation;
+
+import cad.geometry.curves.ArcCurve;
+import cad.geometry.curves.Curve;
+import cad.geometry.curves.LineCurve;
+import cad.math.Vector3d;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+public final class CurveTessellator {
+
+    private CurveTessellator() {
+    }
+
+    public static double[] sampleParameters(Curve curve, TessellationTolerance tolerance) {
+        return sampleParameters(curve, curve.startParam(), curve.endParam(), tolerance);
+    }
+
+    // Recursive bisection until every span meets both the chordal deviation and the tangent angle
+    // tolerance. The recursion starts from the minimum segment count in uniform spans, so a curve whose
+    // midpoint happens to sit on the chord (an S-bend, a closed loop) is still followed.
+    public static double[] sampleParameters(Curve curve, double t0, double t1, TessellationTolerance tolerance) {
+        int spans = initialSpans(curve, t0, t1, tolerance);
+        int perSpan = (tolerance.getMaxSegments() + spans - 1) / spans;
+        int maxDepth = 32 - Integer.numberOfLeadingZeros(Math.max(1, perSpan - 1));
+        Samples samples = new Samples();
+        samples.add(t0);
+
+        double ta = t0;
+        Vector3d pa = curve.value(t0);
+        Vector3d da = curve.derivative(t0);
+        for (int i = 1; i <= spans; i++) {
+            double tb = i == spans ? t1 : t0 + (t1 - t0) * i / spans;
+            Vector3d pb = curve.value(tb);
+            Vector3d db = curve.derivative(tb);
+            subdivide(curve, ta, pa, da, tb, pb, db, tolerance, maxDepth, samples);
+            ta = tb;
+            pa = pb;
+            da = db;
+        }
+        return samples.toArray();
+    }
+
+    // Straight lines need no seeding; arcs get the share of the minimum that their sweep covers, as
+    // in TessellationTolerance.segmentsForArc
+    static int initialSpans(Curve curve, double t0, double t1, TessellationTolerance tolerance) {
+        if (curve instanceof LineCurve) {
+            return 1;
+        }
+        if (curve instanceof ArcCurve) {
+            ArcCurve arc = (ArcCurve) curve;
+            double sweep = Math.abs((arc.getEndAngle() - arc.getStartAngle()) * (t1 - t0));
+            return Math.max(1, (int) Math.ceil(tolerance.getMinSegments() * sweep / (2.0 * Math.PI)));
+        }
+        return tolerance.getMinSegments();
+    }
+
+    public static List<Vector3d> tessellate(Curve curve, TessellationTolerance tolerance) {
+        double[] params = sampleParameters(curve, tolerance);
+        List<Vector3d> points = new ArrayList<>(params.length);
+        for (double t : params) {
+            points.add(curve.value(t));
+        }
+        return points;
+    }
+
+    private static void subdivide(Curve curve, double t0, Vector3d p0, Vector3d d0, double t1, Vector3d p1,
+            Vector3d d1, TessellationTolerance tolerance, int depth, Samples samples) {
+        if (depth > 0) {
+            double tm = 0.5 * (t0 + t1);
+            Vector3d pm = curve.value(tm);
+            if (exceedsTolerance(p0, d0, p1, d1, pm, tolerance)) {
+                Vector3d dm = curve.derivative(tm);
+                subdivide(curve, t0, p0, d0, tm, pm, dm, tolerance, depth - 1, samples);
+                subdivide(curve, tm, pm, dm, t1, p1, d1, tolerance, depth - 1, samples);
+                return;
+            }
+        }
+        samples.add(t1);
+    }
+
+    static boolean exceedsTolerance(Vector3d p0, Vector3d d0, Vector3d p1, Vector3d d1, Vector3d pm,
+            TessellationTolerance tolerance) {
+        if (distanceToSegment(pm, p0, p1) > tolerance.getChordalDeviation()) {
+            return true;
+        }
+        double m0 = d0.magnitude();
+        double m1 = d1.magnitude();
+        if (m0 > 1e-12 && m1 > 1e-12) {
+            double cos = d0.dot(d1) / (m0 * m1);
+            return Math.acos(Math.max(-1.0, Math.min(1.0, cos))) > tolerance.getAngleTolerance();
+        }
+        return false;
+    }
+
+    static double distanceToSegment(Vector3d p, Vector3d a, Vector3d b) {
+        Vector3d ab = b.subtract(a);
+        double lenSq = ab.dot(ab);
+        if (lenSq < 1e-24) {
+            return p.distance(a);
+        }
+        double s = Math.max(0.0, Math.min(1.0, p.subtract(a).dot(ab) / lenSq));
+        return p.distance(a.add(ab.multiply(s)));
+    }
+
+    private static final class Samples {
+        private double[] values = new double[16];
+        private int size;
+
+        void add(double t) {
+            if (size == values.length) {
+                values = Arrays.copyOf(values, size * 2);
+            }
+            values[size++] = t;
+        }
+
+        double[] toArray() {
+            return Arrays.copyOf(values, size);
+        }
+    }
+}
@@ -0,0 +1,441 @@
+package cad.geometry.tessellation;
+
+import cad.geometry.surfaces.PlaneSurface;
+import cad.geometry.surfaces.Surface;
+import cad.math.Vector3d;
+import cad.topology.Edge;
+import cad.topology.EdgeLoop;
+import cad.topology.Face;
+import cad.topology.Vertex;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+
+// Tessellates one face. Planar faces are triangulated from their trimming loops directly; curved faces
+// map the loops to (u,v), triangulate the trimmed domain with its holes, refine until the chordal
+// deviation is met, and evaluate the surface for positions and normals. Loop points always come from
+// the edge samples shared with the neighbouring faces and refinement only adds interior points, so
+// faces meet vertex to vertex without cracks or T-junctions.
+public final class FaceTessellator {
+    private static final int MAX_REFINEMENT = 5;
+
+    private FaceTessellator() {
+    }
+
+    public static TriangleMesh tessellate(Face face, Map<Edge, List<Vector3d>> edgeSamples,
+            TessellationTolerance tolerance) {
+        EdgeLoop outer = face.getOuterLoop();
+        if (outer == null || outer.getEdges().isEmpty()) {
+            return null;
+        }
+        List<Vector3d> boundary = BodyTessellator.loopPolyline(outer, edgeSamples, tolerance);
+        List<List<Vector3d>> holes = new ArrayList<>();
+        for (EdgeLoop inner : face.getInnerLoops()) {
+            List<Vector3d> hole = BodyTessellator.loopPolyline(inner, edgeSamples, tolerance);
+            if (hole.size() >= 3) {
+                holes.add(hole);
+            }
+        }
+
+        Surface surface = face.getSurface();
+        if (surface != null && !(surface instanceof PlaneSurface)) {
+            TriangleMesh mesh = tessellateTrimmed(surface, outer, boundary, holes, edgeSamples, tolerance);
+            if (mesh != null) {
+                return mesh;
+            }
+        }
+        return tessellatePlanar(boundary, holes);
+    }
+
+    static TriangleMesh tessellatePlanar(List<Vector3d> boundary, List<List<Vector3d>> holes) {
+        if (boundary.size() < 3) {
+            return null;
+        }
+        List<Vector3d> points = new ArrayList<>(boundary);
+        for (List<Vector3d> hole : holes) {
+            points.addAll(hole);
+        }
+        int[] indices = PolygonTriangulator.triangulate(boundary, holes);
+        Vector3d normal = PolygonTriangulator.newellNormal(boundary);
+        double[] positions = new double[3 * points.size()];
+        double[] normals = new double[positions.length];
+        for (int i = 0; i < points.size(); i++) {
+            Vector3d p = points.get(i);
+            positions[3 * i] = p.x();
+            positions[3 * i + 1] = p.y();
+            positions[3 * i + 2] = p.z();
+            normals[3 * i] = normal.x();
+            normals[3 * i + 1] = normal.y();
+            normals[3 * i + 2] = normal.z();
+        }
+        return new TriangleMesh(positions, normals, indices);
+    }
+
+    // Returns null when the loops do not lie on the surface, so the caller can fall back to the planar path
+    static TriangleMesh tessellateTrimmed(Surface surface, EdgeLoop outer, List<Vector3d> boundary,
+            List<List<Vector3d>> holes, Map<Edge, List<Vector3d>> edgeSamples, TessellationTolerance tolerance) {
+        double fit = 4 * tolerance.getChordalDeviation();
+        double[] outerUV = toParameters(surface, boundary, fit, Double.NaN);
+        if (outerUV == null) {
+            return null;
+        }
+
+        double domain = (surface.getUMax() - surface.getUMin()) * (surface.getVMax() - surface.getVMin());
+        double area = signedArea(outerUV);
+        if (holes.isEmpty() && Math.abs(area) < 1e-9 * domain) {
+            // The loop collapses onto a seam, as for a full revolution
+            TriangleMesh band = tessellateSeamBand(surface, outer, edgeSamples, fit, tolerance);
+            if (band != null) {
+                return band;
+            }
+            // Not a loop the band can be rebuilt from; the whole surface is right but will not share
+            // vertices with its neighbours
+            return orientNormals(SurfaceTessellator.tessellate(surface, tolerance));
+        }
+
+        double[] box = bounds(outerUV);
+        List<double[]> rings = new ArrayList<>();
+        rings.add(outerUV);
+        double uCenter = 0.5 * (box[0] + box[1]);
+        for (List<Vector3d> hole : holes) {
+            double[] uv = toParameters(surface, hole, fit, uCenter);
+            if (uv == null) {
+                return null;
+            }
+            rings.add(uv);
+        }
+        List<Vector3d> fixedPoints = new ArrayList<>(boundary);
+        for (List<Vector3d> hole : holes) {
+            fixedPoints.addAll(hole);
+        }
+        TriangleMesh mesh = triangulateDomain(surface, rings, fixedPoints, tolerance);
+        return orientNormals(area < 0 ? flip(mesh) : mesh);
+    }
+
+    // Interleaved (u, v) for each point, with u unwrapped across the seam of closed surfaces so the
+    // loop stays continuous. uReference, when given, picks the period nearest to it for the first point.
+    static double[] toParameters(Surface surface, List<Vector3d> points, double fit, double uReference) {
+        double period = surface.getUMax() - surface.getUMin();
+        double[] uv = new double[2 * points.size()];
+        for (int i = 0; i < points.size(); i++) {
+            Vector3d p = points.get(i);
+            double[] st = surface.parametersOf(p);
+            if (surface.value(st[0], st[1]).distance(p) > fit) {
+                return null;
+            }
+            double u = st[0];
+            if (surface.isClosedInU()) {
+                double reference = i > 0 ? uv[2 * i - 2] : uReference;
+                if (!Double.isNaN(reference)) {
+                    u += period * Math.rint((reference - u) / period);
+                }
+            }
+            uv[2 * i] = u;
+            uv[2 * i + 1] = st[1];
+        }
+        return uv;
+    }
+
+    // A face closed around a surface that is closed in u runs along a seam edge, round one boundary
+    // circle, back along the seam and round the other circle (or through a vertex on the axis where
+    // there is none). Its loop has no area in (u, v), so the band between uMin and uMax is rebuilt
+    // from the edges: the seam on both sides and the circles' shared samples across. Returns null for
+    // any other loop.
+    static TriangleMesh tessellateSeamBand(Surface surface, EdgeLoop loop, Map<Edge, List<Vector3d>> edgeSamples,
+            double fit, TessellationTolerance tolerance) {
+        List<Edge> edges = loop.getEdges();
+        if (!surface.isClosedInU() || edges.size() < 2) {
+            return null;
+        }
+        double uMin = surface.getUMin();
+        double uMax = surface.getUMax();
+        List<Vector3d> points = new ArrayList<>();
+        double[] uv = new double[16];
+        int n = 0;
+
+        Edge first = edges.get(0);
+        Edge second = edges.get(1);
+        boolean firstForward = first.getEndVertex().equals(second.getStartVertex())
+                || first.getEndVertex().equals(second.getEndVertex());
+        Vertex current = firstForward ? first.getStartVertex() : first.getEndVertex();
+        double side = uMin;
+        for (int i = 0; i < edges.size(); i++) {
+            Edge edge = edges.get(i);
+            List<Vector3d> samples = edgeSamples.computeIfAbsent(edge, e -> BodyTessellator.sampleEdge(e, tolerance));
+            double other = side == uMin ? uMax : uMin;
+            List<Vector3d> run = new ArrayList<>(samples.subList(0, samples.size() - 1));
+            double[] runU = new double[run.size()];
+            double[] runV = new double[run.size()];
+            if (BodyTessellator.isClosed(edge)) {
+                // Crosses from one side of the band to the other; the samples between the two copies
+                // of the vertex lie strictly inside (uMin, uMax)
+                if (!edge.getStartVertex().equals(current) || run.size() < 2) {
+                    return null;
+                }
+                double[] a = surface.parametersOf(run.get(1));
+                double[] b = surface.parametersOf(run.get(run.size() - 1));
+                if ((b[0] < a[0]) == (side == uMin)) {
+                    Collections.reverse(run.subList(1, run.size()));
+                }
+                for (int k = 0; k < run.size(); k++) {
+                    double[] st = surface.parametersOf(run.get(k));
+                    runU[k] = k == 0 ? side : st[0];
+                    runV[k] = st[1];
+                }
+                side = other;
+            } else {
+                boolean forward = edge.getStartVertex().equals(current);
+                if (!forward) {
+                    run = new ArrayList<>(samples.subList(1, samples.size()));
+                    Collections.reverse(run);
+                }
+                current = forward ? edge.getEndVertex() : edge.getStartVertex();
+                for (int k = 0; k < run.size(); k++) {
+                    runU[k] = side;
+                    runV[k] = surface.parametersOf(run.get(k))[1];
+                }
+                // Where the loop turns back along the seam through a vertex on the axis, that vertex
+                // sits at both ends of the band
+                if (!BodyTessellator.isClosed(edges.get((i + 1) % edges.size()))) {
+                    run.add(current.getPoint());
+                    runU = Arrays.copyOf(runU, run.size());
+                    runV = Arrays.copyOf(runV, run.size());
+                    runU[run.size() - 1] = side;
+                    runV[run.size() - 1] = surface.parametersOf(current.getPoint())[1];
+                    side = other;
+                }
+            }
+            for (int k = 0; k < run.size(); k++) {
+                if (surface.value(runU[k], runV[k]).distance(run.get(k)) > fit) {
+                    return null;
+                }
+                if (2 * n + 2 > uv.length) {
+                    uv = Arrays.copyOf(uv, 2 * uv.length);
+                }
+                uv[2 * n] = runU[k];
+                uv[2 * n + 1] = runV[k];
+                n++;
+                points.add(run.get(k));
+            }
+        }
+        if (side != uMin || n < 3) {
+            return null;
+        }
+        uv = Arrays.copyOf(uv, 2 * n);
+        List<double[]> rings = new ArrayList<>();
+        rings.add(uv);
+        TriangleMesh mesh = triangulateDomain(surface, rings, points, tolerance);
+        return orientNormals(signedArea(uv) < 0 ? flip(mesh) : mesh);
+    }
+
+    private static TriangleMesh triangulateDomain(Surface surface, List<double[]> rings, List<Vector3d> fixedPoints,
+            TessellationTolerance tolerance) {
+        int total = 0;
+        int[] starts = new int[rings.size() + 1];
+        for (int r = 0; r < rings.size(); r++) {
+            starts[r] = total;
+            total += rings.get(r).length / 2;
+        }
+        starts[rings.size()] = total;
+
+        double[] us = new double[Math.max(16, 4 * total)];
+        double[] vs = new double[us.length];
+        int k = 0;
+        for (double[] ring : rings) {
+            for (int i = 0; i < ring.length; i += 2) {
+                us[k] = ring[i];
+                vs[k] = ring[i + 1];
+                k++;
+            }
+        }
+        int[] triangles = PolygonTriangulator.triangulate(us, vs, starts);
+        int count = total;
+
+        // Only triangles that stray from the surface are refined: each of their interior edges is
+        // halved, and every triangle sharing a halved edge is split along it too, so the mesh stays
+        // conforming. Midpoints are shared through the edge map. Loop edges are never split: the
+        // neighbouring face has the same edge samples and nothing between them. Refinement stops
+        // once no stray triangle has an edge left to split.
+        double limit = tolerance.getChordalDeviation();
+        for (int level = 0; level < MAX_REFINEMENT; level++) {
+            Map<Long, Integer> midpoints = new HashMap<>();
+            for (int i = 0; i < triangles.length; i += 3) {
+                int a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+                if (deviation(surface, us, vs, a, b, c) <= limit) {
+                    continue;
+                }
+                int[] corners = { a, b, c };
+                for (int e = 0; e < 3; e++) {
+                    int p = corners[e], q = corners[(e + 1) % 3];
+                    long key = edgeKey(p, q);
+                    if (isLoopEdge(p, q, starts) || midpoints.containsKey(key)) {
+                        continue;
+                    }
+                    if (count == us.length) {
+                        us = Arrays.copyOf(us, 2 * count);
+                        vs = Arrays.copyOf(vs, 2 * count);
+                    }
+                    us[count] = 0.5 * (us[p] + us[q]);
+                    vs[count] = 0.5 * (vs[p] + vs[q]);
+                    midpoints.put(key, count++);
+                }
+            }
+            if (midpoints.isEmpty()) {
+                break;
+            }
+            int[] refined = new int[4 * triangles.length];
+            int t = 0;
+            for (int i = 0; i < triangles.length; i += 3) {
+                int[] corners = { triangles[i], triangles[i + 1], triangles[i + 2] };
+                int[] mids = new int[3];
+                int split = 0;
+                for (int e = 0; e < 3; e++) {
+                    Integer mid = midpoints.get(edgeKey(corners[e], corners[(e + 1) % 3]));
+                    mids[e] = mid != null ? mid : -1;
+                    if (mid != null) {
+                        split++;
+                    }
+                }
+                t = splitTriangle(corners, mids, split, refined, t);
+            }
+            triangles = Arrays.copyOf(refined, t);
+        }
+
+        double[] positions = new double[3 * count];
+        double[] normals = new double[3 * count];
+        for (int i = 0; i < count; i++) {
+            // Loop vertices keep the shared edge samples so neighbouring faces meet exactly
+            Vector3d p = i < fixedPoints.size() ? fixedPoints.get(i) : surface.value(us[i], vs[i]);
+            Vector3d n = surface.normal(us[i], vs[i]);
+            positions[3 * i] = p.x();
+            positions[3 * i + 1] = p.y();
+            positions[3 * i + 2] = p.z();
+            normals[3 * i] = n.x();
+            normals[3 * i + 1] = n.y();
+            normals[3 * i + 2] = n.z();
+        }
+        return new TriangleMesh(positions, normals, triangles);
+    }
+
+    // Consecutive points of one ring; points past the rings are interior
+    private static boolean isLoopEdge(int p, int q, int[] starts) {
+        int rings = starts.length - 1;
+        if (p >= starts[rings] || q >= starts[rings]) {
+            return false;
+        }
+        int lo = Math.min(p, q), hi = Math.max(p, q);
+        for (int r = 0; r < rings; r++) {
+            if (lo >= starts[r] && hi < starts[r + 1]) {
+                return hi == lo + 1 || (lo == starts[r] && hi == starts[r + 1] - 1);
+            }
+        }
+        return false;
+    }
+
+    // mids[e] is the midpoint of the edge from corner e to corner e + 1, or -1 where that edge stays
+    // whole. All three split gives the usual four triangles; fewer gives the two or three that keep
+    // the whole edges intact. Returns the new end of out.
+    private static int splitTriangle(int[] corners, int[] mids, int split, int[] out, int t) {
+        if (split == 0) {
+            out[t++] = corners[0];
+            out[t++] = corners[1];
+            out[t++] = corners[2];
+            return t;
+        }
+        if (split == 3) {
+            int a = corners[0], b = corners[1], c = corners[2];
+            int ab = mids[0], bc = mids[1], ca = mids[2];
+            int[] four = { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca };
+            System.arraycopy(four, 0, out, t, four.length);
+            return t + four.length;
+        }
+        // Rotate so that edge 0 (a to b) is split and, with two splits, edge 2 (c to a) is whole
+        int r = 0;
+        while (mids[r] < 0 || (split == 2 && mids[(r + 2) % 3] >= 0)) {
+            r++;
+        }
+        int a = corners[r], b = corners[(r + 1) % 3], c = corners[(r + 2) % 3];
+        int ab = mids[r];
+        if (split == 1) {
+            int[] two = { a, ab, c, ab, b, c };
+            System.arraycopy(two, 0, out, t, two.length);
+            return t + two.length;
+        }
+        int bc = mids[(r + 1) % 3];
+        int[] three = { a, ab, c, ab, b, bc, ab, bc, c };
+        System.arraycopy(three, 0, out, t, three.length);
+        return t + three.length;
+    }
+
+    // Distance between the surface at a triangle's parametric centroid and the flat triangle there
+    private static double deviation(Surface surface, double[] us, double[] vs, int a, int b, int c) {
+        Vector3d flat = surface.value(us[a], vs[a]).plus(surface.value(us[b], vs[b]))
+                .plus(surface.value(us[c], vs[c])).multiply(1.0 / 3.0);
+        Vector3d curved = surface.value((us[a] + us[b] + us[c]) / 3.0, (vs[a] + vs[b] + vs[c]) / 3.0);
+        return flat.distance(curved);
+    }
+
+    private static long edgeKey(int p, int q) {
+        return ((long) Math.min(p, q) << 32) | Math.max(p, q);
+    }
+
+    private static double signedArea(double[] uv) {
+        int n = uv.length / 2;
+        double area = 0;
+        for (int i = 0; i < n; i++) {
+            int j = (i + 1) % n;
+            area += uv[2 * i] * uv[2 * j + 1] - uv[2 * j] * uv[2 * i + 1];
+        }
+        return 0.5 * area;
+    }
+
+    // uMin, uMax, vMin, vMax
+    private static double[] bounds(double[] uv) {
+        double[] box = { Double.MAX_VALUE, -Double.MAX_VALUE, Double.MAX_VALUE, -Double.MAX_VALUE };
+        for (int i = 0; i < uv.length; i += 2) {
+            box[0] = Math.min(box[0], uv[i]);
+            box[1] = Math.max(box[1], uv[i]);
+            box[2] = Math.min(box[2], uv[i + 1]);
+            box[3] = Math.max(box[3], uv[i + 1]);
+        }
+        return box;
+    }
+
+    private static TriangleMesh flip(TriangleMesh mesh) {
+        int[] indices = mesh.getIndices().clone();
+        for (int i = 0; i < indices.length; i += 3) {
+            int tmp = indices[i + 1];
+            indices[i + 1] = indices[i + 2];
+            indices[i + 2] = tmp;
+        }
+        return new TriangleMesh(mesh.getPositions(), mesh.getNormals(), indices);
+    }
+
+    // Surface normals point whichever way the parametrisation gives; turn them to agree with the winding
+    private static TriangleMesh orientNormals(TriangleMesh mesh) {
+        double[] p = mesh.getPositions();
+        double[] n = mesh.getNormals();
+        int[] idx = mesh.getIndices();
+        if (n == null) {
+            return mesh;
+        }
+        double agreement = 0;
+        for (int t = 0; t < idx.length; t += 3) {
+            int a = 3 * idx[t], b = 3 * idx[t + 1], c = 3 * idx[t + 2];
+            double ux = p[b] - p[a], uy = p[b + 1] - p[a + 1], uz = p[b + 2] - p[a + 2];
+            double vx = p[c] - p[a], vy = p[c + 1] - p[a + 1], vz = p[c + 2] - p[a + 2];
+            double fx = uy * vz - uz * vy, fy = uz * vx - ux * vz, fz = ux * vy - uy * vx;
+            agreement += fx * (n[a] + n[b] + n[c]) + fy * (n[a + 1] + n[b + 1] + n[c + 1])
+                    + fz * (n[a + 2] + n[b + 2] + n[c + 2]);
+        }
+        if (agreement < 0) {
+            for (int i = 0; i < n.length; i++) {
+                n[i] = -n[i];
+            }
+        }
+        return mesh;
+    }
+}
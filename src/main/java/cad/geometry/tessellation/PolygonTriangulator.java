@@ -0,0 +1,282 @@
+package cad.geometry.tessellation;
+
+import cad.math.Vector3d;
+import java.util.ArrayList;
+import java.util.List;
+
+public final class PolygonTriangulator {
+
+    private PolygonTriangulator() {
+    }
+
+    public static Vector3d newellNormal(List<Vector3d> polygon) {
+        double nx = 0, ny = 0, nz = 0;
+        int n = polygon.size();
+        for (int i = 0; i < n; i++) {
+            Vector3d a = polygon.get(i);
+            Vector3d b = polygon.get((i + 1) % n);
+            nx += (a.y() - b.y()) * (a.z() + b.z());
+            ny += (a.z() - b.z()) * (a.x() + b.x());
+            nz += (a.x() - b.x()) * (a.y() + b.y());
+        }
+        return new Vector3d(nx, ny, nz).normalize();
+    }
+
+    // Ear clipping in the plane of the polygon; triangles keep the polygon's winding
+    public static int[] triangulate(List<Vector3d> polygon) {
+        int n = polygon.size();
+        if (n < 3) {
+            return new int[0];
+        }
+        Vector3d normal = newellNormal(polygon);
+        double[] xs = new double[n];
+        double[] ys = new double[n];
+        project(polygon, normal, xs, ys);
+
+        int[] ring = new int[n];
+        for (int i = 0; i < n; i++) {
+            ring[i] = i;
+        }
+        return earClip(xs, ys, ring);
+    }
+
+    // Outer loop and holes share one index space: outer first, then each hole in turn. Holes are bridged
+    // into the outer ring and the result ear-clipped in the plane of the outer loop.
+    public static int[] triangulate(List<Vector3d> outer, List<List<Vector3d>> holes) {
+        if (holes.isEmpty()) {
+            return triangulate(outer);
+        }
+        int total = outer.size();
+        for (List<Vector3d> hole : holes) {
+            total += hole.size();
+        }
+        Vector3d normal = newellNormal(outer);
+        double[] xs = new double[total];
+        double[] ys = new double[total];
+        int[] starts = new int[holes.size() + 2];
+        project(outer, normal, xs, ys);
+        int offset = outer.size();
+        starts[1] = offset;
+        for (int h = 0; h < holes.size(); h++) {
+            List<Vector3d> hole = holes.get(h);
+            double[] hx = new double[hole.size()];
+            double[] hy = new double[hole.size()];
+            project(hole, normal, hx, hy);
+            System.arraycopy(hx, 0, xs, offset, hx.length);
+            System.arraycopy(hy, 0, ys, offset, hy.length);
+            offset += hole.size();
+            starts[h + 2] = offset;
+        }
+        return triangulate(xs, ys, starts);
+    }
+
+    // 2D polygon with holes. ringStarts holds the start of every ring plus the end of the last one;
+    // ring 0 is the outer boundary. Windings are normalised, so either orientation is accepted.
+    public static int[] triangulate(double[] xs, double[] ys, int[] ringStarts) {
+        int rings = ringStarts.length - 1;
+        int[] outer = ring(ringStarts[0], ringStarts[1], signedArea(xs, ys, ringStarts[0], ringStarts[1]) < 0);
+        if (outer.length < 3) {
+            return new int[0];
+        }
+
+        List<int[]> holes = new ArrayList<>();
+        for (int r = 1; r < rings; r++) {
+            int from = ringStarts[r], to = ringStarts[r + 1];
+            if (to - from >= 3) {
+                holes.add(ring(from, to, signedArea(xs, ys, from, to) > 0));
+            }
+        }
+        // Rightmost holes first, so later bridges never cross earlier ones
+        holes.sort((a, b) -> Double.compare(maxX(xs, b), maxX(xs, a)));
+        for (int[] hole : holes) {
+            outer = bridge(xs, ys, outer, hole);
+        }
+        return earClip(xs, ys, outer);
+    }
+
+    private static int[] ring(int from, int to, boolean reversed) {
+        int[] ring = new int[to - from];
+        for (int i = 0; i < ring.length; i++) {
+            ring[i] = reversed ? to - 1 - i : from + i;
+        }
+        return ring;
+    }
+
+    private static double signedArea(double[] xs, double[] ys, int from, int to) {
+        double area = 0;
+        for (int i = from; i < to; i++) {
+            int j = i + 1 < to ? i + 1 : from;
+            area += xs[i] * ys[j] - xs[j] * ys[i];
+        }
+        return 0.5 * area;
+    }
+
+    private static double maxX(double[] xs, int[] ring) {
+        double max = -Double.MAX_VALUE;
+        for (int i : ring) {
+            max = Math.max(max, xs[i]);
+        }
+        return max;
+    }
+
+    // Splices the hole into the outer ring through a segment from the hole's rightmost vertex to the
+    // nearest outer vertex it can see: ... p, m, hole ..., m, p ...
+    private static int[] bridge(double[] xs, double[] ys, int[] outer, int[] hole) {
+        int mi = 0;
+        for (int i = 1; i < hole.length; i++) {
+            if (xs[hole[i]] > xs[hole[mi]]) {
+                mi = i;
+            }
+        }
+        int m = hole[mi];
+
+        int best = -1;
+        double bestDist = Double.MAX_VALUE;
+        for (int i = 0; i < outer.length; i++) {
+            int p = outer[i];
+            double dx = xs[p] - xs[m], dy = ys[p] - ys[m];
+            double d = dx * dx + dy * dy;
+            if (d < bestDist && visible(xs, ys, outer, hole, m, p)) {
+                best = i;
+                bestDist = d;
+            }
+        }
+        if (best < 0) {
+            // No clear line of sight (degenerate input); fall back to the nearest vertex
+            for (int i = 0; i < outer.length; i++) {
+                int p = outer[i];
+                double dx = xs[p] - xs[m], dy = ys[p] - ys[m];
+                double d = dx * dx + dy * dy;
+                if (d < bestDist) {
+                    best = i;
+                    bestDist = d;
+                }
+            }
+        }
+
+        int[] merged = new int[outer.length + hole.length + 2];
+        int k = 0;
+        for (int i = 0; i <= best; i++) {
+            merged[k++] = outer[i];
+        }
+        for (int i = 0; i <= hole.length; i++) {
+            merged[k++] = hole[(mi + i) % hole.length];
+        }
+        for (int i = best; i < outer.length; i++) {
+            merged[k++] = outer[i];
+        }
+        return merged;
+    }
+
+    private static boolean visible(double[] xs, double[] ys, int[] outer, int[] hole, int m, int p) {
+        return !crossesRing(xs, ys, outer, m, p) && !crossesRing(xs, ys, hole, m, p);
+    }
+
+    private static boolean crossesRing(double[] xs, double[] ys, int[] ring, int m, int p) {
+        for (int i = 0; i < ring.length; i++) {
+            int a = ring[i];
+            int b = ring[(i + 1) % ring.length];
+            if (a == m || a == p || b == m || b == p) {
+                continue;
+            }
+            if (segmentsCross(xs, ys, m, p, a, b)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    private static boolean segmentsCross(double[] xs, double[] ys, int a, int b, int c, int d) {
+        double d1 = cross(xs, ys, a, b, c);
+        double d2 = cross(xs, ys, a, b, d);
+        double d3 = cross(xs, ys, c, d, a);
+        double d4 = cross(xs, ys, c, d, b);
+        return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+    }
+
+    // Counter-clockwise ring of vertex indices, which may repeat where holes are bridged
+    static int[] earClip(double[] xs, double[] ys, int[] ring) {
+        int n = ring.length;
+        if (n < 3) {
+            return new int[0];
+        }
+        int[] next = new int[n];
+        int[] prev = new int[n];
+        for (int i = 0; i < n; i++) {
+            next[i] = (i + 1) % n;
+            prev[i] = (i + n - 1) % n;
+        }
+
+        int[] triangles = new int[3 * (n - 2)];
+        int count = 0;
+        int remaining = n;
+        int current = 0;
+        int stalled = 0;
+        while (remaining > 3) {
+            int a = prev[current];
+            int b = current;
+            int c = next[current];
+            boolean ear = isConvex(xs, ys, ring[a], ring[b], ring[c]) && !containsOther(xs, ys, ring, next, a, b, c);
+            if (ear || stalled > remaining) {
+                triangles[count++] = ring[a];
+                triangles[count++] = ring[b];
+                triangles[count++] = ring[c];
+                next[a] = c;
+                prev[c] = a;
+                remaining--;
+                stalled = 0;
+                current = c;
+            } else {
+                current = c;
+                stalled++;
+            }
+        }
+        triangles[count++] = ring[prev[current]];
+        triangles[count++] = ring[current];
+        triangles[count++] = ring[next[current]];
+        return triangles;
+    }
+
+    // Drops the dominant normal axis, mirroring so the polygon is counter-clockwise in 2D
+    static void project(List<Vector3d> polygon, Vector3d normal, double[] xs, double[] ys) {
+        double ax = Math.abs(normal.x());
+        double ay = Math.abs(normal.y());
+        double az = Math.abs(normal.z());
+        for (int i = 0; i < polygon.size(); i++) {
+            Vector3d p = polygon.get(i);
+            if (az >= ax && az >= ay) {
+                xs[i] = p.x();
+                ys[i] = normal.z() >= 0 ? p.y() : -p.y();
+            } else if (ax >= ay) {
+                xs[i] = p.y();
+                ys[i] = normal.x() >= 0 ? p.z() : -p.z();
+            } else {
+                xs[i] = p.z();
+                ys[i] = normal.y() >= 0 ? p.x() : -p.x();
+            }
+        }
+    }
+
+    private static double cross(double[] xs, double[] ys, int a, int b, int c) {
+        return (xs[b] - xs[a]) * (ys[c] - ys[a]) - (ys[b] - ys[a]) * (xs[c] - xs[a]);
+    }
+
+    private static boolean isConvex(double[] xs, double[] ys, int a, int b, int c) {
+        return cross(xs, ys, a, b, c) > 0;
+    }
+
+    private static boolean containsOther(double[] xs, double[] ys, int[] ring, int[] next, int a, int b, int c) {
+        int ia = ring[a], ib = ring[b], ic = ring[c];
+        for (int q = next[c]; q != a; q = next[q]) {
+            int p = ring[q];
+            if ((xs[p] == xs[ia] && ys[p] == ys[ia]) || (xs[p] == xs[ib] && ys[p] == ys[ib])
+                    || (xs[p] == xs[ic] && ys[p] == ys[ic])) {
+                continue;
+            }
+            if (cross(xs, ys, ia, ib, p) >= 0 && cross(xs, ys, ib, ic, p) >= 0 && cross(xs, ys, ic, ia, p) >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,114 @@
+package cad.geometry.tessellation;
+
+import cad.geometry.curves.Curve;
+import cad.geometry.surfaces.Surface;
+import cad.math.Vector3d;
+import java.util.Arrays;
+
+public final class SurfaceTessellator {
+
+    private SurfaceTessellator() {
+    }
+
+    public static TriangleMesh tessellate(Surface surface, TessellationTolerance tolerance) {
+        double[] us = isoParameters(surface, true, tolerance);
+        double[] vs = isoParameters(surface, false, tolerance);
+        return tessellateGrid(surface, us, vs);
+    }
+
+    public static TriangleMesh tessellateGrid(Surface surface, double[] us, double[] vs) {
+        int nu = us.length;
+        int nv = vs.length;
+        double[] positions = new double[3 * nu * nv];
+        double[] normals = new double[positions.length];
+        surface.evaluateGrid(us, vs, positions, normals);
+
+        int[] indices = new int[6 * (nu - 1) * (nv - 1)];
+        int k = 0;
+        for (int j = 0; j < nv - 1; j++) {
+            for (int i = 0; i < nu - 1; i++) {
+                int v00 = j * nu + i;
+                int v10 = v00 + 1;
+                int v01 = v00 + nu;
+                int v11 = v01 + 1;
+                indices[k++] = v00;
+                indices[k++] = v10;
+                indices[k++] = v11;
+                indices[k++] = v00;
+                indices[k++] = v11;
+                indices[k++] = v01;
+            }
+        }
+        return new TriangleMesh(positions, normals, indices);
+    }
+
+    // Parameters along one direction, merged from adaptive sampling of three isoparametric curves
+    public static double[] isoParameters(Surface surface, boolean alongU, TessellationTolerance tolerance) {
+        double otherMin = alongU ? surface.getVMin() : surface.getUMin();
+        double otherMax = alongU ? surface.getVMax() : surface.getUMax();
+        double[] fixedValues = { otherMin, 0.5 * (otherMin + otherMax), otherMax };
+
+        double[][] runs = new double[fixedValues.length][];
+        int total = 0;
+        for (int i = 0; i < fixedValues.length; i++) {
+            runs[i] = CurveTessellator.sampleParameters(new IsoCurve(surface, alongU, fixedValues[i]), tolerance);
+            total += runs[i].length;
+        }
+
+        double[] merged = new double[total];
+        int n = 0;
+        for (double[] run : runs) {
+            System.arraycopy(run, 0, merged, n, run.length);
+            n += run.length;
+        }
+        Arrays.sort(merged);
+
+        double min = alongU ? surface.getUMin() : surface.getVMin();
+        double max = alongU ? surface.getUMax() : surface.getVMax();
+        double eps = 1e-9 * Math.max(1.0, Math.abs(max - min));
+        int unique = 0;
+        for (int i = 0; i < merged.length; i++) {
+            if (unique == 0 || merged[i] - merged[unique - 1] > eps) {
+                merged[unique++] = merged[i];
+            }
+        }
+        return Arrays.copyOf(merged, unique);
+    }
+
+    private static final class IsoCurve extends Curve {
+        private final Surface surface;
+        private final boolean alongU;
+        private final double fixed;
+
+        IsoCurve(Surface surface, boolean alongU, double fixed) {
+            this.surface = surface;
+            this.alongU = alongU;
+            this.fixed = fixed;
+        }
+
+        @Override
+        public Vector3d value(double t) {
+            return alongU ? surface.value(t, fixed) : surface.value(fixed, t);
+        }
+
+        @Override
+        public Vector3d derivative(double t) {
+            return alongU ? surface.derivativeU(t, fixed) : surface.derivativeV(fixed, t);
+        }
+
+        @Override
+        public Vector3d tangent(double t) {
+            return derivative(t).normalize();
+        }
+
+        @Override
+        public double startParam() {
+            return alongU ? surface.getUMin() : surface.getVMin();
+        }
+
+        @Override
+        public double endParam() {
+            return alongU ? surface.getUMax() : surface.getVMax();
+        }
+    }
+}
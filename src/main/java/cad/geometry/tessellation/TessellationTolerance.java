@@ -0,0 +1,89 @@
+package cad.geometry.tessellation;
+
+import java.util.Objects;
+
+public class TessellationTolerance {
+    public static final TessellationTolerance DEFAULT = new TessellationTolerance(0.05, Math.toRadians(20.0), 8, 512);
+    // Coarser tolerance for interactive sketch display
+    public static final TessellationTolerance DISPLAY = new TessellationTolerance(0.1, Math.toRadians(15.0), 12, 256);
+
+    private final double chordalDeviation;
+    private final double angleTolerance;
+    private final int minSegments;
+    private final int maxSegments;
+
+    public TessellationTolerance(double chordalDeviation, double angleTolerance, int minSegments, int maxSegments) {
+        if (chordalDeviation <= 0) {
+            throw new IllegalArgumentException("Chordal deviation must be positive");
+        }
+        if (angleTolerance <= 0 || angleTolerance > Math.PI) {
+            throw new IllegalArgumentException("Angle tolerance must be in (0, pi]");
+        }
+        if (minSegments < 1 || maxSegments < minSegments) {
+            throw new IllegalArgumentException("Segment limits must satisfy 1 <= min <= max");
+        }
+        this.chordalDeviation = chordalDeviation;
+        this.angleTolerance = angleTolerance;
+        this.minSegments = minSegments;
+        this.maxSegments = maxSegments;
+    }
+
+    public double getChordalDeviation() {
+        return chordalDeviation;
+    }
+
+    public double getAngleTolerance() {
+        return angleTolerance;
+    }
+
+    public int getMinSegments() {
+        return minSegments;
+    }
+
+    public int getMaxSegments() {
+        return maxSegments;
+    }
+
+    public TessellationTolerance withChordalDeviation(double deviation) {
+        return new TessellationTolerance(deviation, angleTolerance, minSegments, maxSegments);
+    }
+
+    // Largest angle a chord may subtend on a circle of this radius
+    public double maxStepAngle(double radius) {
+        double step = angleTolerance;
+        if (radius > chordalDeviation) {
+            step = Math.min(step, 2.0 * Math.acos(1.0 - chordalDeviation / radius));
+        }
+        return step;
+    }
+
+    // Segment count for a circular arc; the sagitta of each segment stays within the chordal deviation
+    public int segmentsForArc(double radius, double sweepRadians) {
+        double sweep = Math.abs(sweepRadians);
+        if (sweep == 0 || radius <= 0) {
+            return 1;
+        }
+        int segments = (int) Math.ceil(sweep / maxStepAngle(Math.abs(radius)));
+        int min = Math.max(1, (int) Math.ceil(minSegments * sweep / (2.0 * Math.PI)));
+        return Math.max(min, Math.min(maxSegments, segments));
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+        if (this == obj) return true;
+        if (!(obj instanceof TessellationTolerance)) return false;
+        TessellationTolerance other = (TessellationTolerance) obj;
+        return chordalDeviation == other.chordalDeviation && angleTolerance == other.angleTolerance
+                && minSegments == other.minSegments && maxSegments == other.maxSegments;
+    }
+
+    @Override
+    public int hashCode() {
+        return Objects.hash(chordalDeviation, angleTolerance, minSegments, maxSegments);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("chord=%.4f, angle=%.1f deg", chordalDeviation, Math.toDegrees(angleTolerance));
+    }
+}
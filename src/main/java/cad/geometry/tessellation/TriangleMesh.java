@@ -0,0 +1,109 @@
+package cad.geometry.tessellation;
+
+import java.util.ArrayList;
+import java.util.List;
+
+// Indexed triangles with per-vertex normals, stored as flat xyz arrays
+public class TriangleMesh {
+    private final double[] positions;
+    private final double[] normals;
+    private final int[] indices;
+
+    public TriangleMesh(double[] positions, double[] normals, int[] indices) {
+        if (positions.length % 3 != 0 || indices.length % 3 != 0) {
+            throw new IllegalArgumentException("Positions and indices must come in triples");
+        }
+        if (normals != null && normals.length != positions.length) {
+            throw new IllegalArgumentException("Normals must match positions");
+        }
+        this.positions = positions;
+        this.normals = normals;
+        this.indices = indices;
+    }
+
+    public double[] getPositions() {
+        return positions;
+    }
+
+    public double[] getNormals() {
+        return normals;
+    }
+
+    public int[] getIndices() {
+        return indices;
+    }
+
+    public int getVertexCount() {
+        return positions.length / 3;
+    }
+
+    public int getTriangleCount() {
+        return indices.length / 3;
+    }
+
+    // Converts to the float[12] layout (facet normal, then three vertices) used by Geometry
+    public List<float[]> toTriangles() {
+        List<float[]> triangles = new ArrayList<>(getTriangleCount());
+        for (int t = 0; t < indices.length; t += 3) {
+            int a = indices[t] * 3;
+            int b = indices[t + 1] * 3;
+            int c = indices[t + 2] * 3;
+
+            double ux = positions[b] - positions[a];
+            double uy = positions[b + 1] - positions[a + 1];
+            double uz = positions[b + 2] - positions[a + 2];
+            double vx = positions[c] - positions[a];
+            double vy = positions[c + 1] - positions[a + 1];
+            double vz = positions[c + 2] - positions[a + 2];
+            double nx = uy * vz - uz * vy;
+            double ny = uz * vx - ux * vz;
+            double nz = ux * vy - uy * vx;
+            double len = Math.sqrt(nx * nx + ny * ny + nz * nz);
+            if (len < 1e-20) {
+                continue;
+            }
+
+            float[] tri = new float[12];
+            tri[0] = (float) (nx / len);
+            tri[1] = (float) (ny / len);
+            tri[2] = (float) (nz / len);
+            for (int k = 0; k < 3; k++) {
+                tri[3 + k] = (float) positions[a + k];
+                tri[6 + k] = (float) positions[b + k];
+                tri[9 + k] = (float) positions[c + k];
+            }
+            triangles.add(tri);
+        }
+        return triangles;
+    }
+
+    public static TriangleMesh merge(List<TriangleMesh> meshes) {
+        int vertexTotal = 0;
+        int indexTotal = 0;
+        boolean allNormals = true;
+        for (TriangleMesh m : meshes) {
+            vertexTotal += m.positions.length;
+            indexTotal += m.indices.length;
+            allNormals &= m.normals != null;
+        }
+
+        double[] positions = new double[vertexTotal];
+        double[] normals = allNormals ? new double[vertexTotal] : null;
+        int[] indices = new int[indexTotal];
+        int vOffset = 0;
+        int iOffset = 0;
+        for (TriangleMesh m : meshes) {
+            System.arraycopy(m.positions, 0, positions, vOffset, m.positions.length);
+            if (normals != null) {
+                System.arraycopy(m.normals, 0, normals, vOffset, m.normals.length);
+            }
+            int base = vOffset / 3;
+            for (int i = 0; i < m.indices.length; i++) {
+                indices[iOffset + i] = m.indices[i] + base;
+            }
+            vOffset += m.positions.length;
+            iOffset += m.indices.length;
+        }
+        return new TriangleMesh(positions, normals, indices);
+    }
+}
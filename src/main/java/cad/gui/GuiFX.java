@@ -58,9 +58,12 @@ import com.jogamp.opengl.glu.GLU;
 import com.jogamp.opengl.util.FPSAnimator;
 import com.jogamp.opengl.util.awt.TextRenderer;
 import cad.core.Geometry;
+import cad.core.ModelContext;
+import cad.core.ModelSnapshot;
 import cad.core.Sketch;
 import cad.core.UnitSystem;
 import cad.core.CommandManager;
+import cad.core.OperationExecutor;
 import cad.core.AddConstraintCommand;
 import cad.core.Constraint;
 import cad.core.CoincidentConstraint;
@@ -76,6 +79,8 @@ import cad.aerodynamics.NacaDialog;
 import cad.aerodynamics.CfdDialog;
 import cad.analysis.FlowVisualizer;
 public class GuiFX extends Application {
+    // Repeated drags and spinner edits closer together than this become one undo step
+    private static final long MERGE_WINDOW_MILLIS = 500;
     private TextArea outputArea;
     private JOGLCadCanvas glCanvas;
     private SwingNode canvasNode;
@@ -88,20 +93,28 @@ public class GuiFX extends Application {
     public static int cubeDivisions = 10;
     public static Sketch sketch;
     private CommandManager commandManager;
+    private final OperationExecutor operations = new OperationExecutor(2, Platform::runLater);
+    private volatile OperationExecutor.Operation<?> runningOperation;
+    private TabPane ribbonPane;
+    private TabPane controlPanel;
+    private Button cancelOperationButton;
     private UnitSystem currentUnits = UnitSystem.MMGS;
     private float rotationX = 35.264f;
     private float rotationY = -45.0f;
     private float zoom = -30.0f;
     private int lastMouseX, lastMouseY;
     private boolean isDragging = false;
-    private List<float[]> stlTriangles;
+    private volatile List<float[]> stlTriangles;
     private float sketch2DPanX = 0.0f;
     private float sketch2DPanY = 0.0f;
     private float sketch2DZoom = 1.0f;
     @Override
     public void start(Stage primaryStage) {
         sketch = new Sketch();
+        ModelContext.getDefault().setSketch(sketch);
         commandManager = new CommandManager();
+        commandManager.setNotificationDispatcher(Platform::runLater);
+        commandManager.setMergeWindowMillis(MERGE_WINDOW_MILLIS);
         showUnitSelectionWindow(primaryStage);
     }
     private void showUnitSelectionWindow(Stage primaryStage) {
@@ -142,12 +155,11 @@ public class GuiFX extends Application {
         splashStage.show();
     }
     private void initializeMainUI(Stage primaryStage) {
-        commandManager = new CommandManager();
         interactionManager = new SketchInteractionManager(sketch, commandManager);
         macroManager = new MacroManager(sketch, primaryStage);
         macroManager.setCanvasRefresh(() -> {
             if (glCanvas != null) {
-                javax.swing.SwingUtilities.invokeLater(() -> glCanvas.repaint());
+                javax.swing.SwingUtilities.invokeLater(() -> refreshCanvas());
             }
         });
         macroManager.setOutputCallback(this::appendOutput);
@@ -158,6 +170,11 @@ public class GuiFX extends Application {
             }
         });
         macroManager.setFitViewCallback(this::fitSketchView);
+        macroManager.setPlaybackCallback(playing -> {
+            setModellingEnabled(!playing);
+            cancelOperationButton.setVisible(playing);
+            statusLabel.setText(playing ? "Playing macro..." : "Ready");
+        });
         macroManager.setStlUpdateCallback(triangles -> {
             if (glRenderer != null) {
                 glRenderer.setStlTriangles(triangles);
@@ -175,8 +192,8 @@ public class GuiFX extends Application {
         });
         initializeComponents();
         BorderPane root = new BorderPane();
-        TabPane ribbon = createRibbon();
-        root.setTop(ribbon);
+        ribbonPane = createRibbon();
+        root.setTop(ribbonPane);
         StackPane viewportStack = new StackPane();
         viewportStack.getStyleClass().add("viewport-stack");
         ToolBar headsUpToolbar = new ToolBar();
@@ -204,9 +221,9 @@ public class GuiFX extends Application {
         viewportStack.getChildren().add(headsUpToolbar);
         initializeCanvasAsync(viewportStack);
         root.setCenter(viewportStack);
-        TabPane featureManager = createControlPanel();
+        controlPanel = createControlPanel();
         SplitPane horizontalSplit = new SplitPane();
-        horizontalSplit.getItems().addAll(featureManager, root.getCenter());
+        horizontalSplit.getItems().addAll(controlPanel, root.getCenter());
         horizontalSplit.setDividerPositions(0.2);
         root.setCenter(horizontalSplit);
         VBox bottomPane = new VBox();
@@ -320,8 +337,8 @@ public class GuiFX extends Application {
                 createRibbonButton("Symmetric", "Make Symmetric", e -> applySymmetricConstraint()),
                 new Separator(),
                 createRibbonButton("Solve", "Solve Constraints", e -> {
-                    sketch.solveConstraints();
-                    glCanvas.repaint();
+                    edit(sketch::solveConstraints);
+                    refreshCanvas();
                     appendOutput("Constraints Solved.");
                 }));
         constraintsTab.setContent(constraintsToolbar);
@@ -330,7 +347,8 @@ public class GuiFX extends Application {
         toolsToolbar.getItems().addAll(
                 createRibbonButton("Record", "Record Macro", e -> macroManager.startRecording()),
                 createRibbonButton("Stop", "Stop Recording", e -> macroManager.stopRecording()),
-                createRibbonButton("Run", "Run Macro", e -> showRunMacroMenu()));
+                createRibbonButton("Run", "Run Macro", e -> showRunMacroMenu()),
+                createRibbonButton("Cancel", "Cancel Running Macro", e -> macroManager.cancelMacro()));
         toolsTab.setContent(toolsToolbar);
         Tab aeroTab = new Tab("Aerodynamics");
         ToolBar aeroToolbar = new ToolBar();
@@ -401,14 +419,14 @@ public class GuiFX extends Application {
                             
                             if (cmd instanceof cad.core.CreateExtrudeCommand) {
                                 ((cad.core.CreateExtrudeCommand) cmd).setHeight(val);
-                                cmd.execute();
+                                edit(cmd::execute);
                                 glRenderer.setStlTriangles(cad.core.Geometry.getExtrudedTriangles());
-                                glCanvas.repaint();
+                                refreshCanvas();
                             } else if (cmd instanceof cad.core.CreateRevolveCommand) {
                                 ((cad.core.CreateRevolveCommand) cmd).setAngle(val);
-                                cmd.execute();
+                                edit(cmd::execute);
                                 glRenderer.setStlTriangles(cad.core.Geometry.getExtrudedTriangles());
-                                glCanvas.repaint();
+                                refreshCanvas();
                             }
                             appendOutput("Property updated successfully.");
                         } catch (Exception ex) {
@@ -439,13 +457,15 @@ public class GuiFX extends Application {
         
         // Listen to CommandManager to populate History
         if (commandManager != null) {
+            // Events arrive batched once per frame; every change ends in one onHistoryChanged, so
+            // the tree is rebuilt there only
             commandManager.addListener(new CommandManager.CommandListener() {
                 @Override
-                public void onCommandExecuted(cad.core.Command cmd) { updateHistoryNode(); }
+                public void onCommandExecuted(cad.core.Command cmd) { }
                 @Override
-                public void onUndo(cad.core.Command cmd) { updateHistoryNode(); }
+                public void onUndo(cad.core.Command cmd) { }
                 @Override
-                public void onRedo(cad.core.Command cmd) { updateHistoryNode(); }
+                public void onRedo(cad.core.Command cmd) { }
                 @Override
                 public void onHistoryChanged() { updateHistoryNode(); }
                 
@@ -602,15 +622,14 @@ public class GuiFX extends Application {
     public void setViewMode(boolean showSketch) {
         if (glRenderer != null) {
             glRenderer.setShowSketch(showSketch);
-            glCanvas.repaint();
+            refreshCanvas();
         }
     }
     private void requestViewChange(boolean showSketch) {
         if (glRenderer != null) {
             boolean currentMode = glRenderer.isShowSketch();
             if (currentMode != showSketch) {
-                ViewChangeCommand cmd = new ViewChangeCommand(this, showSketch, currentMode);
-                commandManager.executeCommand(cmd);
+                execute(new ViewChangeCommand(this, showSketch, currentMode));
                 appendOutput("View changed to " + (showSketch ? "2D Sketch" : "3D View"));
             }
         }
@@ -655,8 +674,8 @@ public class GuiFX extends Application {
         });
         Optional<Double> result = dialog.showAndWait();
         result.ifPresent(radius -> {
-            cad.core.Geometry.filletEdge(edgePoints, radius.floatValue());
-            glCanvas.repaint();
+            edit(() -> cad.core.Geometry.filletEdge(edgePoints, radius.floatValue()));
+            refreshCanvas();
             appendOutput("Fillet applied with radius " + radius);
             if (glRenderer != null) {
                 glRenderer.setEdgeSelectionMode(false);
@@ -669,9 +688,9 @@ public class GuiFX extends Application {
             Entity e1 = selected.get(0);
             Entity e2 = selected.get(1);
             Constraint c = new cad.core.TangentConstraint(e1, e2);
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Tangent Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 2 entities for Tangent");
         }
@@ -683,9 +702,9 @@ public class GuiFX extends Application {
                 selected.get(1) instanceof Sketch.Circle) {
             Constraint c = new cad.core.ConcentricConstraint((Sketch.Circle) selected.get(0),
                     (Sketch.Circle) selected.get(1));
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Concentric Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 2 circles for Concentric");
         }
@@ -697,9 +716,9 @@ public class GuiFX extends Application {
                 selected.get(1) instanceof Sketch.Line) {
             Constraint c = new cad.core.ParallelConstraint((Sketch.Line) selected.get(0),
                     (Sketch.Line) selected.get(1));
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Parallel Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 2 lines for Parallel");
         }
@@ -711,9 +730,9 @@ public class GuiFX extends Application {
                 selected.get(1) instanceof Sketch.Line) {
             Constraint c = new cad.core.PerpendicularConstraint((Sketch.Line) selected.get(0),
                     (Sketch.Line) selected.get(1));
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Perpendicular Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 2 lines for Perpendicular");
         }
@@ -730,9 +749,9 @@ public class GuiFX extends Application {
         }
         if (p != null && l != null && selected.size() == 2) {
             Constraint c = new cad.core.MidpointConstraint(p.getPoint(), l.getStartPoint(), l.getEndPoint());
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Midpoint Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 1 point and 1 line for Midpoint");
         }
@@ -741,9 +760,9 @@ public class GuiFX extends Application {
         List<Entity> selected = interactionManager.getSelectedEntities();
         if (selected.size() == 2) {
             Constraint c = new cad.core.EqualConstraint(selected.get(0), selected.get(1));
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Equal Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 2 compatible entities for Equal");
         }
@@ -755,10 +774,12 @@ public class GuiFX extends Application {
             Sketch.Line l2 = (Sketch.Line) selected.get(1);
             Constraint c1 = new cad.core.CollinearConstraint(l1.getStartPoint(), l1.getEndPoint(), l2.getStartPoint());
             Constraint c2 = new cad.core.CollinearConstraint(l1.getStartPoint(), l1.getEndPoint(), l2.getEndPoint());
-            sketch.addConstraint(c1);
-            sketch.addConstraint(c2);
+            edit(() -> {
+                sketch.addConstraint(c1);
+                sketch.addConstraint(c2);
+            });
             appendOutput("Added Collinear Constraint (Line-Line)");
-            glCanvas.repaint();
+            refreshCanvas();
         } else if (selected.size() == 3) {
             appendOutput("Select 2 lines for Collinear");
         } else {
@@ -783,9 +804,9 @@ public class GuiFX extends Application {
         }
         if (p1 != null && p2 != null && centerLine != null && selected.size() == 3) {
             Constraint c = new cad.core.SymmetricConstraint(p1.getPoint(), p2.getPoint(), centerLine);
-            sketch.addConstraint(c);
+            edit(() -> sketch.addConstraint(c));
             appendOutput("Added Symmetric Constraint");
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("Select 2 points and 1 symmetry line");
         }
@@ -796,8 +817,94 @@ public class GuiFX extends Application {
         statusBar.getStyleClass().add("status-bar");
         statusLabel = new Label("Ready");
         statusBar.setLeft(statusLabel);
+        cancelOperationButton = new Button("Cancel");
+        cancelOperationButton.setVisible(false);
+        cancelOperationButton.setOnAction(e -> {
+            if (runningOperation != null) {
+                runningOperation.cancel();
+                statusLabel.setText("Cancelling " + runningOperation.getName() + "...");
+            } else if (macroManager.isMacroRunning()) {
+                macroManager.cancelMacro();
+                statusLabel.setText("Cancelling macro...");
+            }
+        });
+        statusBar.setRight(cancelOperationButton);
         return statusBar;
     }
+    // Runs kernel work on a worker thread with progress in the status bar. onDone runs on the FX thread
+    // with the result; a cancelled or failed operation leaves the model as it was.
+    private <T> void runOperation(String name, java.util.concurrent.Callable<T> work, java.util.function.Consumer<T> onDone) {
+        if (isOperationRunning()) {
+            return;
+        }
+        OperationExecutor.Operation<T> operation = operations.submit(name, ModelContext.getDefault(), work,
+                (phase, done, total) -> statusLabel.setText(total > 0
+                        ? String.format("%s: %s %d/%d", name, phase, done, total)
+                        : String.format("%s: %s %d", name, phase, done)));
+        runningOperation = operation;
+        setModellingEnabled(false);
+        statusLabel.setText(name + "...");
+        cancelOperationButton.setVisible(true);
+        operation.whenDone((result, error) -> {
+            runningOperation = null;
+            setModellingEnabled(true);
+            cancelOperationButton.setVisible(false);
+            statusLabel.setText("Ready");
+            if (error instanceof java.util.concurrent.CancellationException) {
+                appendOutput(name + " cancelled.");
+            } else if (error != null) {
+                appendOutput("Error during " + name + ": " + error.getMessage());
+            } else {
+                onDone.accept(result);
+            }
+        });
+    }
+    // Redraws from the last published snapshot. Edits publish themselves through edit() or execute(),
+    // so this is safe from any thread.
+    private void refreshCanvas() {
+        glCanvas.repaint();
+    }
+    // The FX thread and the Swing EDT both edit the default context. Each edit holds the context while
+    // it changes the model and publishes the result before letting go, so neither thread nor the
+    // kernel workers ever see or snapshot it half done.
+    private void edit(Runnable change) {
+        ModelContext.getDefault().update(change);
+    }
+    private <T> T edit(java.util.concurrent.Callable<T> change) {
+        return ModelContext.getDefault().update(change);
+    }
+    // Commands publish when they finish, so they only need the context held
+    private void execute(cad.core.Command cmd) {
+        ModelContext.getDefault().run(() -> commandManager.executeCommand(cmd));
+    }
+    // The operation owns the model until it finishes, so every modelling control is off meanwhile;
+    // the view buttons, the canvas camera and Cancel stay live
+    private void setModellingEnabled(boolean enabled) {
+        for (TabPane pane : new TabPane[] { ribbonPane, controlPanel }) {
+            if (pane != null) {
+                for (Tab tab : pane.getTabs()) {
+                    tab.getContent().setDisable(!enabled);
+                }
+            }
+        }
+    }
+    // Sketch tools on the canvas ignore input while an operation or macro runs; navigation still works
+    private boolean isCanvasEditBlocked() {
+        return (runningOperation != null || macroManager.isMacroRunning()) && interactionManager != null
+                && interactionManager.getMode() != SketchInteractionManager.InteractionMode.IDLE
+                && interactionManager.getMode() != SketchInteractionManager.InteractionMode.VIEW_ROTATE;
+    }
+    private boolean isOperationRunning() {
+        if (runningOperation != null) {
+            appendOutput("Wait for " + runningOperation.getName() + " to finish, or cancel it.");
+            return true;
+        }
+        if (macroManager.isMacroRunning()) {
+            appendOutput("Wait for the macro to finish, or cancel it.");
+            return true;
+        }
+        return false;
+    }
     private TitledPane createConsolePane() {
         TitledPane consolePane = new TitledPane("Console Output", outputArea);
         consolePane.setCollapsible(true);
@@ -846,18 +953,21 @@ public class GuiFX extends Application {
         @Override
         public void display(GLAutoDrawable drawable) {
             GL2 gl = drawable.getGL().getGL2();
+            // One published snapshot per frame, so the frame is consistent while commands run
+            ModelSnapshot snapshot = ModelContext.getDefault().snapshot();
+            List<float[]> triangles = stlTriangles;
             gl.glClear(GL2.GL_COLOR_BUFFER_BIT | GL2.GL_DEPTH_BUFFER_BIT);
             if (this.showSketch) {
-                renderSketch(gl, drawable);
+                renderSketch(gl, drawable, snapshot);
             } else {
-                updateProjectionMatrix(drawable);
+                updateProjectionMatrix(drawable, snapshot);
                 gl.glLoadIdentity();
                 gl.glTranslatef(0.0f, 0.0f, zoom);
                 gl.glRotatef(rotationX, 1.0f, 0.0f, 0.0f);
                 gl.glRotatef(rotationY, 0.0f, 1.0f, 0.0f);
-                if (stlTriangles != null) {
-                    renderStlTriangles(gl);
-                    renderModelAxes(gl, drawable);
+                if (triangles != null) {
+                    renderStlTriangles(gl, triangles);
+                    renderModelAxes(gl, drawable, snapshot);
                 } else {
                     renderAxes(drawable);
                     renderPlanes(gl);
@@ -867,14 +977,14 @@ public class GuiFX extends Application {
             gl.glGetDoublev(GL2.GL_PROJECTION_MATRIX, projectionMatrix, 0);
             gl.glGetIntegerv(GL2.GL_VIEWPORT, viewport, 0);
         }
-        private void updateProjectionMatrix(GLAutoDrawable drawable) {
+        private void updateProjectionMatrix(GLAutoDrawable drawable, ModelSnapshot snapshot) {
             GL2 gl = drawable.getGL().getGL2();
             int width = drawable.getSurfaceWidth();
             int height = drawable.getSurfaceHeight();
             if (height == 0)
                 height = 1;
             float aspect = (float) width / height;
-            float modelSize = Geometry.getModelMaxDimension();
+            float modelSize = snapshot.getMaxDimension();
             float nearPlane = Math.max(0.01f, Math.abs(zoom) * 0.005f);
             float farPlane = Math.max(1000.0f, Math.abs(zoom) + modelSize * 5.0f);
             gl.glMatrixMode(GL2.GL_PROJECTION);
@@ -891,7 +1001,7 @@ public class GuiFX extends Application {
             gl.glViewport(0, 0, width, height);
             gl.glMatrixMode(GL2.GL_PROJECTION);
             gl.glLoadIdentity();
-            float modelSize = Geometry.getModelMaxDimension();
+            float modelSize = ModelContext.getDefault().snapshot().getMaxDimension();
             float nearPlane = Math.max(0.01f, Math.abs(zoom) * 0.005f);
             float farPlane = Math.max(1000.0f, Math.abs(zoom) + modelSize * 5.0f);
             glu.gluPerspective(45.0, aspect, nearPlane, farPlane);
@@ -1003,11 +1113,11 @@ public class GuiFX extends Application {
             }
             textRenderer.endRendering();
         }
-        private void renderModelAxes(GL2 gl, GLAutoDrawable drawable) {
+        private void renderModelAxes(GL2 gl, GLAutoDrawable drawable, ModelSnapshot snapshot) {
             if (modelCentroid == null) {
                 return;
             }
-            float modelSize = Geometry.getModelMaxDimension();
+            float modelSize = snapshot.getMaxDimension();
             float axisLength = Math.max(modelSize * 0.75f, 5.0f);
             float cx = modelCentroid[0];
             float cy = modelCentroid[1];
@@ -1093,7 +1203,7 @@ public class GuiFX extends Application {
                 gl.glPopAttrib();
             }
         }
-        private void renderStlTriangles(GL2 gl) {
+        private void renderStlTriangles(GL2 gl, List<float[]> triangles) {
             cad.core.Material material = sketch != null ? sketch.getMaterial() : null;
             if (material != null) {
                 gl.glMaterialfv(GL2.GL_FRONT_AND_BACK, GL2.GL_AMBIENT, material.getAmbientColor(), 0);
@@ -1111,8 +1221,8 @@ public class GuiFX extends Application {
                 gl.glMaterialf(GL2.GL_FRONT_AND_BACK, GL2.GL_SHININESS, defaultShininess);
             }
             gl.glBegin(GL2.GL_TRIANGLES);
-            if (stlTriangles != null) {
-                for (float[] triangle : stlTriangles) {
+            if (triangles != null) {
+                for (float[] triangle : triangles) {
                     gl.glNormal3f(triangle[0], triangle[1], triangle[2]);
                     gl.glVertex3f(triangle[3], triangle[4], triangle[5]);
                     gl.glVertex3f(triangle[6], triangle[7], triangle[8]);
@@ -1134,7 +1244,7 @@ public class GuiFX extends Application {
                 gl.glEnable(GL2.GL_LIGHTING);
             }
         }
-        public void renderSketch(GL2 gl, GLAutoDrawable drawable) {
+        public void renderSketch(GL2 gl, GLAutoDrawable drawable, ModelSnapshot snapshot) {
             gl.glDisable(GL2.GL_LIGHTING);
             gl.glColor3f(0.0f, 0.0f, 0.0f);
             gl.glMatrixMode(GL2.GL_PROJECTION);
@@ -1156,12 +1266,12 @@ public class GuiFX extends Application {
             gl.glPushMatrix();
             gl.glLoadIdentity();
             gl.glTranslatef(sketch2DPanX, sketch2DPanY, 0.0f);
-            sketch.draw(gl);
+            snapshot.drawSketch(gl);
             if (interactionManager != null && interactionManager.isDrawing()) {
                 renderGhost(gl, drawable);
             }
-            if (textRenderer != null && sketch != null) {
-                renderDimensionText(gl, drawable);
+            if (textRenderer != null) {
+                renderDimensionText(gl, drawable, snapshot);
             }
             renderSelectionHighlights(gl);
             gl.glPopMatrix();
@@ -1170,8 +1280,8 @@ public class GuiFX extends Application {
             gl.glMatrixMode(GL2.GL_MODELVIEW);
             gl.glEnable(GL2.GL_LIGHTING);
         }
-        private void renderDimensionText(GL2 gl, GLAutoDrawable drawable) {
-            List<cad.core.Dimension> dims = sketch.getDimensions();
+        private void renderDimensionText(GL2 gl, GLAutoDrawable drawable, ModelSnapshot snapshot) {
+            List<cad.core.Dimension> dims = snapshot.getDimensions();
             if (dims.isEmpty())
                 return;
             double[] modelview = new double[16];
@@ -1314,15 +1424,16 @@ public class GuiFX extends Application {
                 rayDir[1] /= len;
                 rayDir[2] /= len;
             }
+            ModelSnapshot snapshot = ModelContext.getDefault().snapshot();
             if (edgeSelectionMode) {
-                float[] edge = Geometry.pickEdge(rayOrigin, rayDir);
+                float[] edge = Geometry.pickEdge(snapshot, rayOrigin, rayDir);
                 if (edge != null) {
                     selectedEdge = edge;
                     glCanvas.repaint();
                     Platform.runLater(() -> showFilletDialog(edge));
                 }
             } else {
-                float[] triangle = Geometry.pickFace(rayOrigin, rayDir);
+                float[] triangle = Geometry.pickFace(snapshot, rayOrigin, rayDir);
                 if (triangle != null) {
                     float area = Geometry.calculateTriangleArea(triangle);
                     appendOutput(String.format("Selected Face Area: %.4f sq units", area));
@@ -1331,9 +1442,11 @@ public class GuiFX extends Application {
                 }
             }
         }
+        // Keeps a frozen copy: callers pass the model's live mesh, which the next command rewrites
         public void setStlTriangles(List<float[]> triangles) {
-            stlTriangles = triangles;
-            modelCentroid = calculateStlCentroid(triangles);
+            stlTriangles = triangles == null ? null
+                    : java.util.Collections.unmodifiableList(cad.core.TriangleList.copyOf(triangles));
+            modelCentroid = calculateStlCentroid(stlTriangles);
             setShowSketch(false);
             glCanvas.repaint();
         }
@@ -1380,6 +1493,9 @@ public class GuiFX extends Application {
     private class CanvasMouseListener implements MouseListener {
         @Override
         public void mouseClicked(MouseEvent e) {
+            if (isCanvasEditBlocked()) {
+                return;
+            }
             if (interactionManager != null &&
                     interactionManager.getMode() == SketchInteractionManager.InteractionMode.DIMENSION_TOOL &&
                     glRenderer != null && glRenderer.isShowingSketch()) {
@@ -1397,9 +1513,9 @@ public class GuiFX extends Application {
                     interactionManager.getMode() == SketchInteractionManager.InteractionMode.SKETCH_SPLINE &&
                     glRenderer != null && glRenderer.isShowingSketch()) {
                 float[] worldCoords = getSketchWorldCoordinates(e.getX(), e.getY());
-                interactionManager.handleMouseClick(e, worldCoords[0], worldCoords[1]);
+                edit(() -> interactionManager.handleMouseClick(e, worldCoords[0], worldCoords[1]));
                 if (glCanvas != null)
-                    glCanvas.repaint();
+                    refreshCanvas();
                 return;
             }
             glCanvas.requestFocusInWindow();
@@ -1412,6 +1528,9 @@ public class GuiFX extends Application {
         }
         @Override
         public void mousePressed(MouseEvent e) {
+            if (isCanvasEditBlocked()) {
+                return;
+            }
             if (glRenderer != null && glRenderer.isShowingSketch() &&
                     interactionManager != null &&
                     (interactionManager.getMode() == SketchInteractionManager.InteractionMode.IDLE ||
@@ -1422,8 +1541,8 @@ public class GuiFX extends Application {
                     interactionManager.getMode() != SketchInteractionManager.InteractionMode.IDLE &&
                     interactionManager.getMode() != SketchInteractionManager.InteractionMode.VIEW_ROTATE) {
                 float[] worldCoords = getSketchWorldCoordinates(e.getX(), e.getY());
-                interactionManager.handleMousePress(worldCoords[0], worldCoords[1]);
-                glCanvas.repaint();
+                edit(() -> interactionManager.handleMousePress(worldCoords[0], worldCoords[1]));
+                refreshCanvas();
                 isDragging = false;
                 return;
             }
@@ -1440,12 +1559,15 @@ public class GuiFX extends Application {
         @Override
         public void mouseReleased(MouseEvent e) {
             isDragging = false;
+            if (isCanvasEditBlocked()) {
+                return;
+            }
             if (interactionManager != null &&
                     interactionManager.getMode() != SketchInteractionManager.InteractionMode.IDLE &&
                     interactionManager.getMode() != SketchInteractionManager.InteractionMode.VIEW_ROTATE) {
                 float[] worldCoords = getSketchWorldCoordinates(e.getX(), e.getY());
-                interactionManager.handleMouseRelease(worldCoords[0], worldCoords[1]);
-                glCanvas.repaint();
+                edit(() -> interactionManager.handleMouseRelease(worldCoords[0], worldCoords[1]));
+                refreshCanvas();
             }
         }
         @Override
@@ -1458,10 +1580,13 @@ public class GuiFX extends Application {
     private class CanvasMouseMotionListener implements MouseMotionListener {
         @Override
         public void mouseDragged(MouseEvent e) {
+            if (isCanvasEditBlocked()) {
+                return;
+            }
             if (interactionManager != null && interactionManager.isDrawing()) {
                 float[] worldCoords = getSketchWorldCoordinates(e.getX(), e.getY());
-                interactionManager.handleMouseMove(worldCoords[0], worldCoords[1]);
-                glCanvas.repaint();
+                edit(() -> interactionManager.handleMouseMove(worldCoords[0], worldCoords[1]));
+                refreshCanvas();
                 return;
             }
             if (isDragging) {
@@ -1482,10 +1607,11 @@ public class GuiFX extends Application {
         }
         @Override
         public void mouseMoved(MouseEvent e) {
-            if (interactionManager != null && glRenderer != null && glRenderer.isShowingSketch()) {
+            if (interactionManager != null && glRenderer != null && glRenderer.isShowingSketch()
+                    && !isCanvasEditBlocked()) {
                 float[] worldCoords = getSketchWorldCoordinates(e.getX(), e.getY());
-                interactionManager.handleMouseMove(worldCoords[0], worldCoords[1]);
-                glCanvas.repaint();
+                edit(() -> interactionManager.handleMouseMove(worldCoords[0], worldCoords[1]));
+                refreshCanvas();
             }
         }
     }
@@ -1666,7 +1792,7 @@ public class GuiFX extends Application {
                     break;
             }
             if (viewChanged && glCanvas != null) {
-                glCanvas.repaint();
+                refreshCanvas();
             }
         }
         @Override
@@ -1694,12 +1820,15 @@ public class GuiFX extends Application {
             }
         });
         if (glCanvas != null) {
-            glCanvas.repaint();
+            refreshCanvas();
         }
     }
     private void performUndo() {
+        if (isOperationRunning()) {
+            return;
+        }
         if (commandManager != null && commandManager.canUndo()) {
-            commandManager.undo();
+            ModelContext.getDefault().run(commandManager::undo);
             appendOutput(commandManager.getUndoDescription());
             if (glRenderer != null) {
                 glRenderer.setStlTriangles(cad.core.Geometry.getExtrudedTriangles());
@@ -1710,15 +1839,18 @@ public class GuiFX extends Application {
                 }
             }
             if (glCanvas != null) {
-                glCanvas.repaint();
+                refreshCanvas();
             }
         } else {
             appendOutput("Nothing to undo");
         }
     }
     private void performRedo() {
+        if (isOperationRunning()) {
+            return;
+        }
         if (commandManager != null && commandManager.canRedo()) {
-            commandManager.redo();
+            ModelContext.getDefault().run(commandManager::redo);
             appendOutput(commandManager.getRedoDescription());
             if (glRenderer != null) {
                 glRenderer.setStlTriangles(cad.core.Geometry.getExtrudedTriangles());
@@ -1729,7 +1861,7 @@ public class GuiFX extends Application {
                 }
             }
             if (glCanvas != null) {
-                glCanvas.repaint();
+                refreshCanvas();
             }
         } else {
             appendOutput("Nothing to redo");
@@ -1756,7 +1888,7 @@ public class GuiFX extends Application {
             }
         });
         if (glCanvas != null) {
-            glCanvas.repaint();
+            refreshCanvas();
         }
     }
     private void handleDimensionClick(float worldX, float worldY) {
@@ -1769,12 +1901,12 @@ public class GuiFX extends Application {
             cad.core.Dimension dim = sketch.createDimensionFor(entity, worldX, worldY);
             if (dim != null) {
                 if (commandManager != null) {
-                    commandManager.executeCommand(new cad.core.AddDimensionCommand(sketch, dim));
+                    execute(new cad.core.AddDimensionCommand(sketch, dim));
                 } else {
-                    sketch.addDimension(dim);
+                    edit(() -> sketch.addDimension(dim));
                 }
                 appendOutput("Dimension added: " + dim.getLabel());
-                glCanvas.repaint();
+                refreshCanvas();
             } else {
                 appendOutput("Could not create dimension for this entity type");
             }
@@ -1807,7 +1939,7 @@ public class GuiFX extends Application {
         }
         zoom = -50.0f;
         if (glCanvas != null) {
-            glCanvas.repaint();
+            refreshCanvas();
         }
     }
     public void toggleSketchView() {
@@ -1825,7 +1957,7 @@ public class GuiFX extends Application {
                 appendOutput("Switched to 3D model view - Use arrow keys to rotate, Q/E to zoom");
             }
             if (glCanvas != null) {
-                glCanvas.repaint();
+                refreshCanvas();
             }
         }
     }
@@ -1853,7 +1985,7 @@ public class GuiFX extends Application {
             zoom = -5.0f;
         }
         if (glCanvas != null) {
-            glCanvas.repaint();
+            refreshCanvas();
         }
     }
     private void showKeyboardHelp() {
@@ -1979,21 +2111,25 @@ public class GuiFX extends Application {
             String lowerPath = path.toLowerCase();
             try {
                 if (lowerPath.endsWith(".stl")) {
-                    List<float[]> triangles = Geometry.loadStl(path);
-                    if (glRenderer != null)
-                        glRenderer.setStlTriangles(triangles);
-                    appendOutput("Loaded STL: " + path);
-                    resetView();
-                    setViewIsometric();
+                    runOperation("STL load", () -> Geometry.loadStl(path), triangles -> {
+                        if (glRenderer != null)
+                            glRenderer.setStlTriangles(triangles);
+                        appendOutput("Loaded STL: " + path);
+                        resetView();
+                        setViewIsometric();
+                    });
                 } else if (lowerPath.endsWith(".dxf")) {
-                    sketch.loadDXF(path);
+                    edit(() -> {
+                        sketch.loadDXF(path);
+                        return null;
+                    });
                     if (glRenderer != null)
                         glRenderer.setShowSketch(true);
                     appendOutput("Loaded DXF: " + path);
                     sketch2DPanX = 0.0f;
                     sketch2DPanY = 0.0f;
                     sketch2DZoom = 1.0f;
-                    glCanvas.repaint();
+                    refreshCanvas();
                 }
             } catch (Exception e) {
                 appendOutput("Error loading file: " + e.getMessage());
@@ -2018,13 +2154,17 @@ public class GuiFX extends Application {
                         setOnAction(e -> {
                             try {
                                 float depth = Float.parseFloat(heightField.getText());
-                                Geometry.extrude(sketch, depth, Geometry.BooleanOp.DIFFERENCE);
-                                sketch.setDirty(true);
-                                glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
-                                glRenderer.setShowSketch(false);
-                                requestViewChange(false);
-                                glCanvas.repaint();
-                                appendOutput("Extruded Cut performed: depth=" + depth);
+                                runOperation("Extruded Cut", () -> {
+                                    Geometry.extrude(sketch, depth, Geometry.BooleanOp.DIFFERENCE);
+                                    return Geometry.getExtrudedTriangles();
+                                }, tris -> {
+                                    sketch.setDirty(true);
+                                    glRenderer.setStlTriangles(tris);
+                                    glRenderer.setShowSketch(false);
+                                    requestViewChange(false);
+                                    refreshCanvas();
+                                    appendOutput("Extruded Cut performed: depth=" + depth);
+                                });
                                 dialog.close();
                             } catch (NumberFormatException ex) {
                                 appendOutput("Invalid depth.");
@@ -2053,13 +2193,17 @@ public class GuiFX extends Application {
                         setOnAction(e -> {
                             try {
                                 float depth = Float.parseFloat(heightField.getText());
-                                Geometry.extrude(sketch, depth, Geometry.BooleanOp.INTERSECTION);
-                                sketch.setDirty(true);
-                                glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
-                                glRenderer.setShowSketch(false);
-                                requestViewChange(false);
-                                glCanvas.repaint();
-                                appendOutput("Intersect performed: depth=" + depth);
+                                runOperation("Intersect", () -> {
+                                    Geometry.extrude(sketch, depth, Geometry.BooleanOp.INTERSECTION);
+                                    return Geometry.getExtrudedTriangles();
+                                }, tris -> {
+                                    sketch.setDirty(true);
+                                    glRenderer.setStlTriangles(tris);
+                                    glRenderer.setShowSketch(false);
+                                    requestViewChange(false);
+                                    refreshCanvas();
+                                    appendOutput("Intersect performed: depth=" + depth);
+                                });
                                 dialog.close();
                             } catch (NumberFormatException ex) {
                                 appendOutput("Invalid depth.");
@@ -2125,15 +2269,17 @@ public class GuiFX extends Application {
                         .direction(dir)
                         .draft(Math.toRadians(angleDeg))
                         .build();
-                cad.topology.BRepBody body = feature.generate();
-                java.util.List<float[]> tris = cad.core.Geometry.convertBodyToTriangles(body);
-                cad.core.Geometry.setExtrudedTriangles(tris);
+                java.util.List<float[]> tris = edit(() -> {
+                    java.util.List<float[]> generated = cad.core.Geometry.convertBodyToTriangles(feature.generate());
+                    cad.core.Geometry.setExtrudedTriangles(generated);
+                    return generated;
+                });
                 if (glRenderer != null) {
                     glRenderer.setStlTriangles(tris);
                     glRenderer.setShowSketch(false);
                 }
                 requestViewChange(false);
-                glCanvas.repaint();
+                refreshCanvas();
                 appendOutput(String.format("Drafted extrusion created (h=%.2f, draft=%.2f°).", height, angleDeg));
             } catch (Exception ex) {
                 appendOutput("Failed to create drafted extrusion: " + ex.getMessage());
@@ -2196,13 +2342,13 @@ public class GuiFX extends Application {
                     pathPoints.add(new cad.core.Sketch.PointEntity(x, y));
                 }
                 path.addPolygon(pathPoints);
-                cad.core.Geometry.sweep(profile, path, false);
+                edit(() -> cad.core.Geometry.sweep(profile, path, false));
                 if (glRenderer != null) {
                     glRenderer.setStlTriangles(cad.core.Geometry.getExtrudedTriangles());
                     glRenderer.setShowSketch(false);
                 }
                 requestViewChange(false);
-                glCanvas.repaint();
+                refreshCanvas();
                 appendOutput(String.format("Wrapped sketch around cylinder (r=%.2f, h=%.2f).", radius, height));
             } catch (Exception ex) {
                 appendOutput("Failed to wrap sketch: " + ex.getMessage());
@@ -2245,13 +2391,13 @@ public class GuiFX extends Application {
                 appendOutput("Shell thickness must be positive.");
                 return;
             }
-            Geometry.shell(thickness.floatValue());
+            edit(() -> Geometry.shell(thickness.floatValue()));
             if (glRenderer != null) {
                 glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
                 glRenderer.setShowSketch(false);
             }
             requestViewChange(false);
-            glCanvas.repaint();
+            refreshCanvas();
             appendOutput("Shell applied with thickness " + thickness + " " + currentUnits.getAbbreviation());
         });
     }
@@ -2265,16 +2411,19 @@ public class GuiFX extends Application {
             appendOutput("Select one or more sketch entities, then click Trim.");
             return;
         }
-        int removedCount = 0;
-        for (Entity entity : selected) {
-            if (sketch.removeEntity(entity)) {
-                removedCount++;
+        int removedCount = edit(() -> {
+            int removed = 0;
+            for (Entity entity : selected) {
+                if (sketch.removeEntity(entity)) {
+                    removed++;
+                }
             }
-        }
+            return removed;
+        });
         interactionManager.clearSelection();
         if (removedCount > 0) {
             appendOutput("Trimmed " + removedCount + " selected entit" + (removedCount == 1 ? "y." : "ies."));
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             appendOutput("No selected entities could be trimmed.");
         }
@@ -2319,67 +2468,70 @@ public class GuiFX extends Application {
                 appendOutput("Offset distance is too small.");
                 return;
             }
-            int created = 0;
-            for (Entity entity : selected) {
-                if (entity instanceof Sketch.Line line) {
-                    float dx = line.getX2() - line.getX1();
-                    float dy = line.getY2() - line.getY1();
-                    float len = (float) Math.sqrt(dx * dx + dy * dy);
-                    if (len < 1e-6f) {
-                        continue;
-                    }
-                    float nx = -dy / len;
-                    float ny = dx / len;
-                    float d = offset.floatValue();
-                    Sketch.Line newLine = new Sketch.Line(
-                            line.getX1() + nx * d, line.getY1() + ny * d,
-                            line.getX2() + nx * d, line.getY2() + ny * d);
-                    sketch.addEntity(newLine);
-                    created++;
-                } else if (entity instanceof Sketch.Circle circle) {
-                    float newRadius = circle.getRadius() + offset.floatValue();
-                    if (newRadius <= 0) {
-                        continue;
-                    }
-                    sketch.addEntity(new Sketch.Circle(circle.getX(), circle.getY(), newRadius));
-                    created++;
-                } else if (entity instanceof Sketch.Polygon polygon) {
-                    List<PointEntity> pts = polygon.getSketchPoints();
-                    if (pts.size() < 3) {
-                        continue;
-                    }
-                    float cx = 0f, cy = 0f;
-                    for (PointEntity p : pts) {
-                        cx += p.getX();
-                        cy += p.getY();
-                    }
-                    cx /= pts.size();
-                    cy /= pts.size();
-                    List<PointEntity> newPts = new java.util.ArrayList<>();
-                    for (PointEntity p : pts) {
-                        float vx = p.getX() - cx;
-                        float vy = p.getY() - cy;
-                        float vlen = (float) Math.sqrt(vx * vx + vy * vy);
-                        if (vlen < 1e-6f) {
-                            newPts.clear();
-                            break;
+            int created = edit(() -> {
+                int count = 0;
+                for (Entity entity : selected) {
+                    if (entity instanceof Sketch.Line line) {
+                        float dx = line.getX2() - line.getX1();
+                        float dy = line.getY2() - line.getY1();
+                        float len = (float) Math.sqrt(dx * dx + dy * dy);
+                        if (len < 1e-6f) {
+                            continue;
                         }
-                        float scale = (vlen + offset.floatValue()) / vlen;
-                        if (scale <= 0) {
-                            newPts.clear();
-                            break;
+                        float nx = -dy / len;
+                        float ny = dx / len;
+                        float d = offset.floatValue();
+                        Sketch.Line newLine = new Sketch.Line(
+                                line.getX1() + nx * d, line.getY1() + ny * d,
+                                line.getX2() + nx * d, line.getY2() + ny * d);
+                        sketch.addEntity(newLine);
+                        count++;
+                    } else if (entity instanceof Sketch.Circle circle) {
+                        float newRadius = circle.getRadius() + offset.floatValue();
+                        if (newRadius <= 0) {
+                            continue;
+                        }
+                        sketch.addEntity(new Sketch.Circle(circle.getX(), circle.getY(), newRadius));
+                        count++;
+                    } else if (entity instanceof Sketch.Polygon polygon) {
+                        List<PointEntity> pts = polygon.getSketchPoints();
+                        if (pts.size() < 3) {
+                            continue;
+                        }
+                        float cx = 0f, cy = 0f;
+                        for (PointEntity p : pts) {
+                            cx += p.getX();
+                            cy += p.getY();
+                        }
+                        cx /= pts.size();
+                        cy /= pts.size();
+                        List<PointEntity> newPts = new java.util.ArrayList<>();
+                        for (PointEntity p : pts) {
+                            float vx = p.getX() - cx;
+                            float vy = p.getY() - cy;
+                            float vlen = (float) Math.sqrt(vx * vx + vy * vy);
+                            if (vlen < 1e-6f) {
+                                newPts.clear();
+                                break;
+                            }
+                            float scale = (vlen + offset.floatValue()) / vlen;
+                            if (scale <= 0) {
+                                newPts.clear();
+                                break;
+                            }
+                            newPts.add(new PointEntity(cx + vx * scale, cy + vy * scale));
+                        }
+                        if (newPts.size() == pts.size()) {
+                            sketch.addEntity(new Sketch.Polygon(newPts));
+                            count++;
                         }
-                        newPts.add(new PointEntity(cx + vx * scale, cy + vy * scale));
-                    }
-                    if (newPts.size() == pts.size()) {
-                        sketch.addEntity(new Sketch.Polygon(newPts));
-                        created++;
                     }
                 }
-            }
+                return count;
+            });
             if (created > 0) {
                 appendOutput("Offset created " + created + " new entit" + (created == 1 ? "y." : "ies."));
-                glCanvas.repaint();
+                refreshCanvas();
             } else {
                 appendOutput("Offset could not create new entities from the current selection.");
             }
@@ -2419,22 +2571,25 @@ public class GuiFX extends Application {
                     appendOutput("Error: Extrusion height must be greater than 0.");
                     return;
                 }
-                commandManager.executeCommand(new cad.core.CreateExtrudeCommand(sketch, (float) height));
-                sketch.setDirty(true);
-                List<float[]> extrudedTriangles = cad.core.Geometry.getExtrudedTriangles();
-                if (extrudedTriangles != null && !extrudedTriangles.isEmpty()) {
-                    glRenderer.setStlTriangles(extrudedTriangles);
-                    appendOutput("Successfully extruded sketch with height " + height);
-                    appendOutput("Generated " + extrudedTriangles.size() + " triangles from extrusion.");
-                    appendOutput("Switching to 3D view to show extruded geometry.");
-                    requestViewChange(false);
-                    resetView();
-                    glCanvas.repaint();
-                    glCanvas.requestFocusInWindow();
-                } else {
-                    appendOutput("Warning: No extrudable geometry found in sketch.");
-                    appendOutput("Tip: Create polygons or circles to extrude into 3D shapes.");
-                }
+                runOperation("Extrude", () -> {
+                    commandManager.executeCommand(new cad.core.CreateExtrudeCommand(sketch, (float) height));
+                    return cad.core.Geometry.getExtrudedTriangles();
+                }, extrudedTriangles -> {
+                    sketch.setDirty(true);
+                    if (extrudedTriangles != null && !extrudedTriangles.isEmpty()) {
+                        glRenderer.setStlTriangles(extrudedTriangles);
+                        appendOutput("Successfully extruded sketch with height " + height);
+                        appendOutput("Generated " + extrudedTriangles.size() + " triangles from extrusion.");
+                        appendOutput("Switching to 3D view to show extruded geometry.");
+                        requestViewChange(false);
+                        resetView();
+                        refreshCanvas();
+                        glCanvas.requestFocusInWindow();
+                    } else {
+                        appendOutput("Warning: No extrudable geometry found in sketch.");
+                        appendOutput("Tip: Create polygons or circles to extrude into 3D shapes.");
+                    }
+                });
                 extrudeDialog.close();
             } catch (NumberFormatException ex) {
                 appendOutput("Error: Invalid height value. Please enter a valid number.");
@@ -2481,9 +2636,9 @@ public class GuiFX extends Application {
                 float v = Float.parseFloat(vField.getText());
                 float h = Float.parseFloat(hField.getText());
                 float a = Float.parseFloat(angleField.getText());
-                sketch.addKite(cx, cy, v, h, a);
+                edit(() -> sketch.addKite(cx, cy, v, h, a));
                 appendOutput("Kite created at (" + cx + "," + cy + ")");
-                glCanvas.repaint();
+                refreshCanvas();
                 dialog.close();
             } catch (NumberFormatException ex) {
                 appendOutput("Invalid number format for Kite");
@@ -2524,14 +2679,15 @@ public class GuiFX extends Application {
                                     boolOp = Geometry.BooleanOp.DIFFERENCE;
                                 else if (op.startsWith("Intersect"))
                                     boolOp = Geometry.BooleanOp.INTERSECTION;
-                                Geometry.createCube(size, divs, boolOp);
+                                Geometry.BooleanOp cubeOp = boolOp;
+                                edit(() -> Geometry.createCube(size, divs, cubeOp));
                                 if (sketch != null)
                                     sketch.setDirty(true);
                                 appendOutput("Cube created: size=" + size + ", op=" + op);
                                 glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
                                 requestViewChange(false);
                                 resetView();
-                                glCanvas.repaint();
+                                refreshCanvas();
                                 dialog.close();
                             } catch (Exception ex) {
                                 appendOutput("Invalid input for Cube");
@@ -2564,14 +2720,14 @@ public class GuiFX extends Application {
                                 int lon = Integer.parseInt(lonField.getText());
                                 sphereLatDiv = lat;
                                 sphereLonDiv = lon;
-                                Geometry.createSphere(r, lat, lon);
+                                edit(() -> Geometry.createSphere(r, lat, lon));
                                 if (sketch != null)
                                     sketch.setDirty(true);
                                 appendOutput("Sphere created: r=" + r + ", lat=" + lat + ", lon=" + lon);
                                 glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
                                 requestViewChange(false);
                                 resetView();
-                                glCanvas.repaint();
+                                refreshCanvas();
                                 dialog.close();
                             } catch (Exception ex) {
                                 appendOutput("Invalid input for Sphere");
@@ -2693,7 +2849,7 @@ public class GuiFX extends Application {
                 requestViewChange(true);
                 resetView();
             }
-            glCanvas.repaint();
+            refreshCanvas();
         });
         nacaDialog.show();
     }
@@ -2725,17 +2881,18 @@ public class GuiFX extends Application {
                                 String axisName = axisBox.getValue().substring(0, 1);
                                 
                                 cad.core.CreateRevolveCommand cmd = new cad.core.CreateRevolveCommand(sketch, axisName, angle, 36);
-                                commandManager.executeCommand(cmd);
-                                
-                                java.util.List<float[]> tris = cad.core.Geometry.getExtrudedTriangles();
-                                
-                                if (sketch != null)
-                                    sketch.setDirty(true);
-                                appendOutput("Revolved sketch " + angle + " degrees around " + axisName + "-Axis (B-Rep via Command)");
-                                glRenderer.setStlTriangles(tris);
-                                glRenderer.setShowSketch(false);
-                                requestViewChange(false);
-                                glCanvas.repaint();
+                                runOperation("Revolve", () -> {
+                                    commandManager.executeCommand(cmd);
+                                    return cad.core.Geometry.getExtrudedTriangles();
+                                }, tris -> {
+                                    if (sketch != null)
+                                        sketch.setDirty(true);
+                                    appendOutput("Revolved sketch " + angle + " degrees around " + axisName + "-Axis (B-Rep via Command)");
+                                    glRenderer.setStlTriangles(tris);
+                                    glRenderer.setShowSketch(false);
+                                    requestViewChange(false);
+                                    refreshCanvas();
+                                });
                                 dialog.close();
                             } catch (Exception ex) {
                                 appendOutput("Error revolving: " + ex.getMessage());
@@ -2759,14 +2916,18 @@ public class GuiFX extends Application {
                     {
                         setOnAction(e -> {
                             try {
-                                Geometry.sweep(sketch, Geometry.BooleanOp.UNION);
-                                if (sketch != null)
-                                    sketch.setDirty(true);
                                 appendOutput("Sweep operation initiated.");
-                                glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
-                                glRenderer.setShowSketch(false);
-                                resetView();
-                                glCanvas.repaint();
+                                runOperation("Sweep", () -> {
+                                    Geometry.sweep(sketch, Geometry.BooleanOp.UNION);
+                                    return Geometry.getExtrudedTriangles();
+                                }, tris -> {
+                                    if (sketch != null)
+                                        sketch.setDirty(true);
+                                    glRenderer.setStlTriangles(tris);
+                                    glRenderer.setShowSketch(false);
+                                    resetView();
+                                    refreshCanvas();
+                                });
                                 dialog.close();
                             } catch (Exception ex) {
                                 appendOutput("Error sweeping: " + ex.getMessage());
@@ -2790,14 +2951,18 @@ public class GuiFX extends Application {
                     {
                         setOnAction(e -> {
                             try {
-                                Geometry.loft(sketch, Geometry.BooleanOp.UNION);
-                                if (sketch != null)
-                                    sketch.setDirty(true);
                                 appendOutput("Loft operation initiated.");
-                                glRenderer.setStlTriangles(Geometry.getExtrudedTriangles());
-                                glRenderer.setShowSketch(false);
-                                resetView();
-                                glCanvas.repaint();
+                                runOperation("Loft", () -> {
+                                    Geometry.loft(sketch, Geometry.BooleanOp.UNION);
+                                    return Geometry.getExtrudedTriangles();
+                                }, tris -> {
+                                    if (sketch != null)
+                                        sketch.setDirty(true);
+                                    glRenderer.setStlTriangles(tris);
+                                    glRenderer.setShowSketch(false);
+                                    resetView();
+                                    refreshCanvas();
+                                });
                                 dialog.close();
                             } catch (Exception ex) {
                                 appendOutput("Error lofting: " + ex.getMessage());
@@ -2837,14 +3002,14 @@ public class GuiFX extends Application {
         if (glRenderer != null) {
             boolean newState = !glRenderer.isShowingCentroid();
             glRenderer.setShowCentroid(newState);
-            glCanvas.repaint();
+            refreshCanvas();
             appendOutput(newState ? "Centroid display enabled" : "Centroid display disabled");
         }
     }
     private void showMaterialDatabaseDialog() {
         MaterialDatabaseDialog dialog = new MaterialDatabaseDialog(sketch, () -> {
             if (glCanvas != null) {
-                glCanvas.repaint();
+                refreshCanvas();
             }
         }, this::appendOutput);
         dialog.showAndWait();
@@ -2861,19 +3026,19 @@ public class GuiFX extends Application {
         if (selected.size() == 1 && selected.get(0) instanceof Line) {
             Line line = (Line) selected.get(0);
             Constraint c = new HorizontalConstraint(line.getStartPoint(), line.getEndPoint());
-            commandManager.executeCommand(new AddConstraintCommand(sketch, c));
+            execute(new AddConstraintCommand(sketch, c));
             appendOutput("Applied Horizontal Constraint to Line.");
             interactionManager.clearSelection();
-            glCanvas.repaint();
+            refreshCanvas();
         } else if (selected.size() == 2 && selected.get(0) instanceof PointEntity
                 && selected.get(1) instanceof PointEntity) {
             PointEntity p1 = (PointEntity) selected.get(0);
             PointEntity p2 = (PointEntity) selected.get(1);
             Constraint c = new HorizontalConstraint(p1.getPoint(), p2.getPoint());
-            commandManager.executeCommand(new AddConstraintCommand(sketch, c));
+            execute(new AddConstraintCommand(sketch, c));
             appendOutput("Applied Horizontal Constraint to Points.");
             interactionManager.clearSelection();
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             interactionManager.clearSelection();
             interactionManager.setMode(SketchInteractionManager.InteractionMode.SELECT);
@@ -2896,19 +3061,19 @@ public class GuiFX extends Application {
         if (selected.size() == 1 && selected.get(0) instanceof Line) {
             Line line = (Line) selected.get(0);
             Constraint c = new VerticalConstraint(line.getStartPoint(), line.getEndPoint());
-            commandManager.executeCommand(new AddConstraintCommand(sketch, c));
+            execute(new AddConstraintCommand(sketch, c));
             appendOutput("Applied Vertical Constraint to Line.");
             interactionManager.clearSelection();
-            glCanvas.repaint();
+            refreshCanvas();
         } else if (selected.size() == 2 && selected.get(0) instanceof PointEntity
                 && selected.get(1) instanceof PointEntity) {
             PointEntity p1 = (PointEntity) selected.get(0);
             PointEntity p2 = (PointEntity) selected.get(1);
             Constraint c = new VerticalConstraint(p1.getPoint(), p2.getPoint());
-            commandManager.executeCommand(new AddConstraintCommand(sketch, c));
+            execute(new AddConstraintCommand(sketch, c));
             appendOutput("Applied Vertical Constraint to Points.");
             interactionManager.clearSelection();
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             interactionManager.clearSelection();
             interactionManager.setMode(SketchInteractionManager.InteractionMode.SELECT);
@@ -2933,7 +3098,7 @@ public class GuiFX extends Application {
                 Entity e1 = selected.get(i);
                 Entity e2 = selected.get(i + 1);
                 Constraint c = new CoincidentConstraint(e1, e2);
-                commandManager.executeCommand(new AddConstraintCommand(sketch, c));
+                execute(new AddConstraintCommand(sketch, c));
             }
             if (selected.size() == 2) {
                 appendOutput("Applied Coincident Constraint to 2 entities.");
@@ -2941,7 +3106,7 @@ public class GuiFX extends Application {
                 appendOutput("Applied Coincident Constraint to " + selected.size() + " entities.");
             }
             interactionManager.clearSelection();
-            glCanvas.repaint();
+            refreshCanvas();
         } else {
             interactionManager.clearSelection();
             interactionManager.setMode(SketchInteractionManager.InteractionMode.SELECT);
@@ -2968,14 +3133,14 @@ public class GuiFX extends Application {
                 if (e instanceof PointEntity) {
                     PointEntity p = (PointEntity) e;
                     Constraint c = new FixedConstraint(p.getPoint());
-                    commandManager.executeCommand(new AddConstraintCommand(sketch, c));
+                    execute(new AddConstraintCommand(sketch, c));
                     count++;
                 }
             }
             if (count > 0) {
                 appendOutput("Fixed " + count + " points.");
                 interactionManager.clearSelection();
-                glCanvas.repaint();
+                refreshCanvas();
             } else {
                 interactionManager.clearSelection();
                 interactionManager.setMode(SketchInteractionManager.InteractionMode.SELECT);
@@ -3096,6 +3261,9 @@ public class GuiFX extends Application {
         launch(args);
     }
     private void showRunMacroMenu() {
+        if (isOperationRunning()) {
+            return;
+        }
         Alert alert = new Alert(Alert.AlertType.CONFIRMATION);
         alert.setTitle("Run Macro");
         alert.setHeaderText("Choose macro source");
@@ -3122,7 +3290,7 @@ public class GuiFX extends Application {
             sketch2DPanY = 0;
             sketch2DZoom = 1.0f;
             if (glCanvas != null)
-                glCanvas.repaint();
+                refreshCanvas();
             return;
         }
         float minX = Float.MAX_VALUE;
@@ -3180,7 +3348,7 @@ public class GuiFX extends Application {
         if (sketch2DZoom > 50.0f)
             sketch2DZoom = 50.0f;
         if (glCanvas != null) {
-            javax.swing.SwingUtilities.invokeLater(() -> glCanvas.repaint());
+            javax.swing.SwingUtilities.invokeLater(() -> refreshCanvas());
         }
         appendOutput(String.format("Fit view to sketch bounds: [%.1f, %.1f] x [%.1f, %.1f]", minX, maxX, minY, maxY));
     }
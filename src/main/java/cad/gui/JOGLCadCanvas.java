@@ -5,6 +5,8 @@ import com.jogamp.opengl.awt.GLJPanel;
 import com.jogamp.opengl.glu.GLU;
 
 import cad.core.Geometry;
+import cad.core.ModelContext;
+import cad.core.ModelSnapshot;
 import cad.core.Sketch;
 
 import java.awt.event.MouseEvent;
@@ -13,7 +15,7 @@ import java.awt.event.MouseAdapter;
 import java.awt.event.KeyEvent;
 import java.awt.event.KeyAdapter;
 import javax.swing.SwingUtilities;
-import java.io.IOException;
+import java.util.List;
 
 public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
 
@@ -31,6 +33,8 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
 
     private VBOManager vboManager = new VBOManager();
     private boolean vboDirty = true;
+    // Faces list of the snapshot last uploaded; a publish with changed faces carries a new list
+    private List<Sketch.Face3D> uploadedFaces;
 
     public JOGLCadCanvas(Sketch sketch) {
 
@@ -123,14 +127,14 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
 
     public void setCube(float size, int divisions) {
 
-        Geometry.createCube(size, divisions);
+        ModelContext.current().update(() -> Geometry.createCube(size, divisions));
 
         show3DModel();
     }
 
     public void setSphere(float radius, int latDiv, int lonDiv) {
 
-        Geometry.createSphere(radius, latDiv);
+        ModelContext.current().update(() -> Geometry.createSphere(radius, latDiv));
 
         show3DModel();
     }
@@ -138,7 +142,7 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
     public void loadSTL(String filePath) {
         try {
 
-            Geometry.loadStl(filePath);
+            ModelContext.current().update(() -> Geometry.loadStl(filePath));
             System.out.println("Loaded STL triangles: " + Geometry.getLoadedStlTriangles().size());
             System.out.println("Current shape after loading: " + Geometry.getCurrentShape());
             System.out.println("Show3DModel flag: " + show3DModel);
@@ -146,8 +150,8 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
             show3DModel();
 
             repaint();
-        } catch (IOException e) {
-
+        } catch (RuntimeException e) {
+            // ModelContext.update wraps the IOException
             System.err.println("Error loading STL file: " + e.getMessage());
             e.printStackTrace();
 
@@ -226,19 +230,21 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
     @Override
     public void display(GLAutoDrawable drawable) {
         GL2 gl = drawable.getGL().getGL2();
+        ModelSnapshot snapshot = ModelContext.getDefault().snapshot();
+        List<Sketch.Face3D> faces = snapshot.getExtrudedFaces();
 
         gl.glClear(GL2.GL_COLOR_BUFFER_BIT | GL2.GL_DEPTH_BUFFER_BIT);
         gl.glLoadIdentity();
 
         if (show3DModel) {
             float distance = -zoomZ;
-            if (sketch != null && !sketch.extrudedFaces.isEmpty()) {
-                float geometrySize = calculateGeometrySize();
+            if (!faces.isEmpty()) {
+                float geometrySize = calculateGeometrySize(faces);
                 float minDistance = geometrySize * 3.0f;
                 if (distance < minDistance)
                     distance = minDistance;
             }
-            float[] geometryCenter = calculateGeometryCenter();
+            float[] geometryCenter = calculateGeometryCenter(faces);
             float centerX = geometryCenter[0];
             float centerY = geometryCenter[1];
             float centerZ = geometryCenter[2];
@@ -266,16 +272,19 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
             float[] objectColor = { 0.6f, 0.7f, 0.9f, 1.0f };
             gl.glMaterialfv(GL2.GL_FRONT, GL2.GL_AMBIENT_AND_DIFFUSE, objectColor, 0);
 
-            if (sketch != null && !sketch.extrudedFaces.isEmpty()) {
-                if (vboDirty) {
+            if (!faces.isEmpty()) {
+                if (vboDirty || faces != uploadedFaces) {
 
-                    sketch.computePerVertexNormals();
-                    vboManager.uploadFaces(gl, glu, sketch.extrudedFaces);
+                    if (sketch != null) {
+                        sketch.computePerVertexNormals();
+                    }
+                    vboManager.uploadFaces(gl, glu, faces);
+                    uploadedFaces = faces;
                     vboDirty = false;
                 }
                 vboManager.draw(gl);
             } else {
-                Geometry.drawCurrentShape(gl);
+                Geometry.drawShape(gl, snapshot);
             }
         } else {
 
@@ -286,10 +295,7 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
             gl.glColor3f(0.2f, 0.2f, 0.8f);
             gl.glLineWidth(2.0f);
 
-            if (sketch != null) {
-
-                sketch.draw(gl);
-            }
+            snapshot.drawSketch(gl);
             gl.glEnable(GL2.GL_LIGHTING);
 
             gl.glEnable(GL2.GL_DEPTH_TEST);
@@ -300,15 +306,15 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
 
     }
 
-    private float[] calculateGeometryCenter() {
+    private float[] calculateGeometryCenter(List<Sketch.Face3D> faces) {
 
-        if (sketch != null && !sketch.extrudedFaces.isEmpty()) {
+        if (!faces.isEmpty()) {
             float totalX = 0.0f;
             float totalY = 0.0f;
             float totalZ = 0.0f;
             int vertexCount = 0;
 
-            for (Sketch.Face3D face : sketch.extrudedFaces) {
+            for (Sketch.Face3D face : faces) {
                 for (Sketch.Point3D vertex : face.getVertices()) {
                     totalX += vertex.getX();
                     totalY += vertex.getY();
@@ -329,13 +335,13 @@ public class JOGLCadCanvas extends GLJPanel implements GLEventListener {
         return new float[] { 0.0f, 0.0f, 0.0f };
     }
 
-    private float calculateGeometrySize() {
-        if (sketch != null && !sketch.extrudedFaces.isEmpty()) {
+    private float calculateGeometrySize(List<Sketch.Face3D> faces) {
+        if (!faces.isEmpty()) {
             float minX = Float.MAX_VALUE, maxX = Float.MIN_VALUE;
             float minY = Float.MAX_VALUE, maxY = Float.MIN_VALUE;
             float minZ = Float.MAX_VALUE, maxZ = Float.MIN_VALUE;
 
-            for (Sketch.Face3D face : sketch.extrudedFaces) {
+            for (Sketch.Face3D face : faces) {
                 for (Sketch.Point3D vertex : face.getVertices()) {
                     float x = vertex.getX();
                     float y = vertex.getY();
@@ -1,8 +1,10 @@
 package cad.gui;
 
+import cad.core.MacroProgram;
 import cad.core.MacroRecorder;
 import cad.core.Sketch;
-import cad.core.Geometry;
+import cad.core.ModelContext;
+import javafx.application.Platform;
 import javafx.stage.FileChooser;
 import javafx.stage.Stage;
 import javafx.scene.control.Alert;
@@ -13,21 +15,33 @@ import java.io.File;
 import java.io.IOException;
 import java.util.List;
 import java.util.Optional;
+import java.util.concurrent.atomic.AtomicBoolean;
 
 public class MacroManager {
 
     private final MacroRecorder recorder;
     private final Sketch sketch;
+    private final ModelContext context;
     private final Stage primaryStage;
     private Runnable canvasRefresh;
     private java.util.function.Consumer<String> outputCallback;
     private Runnable viewModeCallback;
     private Runnable fitViewCallback;
     private java.util.function.Consumer<List<float[]>> stlUpdateCallback;
+    private MacroProgram.ProgressListener progressCallback;
+    private java.util.function.Consumer<Boolean> playbackCallback;
+    private final AtomicBoolean cancelRequested = new AtomicBoolean();
+    private volatile Thread playback;
 
     public MacroManager(Sketch sketch, Stage primaryStage) {
+        this(sketch, ModelContext.getDefault(), primaryStage);
+    }
+
+    // Macros replay against the given context, so several documents can run macros side by side
+    public MacroManager(Sketch sketch, ModelContext context, Stage primaryStage) {
         this.recorder = new MacroRecorder();
         this.sketch = sketch;
+        this.context = context;
         this.primaryStage = primaryStage;
         this.canvasRefresh = null;
         this.outputCallback = null;
@@ -56,6 +70,31 @@ public class MacroManager {
         this.stlUpdateCallback = stlUpdateCallback;
     }
 
+    // Called on the FX thread about once a second while a macro plays; progress is logged when unset
+    public void setProgressCallback(MacroProgram.ProgressListener progressCallback) {
+        this.progressCallback = progressCallback;
+    }
+
+    // Called on the FX thread with true when playback starts and false when it stops. The GUI locks
+    // out modelling in between so that its edits cannot interleave with the macro's steps.
+    public void setPlaybackCallback(java.util.function.Consumer<Boolean> playbackCallback) {
+        this.playbackCallback = playbackCallback;
+    }
+
+    public boolean isMacroRunning() {
+        return playback != null;
+    }
+
+    // Stops playback after the step in progress; the steps already run stay applied
+    public void cancelMacro() {
+        if (playback == null) {
+            showWarning("No Macro Running", "There is no macro playing.");
+            return;
+        }
+        cancelRequested.set(true);
+        log("Cancelling macro...");
+    }
+
     public void uploadAndRunMacro() {
         FileChooser fileChooser = new FileChooser();
         fileChooser.setTitle("Upload Macro File");
@@ -144,30 +183,59 @@ public class MacroManager {
         }
     }
 
+    // Compiles the macro once, then plays it on a worker thread with a single view refresh at the end
     private void executeMacro(List<MacroRecorder.MacroCommand> commands, String macroName) {
-        int failCount = 0;
+        if (playback != null) {
+            showWarning("Macro Running", "Wait for the current macro to finish or cancel it first.");
+            return;
+        }
+
+        MacroProgram program = MacroProgram.compile(commands);
+        program.setProgressIntervalMillis(1000);
 
         if (viewModeCallback != null) {
             viewModeCallback.run();
         }
 
-        log("Executing macro: " + macroName);
+        log("Executing macro: " + macroName + " (" + program.size() + " steps)");
+        for (String error : program.getCompileErrors()) {
+            log("    ✗ ERROR: " + error);
+        }
 
-        for (int i = 0; i < commands.size(); i++) {
-            MacroRecorder.MacroCommand cmd = commands.get(i);
-            log("  [" + (i + 1) + "/" + commands.size() + "] " + cmd.action);
+        MacroProgram.ProgressListener progress = (done, total) -> Platform.runLater(() -> {
+            if (progressCallback != null) {
+                progressCallback.onProgress(done, total);
+            } else {
+                log("  [" + done + "/" + total + "]");
+            }
+        });
 
-            try {
-                executeCommand(cmd);
+        cancelRequested.set(false);
+        Thread worker = new Thread(() -> {
+            MacroProgram.Result result = program.run(context, sketch, progress, cancelRequested);
+            Platform.runLater(() -> finishMacro(macroName, program, result));
+        }, "macro-" + macroName);
+        worker.setDaemon(true);
+        playback = worker;
+        if (playbackCallback != null) {
+            playbackCallback.accept(true);
+        }
+        worker.start();
+    }
 
-                log("    ✓ Success");
+    private void finishMacro(String macroName, MacroProgram program, MacroProgram.Result result) {
+        playback = null;
+        if (playbackCallback != null) {
+            playbackCallback.accept(false);
+        }
+        for (String error : result.getErrors()) {
+            log("    ✗ ERROR: " + error);
+        }
 
-                if (canvasRefresh != null) {
-                    canvasRefresh.run();
-                }
-            } catch (Exception e) {
-                log("    ✗ ERROR: " + e.getMessage());
-                failCount++;
+        if (result.isMeshChanged() && stlUpdateCallback != null) {
+            List<float[]> triangles = context.call(sketch::getExtrudedTriangles);
+            if (triangles != null) {
+                stlUpdateCallback.accept(triangles);
             }
         }
 
@@ -179,105 +247,14 @@ public class MacroManager {
             fitViewCallback.run();
         }
 
-        if (failCount == 0) {
-            log(macroName + " execution completed successfully.");
+        int failCount = program.getCompileErrors().size() + result.getErrors().size();
+        long millis = result.getElapsedNanos() / 1_000_000;
+        if (result.isCancelled()) {
+            log(macroName + " cancelled after " + result.getExecuted() + " of " + result.getTotal() + " steps.");
+        } else if (failCount == 0) {
+            log(macroName + " execution completed successfully in " + millis + " ms.");
         } else {
-            log(macroName + " completed with " + failCount + " errors.");
-        }
-    }
-
-    private void executeCommand(MacroRecorder.MacroCommand cmd) throws Exception {
-        switch (cmd.action) {
-            case SET_UNITS:
-
-                break;
-
-            case CLEAR_SKETCH:
-
-                sketch.clearSketch();
-                break;
-
-            case CLEAR_ALL:
-                sketch.clearAll();
-                break;
-
-            case SKETCH_POINT:
-                float px = Float.parseFloat((String) cmd.parameters.get("x"));
-                float py = Float.parseFloat((String) cmd.parameters.get("y"));
-                sketch.addPoint(px, py);
-                break;
-
-            case SKETCH_LINE:
-                float x1 = Float.parseFloat((String) cmd.parameters.get("x1"));
-                float y1 = Float.parseFloat((String) cmd.parameters.get("y1"));
-                float x2 = Float.parseFloat((String) cmd.parameters.get("x2"));
-                float y2 = Float.parseFloat((String) cmd.parameters.get("y2"));
-                sketch.addLine(x1, y1, x2, y2);
-                break;
-
-            case SKETCH_CIRCLE:
-                float cx = Float.parseFloat((String) cmd.parameters.get("x"));
-                float cy = Float.parseFloat((String) cmd.parameters.get("y"));
-                float radius = Float.parseFloat((String) cmd.parameters.get("radius"));
-                sketch.addCircle(cx, cy, radius);
-                break;
-
-            case SKETCH_POLYGON:
-                float pcx = Float.parseFloat((String) cmd.parameters.get("centerX"));
-                float pcy = Float.parseFloat((String) cmd.parameters.get("centerY"));
-                float prad = Float.parseFloat((String) cmd.parameters.get("radius"));
-                int sides = Integer.parseInt((String) cmd.parameters.get("sides"));
-                sketch.addNSidedPolygon(pcx, pcy, prad, sides);
-                break;
-
-            case EXTRUDE:
-                float depth = Float.parseFloat((String) cmd.parameters.get("depth"));
-
-                sketch.extrude(depth);
-
-                List<float[]> extrudedTriangles = sketch.getExtrudedTriangles();
-                if (stlUpdateCallback != null && extrudedTriangles != null) {
-                    stlUpdateCallback.accept(extrudedTriangles);
-                }
-                break;
-
-            case SAVE_FILE:
-                String filename = (String) cmd.parameters.get("filename");
-                File file = new File(filename);
-
-                Geometry.saveStl(file.getAbsolutePath());
-                break;
-
-            case SKETCH_NACA:
-                String profile = (String) cmd.parameters.get("profile");
-                float chord = Float.parseFloat((String) cmd.parameters.get("chord"));
-                generateNacaProfile(profile, chord);
-                break;
-
-            case REVOLVE:
-                String axis = (String) cmd.parameters.get("axis");
-                float angle = Float.parseFloat((String) cmd.parameters.get("angle"));
-
-                Geometry.revolve(sketch, axis, angle, Geometry.BooleanOp.UNION);
-
-                List<float[]> revolvedTriangles = sketch.getExtrudedTriangles();
-                if (stlUpdateCallback != null && revolvedTriangles != null) {
-                    stlUpdateCallback.accept(revolvedTriangles);
-                }
-                break;
-
-            default:
-                log("    (Command not implemented: " + cmd.action + ")");
-        }
-    }
-
-    private void generateNacaProfile(String profile, float chord) {
-        try {
-            List<Sketch.PointEntity> points = cad.aerodynamics.NacaAirfoilGenerator.generate(profile, chord, 100);
-            sketch.addPolygon(points);
-            log("    Generated NACA " + profile + " polygon with " + points.size() + " points");
-        } catch (Exception e) {
-            log("Error generating NACA profile: " + e.getMessage());
+            log(macroName + " completed with " + failCount + " errors in " + millis + " ms.");
         }
     }
 
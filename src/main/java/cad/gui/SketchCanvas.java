@@ -205,6 +205,9 @@ public class SketchCanvas extends GLJPanel implements GLEventListener {
             gl.glRotated(Math.toDegrees(rotateY), 0, 1, 0);
             gl.glScaled(zoom, zoom, zoom);
             drawStl(gl);
+        } else if (cad.core.ModelContext.getDefault().getSketch() == sketch) {
+            // The application sketch is drawn from its published snapshot
+            cad.core.ModelContext.getDefault().snapshot().drawSketch(gl);
         } else {
             sketch.draw(gl);
         }
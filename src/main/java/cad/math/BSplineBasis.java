@@ -0,0 +1,140 @@
+package cad.math;
+
+public final class BSplineBasis {
+
+    private BSplineBasis() {
+    }
+
+    // Index of the knot span containing u, where n is the last control point index
+    public static int findSpan(int n, int degree, double u, double[] knots) {
+        if (u >= knots[n + 1]) {
+            return n;
+        }
+        if (u <= knots[degree]) {
+            return degree;
+        }
+        int low = degree;
+        int high = n + 1;
+        int mid = (low + high) >>> 1;
+        while (u < knots[mid] || u >= knots[mid + 1]) {
+            if (u < knots[mid]) {
+                high = mid;
+            } else {
+                low = mid;
+            }
+            mid = (low + high) >>> 1;
+        }
+        return mid;
+    }
+
+    // Non-zero basis functions and their derivatives up to order nDers at u.
+    // Results are left in ws.ders[k][j] for basis index span - degree + j.
+    public static void dersBasisFuns(int span, double u, int degree, int nDers, double[] knots, Workspace ws) {
+        ws.ensure(degree, nDers);
+        double[][] ndu = ws.ndu;
+        double[][] a = ws.a;
+        double[][] ders = ws.ders;
+        double[] left = ws.left;
+        double[] right = ws.right;
+
+        ndu[0][0] = 1.0;
+        for (int j = 1; j <= degree; j++) {
+            left[j] = u - knots[span + 1 - j];
+            right[j] = knots[span + j] - u;
+            double saved = 0.0;
+            for (int r = 0; r < j; r++) {
+                ndu[j][r] = right[r + 1] + left[j - r];
+                double temp = ndu[r][j - 1] / ndu[j][r];
+                ndu[r][j] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            ndu[j][j] = saved;
+        }
+
+        for (int j = 0; j <= degree; j++) {
+            ders[0][j] = ndu[j][degree];
+        }
+
+        int maxOrder = Math.min(nDers, degree);
+        for (int r = 0; r <= degree; r++) {
+            int s1 = 0;
+            int s2 = 1;
+            a[0][0] = 1.0;
+            for (int k = 1; k <= maxOrder; k++) {
+                double d = 0.0;
+                int rk = r - k;
+                int pk = degree - k;
+                if (r >= k) {
+                    a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                    d = a[s2][0] * ndu[rk][pk];
+                }
+                int j1 = rk >= -1 ? 1 : -rk;
+                int j2 = (r - 1 <= pk) ? k - 1 : degree - r;
+                for (int j = j1; j <= j2; j++) {
+                    a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                    d += a[s2][j] * ndu[rk + j][pk];
+                }
+                if (r <= pk) {
+                    a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                    d += a[s2][k] * ndu[r][pk];
+                }
+                ders[k][r] = d;
+                int tmp = s1;
+                s1 = s2;
+                s2 = tmp;
+            }
+        }
+
+        double factor = degree;
+        for (int k = 1; k <= maxOrder; k++) {
+            for (int j = 0; j <= degree; j++) {
+                ders[k][j] *= factor;
+            }
+            factor *= (degree - k);
+        }
+        for (int k = maxOrder + 1; k <= nDers; k++) {
+            for (int j = 0; j <= degree; j++) {
+                ders[k][j] = 0.0;
+            }
+        }
+    }
+
+    public static double binomial(int n, int k) {
+        double result = 1.0;
+        for (int i = 1; i <= k; i++) {
+            result = result * (n - k + i) / i;
+        }
+        return result;
+    }
+
+    // Scratch arrays reused between evaluations; one per thread
+    public static final class Workspace {
+        double[][] ndu = new double[0][0];
+        double[][] a = new double[2][0];
+        public double[][] ders = new double[0][0];
+        double[] left = new double[0];
+        double[] right = new double[0];
+        public double[] homogeneous = new double[0];
+        public double[] point = new double[0];
+
+        private int degree = -1;
+        private int nDers = -1;
+
+        public void ensure(int degree, int nDers) {
+            if (degree <= this.degree && nDers <= this.nDers) {
+                return;
+            }
+            int p = Math.max(degree, this.degree);
+            int d = Math.max(nDers, this.nDers);
+            ndu = new double[p + 1][p + 1];
+            a = new double[2][p + 1];
+            ders = new double[d + 1][p + 1];
+            left = new double[p + 1];
+            right = new double[p + 1];
+            homogeneous = new double[4 * (d + 1)];
+            point = new double[3 * (d + 1)];
+            this.degree = p;
+            this.nDers = d;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+package cad.math;
+
+import java.util.function.DoubleUnaryOperator;
+
+// Five-point Gauss-Legendre quadrature, exact for polynomials up to degree 9
+public final class GaussLegendre {
+    private static final double[] NODES = {
+        -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640
+    };
+    private static final double[] WEIGHTS = {
+        0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891
+    };
+
+    public static final int MAX_DEPTH = 30;
+
+    private GaussLegendre() {
+    }
+
+    public static double integrate5(DoubleUnaryOperator f, double a, double b) {
+        double half = 0.5 * (b - a);
+        double mid = 0.5 * (a + b);
+        double sum = 0.0;
+        for (int i = 0; i < NODES.length; i++) {
+            sum += WEIGHTS[i] * f.applyAsDouble(mid + half * NODES[i]);
+        }
+        return sum * half;
+    }
+
+    // Bisects until the two halves agree with the whole interval to within the absolute tolerance
+    public static double integrate(DoubleUnaryOperator f, double a, double b, double tolerance) {
+        return adaptive(f, a, b, integrate5(f, a, b), tolerance, 0);
+    }
+
+    private static double adaptive(DoubleUnaryOperator f, double a, double b, double whole, double tolerance,
+            int depth) {
+        double m = 0.5 * (a + b);
+        double left = integrate5(f, a, m);
+        double right = integrate5(f, m, b);
+        if (depth >= MAX_DEPTH || Math.abs(left + right - whole) <= tolerance) {
+            return left + right;
+        }
+        return adaptive(f, a, m, left, 0.5 * tolerance, depth + 1)
+                + adaptive(f, m, b, right, 0.5 * tolerance, depth + 1);
+    }
+}
@@ -0,0 +1,143 @@
+package cad.math;
+
+// Scratch vector for inner loops. Operations update this instance in place and return it,
+// so chains like v.set(p).sub(origin).cross(axis) allocate nothing. Convert with toVector3d()
+// before handing a result to code that keeps it.
+public final class MutableVector3d {
+    public double x, y, z;
+
+    public MutableVector3d() {
+    }
+
+    public MutableVector3d(double x, double y, double z) {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+    }
+
+    public MutableVector3d set(double x, double y, double z) {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+        return this;
+    }
+
+    public MutableVector3d set(Vector3d v) {
+        return set(v.x(), v.y(), v.z());
+    }
+
+    public MutableVector3d set(MutableVector3d v) {
+        return set(v.x, v.y, v.z);
+    }
+
+    public MutableVector3d set(double[] xyz, int offset) {
+        return set(xyz[offset], xyz[offset + 1], xyz[offset + 2]);
+    }
+
+    public MutableVector3d add(Vector3d v) {
+        x += v.x();
+        y += v.y();
+        z += v.z();
+        return this;
+    }
+
+    public MutableVector3d add(MutableVector3d v) {
+        x += v.x;
+        y += v.y;
+        z += v.z;
+        return this;
+    }
+
+    public MutableVector3d sub(Vector3d v) {
+        x -= v.x();
+        y -= v.y();
+        z -= v.z();
+        return this;
+    }
+
+    public MutableVector3d sub(MutableVector3d v) {
+        x -= v.x;
+        y -= v.y;
+        z -= v.z;
+        return this;
+    }
+
+    // this += v * s
+    public MutableVector3d addScaled(Vector3d v, double s) {
+        x += v.x() * s;
+        y += v.y() * s;
+        z += v.z() * s;
+        return this;
+    }
+
+    public MutableVector3d scale(double s) {
+        x *= s;
+        y *= s;
+        z *= s;
+        return this;
+    }
+
+    public double dot(Vector3d v) {
+        return x * v.x() + y * v.y() + z * v.z();
+    }
+
+    public double dot(MutableVector3d v) {
+        return x * v.x + y * v.y + z * v.z;
+    }
+
+    // this = this x v
+    public MutableVector3d cross(Vector3d v) {
+        double cx = y * v.z() - z * v.y();
+        double cy = z * v.x() - x * v.z();
+        double cz = x * v.y() - y * v.x();
+        return set(cx, cy, cz);
+    }
+
+    public double magnitudeSquared() {
+        return x * x + y * y + z * z;
+    }
+
+    public double magnitude() {
+        return Math.sqrt(magnitudeSquared());
+    }
+
+    // Leaves a zero vector unchanged, matching Vector3d.normalize()
+    public MutableVector3d normalize() {
+        double m = magnitude();
+        if (m == 0) return this;
+        return scale(1.0 / m);
+    }
+
+    // Rodrigues rotation about a unit axis through the origin
+    public MutableVector3d rotate(Vector3d axis, double cos, double sin) {
+        double ax = axis.x(), ay = axis.y(), az = axis.z();
+        double d = ax * x + ay * y + az * z;
+        double cx = ay * z - az * y;
+        double cy = az * x - ax * z;
+        double cz = ax * y - ay * x;
+        double k = d * (1 - cos);
+        return set(x * cos + cx * sin + ax * k,
+                   y * cos + cy * sin + ay * k,
+                   z * cos + cz * sin + az * k);
+    }
+
+    public double distanceSquared(Vector3d v) {
+        double dx = x - v.x(), dy = y - v.y(), dz = z - v.z();
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    public void store(double[] xyz, int offset) {
+        xyz[offset] = x;
+        xyz[offset + 1] = y;
+        xyz[offset + 2] = z;
+    }
+
+    public Vector3d toVector3d() {
+        return new Vector3d(x, y, z);
+    }
+
+    @Override
+    public String toString() {
+        return String.format("(%.3f, %.3f, %.3f)", x, y, z);
+    }
+}
@@ -73,7 +73,12 @@ public class Vector3d {
     }
     
     public double distance(Vector3d v) {
-        return Math.sqrt(Math.pow(x - v.x, 2) + Math.pow(y - v.y, 2) + Math.pow(z - v.z, 2));
+        return Math.sqrt(distanceSquared(v.x, v.y, v.z));
+    }
+
+    public double distanceSquared(double px, double py, double pz) {
+        double dx = x - px, dy = y - py, dz = z - pz;
+        return dx * dx + dy * dy + dz * dz;
     }
     
     public static Vector3d xyz(double x, double y, double z) {
@@ -0,0 +1,147 @@
+package cad.math;
+
+import java.util.List;
+
+// Batch operations on packed xyz streams: point i occupies [3i, 3i + 2]
+public final class VectorArrays {
+
+    private VectorArrays() {
+    }
+
+    public static double[] pack(List<Vector3d> points) {
+        return pack(points, null);
+    }
+
+    // Reuses buffer when it is large enough
+    public static double[] pack(List<Vector3d> points, double[] buffer) {
+        int n = points.size();
+        double[] xyz = buffer != null && buffer.length >= 3 * n ? buffer : new double[3 * n];
+        for (int i = 0; i < n; i++) {
+            Vector3d p = points.get(i);
+            xyz[3 * i] = p.x();
+            xyz[3 * i + 1] = p.y();
+            xyz[3 * i + 2] = p.z();
+        }
+        return xyz;
+    }
+
+    public static double[] pack(Vector3d[] points) {
+        double[] xyz = new double[3 * points.length];
+        for (int i = 0; i < points.length; i++) {
+            xyz[3 * i] = points[i].x();
+            xyz[3 * i + 1] = points[i].y();
+            xyz[3 * i + 2] = points[i].z();
+        }
+        return xyz;
+    }
+
+    public static Vector3d get(double[] xyz, int index) {
+        int o = 3 * index;
+        return new Vector3d(xyz[o], xyz[o + 1], xyz[o + 2]);
+    }
+
+    public static double dot(double[] a, int i, double[] b, int j) {
+        int o = 3 * i, p = 3 * j;
+        return a[o] * b[p] + a[o + 1] * b[p + 1] + a[o + 2] * b[p + 2];
+    }
+
+    // out[k] = a[i] x b[j]; out may alias either input
+    public static void cross(double[] a, int i, double[] b, int j, double[] out, int k) {
+        int o = 3 * i, p = 3 * j, q = 3 * k;
+        double cx = a[o + 1] * b[p + 2] - a[o + 2] * b[p + 1];
+        double cy = a[o + 2] * b[p] - a[o] * b[p + 2];
+        double cz = a[o] * b[p + 1] - a[o + 1] * b[p];
+        out[q] = cx;
+        out[q + 1] = cy;
+        out[q + 2] = cz;
+    }
+
+    // Normalises count vectors in place; zero vectors are left as they are
+    public static void normalize(double[] xyz, int count) {
+        for (int i = 0; i < count; i++) {
+            int o = 3 * i;
+            double len = Math.sqrt(xyz[o] * xyz[o] + xyz[o + 1] * xyz[o + 1] + xyz[o + 2] * xyz[o + 2]);
+            if (len > 0) {
+                xyz[o] /= len;
+                xyz[o + 1] /= len;
+                xyz[o + 2] /= len;
+            }
+        }
+    }
+
+    public static void translate(double[] src, double[] dst, int count, double dx, double dy, double dz) {
+        for (int i = 0; i < 3 * count; i += 3) {
+            dst[i] = src[i] + dx;
+            dst[i + 1] = src[i + 1] + dy;
+            dst[i + 2] = src[i + 2] + dz;
+        }
+    }
+
+    // Rotates count points about the line through origin along the unit axis; src and dst may alias
+    public static void rotateAboutAxis(double[] src, double[] dst, int count, Vector3d origin, Vector3d axis,
+            double cos, double sin) {
+        double ox = origin.x(), oy = origin.y(), oz = origin.z();
+        double ax = axis.x(), ay = axis.y(), az = axis.z();
+        double k = 1 - cos;
+        for (int i = 0; i < 3 * count; i += 3) {
+            double x = src[i] - ox, y = src[i + 1] - oy, z = src[i + 2] - oz;
+            double d = (ax * x + ay * y + az * z) * k;
+            double cx = ay * z - az * y;
+            double cy = az * x - ax * z;
+            double cz = ax * y - ay * x;
+            dst[i] = ox + x * cos + cx * sin + ax * d;
+            dst[i + 1] = oy + y * cos + cy * sin + ay * d;
+            dst[i + 2] = oz + z * cos + cz * sin + az * d;
+        }
+    }
+
+    public static double distanceSquared(double[] xyz, int index, double x, double y, double z) {
+        int o = 3 * index;
+        double dx = xyz[o] - x, dy = xyz[o + 1] - y, dz = xyz[o + 2] - z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Index of the first of count points within tolerance of (x, y, z), or -1
+    public static int indexOf(double[] xyz, int count, double x, double y, double z, double tolerance) {
+        double tol2 = tolerance * tolerance;
+        for (int i = 0; i < count; i++) {
+            if (distanceSquared(xyz, i, x, y, z) < tol2) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Signed volume of the cone from the origin to a planar polygon, fanned from its first point:
+    // sum of p0 . (pi x pi+1) / 6
+    public static double fanSignedVolume(double[] xyz, int count) {
+        if (count < 3) {
+            return 0.0;
+        }
+        double x0 = xyz[0], y0 = xyz[1], z0 = xyz[2];
+        double volume = 0.0;
+        for (int i = 1; i < count - 1; i++) {
+            int a = 3 * i, b = a + 3;
+            double cx = xyz[a + 1] * xyz[b + 2] - xyz[a + 2] * xyz[b + 1];
+            double cy = xyz[a + 2] * xyz[b] - xyz[a] * xyz[b + 2];
+            double cz = xyz[a] * xyz[b + 1] - xyz[a + 1] * xyz[b];
+            volume += x0 * cx + y0 * cy + z0 * cz;
+        }
+        return volume / 6.0;
+    }
+
+    // Area of a planar polygon fanned from its first point
+    public static double fanArea(double[] xyz, int count) {
+        double area = 0.0;
+        for (int i = 1; i < count - 1; i++) {
+            int a = 3 * i, b = a + 3;
+            double ux = xyz[a] - xyz[0], uy = xyz[a + 1] - xyz[1], uz = xyz[a + 2] - xyz[2];
+            double vx = xyz[b] - xyz[0], vy = xyz[b + 1] - xyz[1], vz = xyz[b + 2] - xyz[2];
+            double cx = uy * vz - uz * vy;
+            double cy = uz * vx - ux * vz;
+            double cz = ux * vy - uy * vx;
+            area += Math.sqrt(cx * cx + cy * cy + cz * cz);
+        }
+        return area / 2.0;
+    }
+}
@@ -1,54 +1,104 @@
 package cad.topology;
 
 import cad.math.Vector3d;
-import java.util.ArrayList;
+import cad.math.VectorArrays;
+import java.util.HashMap;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.function.Function;
 
 public class BRepBody {
-    private List<Face> faces;
-    private List<Edge> edges;
-    private List<Vertex> vertices;
+    private final HalfEdgeTopology topology;
+    private NameIndex<Face> faceNames;
+    private NameIndex<Edge> edgeNames;
+    private NameIndex<Vertex> vertexNames;
 
     public BRepBody() {
-        this.faces = new ArrayList<>();
-        this.edges = new ArrayList<>();
-        this.vertices = new ArrayList<>();
+        this.topology = new HalfEdgeTopology();
     }
 
+    // Adding an element twice is a no-op; membership is by identity. A face also registers its
+    // loop edges (and their vertices) and records itself as adjacent to each of them.
     public void addFace(Face face) {
-        if (!faces.contains(face)) {
-            faces.add(face);
-        }
+        topology.addFace(face);
     }
 
     public void addEdge(Edge edge) {
-        if (!edges.contains(edge)) {
-            edges.add(edge);
-        }
+        topology.addEdge(edge);
     }
 
     public void addVertex(Vertex vertex) {
-        if (!vertices.contains(vertex)) {
-            vertices.add(vertex);
-        }
+        topology.addVertex(vertex);
     }
 
     public List<Face> getFaces() {
-        return faces;
+        return topology.getFaces();
     }
 
     public List<Edge> getEdges() {
-        return edges;
+        return topology.getEdges();
     }
 
     public List<Vertex> getVertices() {
-        return vertices;
+        return topology.getVertices();
+    }
+
+    public HalfEdgeTopology getTopology() {
+        return topology;
+    }
+
+    public List<Face> getFacesOfEdge(Edge edge) {
+        return topology.facesOfEdge(edge);
+    }
+
+    public List<Face> getFacesAroundVertex(Vertex vertex) {
+        return topology.facesAroundVertex(vertex);
+    }
+
+    public List<Face> getAdjacentFaces(Face face) {
+        return topology.adjacentFaces(face);
+    }
+
+    // Exact lookups by persistent name; null when no element carries it
+    public Face findFace(TopologicalName name) {
+        faceNames = NameIndex.refresh(faceNames, getFaces(), Face::getName);
+        return faceNames.exact(name);
+    }
+
+    public Edge findEdge(TopologicalName name) {
+        edgeNames = NameIndex.refresh(edgeNames, getEdges(), Edge::getName);
+        return edgeNames.exact(name);
+    }
+
+    public Vertex findVertex(TopologicalName name) {
+        vertexNames = NameIndex.refresh(vertexNames, getVertices(), Vertex::getName);
+        return vertexNames.exact(name);
+    }
+
+    // Re-binding for downstream references: the exact name if it survived, otherwise the element
+    // from the same generator with the nearest sub-index, as when an arc is re-segmented after a
+    // radius change. Null when the generating entity itself is gone.
+    public Face resolveFace(TopologicalName name) {
+        Face face = findFace(name);
+        return face != null ? face : faceNames.nearest(name);
+    }
+
+    public Edge resolveEdge(TopologicalName name) {
+        Edge edge = findEdge(name);
+        return edge != null ? edge : edgeNames.nearest(name);
+    }
+
+    public Vertex resolveVertex(TopologicalName name) {
+        Vertex vertex = findVertex(name);
+        return vertex != null ? vertex : vertexNames.nearest(name);
     }
 
     public boolean validateEulerCharacteristic() {
-        int V = vertices.size();
-        int E = edges.size();
-        int F = faces.size();
+        int V = getVertices().size();
+        int E = getEdges().size();
+        int F = getFaces().size();
         
         int chi = V - E + F;
         
@@ -60,78 +110,111 @@ public class BRepBody {
     
     public double getVolume() {
         double volume = 0.0;
-        for (Face face : faces) {
+        double[] buffer = new double[3 * 64];
+        for (Face face : getFaces()) {
             List<Vertex> faceVertices = getFaceVertices(face);
-            if (faceVertices.size() >= 3) {
-                Vector3d v0 = faceVertices.get(0).getPoint();
-                for (int i = 1; i < faceVertices.size() - 1; i++) {
-                    Vector3d v1 = faceVertices.get(i).getPoint();
-                    Vector3d v2 = faceVertices.get(i + 1).getPoint();
-                    
-                    Vector3d a = v1.subtract(v0);
-                    Vector3d b = v2.subtract(v0);
-                    
-                    volume += v0.dot(a.cross(b)) / 6.0;
-                }
-            }
+            buffer = packPoints(faceVertices, buffer);
+            volume += VectorArrays.fanSignedVolume(buffer, faceVertices.size());
         }
         return Math.abs(volume);
     }
     
     public double getSurfaceArea() {
         double area = 0.0;
-        for (Face face : faces) {
-            area += calculateFaceArea(face);
+        double[] buffer = new double[3 * 64];
+        for (Face face : getFaces()) {
+            List<Vertex> faceVertices = getFaceVertices(face);
+            if (faceVertices.size() < 3) continue;
+            buffer = packPoints(faceVertices, buffer);
+            area += VectorArrays.fanArea(buffer, faceVertices.size());
         }
         return area;
     }
-    
-    private double calculateFaceArea(Face face) {
-        List<Vertex> faceVertices = getFaceVertices(face);
-        if (faceVertices.size() < 3) return 0.0;
-        
-        double area = 0.0;
-        Vector3d v0 = faceVertices.get(0).getPoint();
-        for (int i = 1; i < faceVertices.size() - 1; i++) {
-            Vector3d v1 = faceVertices.get(i).getPoint();
-            Vector3d v2 = faceVertices.get(i + 1).getPoint();
-            
-            Vector3d a = v1.subtract(v0);
-            Vector3d b = v2.subtract(v0);
-            area += a.cross(b).magnitude() / 2.0;
+
+    // Packs vertex positions into buffer, growing it only when a face has more vertices than fit
+    private static double[] packPoints(List<Vertex> vertices, double[] buffer) {
+        int n = vertices.size();
+        if (buffer.length < 3 * n) {
+            buffer = new double[Math.max(3 * n, 2 * buffer.length)];
         }
-        return area;
+        for (int i = 0; i < n; i++) {
+            Vector3d p = vertices.get(i).getPoint();
+            buffer[3 * i] = p.x();
+            buffer[3 * i + 1] = p.y();
+            buffer[3 * i + 2] = p.z();
+        }
+        return buffer;
     }
     
-    private List<Vertex> getFaceVertices(Face face) {
-        List<Vertex> vertices = new ArrayList<>();
-        EdgeLoop outerLoop = face.getOuterLoop();
-        if (outerLoop != null) {
-            for (Edge edge : outerLoop.getEdges()) {
-                if (!vertices.contains(edge.getStartVertex())) {
-                    vertices.add(edge.getStartVertex());
+    // Outer loop vertices in traversal order
+    public List<Vertex> getFaceVertices(Face face) {
+        return topology.faceVertices(face);
+    }
+    
+    // Checks only what changed since the last successful validation, so a feature that appends to a
+    // large body pays for the elements it added rather than for the whole body
+    public ValidationReport validateTopology() throws TopologyException {
+        ValidationReport report = TopologyValidator.validateChanges(this);
+        report.throwIfInvalid();
+        topology.markValidated();
+        return report;
+    }
+
+    public ValidationReport validateAll() {
+        return TopologyValidator.validate(this);
+    }
+
+    // Built on first lookup and rebuilt when elements were added since. Names are set by the features
+    // before they add an element, so the element count is enough to detect a stale index.
+    private static final class NameIndex<T> {
+        private final Map<TopologicalName, T> byName = new HashMap<>();
+        private final Set<TopologicalName> generators = new HashSet<>();
+        private final List<T> elements;
+        private final Function<T, TopologicalName> nameOf;
+        private final int size;
+
+        private NameIndex(List<T> elements, Function<T, TopologicalName> nameOf) {
+            this.elements = elements;
+            this.nameOf = nameOf;
+            this.size = elements.size();
+            for (T element : elements) {
+                TopologicalName name = nameOf.apply(element);
+                if (name != null) {
+                    byName.putIfAbsent(name, element);
+                    generators.add(generatorKey(name));
                 }
             }
         }
-        return vertices;
-    }
-    
-    public void validateTopology() throws TopologyException {
-        if (!validateEulerCharacteristic()) {
-            int chi = vertices.size() - edges.size() + faces.size();
-            throw new TopologyException("Invalid Euler characteristic: V - E + F = " + chi + " (expected <= 2)");
+
+        static <T> NameIndex<T> refresh(NameIndex<T> index, List<T> elements, Function<T, TopologicalName> nameOf) {
+            return index != null && index.size == elements.size() ? index : new NameIndex<>(elements, nameOf);
         }
-        
-        for (Edge edge : edges) {
-            if (edge.getAdjacentFaces().size() < 1 || edge.getAdjacentFaces().size() > 2) {
-                throw new TopologyException("Edge has invalid number of adjacent faces: " + edge.getAdjacentFaces().size());
-            }
+
+        private static TopologicalName generatorKey(TopologicalName name) {
+            return TopologicalName.of(name.getFeatureId(), name.getRole(), name.getEntityId(), 0);
         }
-        
-        for (Vertex vertex : vertices) {
-            if (vertex.getIncidentEdges().isEmpty()) {
-                throw new TopologyException("Vertex has no incident edges");
+
+        T exact(TopologicalName name) {
+            return name != null ? byName.get(name) : null;
+        }
+
+        T nearest(TopologicalName name) {
+            if (name == null || !generators.contains(generatorKey(name))) {
+                return null;
+            }
+            T best = null;
+            int bestDistance = Integer.MAX_VALUE;
+            for (T element : elements) {
+                TopologicalName candidate = nameOf.apply(element);
+                if (name.sameGenerator(candidate)) {
+                    int distance = Math.abs(candidate.getIndex() - name.getIndex());
+                    if (distance < bestDistance) {
+                        best = element;
+                        bestDistance = distance;
+                    }
+                }
             }
+            return best;
         }
     }
 }
@@ -11,6 +11,7 @@ public class Edge {
     private Curve curve;
     private List<Face> adjacentFaces;
     private boolean isOriented;
+    private TopologicalName name;
 
     public Edge(Vertex start, Vertex end, Curve curve) {
         this.startVertex = start;
@@ -35,6 +36,15 @@ public class Edge {
         return curve;
     }
 
+    // Assigned by the generating feature; null for elements built by hand
+    public TopologicalName getName() {
+        return name;
+    }
+
+    public void setName(TopologicalName name) {
+        this.name = name;
+    }
+
     public List<Face> getAdjacentFaces() {
         return adjacentFaces;
     }
@@ -47,11 +57,7 @@ public class Edge {
 
     public double getLength() {
         if (curve != null) {
-            double start = curve.startParam();
-            double end = curve.endParam();
-            Vector3d startPoint = curve.value(start);
-            Vector3d endPoint = curve.value(end);
-            return startPoint.distance(endPoint);
+            return curve.length();
         }
         return startVertex.getPoint().distance(endVertex.getPoint());
     }
@@ -46,6 +46,29 @@ public class EdgeLoop {
         return true;
     }
 
+    // The vertex each edge is entered from when the loop is walked in list order through shared
+    // vertices. Half-edges are oriented by this walk, so faces sharing an edge must disagree on it.
+    public List<Vertex> getWalkOrigins() {
+        List<Vertex> origins = new ArrayList<>(edges.size());
+        if (edges.isEmpty()) {
+            return origins;
+        }
+        Vertex current = edges.get(0).getStartVertex();
+        if (edges.size() > 1) {
+            Edge first = edges.get(0);
+            Edge second = edges.get(1);
+            boolean firstForward = first.getEndVertex().equals(second.getStartVertex())
+                    || first.getEndVertex().equals(second.getEndVertex());
+            current = firstForward ? first.getStartVertex() : first.getEndVertex();
+        }
+        for (Edge edge : edges) {
+            boolean forward = edge.getStartVertex().equals(current);
+            origins.add(forward ? edge.getStartVertex() : edge.getEndVertex());
+            current = forward ? edge.getEndVertex() : edge.getStartVertex();
+        }
+        return origins;
+    }
+
     public double getLength() {
         double length = 0.0;
         for (Edge edge : edges) {
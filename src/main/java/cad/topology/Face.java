@@ -1,6 +1,8 @@
 package cad.topology;
 
 import cad.geometry.surfaces.Surface;
+import cad.geometry.tessellation.TessellationTolerance;
+import cad.geometry.tessellation.TriangleMesh;
 import cad.math.Vector3d;
 import java.util.ArrayList;
 import java.util.List;
@@ -11,6 +13,9 @@ public class Face {
     private List<EdgeLoop> innerLoops;
     private Vector3d normal;
     private boolean isNormalValid;
+    HalfEdgeTopology topology;
+    private volatile CachedMesh cachedMesh;
+    private TopologicalName name;
 
     public Face(Surface surface, EdgeLoop outerLoop) {
         this.surface = surface;
@@ -22,12 +27,22 @@ public class Face {
     public void addInnerLoop(EdgeLoop loop) {
         innerLoops.add(loop);
         isNormalValid = false;
+        cachedMesh = null;
     }
 
     public Surface getSurface() {
         return surface;
     }
 
+    // Assigned by the generating feature; null for elements built by hand
+    public TopologicalName getName() {
+        return name;
+    }
+
+    public void setName(TopologicalName name) {
+        this.name = name;
+    }
+
     public EdgeLoop getOuterLoop() {
         return outerLoop;
     }
@@ -36,6 +51,19 @@ public class Face {
         return innerLoops;
     }
 
+    // Faces sharing an edge with this one; empty until the face is added to a body
+    public List<Face> getAdjacentFaces() {
+        return topology != null ? topology.adjacentFaces(this) : new ArrayList<>();
+    }
+
+    // Outer loop vertices in traversal order once the face belongs to a body
+    public List<Vertex> getVertices() {
+        if (topology != null) {
+            return topology.faceVertices(this);
+        }
+        return outerLoop != null ? getVerticesFromLoop(outerLoop) : new ArrayList<>();
+    }
+
     public Vector3d getNormal() {
         if (!isNormalValid) {
             calculateNormal();
@@ -137,4 +165,28 @@ public class Face {
     public void invalidateNormal() {
         isNormalValid = false;
     }
+
+    // Mesh from the last tessellation at this tolerance, or null once the face geometry has changed
+    public TriangleMesh getCachedMesh(TessellationTolerance tolerance) {
+        CachedMesh cached = cachedMesh;
+        return cached != null && cached.tolerance.equals(tolerance) ? cached.mesh : null;
+    }
+
+    public void setCachedMesh(TessellationTolerance tolerance, TriangleMesh mesh) {
+        cachedMesh = new CachedMesh(tolerance, mesh);
+    }
+
+    public void invalidateTessellation() {
+        cachedMesh = null;
+    }
+
+    private static final class CachedMesh {
+        final TessellationTolerance tolerance;
+        final TriangleMesh mesh;
+
+        CachedMesh(TessellationTolerance tolerance, TriangleMesh mesh) {
+            this.tolerance = tolerance;
+            this.mesh = mesh;
+        }
+    }
 }
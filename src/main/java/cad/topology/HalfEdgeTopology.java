@@ -0,0 +1,335 @@
+package cad.topology;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+
+// Index-based half-edge connectivity behind BRepBody. Elements get dense integer handles in insertion
+// order and are keyed by identity. Edge e owns half-edges 2e and 2e + 1, which are each other's twin;
+// a face loop claims one of them per edge and links them with next pointers in traversal order.
+public class HalfEdgeTopology {
+    public static final int NONE = -1;
+
+    private final List<Vertex> vertices = new ArrayList<>();
+    private final List<Edge> edges = new ArrayList<>();
+    private final List<Face> faces = new ArrayList<>();
+    private final Map<Vertex, Integer> vertexHandles = new IdentityHashMap<>();
+    private final Map<Edge, Integer> edgeHandles = new IdentityHashMap<>();
+    private final Map<Face, Integer> faceHandles = new IdentityHashMap<>();
+
+    private int[] heOrigin = new int[64];
+    private int[] heFace = new int[64];
+    private int[] heNext = new int[64];
+    private int[] vertexOut = new int[32];
+    private int[] faceOuter = new int[16];
+    private final List<int[]> faceInner = new ArrayList<>();
+    private int overflowUses;
+
+    // Elements with handles below these marks passed the last validation; touched holds older
+    // elements whose geometry changed since
+    private int validatedVertices;
+    private int validatedEdges;
+    private int validatedFaces;
+    private final Set<Vertex> touchedVertices = Collections.newSetFromMap(new IdentityHashMap<>());
+
+    public int addVertex(Vertex vertex) {
+        Integer existing = vertexHandles.get(vertex);
+        if (existing != null) {
+            return existing;
+        }
+        int handle = vertices.size();
+        vertices.add(vertex);
+        vertexHandles.put(vertex, handle);
+        if (handle == vertexOut.length) {
+            vertexOut = Arrays.copyOf(vertexOut, 2 * handle);
+        }
+        vertexOut[handle] = NONE;
+        vertex.topology = this;
+        return handle;
+    }
+
+    public int addEdge(Edge edge) {
+        Integer existing = edgeHandles.get(edge);
+        if (existing != null) {
+            return existing;
+        }
+        int start = addVertex(edge.getStartVertex());
+        int end = addVertex(edge.getEndVertex());
+        int handle = edges.size();
+        edges.add(edge);
+        edgeHandles.put(edge, handle);
+
+        int h = 2 * handle;
+        if (h + 1 >= heOrigin.length) {
+            int size = 2 * heOrigin.length;
+            heOrigin = Arrays.copyOf(heOrigin, size);
+            heFace = Arrays.copyOf(heFace, size);
+            heNext = Arrays.copyOf(heNext, size);
+        }
+        heOrigin[h] = start;
+        heOrigin[h + 1] = end;
+        heFace[h] = heFace[h + 1] = NONE;
+        heNext[h] = heNext[h + 1] = NONE;
+        if (vertexOut[start] == NONE) vertexOut[start] = h;
+        if (vertexOut[end] == NONE) vertexOut[end] = h + 1;
+        return handle;
+    }
+
+    public int addFace(Face face) {
+        Integer existing = faceHandles.get(face);
+        if (existing != null) {
+            return existing;
+        }
+        int handle = faces.size();
+        faces.add(face);
+        faceHandles.put(face, handle);
+        if (handle == faceOuter.length) {
+            faceOuter = Arrays.copyOf(faceOuter, 2 * handle);
+        }
+        faceOuter[handle] = face.getOuterLoop() != null ? linkLoop(face.getOuterLoop(), face, handle) : NONE;
+
+        List<EdgeLoop> innerLoops = face.getInnerLoops();
+        int[] inner = new int[innerLoops.size()];
+        for (int i = 0; i < inner.length; i++) {
+            inner[i] = linkLoop(innerLoops.get(i), face, handle);
+        }
+        faceInner.add(inner);
+        face.topology = this;
+        return handle;
+    }
+
+    // Claims a half-edge per loop edge, oriented by walking the loop through shared vertices the same
+    // way the tessellator does, and chains them. Returns the first half-edge or NONE for an empty loop.
+    private int linkLoop(EdgeLoop loop, Face face, int faceHandle) {
+        List<Edge> loopEdges = loop.getEdges();
+        if (loopEdges.isEmpty()) {
+            return NONE;
+        }
+        List<Vertex> origins = loop.getWalkOrigins();
+
+        int[] claimed = new int[loopEdges.size()];
+        int count = 0;
+        for (int i = 0; i < loopEdges.size(); i++) {
+            Edge edge = loopEdges.get(i);
+            Vertex origin = origins.get(i);
+            int e = addEdge(edge);
+            edge.addAdjacentFace(face);
+            int h = edge.getStartVertex().equals(origin) ? 2 * e : 2 * e + 1;
+            if (heFace[h] != NONE) {
+                h ^= 1;
+            }
+            if (heFace[h] != NONE) {
+                // More than two faces on one edge; Edge.getAdjacentFaces still records it for validation
+                overflowUses++;
+            } else {
+                heFace[h] = faceHandle;
+                heOrigin[h] = vertexHandles.get(origin);
+                claimed[count++] = h;
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            heNext[claimed[i]] = claimed[(i + 1) % count];
+        }
+        return count > 0 ? claimed[0] : NONE;
+    }
+
+    public List<Vertex> getVertices() {
+        return Collections.unmodifiableList(vertices);
+    }
+
+    public List<Edge> getEdges() {
+        return Collections.unmodifiableList(edges);
+    }
+
+    public List<Face> getFaces() {
+        return Collections.unmodifiableList(faces);
+    }
+
+    public int vertexHandle(Vertex vertex) {
+        Integer h = vertexHandles.get(vertex);
+        return h != null ? h : NONE;
+    }
+
+    public int edgeHandle(Edge edge) {
+        Integer h = edgeHandles.get(edge);
+        return h != null ? h : NONE;
+    }
+
+    public int faceHandle(Face face) {
+        Integer h = faceHandles.get(face);
+        return h != null ? h : NONE;
+    }
+
+    public boolean contains(Vertex vertex) {
+        return vertexHandles.containsKey(vertex);
+    }
+
+    public boolean contains(Edge edge) {
+        return edgeHandles.containsKey(edge);
+    }
+
+    public boolean contains(Face face) {
+        return faceHandles.containsKey(face);
+    }
+
+    public int getHalfEdgeCount() {
+        return 2 * edges.size();
+    }
+
+    public int origin(int halfEdge) {
+        return heOrigin[halfEdge];
+    }
+
+    public int face(int halfEdge) {
+        return heFace[halfEdge];
+    }
+
+    public int next(int halfEdge) {
+        return heNext[halfEdge];
+    }
+
+    public static int twin(int halfEdge) {
+        return halfEdge ^ 1;
+    }
+
+    public static int edgeOf(int halfEdge) {
+        return halfEdge >> 1;
+    }
+
+    public int outgoing(int vertexHandle) {
+        return vertexOut[vertexHandle];
+    }
+
+    public int outerLoop(int faceHandle) {
+        return faceOuter[faceHandle];
+    }
+
+    public int[] innerLoops(int faceHandle) {
+        return faceInner.get(faceHandle);
+    }
+
+    // Loop uses beyond the two half-edges an edge can hold
+    public int getOverflowUses() {
+        return overflowUses;
+    }
+
+    public synchronized void touch(Vertex vertex) {
+        if (contains(vertex)) {
+            touchedVertices.add(vertex);
+        }
+    }
+
+    public synchronized List<Vertex> getTouchedVertices() {
+        return new ArrayList<>(touchedVertices);
+    }
+
+    public int getValidatedVertexCount() {
+        return validatedVertices;
+    }
+
+    public int getValidatedEdgeCount() {
+        return validatedEdges;
+    }
+
+    public int getValidatedFaceCount() {
+        return validatedFaces;
+    }
+
+    public synchronized void markValidated() {
+        validatedVertices = vertices.size();
+        validatedEdges = edges.size();
+        validatedFaces = faces.size();
+        touchedVertices.clear();
+    }
+
+    public Face faceAt(int handle) {
+        return handle == NONE ? null : faces.get(handle);
+    }
+
+    // Faces on either side of the edge, at most two
+    public List<Face> facesOfEdge(Edge edge) {
+        int e = edgeHandle(edge);
+        List<Face> result = new ArrayList<>(2);
+        if (e == NONE) {
+            return result;
+        }
+        if (heFace[2 * e] != NONE) result.add(faces.get(heFace[2 * e]));
+        if (heFace[2 * e + 1] != NONE && heFace[2 * e + 1] != heFace[2 * e]) result.add(faces.get(heFace[2 * e + 1]));
+        return result;
+    }
+
+    // O(valence): faces of the half-edges on the vertex's incident edges
+    public List<Face> facesAroundVertex(Vertex vertex) {
+        List<Face> result = new ArrayList<>();
+        for (Edge edge : vertex.getIncidentEdges()) {
+            int e = edgeHandle(edge);
+            if (e == NONE) continue;
+            addFaceOnce(result, heFace[2 * e]);
+            addFaceOnce(result, heFace[2 * e + 1]);
+        }
+        return result;
+    }
+
+    private void addFaceOnce(List<Face> result, int faceHandle) {
+        if (faceHandle == NONE) return;
+        Face face = faces.get(faceHandle);
+        for (Face f : result) {
+            if (f == face) return;
+        }
+        result.add(face);
+    }
+
+    // Vertices of the outer loop in traversal order, each once
+    public List<Vertex> faceVertices(Face face) {
+        int f = faceHandle(face);
+        if (f == NONE) {
+            return new ArrayList<>();
+        }
+        return loopVertices(faceOuter[f]);
+    }
+
+    public List<Vertex> loopVertices(int head) {
+        List<Vertex> result = new ArrayList<>();
+        if (head == NONE) {
+            return result;
+        }
+        int h = head;
+        int guard = getHalfEdgeCount();
+        do {
+            result.add(vertices.get(heOrigin[h]));
+            h = heNext[h];
+        } while (h != head && h != NONE && --guard > 0);
+        return result;
+    }
+
+    // Faces sharing an edge with this face, across outer and inner loops
+    public List<Face> adjacentFaces(Face face) {
+        int f = faceHandle(face);
+        List<Face> result = new ArrayList<>();
+        if (f == NONE) {
+            return result;
+        }
+        collectNeighbours(faceOuter[f], f, result);
+        for (int head : faceInner.get(f)) {
+            collectNeighbours(head, f, result);
+        }
+        return result;
+    }
+
+    private void collectNeighbours(int head, int f, List<Face> result) {
+        if (head == NONE) return;
+        int h = head;
+        int guard = getHalfEdgeCount();
+        do {
+            int other = heFace[twin(h)];
+            if (other != f) {
+                addFaceOnce(result, other);
+            }
+            h = heNext[h];
+        } while (h != head && h != NONE && --guard > 0);
+    }
+}
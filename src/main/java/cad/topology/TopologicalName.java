@@ -0,0 +1,108 @@
+package cad.topology;
+
+import java.util.Objects;
+
+// Stable identity of a face, edge or vertex across regenerations: the feature that made it, its
+// role in that feature (a cap, a side, a profile copy) and the sketch entity and sub-index it was
+// swept from. Rebuilding a feature from an edited sketch yields the same names for the same
+// generators, so downstream references can be re-bound by name instead of by geometry.
+public final class TopologicalName {
+    public static final int NO_ENTITY = -1;
+
+    // Roles used by the sweeps: the two caps and their profile copies, edges swept from profile
+    // vertices and faces swept from profile edges
+    public static final String START = "start";
+    public static final String END = "end";
+    public static final String LATERAL = "lateral";
+    public static final String SIDE = "side";
+
+    private final String featureId;
+    private final String role;
+    private final int entityId;
+    private final int index;
+
+    public TopologicalName(String featureId, String role, int entityId, int index) {
+        if (featureId == null || featureId.isEmpty() || featureId.contains("/")) {
+            throw new IllegalArgumentException("Feature id must be non-empty and must not contain '/'");
+        }
+        if (role == null || role.isEmpty() || role.contains("/")) {
+            throw new IllegalArgumentException("Role must be non-empty and must not contain '/'");
+        }
+        this.featureId = featureId;
+        this.role = role;
+        this.entityId = entityId;
+        this.index = index;
+    }
+
+    public static TopologicalName of(String featureId, String role) {
+        return new TopologicalName(featureId, role, NO_ENTITY, 0);
+    }
+
+    public static TopologicalName of(String featureId, String role, int entityId, int index) {
+        return new TopologicalName(featureId, role, entityId, index);
+    }
+
+    // Inverse of toString, for names stored in macros and saved documents
+    public static TopologicalName parse(String text) {
+        String[] parts = text.split("/");
+        if (parts.length != 3) {
+            throw new IllegalArgumentException("Invalid topological name: " + text);
+        }
+        int dot = parts[2].indexOf('.');
+        if (dot < 0) {
+            throw new IllegalArgumentException("Invalid topological name: " + text);
+        }
+        try {
+            return of(parts[0], parts[1], Integer.parseInt(parts[2].substring(0, dot)),
+                    Integer.parseInt(parts[2].substring(dot + 1)));
+        } catch (NumberFormatException e) {
+            throw new IllegalArgumentException("Invalid topological name: " + text, e);
+        }
+    }
+
+    // Same generator, different role: the side face swept from a profile edge, for instance
+    public TopologicalName withRole(String newRole) {
+        return new TopologicalName(featureId, newRole, entityId, index);
+    }
+
+    public String getFeatureId() {
+        return featureId;
+    }
+
+    public String getRole() {
+        return role;
+    }
+
+    public int getEntityId() {
+        return entityId;
+    }
+
+    public int getIndex() {
+        return index;
+    }
+
+    // True when both names come from the same feature, role and sketch entity, whatever the sub-index
+    public boolean sameGenerator(TopologicalName other) {
+        return other != null && featureId.equals(other.featureId) && role.equals(other.role)
+                && entityId == other.entityId;
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+        if (this == obj) return true;
+        if (obj == null || getClass() != obj.getClass()) return false;
+        TopologicalName other = (TopologicalName) obj;
+        return entityId == other.entityId && index == other.index
+                && featureId.equals(other.featureId) && role.equals(other.role);
+    }
+
+    @Override
+    public int hashCode() {
+        return Objects.hash(featureId, role, entityId, index);
+    }
+
+    @Override
+    public String toString() {
+        return featureId + "/" + role + "/" + entityId + "." + index;
+    }
+}
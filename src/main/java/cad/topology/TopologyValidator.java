@@ -0,0 +1,293 @@
+package cad.topology;
+
+import cad.math.Vector3d;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.IdentityHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Objects;
+import java.util.Set;
+import java.util.function.Consumer;
+import java.util.function.IntFunction;
+import java.util.function.ToIntFunction;
+import java.util.stream.Collectors;
+import java.util.stream.IntStream;
+
+// Checks a body for loop closure, manifoldness, orientation consistency and self-intersecting face
+// loops on top of the Euler and adjacency checks. Faces and edges are checked in parallel; the
+// incremental entry point only visits elements added or moved since the topology was last marked
+// validated, plus everything sharing a loop with them.
+public final class TopologyValidator {
+    private static final int PARALLEL_THRESHOLD = 256;
+    private static final double INTERSECTION_TOLERANCE = 1e-9;
+
+    private TopologyValidator() {
+    }
+
+    public static ValidationReport validate(BRepBody body) {
+        HalfEdgeTopology topology = body.getTopology();
+        return check(topology, range(topology.getFaces().size()), range(topology.getEdges().size()),
+                range(topology.getVertices().size()));
+    }
+
+    public static ValidationReport validateChanges(BRepBody body) {
+        HalfEdgeTopology topology = body.getTopology();
+        Set<Face> faces = identitySet();
+        Set<Edge> edges = identitySet();
+        Set<Vertex> vertices = identitySet();
+
+        List<Face> allFaces = topology.getFaces();
+        List<Edge> allEdges = topology.getEdges();
+        List<Vertex> allVertices = topology.getVertices();
+        faces.addAll(allFaces.subList(topology.getValidatedFaceCount(), allFaces.size()));
+        edges.addAll(allEdges.subList(topology.getValidatedEdgeCount(), allEdges.size()));
+        vertices.addAll(allVertices.subList(topology.getValidatedVertexCount(), allVertices.size()));
+
+        for (Vertex vertex : topology.getTouchedVertices()) {
+            vertices.add(vertex);
+            edges.addAll(vertex.getIncidentEdges());
+            faces.addAll(topology.facesAroundVertex(vertex));
+        }
+        // A face changes the adjacency of every edge on its loops, and an edge the valence of its ends
+        for (Face face : faces) {
+            forEachLoop(face, loop -> edges.addAll(loop.getEdges()));
+        }
+        for (Edge edge : edges) {
+            vertices.add(edge.getStartVertex());
+            vertices.add(edge.getEndVertex());
+        }
+
+        return check(topology, handles(faces, topology::faceHandle), handles(edges, topology::edgeHandle),
+                handles(vertices, topology::vertexHandle));
+    }
+
+    private static ValidationReport check(HalfEdgeTopology topology, int[] faces, int[] edges, int[] vertices) {
+        ValidationReport report = new ValidationReport();
+        report.setChecked(faces.length, edges.length, vertices.length);
+
+        // The Euler characteristic is global and cheap, so it is always checked in full. A body may
+        // hold several lumps, each a closed shell contributing at most 2.
+        int chi = topology.getVertices().size() - topology.getEdges().size() + topology.getFaces().size();
+        int shells = countShells(topology);
+        if (chi > 2 * Math.max(1, shells)) {
+            report.addError("Invalid Euler characteristic: V - E + F = " + chi + " (expected <= 2 per shell, "
+                    + shells + " shells)");
+        }
+        if (topology.getOverflowUses() > 0) {
+            report.addError("Non-manifold topology: " + topology.getOverflowUses() + " loop uses beyond two faces per edge");
+        }
+
+        report.addErrors(collect(edges, e -> checkEdge(topology, e)));
+        report.addErrors(collect(edges, e -> checkOrientation(topology, e)));
+        report.addErrors(collect(vertices, v -> checkVertex(topology, v)));
+        report.addErrors(collect(faces, f -> checkFace(topology, f)));
+        return report;
+    }
+
+    // Connected components of the vertex-edge graph, by union-find over the edge list
+    private static int countShells(HalfEdgeTopology topology) {
+        List<Edge> edges = topology.getEdges();
+        int[] parent = new int[topology.getVertices().size()];
+        for (int i = 0; i < parent.length; i++) {
+            parent[i] = i;
+        }
+        int shells = parent.length;
+        for (Edge edge : edges) {
+            int a = root(parent, topology.vertexHandle(edge.getStartVertex()));
+            int b = root(parent, topology.vertexHandle(edge.getEndVertex()));
+            if (a != b) {
+                parent[a] = b;
+                shells--;
+            }
+        }
+        return shells;
+    }
+
+    private static int root(int[] parent, int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    private static String checkEdge(HalfEdgeTopology topology, int e) {
+        Edge edge = topology.getEdges().get(e);
+        int count = edge.getAdjacentFaces().size();
+        if (count < 1 || count > 2) {
+            return "Edge has invalid number of adjacent faces: " + count;
+        }
+        return null;
+    }
+
+    // Two faces sharing an edge must walk it in opposite directions. Closed edges have no direction.
+    private static String checkOrientation(HalfEdgeTopology topology, int e) {
+        Edge edge = topology.getEdges().get(e);
+        int h = 2 * e;
+        if (edge.getStartVertex() == edge.getEndVertex()
+                || topology.face(h) == HalfEdgeTopology.NONE || topology.face(h + 1) == HalfEdgeTopology.NONE) {
+            return null;
+        }
+        if (topology.origin(h) == topology.origin(h + 1)) {
+            return "Edge " + e + " is traversed in the same direction by both adjacent faces";
+        }
+        return null;
+    }
+
+    private static String checkVertex(HalfEdgeTopology topology, int v) {
+        if (topology.getVertices().get(v).getIncidentEdges().isEmpty()) {
+            return "Vertex has no incident edges";
+        }
+        return null;
+    }
+
+    private static String checkFace(HalfEdgeTopology topology, int f) {
+        Face face = topology.getFaces().get(f);
+        List<EdgeLoop> loops = new ArrayList<>();
+        forEachLoop(face, loops::add);
+        for (EdgeLoop loop : loops) {
+            if (!isClosed(loop)) {
+                return "Face " + f + " has a loop that is not closed";
+            }
+        }
+        if (hasSelfIntersection(loops)) {
+            return "Face " + f + " has self-intersecting loops";
+        }
+        return null;
+    }
+
+    // Closed when every vertex is the end of an even number of edge uses. This admits loops made of
+    // several cycles and seam edges used twice, as the sweeps produce.
+    static boolean isClosed(EdgeLoop loop) {
+        List<Edge> edges = loop.getEdges();
+        if (edges.isEmpty()) {
+            return false;
+        }
+        Map<Vertex, Integer> degree = new IdentityHashMap<>();
+        for (Edge edge : edges) {
+            degree.merge(edge.getStartVertex(), 1, Integer::sum);
+            degree.merge(edge.getEndVertex(), 1, Integer::sum);
+        }
+        for (int d : degree.values()) {
+            if ((d & 1) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Segments of all loops of a face, swept in order of their lowest x so each is only compared
+    // with segments whose x-extent overlaps it. Segments sharing a vertex touch by construction.
+    static boolean hasSelfIntersection(List<EdgeLoop> loops) {
+        List<Edge> segments = new ArrayList<>();
+        Set<Edge> seen = identitySet();
+        for (EdgeLoop loop : loops) {
+            for (Edge edge : loop.getEdges()) {
+                if (edge.getStartVertex().getPoint().distance(edge.getEndVertex().getPoint()) > INTERSECTION_TOLERANCE
+                        && seen.add(edge)) {
+                    segments.add(edge);
+                }
+            }
+        }
+        int n = segments.size();
+        if (n < 4) {
+            return false;
+        }
+        double[] minX = new double[n];
+        double[] maxX = new double[n];
+        Integer[] order = new Integer[n];
+        for (int i = 0; i < n; i++) {
+            double a = segments.get(i).getStartVertex().getPoint().x();
+            double b = segments.get(i).getEndVertex().getPoint().x();
+            minX[i] = Math.min(a, b);
+            maxX[i] = Math.max(a, b);
+            order[i] = i;
+        }
+        Arrays.sort(order, (i, j) -> Double.compare(minX[i], minX[j]));
+
+        for (int a = 0; a < n; a++) {
+            int i = order[a];
+            Edge s = segments.get(i);
+            for (int b = a + 1; b < n && minX[order[b]] <= maxX[i] + INTERSECTION_TOLERANCE; b++) {
+                Edge t = segments.get(order[b]);
+                if (sharesVertex(s, t)) {
+                    continue;
+                }
+                if (segmentDistanceSquared(s.getStartVertex().getPoint(), s.getEndVertex().getPoint(),
+                        t.getStartVertex().getPoint(), t.getEndVertex().getPoint())
+                        <= INTERSECTION_TOLERANCE * INTERSECTION_TOLERANCE) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    private static boolean sharesVertex(Edge s, Edge t) {
+        return s.getStartVertex().equals(t.getStartVertex()) || s.getStartVertex().equals(t.getEndVertex())
+                || s.getEndVertex().equals(t.getStartVertex()) || s.getEndVertex().equals(t.getEndVertex());
+    }
+
+    // Squared distance between segments p1q1 and p2q2 (closest points, clamped to both segments)
+    static double segmentDistanceSquared(Vector3d p1, Vector3d q1, Vector3d p2, Vector3d q2) {
+        double d1x = q1.x() - p1.x(), d1y = q1.y() - p1.y(), d1z = q1.z() - p1.z();
+        double d2x = q2.x() - p2.x(), d2y = q2.y() - p2.y(), d2z = q2.z() - p2.z();
+        double rx = p1.x() - p2.x(), ry = p1.y() - p2.y(), rz = p1.z() - p2.z();
+        double a = d1x * d1x + d1y * d1y + d1z * d1z;
+        double e = d2x * d2x + d2y * d2y + d2z * d2z;
+        double f = d2x * rx + d2y * ry + d2z * rz;
+        double c = d1x * rx + d1y * ry + d1z * rz;
+        double b = d1x * d2x + d1y * d2y + d1z * d2z;
+        double denom = a * e - b * b;
+
+        double s = denom > 1e-30 ? clamp((b * f - c * e) / denom) : 0.0;
+        double t = (b * s + f) / e;
+        if (t < 0.0) {
+            t = 0.0;
+            s = clamp(-c / a);
+        } else if (t > 1.0) {
+            t = 1.0;
+            s = clamp((b - c) / a);
+        }
+        double dx = rx + d1x * s - d2x * t;
+        double dy = ry + d1y * s - d2y * t;
+        double dz = rz + d1z * s - d2z * t;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    private static double clamp(double x) {
+        return x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x);
+    }
+
+    private static void forEachLoop(Face face, Consumer<EdgeLoop> action) {
+        if (face.getOuterLoop() != null) {
+            action.accept(face.getOuterLoop());
+        }
+        for (EdgeLoop loop : face.getInnerLoops()) {
+            action.accept(loop);
+        }
+    }
+
+    // Messages in handle order, whether or not the stream ran in parallel
+    private static List<String> collect(int[] handles, IntFunction<String> check) {
+        IntStream stream = IntStream.of(handles);
+        if (handles.length >= PARALLEL_THRESHOLD) {
+            stream = stream.parallel();
+        }
+        return stream.mapToObj(check).filter(Objects::nonNull).collect(Collectors.toList());
+    }
+
+    private static <T> int[] handles(Set<T> elements, ToIntFunction<T> handleOf) {
+        return elements.stream().mapToInt(handleOf).filter(h -> h != HalfEdgeTopology.NONE).sorted().toArray();
+    }
+
+    private static int[] range(int n) {
+        return IntStream.range(0, n).toArray();
+    }
+
+    private static <T> Set<T> identitySet() {
+        return Collections.newSetFromMap(new IdentityHashMap<>());
+    }
+}
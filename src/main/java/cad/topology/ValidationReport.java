@@ -0,0 +1,74 @@
+package cad.topology;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+// Result of a topology check. Errors make the body invalid; warnings flag defects the kernel
+// tolerates.
+public class ValidationReport {
+    private final List<String> errors = new ArrayList<>();
+    private final List<String> warnings = new ArrayList<>();
+    private int checkedFaces;
+    private int checkedEdges;
+    private int checkedVertices;
+
+    void addError(String message) {
+        errors.add(message);
+    }
+
+    void addErrors(List<String> messages) {
+        errors.addAll(messages);
+    }
+
+    void addWarnings(List<String> messages) {
+        warnings.addAll(messages);
+    }
+
+    void setChecked(int faces, int edges, int vertices) {
+        this.checkedFaces = faces;
+        this.checkedEdges = edges;
+        this.checkedVertices = vertices;
+    }
+
+    public boolean isValid() {
+        return errors.isEmpty();
+    }
+
+    public List<String> getErrors() {
+        return Collections.unmodifiableList(errors);
+    }
+
+    public List<String> getWarnings() {
+        return Collections.unmodifiableList(warnings);
+    }
+
+    public int getCheckedFaces() {
+        return checkedFaces;
+    }
+
+    public int getCheckedEdges() {
+        return checkedEdges;
+    }
+
+    public int getCheckedVertices() {
+        return checkedVertices;
+    }
+
+    public void throwIfInvalid() throws TopologyException {
+        if (errors.isEmpty()) {
+            return;
+        }
+        String message = errors.get(0);
+        if (errors.size() > 1) {
+            message += " (and " + (errors.size() - 1) + " more)";
+        }
+        throw new TopologyException(message);
+    }
+
+    @Override
+    public String toString() {
+        return "ValidationReport{faces=" + checkedFaces + ", edges=" + checkedEdges + ", vertices=" + checkedVertices
+                + ", errors=" + errors.size() + ", warnings=" + warnings.size() + "}";
+    }
+}
@@ -7,6 +7,8 @@ import cad.math.Vector3d;
 public class Vertex {
     private Vector3d point;
     private List<Edge> incidentEdges;
+    HalfEdgeTopology topology;
+    private TopologicalName name;
 
     public Vertex(Vector3d point) {
         this.point = point;
@@ -21,8 +23,25 @@ public class Vertex {
         return point;
     }
 
+    // Moving a vertex changes the geometry of every face around it
     public void setPoint(Vector3d point) {
         this.point = point;
+        if (topology != null) {
+            topology.touch(this);
+        }
+        for (Face face : getAdjacentFaces()) {
+            face.invalidateNormal();
+            face.invalidateTessellation();
+        }
+    }
+
+    // Assigned by the generating feature; null for elements built by hand
+    public TopologicalName getName() {
+        return name;
+    }
+
+    public void setName(TopologicalName name) {
+        this.name = name;
     }
 
     public List<Edge> getIncidentEdges() {
@@ -51,6 +70,9 @@ public class Vertex {
     }
 
     public List<Face> getAdjacentFaces() {
+        if (topology != null) {
+            return topology.facesAroundVertex(this);
+        }
         List<Face> faces = new ArrayList<>();
         for (Edge edge : incidentEdges) {
             for (Face face : edge.getAdjacentFaces()) {
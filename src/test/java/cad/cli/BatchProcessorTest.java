@@ -0,0 +1,69 @@
+package cad.cli;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+import static org.junit.Assert.*;
+
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+
+public class BatchProcessorTest {
+
+    @Rule
+    public TemporaryFolder folder = new TemporaryFolder();
+
+    @Test
+    public void testFilesRunInIsolation() throws Exception {
+        Path dir = folder.newFolder("parts").toPath();
+        Files.createDirectories(dir.resolve("nested"));
+        for (String name : new String[] { "2.part", "nested/3.part", "bad.part", "skip.txt" }) {
+            Files.createFile(dir.resolve(name));
+        }
+
+        List<Path> files = BatchProcessor.resolveInputs(List.of(dir + "/**/*.part"));
+        assertEquals(3, files.size());
+
+        BatchProcessor processor = new BatchProcessor(List.of("cube {name}", "mass_props"), folder.getRoot().toString(), 3);
+        int[] progress = { 0 };
+        List<BatchProcessor.FileResult> results = processor.process(files, (done, total, r) -> progress[0] = done);
+        assertEquals(3, progress[0]);
+
+        for (BatchProcessor.FileResult result : results) {
+            String name = result.getFile().getFileName().toString();
+            if (name.equals("bad.part")) {
+                assertFalse(result.isOk());
+                assertEquals(BatchRunner.EXIT_SCRIPT_ERROR, result.getExitCode());
+                assertNull(result.getMassProperties());
+            } else {
+                assertTrue(result.getMessage(), result.isOk());
+                double size = Double.parseDouble(name.substring(0, 1));
+                assertEquals("Each file sees only its own cube", size * size * size, result.getMassProperties()[0], 1e-3);
+            }
+        }
+
+        Path summary = folder.getRoot().toPath().resolve("summary.csv");
+        BatchProcessor.writeSummary(summary, results);
+        List<String> rows = Files.readAllLines(summary);
+        assertEquals(4, rows.size());
+        assertTrue(rows.get(0).startsWith("file,status,exit_code"));
+    }
+
+    @Test
+    public void testPathsWithSpacesStayOneWord() throws Exception {
+        Path part = folder.newFolder("my parts").toPath().resolve("2 mm.part");
+        Files.createFile(part);
+        Path out = folder.newFolder("out dir").toPath();
+
+        BatchProcessor processor = new BatchProcessor(List.of("cube 2", "save {out}/{name}.stl"), out.toString(), 1);
+        BatchProcessor.FileResult result = processor.processFile(part);
+        assertTrue(result.getMessage(), result.isOk());
+        assertTrue(Files.exists(out.resolve("2 mm.stl")));
+
+        String awkward = "C:\\my parts\\a \"b\".stl";
+        assertArrayEquals(new String[] { "save", awkward }, Cli.tokenize("save " + Cli.quote(awkward)));
+        assertArrayEquals("Unquoted backslashes are literal", new String[] { "load", "C:\\x\\y.stl" },
+                Cli.tokenize("load   C:\\x\\y.stl"));
+    }
+}
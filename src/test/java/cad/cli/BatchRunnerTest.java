@@ -0,0 +1,46 @@
+package cad.cli;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.util.List;
+import java.util.Locale;
+
+public class BatchRunnerTest {
+
+    @Test
+    public void testExitCodesAndResults() {
+        List<String> script = BatchRunner.splitCommands("# comment; cube 10; mass_props; cube; nonsense 1; cube 5");
+
+        BatchRunner.Report failFast = new BatchRunner().captureOutput(true).execute("<test>", script);
+        assertEquals(BatchRunner.EXIT_SCRIPT_ERROR, failFast.getExitCode());
+        assertEquals("Stops at the bad cube line", 3, failFast.getResults().size());
+        assertTrue(failFast.getResults().get(1).getOutput().contains("Volume: "));
+        assertEquals(CommandResult.Status.INVALID_ARGUMENTS, failFast.getResults().get(2).getStatus());
+
+        BatchRunner.Report all = new BatchRunner().keepGoing(true).execute("<test>", script);
+        assertEquals(BatchRunner.EXIT_SCRIPT_ERROR, all.getExitCode());
+        assertEquals(5, all.getResults().size());
+        assertEquals(CommandResult.Status.UNKNOWN_COMMAND, all.getResults().get(3).getStatus());
+
+        BatchRunner.Report exit = new BatchRunner().execute("<test>", List.of("cube 2", "exit", "nonsense"));
+        assertEquals(BatchRunner.EXIT_OK, exit.getExitCode());
+        assertEquals(2, exit.getResults().size());
+    }
+
+    @Test
+    public void testMassPropertiesIgnoreTheDefaultLocale() {
+        Locale saved = Locale.getDefault();
+        Locale.setDefault(Locale.GERMANY);
+        try {
+            BatchRunner.Report report = new BatchRunner().captureOutput(true)
+                    .execute("<test>", List.of("cube 2", "mass_props"));
+            CommandResult props = report.getResults().get(1);
+            assertEquals(8.0, props.getValue("volume"), 1e-3);
+            assertEquals(24.0, props.getValue("surface_area"), 1e-3);
+            assertTrue(props.getOutput(), props.getOutput().contains("Volume: 8.0000"));
+        } finally {
+            Locale.setDefault(saved);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+package cad.cli;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import com.google.gson.JsonObject;
+import com.google.gson.JsonParser;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.HashMap;
+import java.util.Map;
+
+public class KernelServerTest {
+
+    @Test
+    public void testDocumentsStayResidentAndIsolated() throws Exception {
+        String requests = String.join("\n",
+                "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"open\",\"params\":{\"document\":\"a\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"open\",\"params\":{\"document\":\"b\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"cube\",\"params\":{\"document\":\"a\",\"args\":[10]}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":4,\"method\":\"execute\",\"params\":{\"document\":\"b\",\"command\":\"cube 2\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":5,\"method\":\"massProperties\",\"params\":{\"document\":\"a\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":6,\"method\":\"massProperties\",\"params\":{\"document\":\"b\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":7,\"method\":\"cube\",\"params\":{\"document\":\"a\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":8,\"method\":\"no_such_method\",\"params\":{\"document\":\"a\"}}",
+                "not json",
+                "");
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        new KernelServer(4).serve(new ByteArrayInputStream(requests.getBytes(StandardCharsets.UTF_8)), out);
+
+        // Responses on different documents may arrive in any order
+        Map<String, JsonObject> byId = new HashMap<>();
+        for (String line : out.toString(StandardCharsets.UTF_8).split("\n")) {
+            JsonObject response = JsonParser.parseString(line).getAsJsonObject();
+            byId.put(response.get("id").toString(), response);
+        }
+        assertEquals(9, byId.size());
+        assertEquals("a", byId.get("1").get("result").getAsString());
+        assertEquals(0, byId.get("4").getAsJsonObject("result").get("exitCode").getAsInt());
+        double volumeA = byId.get("5").getAsJsonObject("result").get("volume").getAsDouble();
+        double volumeB = byId.get("6").getAsJsonObject("result").get("volume").getAsDouble();
+        assertEquals("Each document keeps its own model", 125.0, volumeA / volumeB, 1.0);
+        assertEquals(KernelServer.COMMAND_FAILED, byId.get("7").getAsJsonObject("error").get("code").getAsInt());
+        assertEquals(KernelServer.METHOD_NOT_FOUND, byId.get("8").getAsJsonObject("error").get("code").getAsInt());
+        assertEquals(KernelServer.PARSE_ERROR, byId.get("null").getAsJsonObject("error").get("code").getAsInt());
+    }
+
+    @Test
+    public void testBadParamsAndNotificationsKeepServing() throws Exception {
+        String requests = String.join("\n",
+                "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"open\",\"params\":{\"document\":{}}}",
+                "{\"jsonrpc\":\"2.0\",\"method\":\"open\",\"params\":{\"document\":\"a\"}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"cube\",\"params\":{\"document\":\"a\",\"args\":[{\"size\":1}]}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"execute\",\"params\":{\"document\":\"a\",\"commands\":[[1]]}}",
+                "{\"jsonrpc\":\"2.0\",\"id\":4,\"method\":\"documents\"}",
+                "");
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        new KernelServer(2).serve(new ByteArrayInputStream(requests.getBytes(StandardCharsets.UTF_8)), out);
+
+        Map<String, JsonObject> byId = new HashMap<>();
+        for (String line : out.toString(StandardCharsets.UTF_8).split("\n")) {
+            JsonObject response = JsonParser.parseString(line).getAsJsonObject();
+            byId.put(response.get("id").toString(), response);
+        }
+        // The notification opened "a" without a response of its own
+        assertEquals(4, byId.size());
+        assertEquals(KernelServer.INVALID_PARAMS, byId.get("1").getAsJsonObject("error").get("code").getAsInt());
+        assertEquals(KernelServer.INVALID_PARAMS, byId.get("2").getAsJsonObject("error").get("code").getAsInt());
+        assertEquals(KernelServer.INVALID_PARAMS, byId.get("3").getAsJsonObject("error").get("code").getAsInt());
+        assertEquals("a", byId.get("4").getAsJsonArray("result").get(0).getAsString());
+    }
+}
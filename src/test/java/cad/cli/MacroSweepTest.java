@@ -0,0 +1,111 @@
+package cad.cli;
+
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+import static org.junit.Assert.*;
+
+import cad.core.MacroRecorder;
+import cad.core.Sketch;
+import java.io.StringWriter;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+
+public class MacroSweepTest {
+
+    @Rule
+    public TemporaryFolder temp = new TemporaryFolder();
+
+    @Test
+    public void testValueSpecs() {
+        assertEquals(List.of("10", "12.5", "15"), MacroSweep.parseValues("10:15:2.5"));
+        assertEquals(List.of("0012", "2412"), MacroSweep.parseValues("0012, 2412"));
+    }
+
+    @Test
+    public void testGridSweepSharesIdenticalVariants() throws Exception {
+        List<MacroRecorder.MacroCommand> template = MacroSweep.parseTemplate(List.of(
+                "# square prism",
+                "SKETCH_POLYGON centerX=0 centerY=0 radius=${r} sides=4",
+                "EXTRUDE depth=${h}"));
+        Map<String, List<String>> params = new LinkedHashMap<>();
+        params.put("r", List.of("5"));
+        params.put("h", List.of("10", "20"));
+        // Not referenced by the macro, so both values model the same part
+        params.put("tag", List.of("a", "b"));
+
+        Path out = temp.newFolder("variants").toPath();
+        MacroSweep sweep = new MacroSweep(template, params, false, out, 4);
+        assertEquals(4, sweep.variants().size());
+        assertEquals("20", sweep.variants().get(2).get("h"));
+
+        List<MacroSweep.VariantResult> results = sweep.run(null);
+        for (MacroSweep.VariantResult result : results) {
+            assertTrue(result.getErrors().toString(), result.isOk());
+            assertTrue(Files.size(result.getExport()) > 0);
+        }
+        assertTrue("Taller prism, larger volume", results.get(2).getVolume() > results.get(0).getVolume());
+        assertEquals(results.get(0).getVolume(), results.get(1).getVolume(), 0.0);
+        assertTrue("One of each identical pair is copied", results.get(0).isReused() != results.get(1).isReused());
+
+        StringWriter csv = new StringWriter();
+        sweep.writeCsv(csv, results);
+        String[] rows = csv.toString().split("\\R");
+        assertEquals(5, rows.length);
+        assertTrue(rows[0].startsWith("variant,r,h,tag,status,volume"));
+    }
+
+    @Test
+    public void testVariantsShareTheirOpeningSketch() throws Exception {
+        List<MacroRecorder.MacroCommand> template = MacroSweep.parseTemplate(List.of(
+                "SKETCH_POLYGON centerX=0 centerY=0 radius=${r} sides=6",
+                "SKETCH_CIRCLE x=0 y=0 radius=1",
+                "EXTRUDE depth=${h}"));
+        Map<String, List<String>> params = new LinkedHashMap<>();
+        params.put("r", List.of("4", "5"));
+        params.put("h", List.of("10", "20"));
+        MacroSweep sweep = new MacroSweep(template, params, false, null, 2);
+
+        List<List<MacroRecorder.MacroCommand>> scripts = new ArrayList<>();
+        for (Map<String, String> values : sweep.variants()) {
+            scripts.add(MacroSweep.instantiate(template, values));
+        }
+        // Both sketch steps are shared within each radius; the extrusion never is
+        assertArrayEquals(new int[] { 2, 2, 2, 2 }, MacroSweep.sharedPrefixLengths(scripts));
+        scripts.add(MacroSweep.instantiate(template, Map.of("r", "6", "h", "10")));
+        assertEquals(0, MacroSweep.sharedPrefixLengths(scripts)[4]);
+
+        List<MacroSweep.VariantResult> results = sweep.run(null);
+        for (MacroSweep.VariantResult result : results) {
+            assertTrue(result.getErrors().toString(), result.isOk());
+            assertFalse(result.isReused());
+        }
+        assertEquals(2 * results.get(0).getVolume(), results.get(1).getVolume(), 1e-3 * results.get(1).getVolume());
+        assertTrue("Wider prism, larger volume", results.get(2).getVolume() > results.get(0).getVolume());
+    }
+
+    @Test
+    public void testSketchCopiesAreIndependent() {
+        Sketch sketch = new Sketch();
+        sketch.addLine(0, 0, 1, 0);
+        sketch.addNSidedPolygon(0, 0, 2, 5);
+        Sketch copy = new Sketch(sketch);
+        assertEquals(2, copy.getEntities().size());
+        assertEquals(sketch.polygons.size(), copy.polygons.size());
+
+        ((Sketch.Line) copy.getEntities().get(0)).setEnd(3, 3);
+        copy.addCircle(0, 0, 1);
+        assertEquals(1.0f, ((Sketch.Line) sketch.getEntities().get(0)).getX2(), 0f);
+        assertEquals(2, sketch.getEntities().size());
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testMissingPlaceholderValuesAreRejected() {
+        List<MacroRecorder.MacroCommand> template = MacroSweep.parseTemplate(List.of("EXTRUDE depth=${h}"));
+        new MacroSweep(template, Map.of(), false, null, 1);
+    }
+}
@@ -0,0 +1,196 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+public class CommandManagerTest {
+
+    @Test
+    public void testHistoryIsTrimmedByCount() {
+        CommandManager manager = new CommandManager();
+        manager.setMaxHistorySize(3);
+        ModelContext context = new ModelContext();
+        context.run(() -> {
+            for (int i = 1; i <= 5; i++) {
+                manager.executeCommand(new CreateCubeCommand(i, 1));
+            }
+        });
+        assertEquals(3, manager.getUndoCount());
+        assertEquals("Create Cube (size=3.0)", manager.getCommandHistory().get(0).getDescription());
+    }
+
+    @Test
+    public void testSpilledStateIsRestoredExactly() {
+        CommandManager manager = new CommandManager();
+        ModelContext context = new ModelContext();
+        context.run(() -> {
+            Geometry.createCube(10.0f, 6);
+            List<float[]> before = new ArrayList<>(Geometry.getLoadedStlTriangles());
+            List<float[]> meshBefore = new ArrayList<>(Geometry.getExtrudedTriangles());
+
+            manager.executeCommand(new CreateCubeCommand(4.0f, 3));
+            assertTrue("Replacing the cube retains the old mesh", manager.getRetainedBytes() > 0);
+
+            // A zero budget pushes every undo state to the spill file
+            manager.setMemoryBudget(0);
+            assertEquals(0, manager.getRetainedBytes());
+            assertTrue(manager.getSpilledBytes() > 0);
+
+            assertTrue(manager.undo());
+            assertEquals(10.0f, Geometry.getParam(), 1e-6f);
+            assertTriangles(before, Geometry.getLoadedStlTriangles());
+            assertTriangles(meshBefore, Geometry.getExtrudedTriangles());
+
+            assertTrue(manager.redo());
+            assertEquals(4.0f, Geometry.getParam(), 1e-6f);
+            manager.clearHistory();
+            assertEquals(0, manager.getSpilledBytes());
+        });
+    }
+
+    @Test
+    public void testReleasedSpillSpaceIsReused() throws Exception {
+        try (UndoSpill spill = new UndoSpill()) {
+            byte[] data = new byte[10_000];
+            new Random(7).nextBytes(data);
+            UndoSpill.Record first = spill.write(out -> out.write(data));
+            UndoSpill.Record second = spill.write(out -> out.write(data));
+            UndoSpill.Record third = spill.write(out -> out.write(data));
+
+            // Half the file is still live, so nothing moves yet
+            spill.release(first);
+            assertEquals(first.getLength() + second.getLength() + third.getLength(), spill.getFileSize());
+
+            // Mostly dead: the last record moves to the front and the file shrinks to it
+            spill.release(second);
+            assertEquals(third.getLength(), spill.getFileSize());
+            byte[] read = spill.read(third, in -> {
+                byte[] bytes = new byte[data.length];
+                in.readFully(bytes);
+                return bytes;
+            });
+            assertArrayEquals(data, read);
+
+            UndoSpill.Record fourth = spill.write(out -> out.write(data));
+            assertEquals(third.getLength() + fourth.getLength(), spill.getFileSize());
+        }
+    }
+
+    // Sets a value, merging with the previous step like a scrubbed dimension
+    private static class SetValueCommand implements Command {
+        private final int[] target;
+        private final int before;
+        private int value;
+
+        SetValueCommand(int[] target, int value) {
+            this.target = target;
+            this.before = target[0];
+            this.value = value;
+        }
+
+        public void execute() {
+            target[0] = value;
+        }
+
+        public void undo() {
+            target[0] = before;
+        }
+
+        public String getDescription() {
+            return "Set " + value;
+        }
+
+        @Override
+        public boolean mergeWith(Command next) {
+            if (next instanceof SetValueCommand other && other.target == target) {
+                value = other.value;
+                return true;
+            }
+            return false;
+        }
+    }
+
+    @Test
+    public void testContinuousEditsCoalesce() {
+        CommandManager manager = new CommandManager();
+        manager.setMergeWindowMillis(60_000);
+        int[] value = { 0 };
+        for (int i = 1; i <= 50; i++) {
+            manager.executeCommand(new SetValueCommand(value, i));
+        }
+        assertEquals(1, manager.getUndoCount());
+        assertEquals("Set 50", manager.getUndoDescription().substring(5));
+        manager.undo();
+        assertEquals(0, value[0]);
+        manager.redo();
+        assertEquals(50, value[0]);
+
+        // After an undo the next edit starts a new step
+        manager.undo();
+        manager.executeCommand(new SetValueCommand(value, 7));
+        manager.setMergeWindowMillis(0);
+        int[] other = { 0 };
+        manager.executeCommand(new SetValueCommand(other, 1));
+        manager.executeCommand(new SetValueCommand(other, 2));
+        assertEquals(3, manager.getUndoCount());
+    }
+
+    @Test
+    public void testNoMergingByDefault() {
+        CommandManager manager = new CommandManager();
+        int[] value = { 0 };
+        manager.executeCommand(new SetValueCommand(value, 1));
+        manager.executeCommand(new SetValueCommand(value, 2));
+        assertEquals(0, manager.getMergeWindowMillis());
+        assertEquals(2, manager.getUndoCount());
+    }
+
+    @Test
+    public void testGroupIsOneStepWithBatchedNotifications() {
+        CommandManager manager = new CommandManager();
+        List<Runnable> frames = new ArrayList<>();
+        manager.setNotificationDispatcher(frames::add);
+        int[] historyEvents = { 0 };
+        int[] executedEvents = { 0 };
+        manager.addListener(new CommandManager.CommandListener() {
+            public void onCommandExecuted(Command cmd) { executedEvents[0]++; }
+            public void onUndo(Command cmd) { }
+            public void onRedo(Command cmd) { }
+            public void onHistoryChanged() { historyEvents[0]++; }
+        });
+
+        int[] a = { 0 };
+        int[] b = { 0 };
+        manager.beginGroup("Drag");
+        for (int i = 1; i <= 10; i++) {
+            manager.executeCommand(new SetValueCommand(a, i));
+            manager.executeCommand(new SetValueCommand(b, -i));
+        }
+        manager.endGroup();
+        manager.executeCommand(new SetValueCommand(new int[1], 1));
+
+        assertEquals("Nothing is delivered until the frame runs", 0, historyEvents[0]);
+        assertEquals(1, frames.size());
+        frames.get(0).run();
+        assertEquals(1, historyEvents[0]);
+        assertEquals(2, executedEvents[0]);
+
+        assertEquals(2, manager.getUndoCount());
+        manager.undo();
+        assertEquals("Drag", manager.getCommandHistory().get(0).getDescription());
+        manager.undo();
+        assertEquals(0, a[0]);
+        assertEquals(0, b[0]);
+    }
+
+    private static void assertTriangles(List<float[]> expected, List<float[]> actual) {
+        assertEquals(expected.size(), actual.size());
+        for (int i = 0; i < expected.size(); i++) {
+            assertArrayEquals(expected.get(i), actual.get(i), 0.0f);
+        }
+    }
+}
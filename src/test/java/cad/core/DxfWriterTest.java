@@ -0,0 +1,87 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.io.File;
+import java.util.Arrays;
+import java.util.List;
+
+public class DxfWriterTest {
+
+    private static Sketch roundTrip(Sketch sketch, DxfWriter writer) throws Exception {
+        File file = File.createTempFile("roundtrip", ".dxf");
+        try {
+            writer.write(sketch, file.getPath());
+            Sketch loaded = new Sketch();
+            loaded.loadDXF(file.getPath());
+            return loaded;
+        } finally {
+            file.delete();
+        }
+    }
+
+    private static void assertSamePoints(List<Sketch.PointEntity> expected, List<Sketch.PointEntity> actual) {
+        assertEquals(expected.size(), actual.size());
+        for (int i = 0; i < expected.size(); i++) {
+            assertEquals(expected.get(i).getX(), actual.get(i).getX(), 1e-5f);
+            assertEquals(expected.get(i).getY(), actual.get(i).getY(), 1e-5f);
+        }
+    }
+
+    @Test
+    public void testEntitiesSurviveWriteAndRead() throws Exception {
+        Sketch sketch = new Sketch();
+        sketch.addPoint(1.5f, -2.25f);
+        sketch.addLine(0, 0, 10, 5);
+        sketch.addCircle(3, 4, 2.5f);
+        sketch.addEntity(new Sketch.Arc(1, 1, 4, 30, 120));
+        sketch.addNSidedPolygon(20, 20, 5, 6);
+        List<Sketch.PointEntity> open = Arrays.asList(new Sketch.PointEntity(0, 0), new Sketch.PointEntity(1, 2),
+                new Sketch.PointEntity(3, 2), new Sketch.PointEntity(4, 0), new Sketch.PointEntity(6, 1));
+        sketch.addSpline(open, false);
+        List<Sketch.PointEntity> closed = Arrays.asList(new Sketch.PointEntity(0, 0), new Sketch.PointEntity(4, 0),
+                new Sketch.PointEntity(4, 4), new Sketch.PointEntity(0, 4), new Sketch.PointEntity(-1, 2));
+        sketch.addSpline(closed, true);
+
+        List<Sketch.Entity> read = roundTrip(sketch, new DxfWriter()).getEntities();
+        List<Sketch.Entity> written = sketch.getEntities();
+        assertEquals(written.size(), read.size());
+
+        Sketch.PointEntity point = (Sketch.PointEntity) read.get(0);
+        assertEquals(1.5f, point.getX(), 1e-6f);
+        assertEquals(-2.25f, point.getY(), 1e-6f);
+        Sketch.Line line = (Sketch.Line) read.get(1);
+        assertEquals(10f, line.getX2(), 1e-6f);
+        assertEquals(5f, line.getY2(), 1e-6f);
+        assertEquals(2.5f, ((Sketch.Circle) read.get(2)).getRadius(), 1e-6f);
+        Sketch.Arc arc = (Sketch.Arc) read.get(3);
+        assertEquals(30f, arc.getStartAngle(), 1e-6f);
+        assertEquals(120f, arc.getEndAngle(), 1e-6f);
+        assertSamePoints(((Sketch.Polygon) written.get(4)).getSketchPoints(),
+                ((Sketch.Polygon) read.get(4)).getSketchPoints());
+
+        Sketch.Spline openSpline = (Sketch.Spline) read.get(5);
+        assertFalse(openSpline.isClosed());
+        assertSamePoints(open, openSpline.getControlPoints());
+        // Written periodic with wrapped control points; read back as the original loop
+        Sketch.Spline closedSpline = (Sketch.Spline) read.get(6);
+        assertTrue(closedSpline.isClosed());
+        assertSamePoints(closed, closedSpline.getControlPoints());
+    }
+
+    @Test
+    public void testLargeValuesKeepTheirMagnitude() throws Exception {
+        // 9 decimals leave room for about 9.2e9 in fixed notation; beyond that E notation is used
+        Sketch sketch = new Sketch();
+        sketch.addPoint(5e9f, -1e10f);
+        sketch.addLine(0, 0, 2e13f, 1);
+
+        List<Sketch.Entity> read = roundTrip(sketch, new DxfWriter(DxfWriter.DEFAULT_BUFFER_SIZE, 9)).getEntities();
+
+        Sketch.PointEntity point = (Sketch.PointEntity) read.get(0);
+        assertEquals(5e9f, point.getX(), 0f);
+        assertEquals(-1e10f, point.getY(), 0f);
+        assertEquals(2e13f, ((Sketch.Line) read.get(1)).getX2(), 0f);
+    }
+}
@@ -0,0 +1,115 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import cad.features.tree.*;
+import cad.geometry.tessellation.TessellationTolerance;
+import cad.topology.Edge;
+import cad.topology.TopologicalName;
+import java.util.Arrays;
+import java.util.LinkedHashSet;
+import java.util.Set;
+
+public class FeatureTreeTest {
+
+    @Test
+    public void testRegeneratesOnlyDownstreamCone() {
+        Sketch base = new Sketch();
+        base.addCircle(0, 0, 5);
+        Sketch boss = new Sketch();
+        boss.addCircle(20, 0, 3);
+
+        FeatureTree tree = new FeatureTree();
+        SketchNode baseSketch = tree.add(new SketchNode("sketch1", base));
+        SketchNode bossSketch = tree.add(new SketchNode("sketch2", boss));
+        ExtrudeNode pad = tree.add(new ExtrudeNode("pad", baseSketch, 10));
+        ExtrudeNode bossPad = tree.add(new ExtrudeNode("boss", bossSketch, 4));
+        tree.add(new CombineNode("body", pad, bossPad, Geometry.BooleanOp.UNION));
+
+        assertEquals(5, tree.regenerate().size());
+        assertNotNull(tree.getSolid("body"));
+        assertTrue("Nothing changed", tree.regenerate().isEmpty());
+
+        pad.setHeight(12);
+        assertEquals(new LinkedHashSet<>(Arrays.asList("pad", "body")), tree.regenerate());
+
+        boss.addCircle(30, 0, 1);
+        Set<String> recomputed = tree.regenerate();
+        assertEquals(new LinkedHashSet<>(Arrays.asList("sketch2", "boss", "body")), recomputed);
+        assertNull(tree.get("body").getError());
+    }
+
+    @Test
+    public void testWorkersUseTheCallersTolerance() {
+        Sketch sketch = new Sketch();
+        sketch.addCircle(0, 0, 5);
+        FeatureTree tree = new FeatureTree();
+        SketchNode circle = tree.add(new SketchNode("sketch1", sketch));
+        tree.add(new ExtrudeNode("pad", circle, 10));
+
+        // Pinned to eight segments, unlike the default context the pool threads would otherwise see
+        ModelContext context = new ModelContext();
+        context.run(() -> {
+            Geometry.setTessellationTolerance(new TessellationTolerance(1.0, Math.PI, 8, 8));
+            tree.regenerate();
+        });
+
+        assertEquals("Eight slices of two caps and a side", 24, tree.getSolid("pad").getPolygons().size());
+    }
+
+    @Test
+    public void testFilletFollowsItsNamedEdge() {
+        Sketch sketch = new Sketch();
+        sketch.addNSidedPolygon(0, 0, 5, 4);
+        FeatureTree tree = new FeatureTree();
+        SketchNode profile = tree.add(new SketchNode("sketch1", sketch));
+        ExtrudeNode pad = tree.add(new ExtrudeNode("pad", profile, 10));
+
+        TopologicalName name = null;
+        for (Edge edge : pad.getBody(TessellationTolerance.DEFAULT).getEdges()) {
+            if (edge.getName() != null && TopologicalName.LATERAL.equals(edge.getName().getRole())) {
+                name = edge.getName();
+                break;
+            }
+        }
+        assertNotNull(name);
+        tree.add(new FilletNode("fillet", pad, name, 1));
+        tree.regenerate();
+        assertNull(tree.get("fillet").getError());
+        assertNotNull(tree.getSolid("fillet"));
+
+        // The vertical edge grows with the pad and the fillet is re-bound to it by name
+        pad.setHeight(20);
+        assertTrue(tree.regenerate().contains("fillet"));
+        assertNull(tree.get("fillet").getError());
+        assertEquals(20.0, pad.getBody(TessellationTolerance.DEFAULT).resolveEdge(name).getLength(), 1e-6);
+        assertNotNull(tree.getSolid("fillet"));
+    }
+
+    @Test
+    public void testRejectsUnknownInputsAndUsedRemovals() {
+        FeatureTree tree = new FeatureTree();
+        SketchNode detached = new SketchNode("sketch1", new Sketch());
+        try {
+            tree.add(new ExtrudeNode("pad", detached, 10));
+            fail("Expected IllegalArgumentException for an input outside the tree");
+        } catch (IllegalArgumentException e) {
+            // Success
+        }
+
+        tree.add(detached);
+        tree.add(new ExtrudeNode("pad", detached, 10));
+        try {
+            tree.remove("sketch1");
+            fail("Expected IllegalArgumentException when removing a used feature");
+        } catch (IllegalArgumentException e) {
+            // Success
+        }
+
+        // An empty sketch extrudes to nothing; the failure is recorded, not thrown
+        tree.regenerate();
+        assertNull(tree.getSolid("pad"));
+        assertNotNull(tree.get("pad").getError());
+    }
+}
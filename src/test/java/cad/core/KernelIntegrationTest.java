@@ -5,6 +5,8 @@ import static org.junit.Assert.*;
 
 import cad.topology.*;
 import cad.features.extrusion.LinearSweepFeature;
+import cad.geometry.curves.LineCurve;
+import cad.geometry.surfaces.PlaneSurface;
 import cad.math.Vector3d;
 import java.util.List;
 
@@ -101,4 +103,152 @@ public class KernelIntegrationTest {
         assertEquals(segments * 3, body.getEdges().size());
         assertEquals(segments + 2, body.getFaces().size());
     }
+
+    @Test
+    public void testHalfEdgeAdjacency() throws Exception {
+        Sketch sketch = new Sketch();
+        sketch.addLine(0, 0, 10, 0);
+        sketch.addLine(10, 0, 10, 10);
+        sketch.addLine(10, 10, 0, 10);
+        sketch.addLine(0, 10, 0, 0);
+
+        BRepBody body = new LinearSweepFeature(sketch, 10.0, Vector3d.Z_AXIS).generate();
+
+        for (Face face : body.getFaces()) {
+            assertEquals("Each box face has four corners", 4, body.getFaceVertices(face).size());
+            assertEquals("Each box face touches four others", 4, face.getAdjacentFaces().size());
+        }
+        for (Vertex vertex : body.getVertices()) {
+            assertEquals("Three faces meet at each corner", 3, vertex.getAdjacentFaces().size());
+        }
+        for (Edge edge : body.getEdges()) {
+            assertEquals(2, body.getFacesOfEdge(edge).size());
+        }
+    }
+
+    @Test
+    public void testIncrementalValidation() throws Exception {
+        Sketch sketch = new Sketch();
+        sketch.addLine(0, 0, 10, 0);
+        sketch.addLine(10, 0, 10, 10);
+        sketch.addLine(10, 10, 0, 10);
+        sketch.addLine(0, 10, 0, 0);
+
+        BRepBody body = new LinearSweepFeature(sketch, 10.0, Vector3d.Z_AXIS).generate();
+        ValidationReport full = body.validateAll();
+        assertTrue(full.getErrors().toString(), full.isValid());
+        assertEquals(6, full.getCheckedFaces());
+
+        // generate() validated the body, so nothing is left to check until a vertex moves
+        assertEquals(0, TopologyValidator.validateChanges(body).getCheckedFaces());
+        Vertex corner = body.getVertices().get(0);
+        corner.setPoint(corner.getPoint().add(new Vector3d(0, 0, -1)));
+        ValidationReport changes = TopologyValidator.validateChanges(body);
+        assertTrue(changes.isValid());
+        assertEquals("Only the faces around the moved corner are checked", 3, changes.getCheckedFaces());
+
+        body.validateTopology();
+        assertEquals(0, TopologyValidator.validateChanges(body).getCheckedFaces());
+    }
+
+    @Test
+    public void testAppendedSweepIsValidatedIncrementally() throws Exception {
+        Sketch base = new Sketch();
+        base.addLine(0, 0, 10, 0);
+        base.addLine(10, 0, 10, 10);
+        base.addLine(10, 10, 0, 10);
+        base.addLine(0, 10, 0, 0);
+        // Drawn clockwise and with one line reversed, so the loop walk disagrees with edge storage
+        Sketch boss = new Sketch();
+        boss.addLine(20, 0, 20, 5);
+        boss.addLine(20, 5, 25, 5);
+        boss.addLine(25, 0, 25, 5);
+        boss.addLine(25, 0, 20, 0);
+
+        BRepBody body = new LinearSweepFeature(base, 10.0, Vector3d.Z_AXIS).generate();
+        ValidationReport appended = new LinearSweepFeature(boss, 5.0, Vector3d.Z_AXIS).appendTo(body);
+
+        assertEquals(12, body.getFaces().size());
+        assertEquals("Only the appended lump is checked", 6, appended.getCheckedFaces());
+        assertEquals(12, appended.getCheckedEdges());
+        ValidationReport full = body.validateAll();
+        assertTrue(full.getErrors().toString(), full.isValid());
+        assertEquals(12, full.getCheckedFaces());
+    }
+
+    @Test
+    public void testSameDirectionLoopsAreRejected() {
+        Vertex a = new Vertex(0, 0, 0);
+        Vertex b = new Vertex(1, 0, 0);
+        Vertex c = new Vertex(0, 1, 0);
+        Vertex d = new Vertex(0, 0, 1);
+        Edge ab = new Edge(a, b, new LineCurve(a.getPoint(), b.getPoint()));
+        Edge bc = new Edge(b, c, new LineCurve(b.getPoint(), c.getPoint()));
+        Edge ca = new Edge(c, a, new LineCurve(c.getPoint(), a.getPoint()));
+        Edge bd = new Edge(b, d, new LineCurve(b.getPoint(), d.getPoint()));
+        Edge da = new Edge(d, a, new LineCurve(d.getPoint(), a.getPoint()));
+        BRepBody body = new BRepBody();
+        body.addFace(new Face(new PlaneSurface(a.getPoint(), Vector3d.Z_AXIS), new EdgeLoop(List.of(ab, bc, ca))));
+        body.addFace(new Face(new PlaneSurface(a.getPoint(), Vector3d.Y_AXIS), new EdgeLoop(List.of(ab, bd, da))));
+
+        ValidationReport report = body.validateAll();
+        assertFalse(report.isValid());
+        assertTrue(report.getErrors().toString(),
+                report.getErrors().contains("Edge 0 is traversed in the same direction by both adjacent faces"));
+    }
+
+    @Test
+    public void testOpenLoopIsRejected() {
+        Vertex a = new Vertex(0, 0, 0);
+        Vertex b = new Vertex(1, 0, 0);
+        Vertex c = new Vertex(0, 1, 0);
+        Edge ab = new Edge(a, b, new LineCurve(a.getPoint(), b.getPoint()));
+        Edge bc = new Edge(b, c, new LineCurve(b.getPoint(), c.getPoint()));
+        BRepBody body = new BRepBody();
+        body.addFace(new Face(new PlaneSurface(a.getPoint(), Vector3d.Z_AXIS), new EdgeLoop(List.of(ab, bc))));
+
+        ValidationReport report = body.validateAll();
+        assertFalse(report.isValid());
+        assertTrue(report.getErrors().contains("Face 0 has a loop that is not closed"));
+        try {
+            body.validateTopology();
+            fail("Expected TopologyException for an open loop");
+        } catch (TopologyException e) {
+            // Success
+        }
+    }
+
+    @Test
+    public void testTopologicalNamesSurviveRegeneration() throws Exception {
+        Sketch sketch = new Sketch();
+        sketch.addLine(0, 0, 10, 0);
+        sketch.addLine(10, 0, 10, 10);
+        sketch.addLine(10, 10, 0, 10);
+        sketch.addLine(0, 10, 0, 0);
+
+        LinearSweepFeature extrude = LinearSweepFeature.builder().sketch(sketch).distance(10.0).id("pad").build();
+        BRepBody body = extrude.generate();
+        Edge picked = body.getEdges().get(0);
+        TopologicalName name = picked.getName();
+        assertNotNull(name);
+        assertEquals("pad", name.getFeatureId());
+        assertEquals(name, TopologicalName.parse(name.toString()));
+        assertSame("Unchanged inputs reuse the body", body, extrude.regenerate());
+
+        // Widen the square; the picked edge keeps its name on the rebuilt body
+        List<Sketch.Entity> entities = sketch.getEntities();
+        ((Sketch.Line) entities.get(0)).setEnd(20, 0);
+        ((Sketch.Line) entities.get(1)).setStart(20, 0);
+        ((Sketch.Line) entities.get(1)).setEnd(20, 10);
+        ((Sketch.Line) entities.get(2)).setStart(20, 10);
+        assertFalse(extrude.isUpToDate());
+
+        BRepBody rebuilt = extrude.regenerate();
+        assertNotSame(body, rebuilt);
+        Edge rebound = rebuilt.resolveEdge(name);
+        assertNotNull(rebound);
+        assertEquals(20.0, rebound.getLength(), 1e-9);
+        assertNotNull(rebuilt.findFace(name.withRole(TopologicalName.SIDE)));
+        assertNotNull(rebuilt.findFace(TopologicalName.of("pad", TopologicalName.END)));
+    }
 }
@@ -0,0 +1,75 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.atomic.AtomicBoolean;
+
+public class MacroProgramTest {
+
+    @Test
+    public void testCompileOnceAndRun() {
+        List<MacroRecorder.MacroCommand> commands = new ArrayList<>();
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SKETCH_POINT x=1 y=2"));
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SKETCH_LINE  x1=0 y1=0 x2=3 y2=4"));
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SKETCH_CIRCLE x=0 y=0 radius=abc"));
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SET_UNITS unit=mm"));
+        assertEquals("4", commands.get(1).parameters.get("y2"));
+
+        MacroProgram program = MacroProgram.compile(commands);
+        assertEquals(2, program.size());
+        assertEquals(1, program.getCompileErrors().size());
+
+        ModelContext context = new ModelContext();
+        Sketch sketch = new Sketch();
+        List<Integer> progress = new ArrayList<>();
+        MacroProgram.Result result = program.run(context, sketch, (done, total) -> progress.add(done), null);
+        assertEquals(2, result.getExecuted());
+        assertFalse(result.isCancelled());
+        assertTrue(result.getErrors().isEmpty());
+        assertEquals(2, sketch.getEntities().size());
+        assertEquals("The final step always reports", Integer.valueOf(2), progress.get(progress.size() - 1));
+    }
+
+    @Test
+    public void testRunErrorsNameTheRecordedStep() {
+        List<MacroRecorder.MacroCommand> commands = new ArrayList<>();
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SET_UNITS unit=mm"));
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SKETCH_POINT x=1 y=2"));
+        commands.add(MacroRecorder.MacroCommand.fromScriptLine("SKETCH_NACA profile=12 chord=1"));
+
+        // SET_UNITS compiles to nothing, so the failing step is the second instruction
+        MacroProgram program = MacroProgram.compile(commands);
+        assertEquals(2, program.size());
+        MacroProgram.Result result = program.run(new ModelContext(), new Sketch(), null, null);
+        assertEquals(1, result.getErrors().size());
+        assertTrue(result.getErrors().get(0), result.getErrors().get(0).startsWith("Step 3 (SKETCH_NACA)"));
+
+        MacroProgram tail = MacroProgram.compile(commands, null, 5);
+        MacroProgram.Result tailResult = tail.run(new ModelContext(), new Sketch(), null, null);
+        assertTrue(tailResult.getErrors().get(0), tailResult.getErrors().get(0).startsWith("Step 7 (SKETCH_NACA)"));
+    }
+
+    @Test
+    public void testCancelStopsBetweenSteps() {
+        List<MacroRecorder.MacroCommand> commands = new ArrayList<>();
+        for (int i = 0; i < 100; i++) {
+            commands.add(MacroRecorder.MacroCommand.fromScriptLine("SKETCH_POINT x=" + i + " y=0"));
+        }
+        MacroProgram program = MacroProgram.compile(commands);
+        program.setProgressIntervalMillis(0);
+
+        AtomicBoolean cancel = new AtomicBoolean();
+        Sketch sketch = new Sketch();
+        MacroProgram.Result result = program.run(new ModelContext(), sketch, (done, total) -> {
+            if (done == 10) {
+                cancel.set(true);
+            }
+        }, cancel);
+        assertTrue(result.isCancelled());
+        assertEquals(10, result.getExecuted());
+        assertEquals(10, sketch.getEntities().size());
+    }
+}
@@ -0,0 +1,104 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import cad.geometry.booleans.IndexedMesh;
+import cad.geometry.booleans.MeshBoolean;
+import cad.geometry.booleans.Predicates;
+import eu.mihosoft.jcsg.CSG;
+import eu.mihosoft.jcsg.Cube;
+import eu.mihosoft.jcsg.Cylinder;
+import eu.mihosoft.vvecmath.Transform;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CancellationException;
+
+public class MeshBooleanTest {
+
+    private static IndexedMesh box(double size, double x, double y, double z) {
+        CSG cube = new Cube(size, size, size).toCSG().transformed(Transform.unity().translate(x, y, z));
+        return IndexedMesh.fromCSG(cube);
+    }
+
+    private static void assertClosed(IndexedMesh mesh) {
+        assertEquals("Result should be watertight", 0, mesh.countOpenEdges());
+    }
+
+    @Test
+    public void testOffsetCubes() {
+        IndexedMesh a = box(2, 0, 0, 0);
+        IndexedMesh b = box(2, 1, 1, 1);
+
+        IndexedMesh union = MeshBoolean.union(a, b);
+        IndexedMesh difference = MeshBoolean.difference(a, b);
+        IndexedMesh intersection = MeshBoolean.intersection(a, b);
+
+        assertEquals(15.0, union.volume(), 1e-9);
+        assertEquals(7.0, difference.volume(), 1e-9);
+        assertEquals(1.0, intersection.volume(), 1e-9);
+        assertClosed(union);
+        assertClosed(difference);
+        assertClosed(intersection);
+    }
+
+    @Test
+    public void testCoplanarFaces() {
+        // Stacked cubes share a face; a pocket is flush with the top of the block
+        IndexedMesh stacked = MeshBoolean.union(box(2, 0, 0, 0), box(2, 0, 0, 2));
+        assertEquals(16.0, stacked.volume(), 1e-9);
+        assertClosed(stacked);
+
+        IndexedMesh block = IndexedMesh.fromCSG(new Cube(4, 4, 2).toCSG());
+        IndexedMesh pocket = IndexedMesh.fromCSG(
+                new Cube(2, 2, 1).toCSG().transformed(Transform.unity().translateZ(0.5)));
+        IndexedMesh pocketed = MeshBoolean.difference(block, pocket);
+        assertEquals(28.0, pocketed.volume(), 1e-9);
+        assertClosed(pocketed);
+    }
+
+    @Test
+    public void testDrilledCubeVolumesAgree() {
+        IndexedMesh a = box(2, 0, 0, 0);
+        IndexedMesh b = IndexedMesh.fromCSG(new Cylinder(0.7, 2.4, 24).toCSG()
+                .transformed(Transform.unity().translate(0.3, 0.2, -1.2)));
+
+        double union = MeshBoolean.union(a, b).volume();
+        double difference = MeshBoolean.difference(a, b).volume();
+        double intersection = MeshBoolean.intersection(a, b).volume();
+
+        assertEquals(a.volume() + b.volume() - intersection, union, 1e-9);
+        assertEquals(a.volume() - intersection, difference, 1e-9);
+        assertClosed(MeshBoolean.difference(a, b));
+    }
+
+    @Test
+    public void testProgressAndCancellation() throws Exception {
+        List<String> phases = new ArrayList<>();
+        OperationMonitor monitor = new OperationMonitor((phase, done, total) -> {
+            synchronized (phases) {
+                phases.add(phase);
+            }
+        });
+        monitor.call(() -> MeshBoolean.union(box(2, 0, 0, 0), box(2, 1, 1, 1)));
+        assertTrue(phases.toString(), phases.contains("Intersecting triangles"));
+        assertTrue(phases.toString(), phases.contains("Classifying patches"));
+
+        monitor.cancel();
+        try {
+            monitor.call(() -> MeshBoolean.union(box(2, 0, 0, 0), box(2, 1, 1, 1)));
+            fail("A cancelled boolean should not finish");
+        } catch (CancellationException expected) {
+        }
+    }
+
+    @Test
+    public void testOrientationIsExactNearDegenerateInput() {
+        // Points with x == y are exactly collinear; moving one by a single ulp must change the sign
+        double below = Math.nextDown(0.2);
+        assertEquals(0, Predicates.orient2d(0.1, 0.1, 0.3, 0.3, 0.2, 0.2));
+        assertEquals(-1, Predicates.orient2d(0.1, 0.1, 0.3, 0.3, 0.2, below));
+        assertEquals(0, Predicates.orient3d(0.1, 0.1, 0, 0.3, 0.3, 0, 0.1, 0.1, 1, 0.2, 0.2, 0.5));
+        assertEquals(1, Predicates.orient3d(0.1, 0.1, 0, 0.3, 0.3, 0, 0.1, 0.1, 1, 0.2, below, 0.5));
+    }
+}
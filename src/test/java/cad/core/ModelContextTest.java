@@ -0,0 +1,42 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+public class ModelContextTest {
+
+    @Test
+    public void testContextsAreIsolated() throws Exception {
+        ModelContext a = new ModelContext("a");
+        ModelContext b = new ModelContext("b");
+        float before = ModelContext.getDefault().call(Geometry::getParam);
+
+        ExecutorService pool = Executors.newFixedThreadPool(2);
+        try {
+            Future<Float> fa = pool.submit(() -> a.call(() -> {
+                Geometry.createCube(10.0f, 1);
+                return Geometry.getParam();
+            }));
+            Future<Float> fb = pool.submit(() -> b.call(() -> {
+                Geometry.createCube(20.0f, 1);
+                return Geometry.getParam();
+            }));
+            assertEquals(10.0f, fa.get(), 1e-6f);
+            assertEquals(20.0f, fb.get(), 1e-6f);
+        } finally {
+            pool.shutdown();
+        }
+
+        // Each context keeps its own model after the threads are gone
+        assertEquals(10.0f, a.call(Geometry::getParam), 1e-6f);
+        assertEquals(20.0f, b.call(Geometry::getParam), 1e-6f);
+        assertEquals(before, Geometry.getParam(), 1e-6f);
+        List<float[]> triangles = a.call(Geometry::getExtrudedTriangles);
+        assertNotSame(triangles, b.call(Geometry::getExtrudedTriangles));
+    }
+}
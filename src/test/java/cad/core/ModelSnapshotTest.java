@@ -0,0 +1,92 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+
+public class ModelSnapshotTest {
+
+    @Test
+    public void testCommandsPublishImmutableVersions() {
+        ModelContext context = new ModelContext();
+        CommandManager manager = new CommandManager();
+        assertSame(ModelSnapshot.EMPTY, context.snapshot());
+
+        context.run(() -> manager.executeCommand(new CreateCubeCommand(10.0f, 4)));
+        ModelSnapshot first = context.snapshot();
+        assertEquals(1, first.getVersion());
+        assertEquals(Geometry.Shape.CSG_RESULT, first.getShape());
+        int cubeTriangles = first.getActiveTriangles().size();
+        assertTrue(cubeTriangles > 0);
+        assertEquals(10.0f, first.getMaxDimension(), 1e-4f);
+
+        // Editing the live model afterwards leaves the published version as it was
+        context.run(() -> manager.executeCommand(new CreateCubeCommand(2.0f, 1)));
+        ModelSnapshot second = context.snapshot();
+        assertEquals(2, second.getVersion());
+        assertEquals(2.0f, second.getParam(), 0.0f);
+        assertEquals(10.0f, first.getParam(), 0.0f);
+        assertEquals(cubeTriangles, first.getActiveTriangles().size());
+        assertEquals(10.0f, first.getMaxDimension(), 1e-4f);
+        assertEquals(2.0f, second.getMaxDimension(), 1e-4f);
+
+        context.run(manager::undo);
+        assertEquals(10.0f, context.snapshot().getParam(), 0.0f);
+    }
+
+    @Test
+    public void testSketchIsFrozenIntoStrokes() {
+        ModelContext context = new ModelContext();
+        Sketch sketch = new Sketch();
+        context.setSketch(sketch);
+        sketch.addLine(0, 0, 3, 4);
+        sketch.addCircle(0, 0, 2);
+        ModelSnapshot before = context.publish();
+        assertEquals(2, before.getStrokes().size());
+        ModelSnapshot.Stroke line = before.getStrokes().get(0);
+        assertEquals(ModelSnapshot.StrokeMode.LINES, line.getMode());
+        assertEquals(4.0f, line.getY(1), 0.0f);
+
+        sketch.addPoint(1, 1);
+        assertEquals(2, before.getStrokes().size());
+        assertEquals(3, context.publish().getStrokes().size());
+    }
+
+    @Test
+    public void testPublishDoesNotWaitForAnotherWriter() throws Exception {
+        ModelContext context = new ModelContext();
+        CountDownLatch holding = new CountDownLatch(1);
+        CountDownLatch release = new CountDownLatch(1);
+        CompletableFuture<Void> writer = CompletableFuture.runAsync(() -> context.run(() -> {
+            holding.countDown();
+            try {
+                release.await();
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+        }));
+        assertTrue(holding.await(10, TimeUnit.SECONDS));
+        assertSame(ModelSnapshot.EMPTY, context.publish());
+        release.countDown();
+        writer.get(10, TimeUnit.SECONDS);
+        assertEquals(1, context.publish().getVersion());
+    }
+
+    @Test
+    public void testUpdatePublishesFromTheEditingThread() {
+        ModelContext context = new ModelContext();
+        Sketch sketch = new Sketch();
+        context.setSketch(sketch);
+        context.update(() -> sketch.addLine(0, 0, 1, 1));
+        assertEquals(1, context.snapshot().getVersion());
+        assertEquals(1, context.snapshot().getStrokes().size());
+
+        int status = context.update(() -> sketch.addCircle(0, 0, 2));
+        assertEquals(0, status);
+        assertEquals(2, context.snapshot().getVersion());
+        assertEquals(2, context.snapshot().getStrokes().size());
+    }
+}
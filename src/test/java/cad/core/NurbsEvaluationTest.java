@@ -0,0 +1,94 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import cad.geometry.curves.NurbsCurve;
+import cad.geometry.surfaces.NurbsSurface;
+import cad.geometry.surfaces.Surface;
+import cad.math.Vector3d;
+
+public class NurbsEvaluationTest {
+
+    @Test
+    public void testCircleLiesOnRadius() {
+        NurbsCurve circle = NurbsCurve.createCircle(Vector3d.zero(), 5.0, Vector3d.Z_AXIS);
+
+        for (int i = 0; i <= 100; i++) {
+            Vector3d p = circle.value(i / 100.0);
+            assertEquals("Point should lie on the circle", 5.0, p.magnitude(), 1e-9);
+        }
+    }
+
+    @Test
+    public void testDerivativeMatchesFiniteDifference() {
+        NurbsCurve circle = NurbsCurve.createCircle(Vector3d.zero(), 2.0, Vector3d.Z_AXIS);
+        double h = 1e-6;
+
+        for (double t : new double[] { 0.1, 0.3, 0.6, 0.9 }) {
+            Vector3d d = circle.derivative(t);
+            Vector3d fd = circle.value(t + h).minus(circle.value(t - h)).multiply(1.0 / (2 * h));
+            assertEquals(fd.x(), d.x(), 1e-4);
+            assertEquals(fd.y(), d.y(), 1e-4);
+            assertEquals(fd.z(), d.z(), 1e-4);
+        }
+    }
+
+    @Test
+    public void testBatchEvaluateMatchesValue() {
+        NurbsCurve line = NurbsCurve.createLine(new Vector3d(0, 0, 0), new Vector3d(10, 4, 2));
+        double[] ts = { 0.0, 0.25, 0.5, 1.0 };
+        double[] out = new double[3 * ts.length];
+
+        line.evaluate(ts, out);
+
+        for (int i = 0; i < ts.length; i++) {
+            Vector3d p = line.value(ts[i]);
+            assertEquals(p.x(), out[3 * i], 1e-12);
+            assertEquals(p.y(), out[3 * i + 1], 1e-12);
+            assertEquals(p.z(), out[3 * i + 2], 1e-12);
+        }
+        assertEquals(10.0, out[9], 1e-12);
+    }
+
+    @Test
+    public void testSurfaceGridMatchesPointEvaluation() {
+        NurbsSurface cylinder = NurbsSurface.createCylindricalSurface(Vector3d.zero(), Vector3d.Z_AXIS, 3.0, 8.0);
+        double[] us = Surface.uniformSamples(0.0, 1.0, 17);
+        double[] vs = Surface.uniformSamples(0.0, 1.0, 5);
+        double[] positions = new double[3 * us.length * vs.length];
+        double[] normals = new double[positions.length];
+
+        cylinder.evaluateGrid(us, vs, positions, normals);
+
+        for (int j = 0; j < vs.length; j++) {
+            for (int i = 0; i < us.length; i++) {
+                int o = (j * us.length + i) * 3;
+                Vector3d p = cylinder.value(us[i], vs[j]);
+                Vector3d n = cylinder.normal(us[i], vs[j]);
+                assertEquals(p.x(), positions[o], 1e-9);
+                assertEquals(p.y(), positions[o + 1], 1e-9);
+                assertEquals(p.z(), positions[o + 2], 1e-9);
+                assertEquals(n.x(), normals[o], 1e-9);
+                assertEquals(n.y(), normals[o + 1], 1e-9);
+                assertEquals(n.z(), normals[o + 2], 1e-9);
+                assertEquals(3.0, Math.hypot(positions[o], positions[o + 1]), 1e-9);
+            }
+        }
+    }
+
+    @Test
+    public void testArcLengthTable() {
+        NurbsCurve circle = NurbsCurve.createCircle(Vector3d.zero(), 5.0, Vector3d.Z_AXIS);
+        assertEquals(2 * Math.PI * 5.0, circle.length(), 1e-8);
+        // Start and end coincide, so the chord says nothing about the length
+        assertEquals(2 * Math.PI * 5.0, circle.length(circle.startParam(), circle.endParam()), 1e-8);
+
+        double[] ts = circle.equalLengthParams(9);
+        double step = circle.length() / 8;
+        for (int i = 0; i < ts.length - 1; i++) {
+            assertEquals(step, circle.length(ts[i], ts[i + 1]), 1e-8);
+        }
+        assertEquals(0.3, circle.paramAtLength(circle.getArcLengthTable().lengthAtParam(0.3)), 1e-9);
+    }
+}
@@ -0,0 +1,108 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import java.util.List;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+
+public class OperationExecutorTest {
+
+    @Test
+    public void testCancelRollsBackGeometry() throws Exception {
+        OperationExecutor executor = new OperationExecutor(1, Runnable::run);
+        ModelContext context = new ModelContext("cancel");
+        Sketch sketch = new Sketch();
+        sketch.addNSidedPolygon(0, 0, 5, 4);
+        CountDownLatch extruded = new CountDownLatch(1);
+
+        OperationExecutor.Operation<List<float[]>> operation = executor.submit("extrude", context, () -> {
+            Geometry.extrude(sketch, 10, Geometry.BooleanOp.UNION);
+            extruded.countDown();
+            // Stand-in for a long kernel loop
+            while (true) {
+                OperationMonitor.current().step();
+                Thread.onSpinWait();
+            }
+        }, null);
+        assertTrue(extruded.await(10, TimeUnit.SECONDS));
+        operation.cancel();
+        try {
+            operation.getFuture().get(10, TimeUnit.SECONDS);
+            fail("Expected cancellation");
+        } catch (ExecutionException e) {
+            assertTrue(e.getCause() instanceof CancellationException);
+        }
+        assertTrue(context.call(Geometry::getExtrudedTriangles).isEmpty());
+        executor.shutdown();
+    }
+
+    @Test
+    public void testCancelDoesNotWaitForOpaqueWork() throws Exception {
+        OperationExecutor executor = new OperationExecutor(1, Runnable::run);
+        ModelContext context = new ModelContext("opaque");
+        CountDownLatch started = new CountDownLatch(1);
+        CountDownLatch release = new CountDownLatch(1);
+
+        // Stands in for a JCSG boolean, which never checks the monitor
+        OperationExecutor.Operation<Object> operation = executor.submit("boolean", context,
+                () -> OperationMonitor.current().callOpaque(() -> {
+                    started.countDown();
+                    try {
+                        release.await();
+                    } catch (InterruptedException e) {
+                        Thread.currentThread().interrupt();
+                    }
+                    return null;
+                }), null);
+        assertTrue(started.await(10, TimeUnit.SECONDS));
+        operation.cancel();
+        try {
+            operation.getFuture().get(10, TimeUnit.SECONDS);
+            fail("Expected cancellation");
+        } catch (ExecutionException e) {
+            assertTrue(e.getCause() instanceof CancellationException);
+        } finally {
+            release.countDown();
+        }
+        executor.shutdown();
+    }
+
+    @Test
+    public void testResultAndProgress() throws Exception {
+        OperationExecutor executor = new OperationExecutor(1, Runnable::run);
+        ModelContext context = new ModelContext("progress");
+        Sketch sketch = new Sketch();
+        sketch.addNSidedPolygon(0, 0, 5, 4);
+        StringBuilder phases = new StringBuilder();
+
+        OperationExecutor.Operation<List<float[]>> operation = executor.submit("extrude", context, () -> {
+            Geometry.extrude(sketch, 10, Geometry.BooleanOp.UNION);
+            return Geometry.getExtrudedTriangles();
+        }, (phase, done, total) -> phases.append(phase).append(';'));
+        assertFalse(operation.getFuture().get(10, TimeUnit.SECONDS).isEmpty());
+        assertTrue(phases.length() > 0);
+        executor.shutdown();
+    }
+
+    @Test
+    public void testRevolveReportsProfileAndFaces() throws Exception {
+        OperationExecutor executor = new OperationExecutor(1, Runnable::run);
+        ModelContext context = new ModelContext("revolve");
+        Sketch sketch = new Sketch();
+        sketch.addNSidedPolygon(10, 0, 2, 4);
+        StringBuilder phases = new StringBuilder();
+
+        OperationExecutor.Operation<List<float[]>> operation = executor.submit("revolve", context, () -> {
+            new CreateRevolveCommand(sketch, "Y", 360, 32).execute();
+            return Geometry.getExtrudedTriangles();
+        }, (phase, done, total) -> phases.append(phase).append(';'));
+        assertFalse(operation.getFuture().get(10, TimeUnit.SECONDS).isEmpty());
+        assertTrue(phases.toString(), phases.indexOf("Revolving profile") >= 0);
+        assertTrue(phases.toString(), phases.indexOf("Tessellating faces") >= 0);
+        executor.shutdown();
+    }
+}
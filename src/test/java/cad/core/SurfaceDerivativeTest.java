@@ -0,0 +1,61 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import cad.geometry.curves.ArcCurve;
+import cad.geometry.curves.CurveDerivatives;
+import cad.geometry.curves.LineCurve;
+import cad.geometry.surfaces.ConicalSurface;
+import cad.geometry.surfaces.SphericalSurface;
+import cad.geometry.surfaces.Surface;
+import cad.geometry.surfaces.SurfaceDerivatives;
+import cad.geometry.surfaces.SurfaceOfRevolution;
+import cad.math.Vector3d;
+
+public class SurfaceDerivativeTest {
+    private static final double H = 1e-5;
+
+    @Test
+    public void testAnalyticSurfaceDerivativesMatchDifferences() {
+        Surface[] surfaces = {
+            new SphericalSurface(new Vector3d(1, 2, 3), 4.0),
+            new ConicalSurface(Vector3d.zero(), Vector3d.Z_AXIS, 2.0, 0.3, 0.0, 5.0),
+            new SurfaceOfRevolution(new LineCurve(new Vector3d(2, 0, 0), new Vector3d(3, 0, 4)),
+                Vector3d.zero(), Vector3d.Z_AXIS)
+        };
+
+        for (Surface s : surfaces) {
+            double u = 0.3, v = 0.4;
+            SurfaceDerivatives d = s.evaluateWithDerivatives(u, v);
+            assertClose(s.value(u, v), d.point, 1e-9);
+            assertClose(difference(s.value(u + H, v), s.value(u - H, v)), d.du, 1e-4);
+            assertClose(difference(s.value(u, v + H), s.value(u, v - H)), d.dv, 1e-4);
+            assertClose(difference(s.derivativeU(u + H, v), s.derivativeU(u - H, v)), d.duu, 1e-3);
+            assertClose(difference(s.derivativeU(u, v + H), s.derivativeU(u, v - H)), d.duv, 1e-3);
+            assertClose(difference(s.derivativeV(u, v + H), s.derivativeV(u, v - H)), d.dvv, 1e-3);
+        }
+    }
+
+    @Test
+    public void testArcDerivatives() {
+        ArcCurve arc = new ArcCurve(Vector3d.zero(), 3.0, 0.5, 2.0, Vector3d.Z_AXIS);
+        assertEquals(3.0, arc.getStart().magnitude(), 1e-12);
+
+        double t = 0.6;
+        CurveDerivatives d = arc.evaluateWithDerivatives(t);
+        assertClose(difference(arc.value(t + H), arc.value(t - H)), d.first, 1e-4);
+        assertClose(difference(arc.derivative(t + H), arc.derivative(t - H)), d.second, 1e-3);
+        assertEquals(1.0 / 3.0, d.curvature(), 1e-9);
+    }
+
+    private static Vector3d difference(Vector3d plus, Vector3d minus) {
+        return plus.subtract(minus).multiply(1.0 / (2 * H));
+    }
+
+    private static void assertClose(Vector3d expected, Vector3d actual, double tol) {
+        assertEquals(expected.x(), actual.x(), tol);
+        assertEquals(expected.y(), actual.y(), tol);
+        assertEquals(expected.z(), actual.z(), tol);
+    }
+}
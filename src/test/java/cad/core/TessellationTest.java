@@ -0,0 +1,193 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+import cad.features.extrusion.LinearSweepFeature;
+import cad.features.revolve.RotationalSweepFeature;
+import cad.geometry.booleans.IndexedMesh;
+import cad.geometry.curves.ArcCurve;
+import cad.geometry.curves.LineCurve;
+import cad.geometry.surfaces.PlaneSurface;
+import cad.geometry.surfaces.Surface;
+import cad.geometry.tessellation.BodyTessellator;
+import cad.geometry.tessellation.CurveTessellator;
+import cad.geometry.tessellation.FaceTessellator;
+import cad.geometry.tessellation.TessellationTolerance;
+import cad.geometry.tessellation.TriangleMesh;
+import cad.math.Vector3d;
+import cad.topology.BRepBody;
+import cad.topology.Edge;
+import cad.topology.EdgeLoop;
+import cad.topology.Face;
+import cad.topology.Vertex;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+
+public class TessellationTest {
+
+    @Test
+    public void testSegmentCountScalesWithRadius() {
+        TessellationTolerance tol = TessellationTolerance.DEFAULT;
+        int small = tol.segmentsForArc(0.5, 2 * Math.PI);
+        int large = tol.segmentsForArc(50.0, 2 * Math.PI);
+
+        assertTrue("Small circles should use few segments", small < 32);
+        assertTrue("Large circles should use more segments than small ones", large > small);
+    }
+
+    @Test
+    public void testCurveSamplesRespectChordalDeviation() {
+        double radius = 20.0;
+        ArcCurve arc = new ArcCurve(Vector3d.zero(), radius, 0.0, Math.PI, Vector3d.Z_AXIS);
+        TessellationTolerance tol = new TessellationTolerance(0.01, Math.PI, 1, 4096);
+
+        List<Vector3d> points = CurveTessellator.tessellate(arc, tol);
+
+        for (int i = 0; i < points.size() - 1; i++) {
+            Vector3d mid = points.get(i).plus(points.get(i + 1)).multiply(0.5);
+            double sagitta = radius - mid.magnitude();
+            assertTrue("Sagitta " + sagitta + " exceeds tolerance", sagitta <= 0.01 + 1e-9);
+        }
+    }
+
+    @Test
+    public void testCurveSamplesHonourMinimumSegments() {
+        // Loose enough that bisection alone would stop at once: a full circle's midpoint is a whole
+        // diameter from its degenerate chord, and the end tangents agree
+        TessellationTolerance tol = new TessellationTolerance(10.0, Math.PI, 8, 512);
+        ArcCurve circle = new ArcCurve(Vector3d.zero(), 1.0, 0.0, 2 * Math.PI, Vector3d.Z_AXIS);
+        ArcCurve quarter = new ArcCurve(Vector3d.zero(), 1.0, 0.0, Math.PI / 2, Vector3d.Z_AXIS);
+        LineCurve line = new LineCurve(Vector3d.zero(), new Vector3d(10, 0, 0));
+
+        assertEquals(9, CurveTessellator.sampleParameters(circle, tol).length);
+        assertEquals("An arc gets the share of the minimum its sweep covers", 3,
+                CurveTessellator.sampleParameters(quarter, tol).length);
+        assertEquals("Straight edges are not seeded", 2, CurveTessellator.sampleParameters(line, tol).length);
+    }
+
+    @Test
+    public void testExtrudedBoxTessellation() throws Exception {
+        Sketch sketch = new Sketch();
+        sketch.addLine(0, 0, 10, 0);
+        sketch.addLine(10, 0, 10, 10);
+        sketch.addLine(10, 10, 0, 10);
+        sketch.addLine(0, 10, 0, 0);
+
+        BRepBody body = new LinearSweepFeature(sketch, 10.0, Vector3d.Z_AXIS).generate();
+        TriangleMesh mesh = BodyTessellator.tessellate(body, TessellationTolerance.DEFAULT);
+
+        assertEquals("Six quads should give twelve triangles", 12, mesh.getTriangleCount());
+
+        double area = 0.0;
+        for (float[] tri : mesh.toTriangles()) {
+            Vector3d a = new Vector3d(tri[3], tri[4], tri[5]);
+            Vector3d b = new Vector3d(tri[6], tri[7], tri[8]);
+            Vector3d c = new Vector3d(tri[9], tri[10], tri[11]);
+            area += b.subtract(a).cross(c.subtract(a)).magnitude() / 2.0;
+        }
+        assertEquals(600.0, area, 1e-6);
+    }
+
+    @Test
+    public void testFaceWithHole() {
+        EdgeLoop outer = squareLoop(0, 0, 10);
+        EdgeLoop inner = squareLoop(4, 4, 2);
+        Face face = new Face(new PlaneSurface(Vector3d.zero(), Vector3d.Z_AXIS), outer);
+        face.addInnerLoop(inner);
+
+        TriangleMesh mesh = FaceTessellator.tessellate(face, new HashMap<>(), TessellationTolerance.DEFAULT);
+
+        double area = 0.0;
+        for (float[] tri : mesh.toTriangles()) {
+            Vector3d a = new Vector3d(tri[3], tri[4], tri[5]);
+            Vector3d b = new Vector3d(tri[6], tri[7], tri[8]);
+            Vector3d c = new Vector3d(tri[9], tri[10], tri[11]);
+            area += b.subtract(a).cross(c.subtract(a)).magnitude() / 2.0;
+        }
+        assertEquals("The hole must stay open", 96.0, area, 1e-6);
+    }
+
+    @Test
+    public void testRevolvedFacesShareTheirEdges() throws Exception {
+        // Neighbouring swept faces are both curved and meet along the arcs the profile corners sweep
+        Sketch sketch = new Sketch();
+        sketch.addNSidedPolygon(10, 0, 2, 4);
+
+        for (double angle : new double[] { Math.PI / 2, 2 * Math.PI }) {
+            BRepBody body = new RotationalSweepFeature(sketch, Vector3d.zero(), Vector3d.Y_AXIS, angle).generate();
+            TriangleMesh mesh = BodyTessellator.tessellate(body, TessellationTolerance.DEFAULT);
+            IndexedMesh welded = IndexedMesh.fromTriangles(mesh.toTriangles());
+
+            assertEquals("Revolve by " + angle + " should be watertight", 0, welded.countOpenEdges());
+        }
+    }
+
+    @Test
+    public void testRefinementStaysWhereTheSurfaceCurves() {
+        // Flat except for a bump of radius 3 around (7, 5); the left strip is far from it
+        Surface bump = new Surface() {
+            @Override
+            public Vector3d value(double u, double v) {
+                double r2 = ((u - 7) * (u - 7) + (v - 5) * (v - 5)) / 9.0;
+                return new Vector3d(u, v, r2 < 1 ? 2 * (1 - r2) * (1 - r2) : 0);
+            }
+
+            @Override
+            public Vector3d normal(double u, double v) {
+                return derivativeU(u, v).cross(derivativeV(u, v)).normalize();
+            }
+
+            @Override
+            public double[] parametersOf(Vector3d p) {
+                return new double[] { p.x(), p.y() };
+            }
+
+            @Override
+            public double getUMax() {
+                return 10;
+            }
+
+            @Override
+            public double getVMax() {
+                return 10;
+            }
+
+            @Override
+            public BoundingBox getBounds() {
+                return new BoundingBox(Vector3d.zero(), new Vector3d(10, 10, 2));
+            }
+        };
+        Face face = new Face(bump, squareLoop(0, 0, 10));
+
+        TriangleMesh mesh = FaceTessellator.tessellate(face, new HashMap<>(), TessellationTolerance.DEFAULT);
+
+        int flat = 0;
+        int curved = 0;
+        for (float[] tri : mesh.toTriangles()) {
+            double x = (tri[3] + tri[6] + tri[9]) / 3.0;
+            double y = (tri[4] + tri[7] + tri[10]) / 3.0;
+            if (x < 3) {
+                flat++;
+            } else if (Math.hypot(x - 7, y - 5) < 3) {
+                curved++;
+            }
+        }
+        assertTrue(flat + " flat against " + curved + " curved", 10 * flat < curved);
+    }
+
+    private static EdgeLoop squareLoop(double x, double y, double size) {
+        Vertex[] corners = {
+            new Vertex(x, y, 0), new Vertex(x + size, y, 0),
+            new Vertex(x + size, y + size, 0), new Vertex(x, y + size, 0)
+        };
+        List<Edge> edges = new ArrayList<>();
+        for (int i = 0; i < 4; i++) {
+            Vertex a = corners[i];
+            Vertex b = corners[(i + 1) % 4];
+            edges.add(new Edge(a, b, new LineCurve(a.getPoint(), b.getPoint())));
+        }
+        return new EdgeLoop(edges);
+    }
+}
@@ -0,0 +1,62 @@
+package cad.core;
+
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+public class TriangleListTest {
+
+    private static float[] tri(float v) {
+        return new float[] { 0, 0, 1, v, 0, 0, v + 1, 0, 0, v, 1, 0 };
+    }
+
+    @Test
+    public void testSnapshotSharesUntilWritten() {
+        TriangleList live = new TriangleList();
+        int count = 3 * TriangleList.CHUNK_SIZE + 10;
+        for (int i = 0; i < count; i++) {
+            live.add(tri(i));
+        }
+
+        TriangleList snapshot = live.snapshot();
+        assertEquals(count, snapshot.size());
+        for (int c = 0; c < 4; c++) {
+            assertSame(live.chunks()[c], snapshot.chunks()[c]);
+        }
+
+        // Writing one triangle copies only its chunk, and the snapshot keeps the old value
+        float[] replaced = live.get(5);
+        live.set(5, tri(-1));
+        assertSame(replaced, snapshot.get(5));
+        assertNotSame(live.chunks()[0], snapshot.chunks()[0]);
+        assertSame(live.chunks()[1], snapshot.chunks()[1]);
+
+        live.add(tri(count));
+        live.remove(0);
+        assertEquals(count, live.size());
+        assertEquals(count, snapshot.size());
+        assertSame(replaced, snapshot.get(5));
+
+        live.clear();
+        assertTrue(live.isEmpty());
+        assertEquals(count, snapshot.size());
+    }
+
+    @Test
+    public void testUndoRestoresSharedTriangles() {
+        ModelContext context = new ModelContext();
+        context.run(() -> {
+            Geometry.createCube(10.0f, 4);
+            int before = Geometry.getLoadedStlTriangles().size();
+            float[] first = Geometry.getLoadedStlTriangles().get(0);
+
+            CreateCubeCommand cmd = new CreateCubeCommand(5.0f, 8);
+            cmd.execute();
+            assertNotEquals(before, Geometry.getLoadedStlTriangles().size());
+
+            cmd.undo();
+            assertEquals(before, Geometry.getLoadedStlTriangles().size());
+            assertSame(first, Geometry.getLoadedStlTriangles().get(0));
+            assertEquals(10.0f, Geometry.getParam(), 1e-6f);
+        });
+    }
+}